@@ -6,6 +6,8 @@ struct Vertex
     vec2 uv;
 };
 
+#ifndef CAMERA_DATA
+#define CAMERA_DATA
 struct CameraData
 {
     mat4 view;
@@ -14,6 +16,7 @@ struct CameraData
     mat4 proj_inverse;
     vec4 eye;
 };
+#endif
 
 vec3 compute_diffuse(vec3 color, vec3 light_dir, vec3 normal) {
     float dot_nl = max(dot(normal, light_dir), 0.0);
@@ -0,0 +1,25 @@
+// Per-object data of the scene, indexed by object index. Passes receive the buffer address or bind the buffer.
+// Layout must match sd::GpuObject, requires GL_EXT_buffer_reference2, GL_EXT_scalar_block_layout and 64-bit integers.
+#ifndef GPU_SCENE_GLSL
+#define GPU_SCENE_GLSL
+
+const uint NO_MESH = 0xffffffffu;
+
+struct GpuObject
+{
+    mat4     model;
+    vec4     color;
+    uint64_t vertex_buffer;
+    uint64_t index_buffer;
+    uint64_t meshlet_buffer;
+    uint     mesh_index;
+    uint     meshlet_count;
+    uint64_t previous_vertex_buffer;
+    uint     first_vertex;
+    // Largest distance a vertex is moved by the deformation, 0 for objects that draw the vertices of their mesh.
+    float    deformation;
+};
+
+layout(buffer_reference, scalar) readonly buffer GpuObjects { GpuObject objects[]; };
+
+#endif
@@ -1,29 +1,23 @@
-#version 460
-
-#extension GL_EXT_ray_tracing : require
-#extension GL_EXT_ray_query : enable
-#extension GL_GOOGLE_include_directive : enable
+// Shared by rg_lighting_pass.frag and rg_lighting_pass_raster.frag.
+// LIGHTING_PASS_RAY_QUERY enables ray query shadows, it requires a ray tracing capable device.
 
 layout (location = 0) in vec2 f_uv;
 
-layout (set = 0, binding = 0) uniform LightingPassUniform {
-    mat4 view;
-    mat4 proj;
-    mat4 view_inverse;
-    mat4 proj_inverse;
-    vec4 eye;
-} ubo;
-
-layout (set = 0, binding = 1) uniform sampler2D u_position;
-layout (set = 0, binding = 2) uniform sampler2D u_normal;
-layout (set = 0, binding = 3) uniform sampler2D u_albedo;
-layout (set = 0, binding = 4) uniform sampler2D u_depth;
-layout (set = 0, binding = 5) uniform sampler2D u_ao;
-layout (set = 0, binding = 6) uniform accelerationStructureEXT u_tlas;
+#include "include/view_constants.glsl"
+
+layout (set = 1, binding = 1) uniform sampler2D u_position;
+layout (set = 1, binding = 2) uniform sampler2D u_normal;
+layout (set = 1, binding = 3) uniform sampler2D u_albedo;
+layout (set = 1, binding = 4) uniform sampler2D u_depth;
+#ifdef LIGHTING_PASS_RAY_QUERY
+layout (set = 1, binding = 5) uniform accelerationStructureEXT u_tlas;
+#endif
+layout (set = 1, binding = 6) uniform sampler2D u_ao;
+
+layout (constant_id = 0) const bool ENABLE_AO = false;
+layout (constant_id = 1) const bool ENABLE_SHADOWS = true;
 
 layout (push_constant) uniform LightingPassPushConstant {
-    // [0]: Enabled RayQuery shadows
-    ivec4 flags_a;
     vec4 light_pos;
 } pc;
 
@@ -55,7 +49,7 @@ void main() {
     vec3 i_worldPos = texture(u_position, uv).rgb;
     vec3 i_worldNormal = texture(u_normal, uv).rgb;
     vec3 i_color = texture(u_albedo, uv).rgb;
-    vec3 i_viewDir = ubo.eye.xyz - i_worldPos;
+    vec3 i_viewDir = u_view.current.eye.xyz - i_worldPos;
 
     vec3 N = normalize(i_worldNormal);
 
@@ -74,7 +68,8 @@ void main() {
     float t_min = 0.01;
     float t_max = light_distance;
 
-    if (pc.flags_a.x == 1) {
+#ifdef LIGHTING_PASS_RAY_QUERY
+    if (ENABLE_SHADOWS) {
         rayQueryEXT ray_query;
         rayQueryInitializeEXT(ray_query, u_tlas, gl_RayFlagsTerminateOnFirstHitEXT | gl_RayFlagsOpaqueEXT, 0xFF, origin, t_min, direction, t_max);
 
@@ -85,8 +80,13 @@ void main() {
             color *= shadow;
         }
     }
+#endif
+
+    if (ENABLE_AO) {
+        float occlusion = texture(u_ao, uv).r;
+        color.rgb *= occlusion;
+    }
 
     float gamma = 1.0 / 2.2;
-    float occlusion = texture(u_ao, uv).r;
-    outColor = vec4(pow(color.rgb * occlusion, vec3(gamma)), 1.0);
+    outColor = vec4(pow(color.rgb, vec3(gamma)), 1.0);
 }
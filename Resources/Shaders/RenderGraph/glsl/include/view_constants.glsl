@@ -0,0 +1,26 @@
+// Per-frame view constants, computed and uploaded once per frame and shared by every pass at set 0.
+// Layout must match Nebula::RenderGraph::ViewConstantsData.
+#ifndef VIEW_CONSTANTS_GLSL
+#define VIEW_CONSTANTS_GLSL
+
+#ifndef CAMERA_DATA
+#define CAMERA_DATA
+struct CameraData
+{
+    mat4 view;
+    mat4 proj;
+    mat4 view_inverse;
+    mat4 proj_inverse;
+    vec4 eye;
+};
+#endif
+
+layout (set = 0, binding = 0) uniform ViewConstants {
+    CameraData current;
+    CameraData previous;
+    vec2       jitter;
+    vec2       resolution;
+    uint       frame_index;
+} u_view;
+
+#endif
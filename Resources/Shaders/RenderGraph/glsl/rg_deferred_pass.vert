@@ -1,23 +1,28 @@
 #version 460
 
-struct CameraData
-{
-    mat4 view;
-    mat4 proj;
-    mat4 view_inverse;
-    mat4 proj_inverse;
-    vec4 eye;
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_scalar_block_layout : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "include/view_constants.glsl"
+#include "include/gpu_scene.glsl"
+
+// Object index of each instance, from the render list or written by GPU culling.
+layout(buffer_reference, scalar) readonly buffer InstanceObjects { uint objects[]; };
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
 };
 
-layout (set = 0, binding = 0) uniform PrePassUniform {
-    CameraData current_camera;
-    CameraData previous_camera;
-} ubo;
+layout(buffer_reference, scalar) readonly buffer Vertices { Vertex vertices[]; };
 
-layout (push_constant) uniform ObjectPushConstantData {
-    mat4 model;
-    vec4 color;
-} obj;
+layout (push_constant) uniform PushConstant {
+    uint64_t objects_address;
+    uint64_t instances_address;
+} push_constant;
 
 layout (location = 0) in vec3 i_position;
 layout (location = 1) in vec3 i_normal;
@@ -33,20 +38,35 @@ layout (location = 6) out vec4 o_previousPosition;
 
 void main()
 {
-    CameraData camera = ubo.current_camera;
-    CameraData previous_camera = ubo.previous_camera;
+    uint object = InstanceObjects(push_constant.instances_address).objects[gl_InstanceIndex];
+    GpuObject obj = GpuObjects(push_constant.objects_address).objects[object];
+
+    vec3 position = i_position;
+    vec3 normal = i_normal;
+    vec3 previous_position = i_position;
+    if (obj.deformation > 0.0)
+    {
+        // Drawn with the indices and vertex offset of the mesh, the deformed vertices of the object start at its first vertex.
+        uint vertex = uint(gl_VertexIndex) - obj.first_vertex;
+        position = Vertices(obj.vertex_buffer).vertices[vertex].position;
+        normal = Vertices(obj.vertex_buffer).vertices[vertex].normal;
+        previous_position = Vertices(obj.previous_vertex_buffer).vertices[vertex].position;
+    }
+
+    CameraData camera = u_view.current;
+    CameraData previous_camera = u_view.previous;
 
     vec3 origin = vec3(camera.view_inverse * vec4(0, 0, 0, 1));
-    vec4 currentWorldPosition = obj.model * vec4(i_position, 1.0);
+    vec4 currentWorldPosition = obj.model * vec4(position, 1.0);
 
     o_worldPos = currentWorldPosition.xyz;
-    o_worldNormal = mat3(obj.model) * i_normal;
+    o_worldNormal = mat3(obj.model) * normal;
     o_uv = i_uv;
     o_color = obj.color.xyz;
     o_viewDir = vec3(o_worldPos - origin);
 
     o_currentPosition = camera.proj * camera.view * currentWorldPosition;
-    o_previousPosition = previous_camera.proj * previous_camera.view * obj.model * vec4(i_position, 1.0);
+    o_previousPosition = previous_camera.proj * previous_camera.view * obj.model * vec4(previous_position, 1.0);
 
     gl_Position = o_currentPosition;
 }
\ No newline at end of file
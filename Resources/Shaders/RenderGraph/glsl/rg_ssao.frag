@@ -1,24 +1,20 @@
 #version 460
 
-layout (location = 0) in vec2 f_uv;
+#extension GL_GOOGLE_include_directive : enable
+
+#include "include/view_constants.glsl"
 
-layout (set = 0, binding = 0) uniform CameraDataUniform {
-    mat4 view;
-    mat4 proj;
-    mat4 view_inverse;
-    mat4 proj_inverse;
-    vec4 eye;
-} camera;
+layout (location = 0) in vec2 f_uv;
 
-layout (set = 0, binding = 1) uniform Options {
+layout (set = 1, binding = 1) uniform Options {
     ivec4 sampleCount;
     vec4 radius_bias; /* 0.5, 0.025 */
     vec4 samples[64]; /* Capped at 64 */
     vec4 noise[32]; /* Always at 32 */
 } options;
 
-layout (set = 0, binding = 2) uniform sampler2D u_position;
-layout (set = 0, binding = 3) uniform sampler2D u_normal;
+layout (set = 1, binding = 2) uniform sampler2D u_position;
+layout (set = 1, binding = 3) uniform sampler2D u_normal;
 
 layout (location = 0) out float outColor;
 
@@ -49,7 +45,7 @@ void main() {
         sample_pos = position + sample_pos * radius;
 
         vec4 offset = vec4(sample_pos, 1.0);
-        offset = camera.proj * offset;
+        offset = u_view.current.proj * offset;
         offset.xyz /= offset.w;
         offset.xyz = offset.xyz * 0.5 + 0.5;
 
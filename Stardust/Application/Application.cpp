@@ -1,23 +1,74 @@
 #include "Application.hpp"
 
+#include <algorithm>
+#include <format>
+#include <iostream>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_vulkan.h>
 #include <imnodes.h>
+#include <Benchmark/Benchmark.hpp>
+#include <Nebula/FrameArena.hpp>
+#include <Nebula/SamplerCache.hpp>
 #include <Vulkan/ContextBuilder.hpp>
 #include <Vulkan/Presentation/SwapchainBuilder.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Scene/Scene.hpp>
 #include <VirtualGraph/Builder/Builder.h>
+#include <VirtualGraph/RenderGraph/Nodes/GBufferPass.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 
 std::shared_ptr<sd::Scene> g_rgs;
 
 namespace sd
 {
-    uint32_t Application::s_current_frame = 0;
-
     Application::Application(const ApplicationOptions& options)
     : m_options(options)
+    {
+        m_options.headless |= m_options.benchmark.enabled;
+
+        if (m_options.headless)
+        {
+            create_headless();
+        }
+        else
+        {
+            create_windowed();
+        }
+
+        // Build initial graph
+        const auto initial_graph = Nebula::RenderGraph::Builder::create_preset_graph(m_options.graph_preset, m_rgctx);
+        m_rgctx->set_render_path(initial_graph.render_path);
+        m_graph_compile_ms = static_cast<double>(initial_graph.compile_time.count());
+
+        register_memory_policies();
+
+        if (!m_options.headless)
+        {
+            init_imgui();
+        }
+
+        // Staging buffers of the scene upload are done, frames in flight bound how long later releases are held.
+        const uint32_t frames_in_flight = m_options.headless ? m_offscreen_target->image_count() : m_swapchain->image_count();
+        m_context->destruction_queue()->set_latency(frames_in_flight + 1);
+        m_context->device().waitIdle();
+        m_context->destruction_queue()->flush();
+    }
+
+    Application::~Application()
+    {
+        // Graph nodes, the editor and the scene release their objects through the Context, so they go first.
+        // The compile thread still references the graph context.
+        m_graph_compiler.reset();
+        m_context->device().waitIdle();
+        m_ge.reset();
+        m_rgctx.reset();
+        g_rgs.reset();
+        Nebula::SamplerCache::release(*m_context);
+        m_context->destruction_queue()->flush();
+    }
+
+    void Application::create_windowed()
     {
         m_window = std::make_unique<Window>(m_options.window_options);
 
@@ -26,7 +77,7 @@ namespace sd
             .add_instance_extensions({ VK_KHR_SURFACE_EXTENSION_NAME })
             .set_validation(true)
             .set_debug_utils(true)
-            .with_surface(m_window->handle())
+            .with_surface([&](const vk::Instance& instance){ return m_window->create_surface(instance); })
             .add_device_extensions({
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                 VK_KHR_MAINTENANCE_4_EXTENSION_NAME,
@@ -36,6 +87,9 @@ namespace sd
                 VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
                 VK_EXT_MESH_SHADER_EXTENSION_NAME,
             })
+            .add_optional_device_extensions({
+                VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
+            })
             .add_raytracing_extensions(true)
             .create_context();
 
@@ -47,23 +101,57 @@ namespace sd
                 .set_preferred_format(vk::Format::eB8G8R8A8Unorm)
                 .create();
 
-        g_rgs = std::make_shared<Scene>(*m_command_buffers, *m_context);
+        g_rgs = create_scene();
 
         m_rgctx = std::make_shared<Nebula::RenderGraph::RenderGraphContext>(*m_command_buffers, *m_context, *m_swapchain);
         m_rgctx->set_scene(g_rgs);
+        m_graph_compiler = std::make_unique<Nebula::RenderGraph::Compiler::AsyncGraphCompiler>(*m_rgctx);
 
-        m_ge = std::make_shared<Nebula::RenderGraph::Editor::GraphEditor>(*m_rgctx);
+        m_ge = std::make_shared<Nebula::RenderGraph::Editor::GraphEditor>(*m_rgctx, *m_graph_compiler);
         m_ge->set_scene(g_rgs);
+    }
 
-        // Build initial graph
-        const auto initial_graph = Nebula::RenderGraph::Builder::create_initial_graph(m_rgctx);
-        m_rgctx->set_render_path(initial_graph.render_path);
+    void Application::create_headless()
+    {
+        // Ray tracing and mesh shaders are optional so software implementations can run the raster graph.
+        m_context = sdvk::ContextBuilder()
+            .set_validation(true)
+            .set_debug_utils(true)
+            .set_allow_cpu_device(true)
+            .add_device_extensions({
+                VK_KHR_MAINTENANCE_4_EXTENSION_NAME,
+                VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME,
+                VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+                VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
+            })
+            .add_optional_device_extensions({
+                VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+                VK_EXT_MESH_SHADER_EXTENSION_NAME,
+                VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
+            })
+            .add_raytracing_extensions(true, false)
+            .create_context();
+
+        m_command_buffers = std::make_unique<sdvk::CommandBuffers>(8, *m_context);
+
+        m_offscreen_target = std::make_unique<sdvk::OffscreenTarget>(s_extent.vk_ext(), vk::Format::eB8G8R8A8Unorm,
+                                                                     s_max_frames_in_flight, *m_context);
 
-        init_imgui();
+        g_rgs = create_scene();
+
+        m_rgctx = std::make_shared<Nebula::RenderGraph::RenderGraphContext>(*m_command_buffers, *m_context, *m_offscreen_target);
+        m_rgctx->set_scene(g_rgs);
+        m_graph_compiler = std::make_unique<Nebula::RenderGraph::Compiler::AsyncGraphCompiler>(*m_rgctx);
     }
 
     void Application::run()
     {
+        if (m_options.headless)
+        {
+            run_headless();
+            return;
+        }
+
         static auto convert_memory = [&](const uint64_t input_memory){
             std::tuple<float, std::string> result;
 
@@ -120,20 +208,29 @@ namespace sd
             auto [ mb, mb_m ] = convert_memory(memory_budget);
 
             const auto acquired_frame = m_swapchain->acquire_frame(s_current_frame);
+            s_current_image = acquired_frame;
+            Nebula::FrameArena::begin_frame(s_current_frame);
+            m_context->memory_tracker()->begin_frame(m_frame_number);
+            m_context->memory_manager()->update(m_frame_number);
+            m_context->destruction_queue()->begin_frame(m_frame_number);
+            m_graph_compiler->poll();
 
             const auto command_buffer = m_command_buffers->begin(s_current_frame);
+            defragment_memory(command_buffer);
 
             const auto vp = m_swapchain->make_viewport();
             const auto sc = m_swapchain->make_scissor();
             command_buffer.setViewport(0, 1, &vp);
             command_buffer.setScissor(0, 1, &sc);
 
+            g_rgs->update(static_cast<float>(m_frame_number++) * s_scene_time_step, s_current_frame, command_buffer);
+            Nebula::RenderGraph::ViewConstants::instance(*m_context).update(*g_rgs->camera(), s_extent.vk_ext(), s_current_frame);
             m_rgctx->get_render_path()->execute(command_buffer);
 
             std::array<vk::ClearValue, 1> clear_value;
             clear_value[0].color = std::array<float, 4>({ 0.f, 0.f, 0.f, 0.f });
             sdvk::RenderPass::Execute()
-                .with_framebuffer(m_fbos[s_current_frame])
+                .with_framebuffer(m_fbos[acquired_frame])
                 .with_render_pass(m_renderpass)
                 .with_clear_value(clear_value)
                 .with_render_area({{0, 0}, m_swapchain->extent()})
@@ -150,6 +247,60 @@ namespace sd
                             ImGui::Text("FPS: %.2f (%.2gms)", io.Framerate, io.Framerate ? 1000.0f / io.Framerate : 0.0f);
                             ImGui::Text("Total Memory Usage: %.2f %s", mu, mu_m.c_str());
                             ImGui::Text("Available Memory Budget: %.2f %s", mb, mb_m.c_str());
+                            ImGui::Text("Memory Pressure: %s", sdvk::MemoryManager::to_string(m_context->memory_manager()->level()).c_str());
+                            ImGui::Text("Cached Samplers: %u", Nebula::SamplerCache::instance(*m_context).count());
+                            ImGui::Text("Deferred Destructions: %zu pending", m_context->destruction_queue()->pending());
+                            const auto& culling = g_rgs->cull_statistics();
+                            ImGui::Text("Culling: %u visible, %u culled (%u nodes, %u objects tested)",
+                                        culling.visible, culling.culled, culling.tested_nodes, culling.tested_objects);
+                            ImGui::Text("GPU Scene Upload: %.1f KB", static_cast<float>(g_rgs->gpu_scene().uploaded_bytes()) / 1024.0f);
+                            const auto& deformation = g_rgs->deformer().statistics();
+                            ImGui::Text("Deformation: %u objects, %u BLAS refits, %u rebuilds",
+                                        deformation.deformed_objects, deformation.refits, deformation.rebuilds);
+                            const auto& mesh_registry = g_rgs->mesh_registry();
+                            ImGui::Text("Meshes: %u unique, %u deduplicated, %u geometry pages",
+                                        mesh_registry.mesh_count(), mesh_registry.duplicate_count(), mesh_registry.geometry_pool().page_count());
+                            if (const auto* streamer = g_rgs->streamer())
+                            {
+                                const auto& streaming = streamer->statistics();
+                                ImGui::Text("Streaming: %u/%u cells, %u meshes (%.1f MB), %u loading, %.1f KB uploaded, %u BLAS builds",
+                                            streaming.resident_cells, streaming.cells, streaming.resident_meshes,
+                                            static_cast<float>(streaming.resident_bytes) / (1024.0f * 1024.0f), streaming.pending_loads,
+                                            static_cast<float>(streaming.uploaded_bytes) / 1024.0f, streaming.blas_builds);
+                            }
+                            // Read back from the GPU, drawn plus occluded objects should match the CPU visible count above.
+                            for (const auto& node : m_rgctx->get_render_path()->nodes)
+                            {
+                                if (node->type() != Nebula::RenderGraph::NodeType::eGBufferPass)
+                                {
+                                    continue;
+                                }
+                                if (const auto* gpu_culling = static_cast<const Nebula::RenderGraph::GBufferPass*>(node.get())->gpu_culling())
+                                {
+                                    const auto& gpu = gpu_culling->statistics();
+                                    ImGui::Text("GPU Culling: %u drawn, %u outside frustum, %u occluded (%u tested)",
+                                                gpu.visible, gpu.frustum_culled, gpu.occlusion_culled, gpu.tested);
+                                }
+                            }
+                            const auto& frame_arena = Nebula::FrameArena::current();
+                            ImGui::Text("Frame Arena: %.1f / %.1f KB (%u heap allocations)",
+                                        static_cast<float>(frame_arena.bytes_used()) / 1024.0f,
+                                        static_cast<float>(frame_arena.capacity()) / 1024.0f,
+                                        frame_arena.heap_allocations());
+                            if (ImGui::CollapsingHeader("GPU Memory"))
+                            {
+                                render_memory_statistics();
+                            }
+                            if (ImGui::CollapsingHeader("Shader Permutations"))
+                            {
+                                for (const auto& node : m_rgctx->get_render_path()->nodes)
+                                {
+                                    if (const uint32_t count = node->permutation_count(); count > 0)
+                                    {
+                                        ImGui::Text("%s: %u", node->name().c_str(), count);
+                                    }
+                                }
+                            }
                             ImGui::End();
 
                             m_ge->render();
@@ -165,14 +316,291 @@ namespace sd
             command_buffer.end();
 
             m_swapchain->submit_and_present(s_current_frame, acquired_frame, command_buffer);
-            s_current_frame = (s_current_frame + 1) % m_swapchain->image_count();
-
-            m_context->device().waitIdle();
+            s_current_frame = (s_current_frame + 1) % s_max_frames_in_flight;
         };
 
         m_window->while_open(render_command);
     }
 
+    void Application::run_headless()
+    {
+        std::unique_ptr<Benchmark> benchmark;
+        if (m_options.benchmark.enabled)
+        {
+            benchmark = std::make_unique<Benchmark>(m_options.benchmark, m_offscreen_target->image_count(), *m_context);
+        }
+
+        const uint32_t frame_count = benchmark ? benchmark->total_frames() : m_options.headless_frame_count;
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            m_offscreen_target->wait(s_current_frame);
+            s_current_image = s_current_frame;
+            Nebula::FrameArena::begin_frame(s_current_frame);
+            m_context->memory_tracker()->begin_frame(i);
+            m_context->memory_manager()->update(i);
+            m_context->destruction_queue()->begin_frame(i);
+            m_graph_compiler->poll();
+            if (benchmark)
+            {
+                benchmark->collect(s_current_frame, *m_offscreen_target);
+            }
+
+            const auto command_buffer = m_command_buffers->begin(s_current_frame);
+            if (benchmark)
+            {
+                benchmark->begin_frame(i, s_current_frame, *g_rgs->camera(), command_buffer);
+            }
+            defragment_memory(command_buffer);
+
+            const auto vp = m_offscreen_target->make_viewport();
+            const auto sc = m_offscreen_target->make_scissor();
+            command_buffer.setViewport(0, 1, &vp);
+            command_buffer.setScissor(0, 1, &sc);
+
+            g_rgs->update(static_cast<float>(i) * s_scene_time_step, s_current_frame, command_buffer);
+            Nebula::RenderGraph::ViewConstants::instance(*m_context).update(*g_rgs->camera(), s_extent.vk_ext(), s_current_frame);
+            m_rgctx->get_render_path()->execute(command_buffer);
+
+            if (benchmark)
+            {
+                benchmark->end_frame(s_current_frame, command_buffer);
+            }
+            command_buffer.end();
+
+            m_offscreen_target->submit(s_current_frame, command_buffer);
+            s_current_frame = (s_current_frame + 1) % m_offscreen_target->image_count();
+        }
+
+        m_context->device().waitIdle();
+
+        if (benchmark)
+        {
+            for (uint32_t slot = 0; slot < m_offscreen_target->image_count(); slot++)
+            {
+                benchmark->collect(slot, *m_offscreen_target);
+            }
+            BenchmarkConfiguration configuration;
+            configuration.graph = m_options.graph_preset;
+            configuration.scene = m_options.scene_generator.enabled ? SceneGeneratorOptions::to_string(m_options.scene_generator.distribution) : "default";
+            configuration.object_count = m_options.scene_object_count;
+            configuration.mesh_count = static_cast<uint32_t>(g_rgs->meshes().size());
+            configuration.dynamic_object_count = static_cast<uint32_t>(g_rgs->motions().size());
+            configuration.compile_ms = m_graph_compile_ms;
+            benchmark->write_report(configuration);
+        }
+
+        if (m_options.write_memory_report)
+        {
+            const auto& allocator = m_context->block_allocator();
+            m_context->memory_tracker()->set_fragmentation(allocator->fragmentation(), allocator->defragmentation_statistics());
+            m_context->memory_tracker()->write_json(m_options.memory_report_path);
+        }
+
+        if (m_options.write_memory_pressure_log)
+        {
+            m_context->memory_manager()->write_json(m_options.memory_pressure_log_path);
+        }
+    }
+
+    void Application::register_memory_policies()
+    {
+        auto& manager = *m_context->memory_manager();
+        manager.set_options(m_options.memory_budget);
+
+        auto set_accumulation = [this](const bool enabled) {
+            m_rgctx->set_accumulation_enabled(enabled);
+            for (const auto& node : m_rgctx->get_render_path()->nodes)
+            {
+                node->set_accumulation_enabled(enabled);
+            }
+        };
+        manager.set_policy(sdvk::MemoryPressureLevel::eReleaseAccumulation, "release ray traced AO accumulation",
+                           [set_accumulation]{ set_accumulation(false); },
+                           [set_accumulation]{ set_accumulation(true); });
+
+        auto set_render_scale = [this](const float scale) {
+            const vk::Extent2D target = m_rgctx->target_resolution();
+            m_rgctx->set_render_resolution({
+                std::max(static_cast<uint32_t>(static_cast<float>(target.width) * scale), 1u),
+                std::max(static_cast<uint32_t>(static_cast<float>(target.height) * scale), 1u),
+            });
+            recompile_graph();
+        };
+        manager.set_policy(sdvk::MemoryPressureLevel::eLowerResolution,
+                           std::format("lower render resolution to {:.0f}%", s_pressure_render_scale * 100.0f),
+                           [set_render_scale]{ set_render_scale(s_pressure_render_scale); },
+                           [set_render_scale]{ set_render_scale(1.0f); });
+
+        manager.set_policy(sdvk::MemoryPressureLevel::eEvictColdMeshes, "evict cold mesh buffers to host memory",
+                           [this]{
+                               m_context->device().waitIdle();
+                               const uint32_t evicted = g_rgs->evict_cold_meshes();
+                               std::cout << std::format("[Memory] Evicted {} of {} meshes", evicted, g_rgs->meshes().size()) << std::endl;
+                           },
+                           [this]{
+                               m_context->device().waitIdle();
+                               const uint32_t restored = g_rgs->make_meshes_resident();
+                               std::cout << std::format("[Memory] Restored {} meshes", restored) << std::endl;
+                           });
+
+        manager.set_policy(sdvk::MemoryPressureLevel::eRefuseUploads, "refuse new uploads", {}, {});
+    }
+
+    void Application::defragment_memory(const vk::CommandBuffer& command_buffer)
+    {
+        // Nodes on the compile thread may be writing descriptors with the current buffer handles.
+        if (m_options.defragmentation_budget == 0 || m_graph_compiler->is_busy())
+        {
+            return;
+        }
+
+        const uint32_t moves = m_context->block_allocator()->defragment(command_buffer, m_options.defragmentation_budget, *m_context);
+        if (moves > 0)
+        {
+            g_rgs->invalidate_device_addresses();
+        }
+    }
+
+    void Application::recompile_graph()
+    {
+        if (m_ge && m_ge->recompile())
+        {
+            return;
+        }
+
+        Nebula::RenderGraph::Builder::make_preset_graph(m_options.graph_preset, m_rgctx).compile_async(*m_graph_compiler);
+    }
+
+
+    void Application::render_memory_statistics() const
+    {
+        static constexpr float kilobyte = 1024.0f;
+        const auto& tracker = m_context->memory_tracker();
+
+        const auto frames = tracker->frame_history();
+        const auto& last_frame = frames.size() > 1 ? frames[frames.size() - 2] : frames.back();
+        ImGui::Text("Live: %.2f MB", static_cast<float>(tracker->live_bytes()) / (kilobyte * kilobyte));
+        ImGui::Text("Last frame: %u allocations (%.1f KB), %u frees (%.1f KB)",
+                    last_frame.allocations, static_cast<float>(last_frame.allocated_bytes) / kilobyte,
+                    last_frame.frees, static_cast<float>(last_frame.freed_bytes) / kilobyte);
+        if (ImGui::Button("Write JSON"))
+        {
+            const auto& allocator = m_context->block_allocator();
+            tracker->set_fragmentation(allocator->fragmentation(), allocator->defragmentation_statistics());
+            tracker->write_json(m_options.memory_report_path);
+        }
+
+        static constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders
+                                                     | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+        auto tags = tracker->tag_statistics();
+        if (ImGui::BeginTable("Memory Tags", 6, table_flags, ImVec2(0.0f, 320.0f)))
+        {
+            ImGui::TableSetupColumn("Owner");
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Allocations");
+            ImGui::TableSetupColumn("Live (KB)", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Peak (KB)", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableHeadersRow();
+
+            if (const ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs(); sort_specs && sort_specs->SpecsCount > 0)
+            {
+                const ImGuiTableColumnSortSpecs spec = sort_specs->Specs[0];
+                std::ranges::stable_sort(tags, [&spec](const sdvk::MemoryTagStatistics& a, const sdvk::MemoryTagStatistics& b) {
+                    const auto compare = [&spec](const auto& lhs, const auto& rhs) {
+                        return spec.SortDirection == ImGuiSortDirection_Ascending ? lhs < rhs : rhs < lhs;
+                    };
+                    switch (spec.ColumnIndex)
+                    {
+                        case 0:  return compare(a.tag, b.tag);
+                        case 1:  return compare(a.category, b.category);
+                        case 2:  return compare(a.memory_type, b.memory_type);
+                        case 3:  return compare(a.live_allocations, b.live_allocations);
+                        case 5:  return compare(a.peak_bytes, b.peak_bytes);
+                        default: return compare(a.live_bytes, b.live_bytes);
+                    }
+                });
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int32_t>(tags.size()));
+            while (clipper.Step())
+            {
+                for (int32_t i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                {
+                    const auto& tag = tags[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(tag.tag.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(sdvk::MemoryTracker::to_string(tag.category).c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", tag.memory_type);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", tag.live_allocations);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", static_cast<float>(tag.live_bytes) / kilobyte);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", static_cast<float>(tag.peak_bytes) / kilobyte);
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::TreeNode("Memory Types"))
+        {
+            for (const auto& type : tracker->type_statistics())
+            {
+                if (type.live_allocations > 0)
+                {
+                    ImGui::Text("#%u (heap %u, %s): %u allocations, %.2f MB", type.index, type.heap, vk::to_string(type.flags).c_str(),
+                                type.live_allocations, static_cast<float>(type.live_bytes) / (kilobyte * kilobyte));
+                }
+            }
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("Memory Blocks"))
+        {
+            const auto& allocator = m_context->block_allocator();
+            for (const auto& type : allocator->fragmentation())
+            {
+                ImGui::Text("Type #%u: %u blocks, %.2f / %.2f MB used, %u free ranges, fragmentation %.2f", type.memory_type, type.blocks,
+                            static_cast<float>(type.used) / (kilobyte * kilobyte), static_cast<float>(type.reserved) / (kilobyte * kilobyte),
+                            type.free_ranges, type.fragmentation());
+            }
+
+            const auto defragmentation = allocator->defragmentation_statistics();
+            ImGui::Text("Defragmentation: %llu moves, %.2f MB moved, %llu blocks released",
+                        static_cast<unsigned long long>(defragmentation.moves),
+                        static_cast<float>(defragmentation.moved_bytes) / (kilobyte * kilobyte),
+                        static_cast<unsigned long long>(defragmentation.released_blocks));
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("Alias Savings"))
+        {
+            for (const auto& saving : tracker->alias_savings())
+            {
+                ImGui::Text("%s: %u resources, %.2f MB saved", saving.tag.c_str(), saving.aliased_resources,
+                            static_cast<float>(saving.saved_bytes) / (kilobyte * kilobyte));
+            }
+            ImGui::TreePop();
+        }
+    }
+
+    std::shared_ptr<Scene> Application::create_scene() const
+    {
+        if (m_options.scene_generator.enabled)
+        {
+            return std::make_shared<Scene>(m_options.scene_generator, *m_command_buffers, *m_context,
+                                           m_options.benchmark.seed, m_options.scene_object_count);
+        }
+        return std::make_shared<Scene>(*m_command_buffers, *m_context, m_options.benchmark.seed, m_options.scene_object_count);
+    }
+
     void Application::init_imgui()
     {
         m_renderpass = sdvk::RenderPass::Builder()
@@ -192,7 +620,8 @@ namespace sd
         framebuffer_create_info.setWidth(extent.width);
         framebuffer_create_info.setHeight(extent.height);
         framebuffer_create_info.setLayers(1);
-        for (int32_t i = 0; i < 2; i++)
+        m_fbos.resize(m_swapchain->image_count());
+        for (uint32_t i = 0; i < m_fbos.size(); i++)
         {
             comp_attachments[0] = m_swapchain->view(i);
             if (const vk::Result result = m_context->device().createFramebuffer(&framebuffer_create_info, nullptr, &m_fbos[i]);
@@ -253,7 +682,7 @@ namespace sd
         init_info.PipelineCache = m_pipeline_cache;
         init_info.DescriptorPool = m_pool;
         init_info.Subpass = 0;
-        init_info.ImageCount = 2;
+        init_info.ImageCount = m_swapchain->image_count();
         init_info.MinImageCount = 2;
         init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
         init_info.Allocator = nullptr;
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <Application/ApplicationOptions.hpp>
 #include <Vulkan/CommandBuffers.hpp>
 #include <Vulkan/Context.hpp>
+#include <Vulkan/Presentation/OffscreenTarget.hpp>
 #include <Vulkan/Presentation/Swapchain.hpp>
 #include <Window/Window.hpp>
 #include <VirtualGraph/Editor/GraphEditor.hpp>
 #include <VirtualGraph/Common/GraphContext.hpp>
+#include <VirtualGraph/Compile/AsyncGraphCompiler.hpp>
 
 namespace sd
 {
@@ -16,37 +19,69 @@ namespace sd
     public:
         explicit Application(ApplicationOptions const& options);
 
+        ~Application();
+
         void run();
 
     public:
         static constexpr uint32_t s_max_frames_in_flight {2};
         static constexpr bool s_imgui_enabled { true };
+        // Scene animation advances by a fixed step per frame, so benchmark runs see the same motion.
+        static constexpr float s_scene_time_step { 1.0f / 60.0f };
+        // Render resolution relative to the target while memory is oversubscribed.
+        static constexpr float s_pressure_render_scale { 0.5f };
         static uint32_t s_current_frame;
+        // Swapchain image acquired for the current frame, not tied to the frame slot. Equal to s_current_frame when headless.
+        static uint32_t s_current_image;
         static sd::Extent s_extent;
 
     public:
         static std::tuple<float, float> get_ui_scale();
 
     private:
+        void create_windowed();
+
+        void create_headless();
+
+        void run_headless();
+
+        std::shared_ptr<Scene> create_scene() const;
+
         void init_imgui();
 
+        void render_memory_statistics() const;
+
+        // Degradation steps of the memory manager, from releasing AO history to refusing uploads.
+        void register_memory_policies();
+
+        // Moves a budgeted amount of memory out of sparsely used blocks, the scene picks up the new addresses in its update.
+        void defragment_memory(const vk::CommandBuffer& command_buffer);
+
+        // Recompiles the active graph in the background, e.g. after the render resolution changed.
+        void recompile_graph();
+
         static std::tuple<float, float> get_ui_scale(const Extent& resolution);
 
         vk::DescriptorPool m_pool;
         vk::PipelineCache m_pipeline_cache { nullptr };
         vk::RenderPass m_renderpass;
-        std::array<vk::Framebuffer, 2> m_fbos;
+        // One per swapchain image, indexed by the acquired image.
+        std::vector<vk::Framebuffer> m_fbos;
 
     private:
         ApplicationOptions m_options;
 
         std::shared_ptr<Nebula::RenderGraph::RenderGraphContext> m_rgctx;
         std::shared_ptr<Nebula::RenderGraph::Editor::GraphEditor> m_ge;
+        std::unique_ptr<Nebula::RenderGraph::Compiler::AsyncGraphCompiler> m_graph_compiler;
 
         std::unique_ptr<sd::Window> m_window;
         std::unique_ptr<sdvk::Context> m_context;
         std::unique_ptr<sdvk::CommandBuffers> m_command_buffers;
         std::unique_ptr<sdvk::Swapchain> m_swapchain;
+        std::unique_ptr<sdvk::OffscreenTarget> m_offscreen_target;
         uint32_t m_current_frame = 0;
+        uint32_t m_frame_number = 0;
+        double m_graph_compile_ms = 0.0;
     };
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+#include <Benchmark/BenchmarkOptions.hpp>
+#include <Scene/Scene.hpp>
+#include <Vulkan/MemoryManager.hpp>
 #include <Window/WindowOptions.hpp>
 
 namespace sd
@@ -15,5 +18,31 @@ namespace sd
         std::string name = "Application";
         RenderAPI render_api { eVulkan };
         WindowOptions window_options {};
+
+        // Renders into an offscreen image without a window or swapchain, CPU devices (lavapipe) are allowed.
+        bool headless { false };
+        uint32_t headless_frame_count { 100 };
+
+        // One of Builder::s_graph_presets, used as the initial render graph.
+        std::string graph_preset { "default" };
+        uint32_t scene_object_count { Scene::s_default_object_count };
+
+        // Synthetic stress scene, shares the object count and the benchmark seed with the default scene.
+        SceneGeneratorOptions scene_generator {};
+
+        // Per owner GPU memory statistics are written here at the end of a headless run and from the Metrics window.
+        std::string memory_report_path { "memory_report.json" };
+        bool write_memory_report { false };
+
+        // Headroom and an optional simulated budget for the memory manager, its steps are logged to the pressure log.
+        sdvk::MemoryBudgetOptions memory_budget {};
+        std::string memory_pressure_log_path { "memory_pressure.json" };
+        bool write_memory_pressure_log { false };
+
+        // Bytes the block allocator may move per frame to compact sparsely used memory blocks, 0 disables defragmentation.
+        vk::DeviceSize defragmentation_budget { 4 * 1024 * 1024 };
+
+        // Runs through the headless loop, headless is implied.
+        BenchmarkOptions benchmark {};
     };
 }
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include "Application.hpp"
+
+// Frame state read by the render graph nodes, defined here so the core library links without the Application.
+namespace sd
+{
+    uint32_t Application::s_current_frame = 0;
+    uint32_t Application::s_current_image = 0;
+    Extent   Application::s_extent = {};
+}
@@ -0,0 +1,172 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <Scene/Camera.hpp>
+#include <Vulkan/Presentation/OffscreenTarget.hpp>
+
+namespace sd
+{
+    FrameTimeStatistics FrameTimeStatistics::from_samples(std::vector<double> samples)
+    {
+        FrameTimeStatistics result;
+        if (samples.empty())
+        {
+            return result;
+        }
+
+        std::ranges::sort(samples);
+        auto percentile = [&samples](const double p) {
+            const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(samples.size())));
+            return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+        };
+
+        result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        result.min  = samples.front();
+        result.max  = samples.back();
+        result.p50  = percentile(50.0);
+        result.p95  = percentile(95.0);
+        result.p99  = percentile(99.0);
+        return result;
+    }
+
+    Benchmark::Benchmark(const BenchmarkOptions& options, const uint32_t frame_slots, const sdvk::Context& context)
+    : m_options(options)
+    , m_gpu_timer(frame_slots, context)
+    , m_in_flight(frame_slots)
+    , m_memory_before_frames(context.memory_statistics())
+    , m_context(context)
+    {
+        if (!m_options.camera_path.empty())
+        {
+            m_camera_path = CameraPath::load(m_options.camera_path);
+        }
+
+        m_cpu_samples.reserve(m_options.measured_frames);
+        m_gpu_samples.reserve(m_options.measured_frames);
+    }
+
+    void Benchmark::collect(const uint32_t frame_slot, const sdvk::OffscreenTarget& target)
+    {
+        auto& in_flight = m_in_flight[frame_slot];
+        if (!in_flight.frame.has_value())
+        {
+            return;
+        }
+
+        const uint32_t frame = in_flight.frame.value();
+        in_flight.frame.reset();
+
+        if (frame < m_options.warmup_frames)
+        {
+            return;
+        }
+
+        const uint32_t measured_frame = frame - m_options.warmup_frames;
+        m_cpu_samples.push_back(in_flight.cpu_ms);
+        if (const auto gpu_ms = m_gpu_timer.elapsed_ms(frame_slot); gpu_ms.has_value())
+        {
+            m_gpu_samples.push_back(gpu_ms.value());
+        }
+
+        if (std::ranges::find(m_options.capture_frames, measured_frame) != m_options.capture_frames.end())
+        {
+            _capture(measured_frame, frame_slot, target);
+        }
+    }
+
+    void Benchmark::begin_frame(const uint32_t frame, const uint32_t frame_slot, Camera& camera, const vk::CommandBuffer& command_buffer)
+    {
+        auto& in_flight = m_in_flight[frame_slot];
+        in_flight.frame = frame;
+        in_flight.cpu_begin = clock::now();
+
+        if (m_camera_path.has_value())
+        {
+            m_camera_path->apply(camera, frame);
+        }
+
+        m_gpu_timer.begin(command_buffer, frame_slot);
+    }
+
+    void Benchmark::end_frame(const uint32_t frame_slot, const vk::CommandBuffer& command_buffer)
+    {
+        m_gpu_timer.end(command_buffer, frame_slot);
+
+        auto& in_flight = m_in_flight[frame_slot];
+        in_flight.cpu_ms = std::chrono::duration<double, std::milli>(clock::now() - in_flight.cpu_begin).count();
+    }
+
+    void Benchmark::write_report(const BenchmarkConfiguration& configuration) const
+    {
+        static constexpr double bytes_per_megabyte = 1024.0 * 1024.0;
+
+        auto write_statistics = [](std::ofstream& out, const std::string& name, const FrameTimeStatistics& stats, const bool last) {
+            out << std::format("  \"{}\": {{ \"mean\": {:.4f}, \"min\": {:.4f}, \"max\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f} }}{}\n",
+                               name, stats.mean, stats.min, stats.max, stats.p50, stats.p95, stats.p99, last ? "" : ",");
+        };
+
+        std::ofstream out(m_options.report_path);
+        if (!out.is_open())
+        {
+            throw std::runtime_error(std::format("[Error] Failed to open benchmark report \"{}\"", m_options.report_path));
+        }
+
+        const auto properties = m_context.physical_device().getProperties();
+        std::string device_name = properties.deviceName.data();
+        std::ranges::replace(device_name, '"', '\'');
+
+        out << "{\n";
+        out << std::format("  \"device\": \"{}\",\n", device_name);
+        out << std::format("  \"seed\": {},\n", m_options.seed);
+        out << std::format("  \"warmup_frames\": {},\n", m_options.warmup_frames);
+        out << std::format("  \"measured_frames\": {},\n", m_cpu_samples.size());
+        out << std::format("  \"graph\": \"{}\",\n", configuration.graph);
+        out << std::format("  \"scene\": \"{}\",\n", configuration.scene);
+        out << std::format("  \"object_count\": {},\n", configuration.object_count);
+        out << std::format("  \"mesh_count\": {},\n", configuration.mesh_count);
+        out << std::format("  \"dynamic_object_count\": {},\n", configuration.dynamic_object_count);
+        out << std::format("  \"raytracing\": {},\n", m_context.is_raytracing_capable());
+        out << std::format("  \"compile_ms\": {:.4f},\n", configuration.compile_ms);
+
+        const auto& memory = m_context.memory_statistics();
+        out << std::format("  \"gpu_allocations\": {},\n", memory.allocation_count);
+        out << std::format("  \"gpu_allocated_mb\": {:.4f},\n", static_cast<double>(memory.allocated_bytes) / bytes_per_megabyte);
+        out << std::format("  \"frame_gpu_allocations\": {},\n", memory.total_allocation_count - m_memory_before_frames.total_allocation_count);
+        write_statistics(out, "cpu_ms", FrameTimeStatistics::from_samples(m_cpu_samples), false);
+        write_statistics(out, "gpu_ms", FrameTimeStatistics::from_samples(m_gpu_samples), true);
+        out << "}\n";
+
+        std::cout << std::format("Benchmark report written to \"{}\"", m_options.report_path) << std::endl;
+    }
+
+    void Benchmark::_capture(const uint32_t measured_frame, const uint32_t frame_slot, const sdvk::OffscreenTarget& target) const
+    {
+        const auto extent = target.extent();
+        const auto pixels = target.read_pixels(frame_slot);
+        const bool is_bgra = target.format() == vk::Format::eB8G8R8A8Unorm || target.format() == vk::Format::eB8G8R8A8Srgb;
+
+        const auto path = std::filesystem::path(m_options.capture_directory) / std::format("frame_{:05}.ppm", measured_frame);
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open())
+        {
+            throw std::runtime_error(std::format("[Error] Failed to open capture file \"{}\"", path.string()));
+        }
+
+        out << std::format("P6\n{} {}\n255\n", extent.width, extent.height);
+        for (size_t i = 0; i + 3 < pixels.size(); i += 4)
+        {
+            const char rgb[3] = {
+                static_cast<char>(pixels[i + (is_bgra ? 2 : 0)]),
+                static_cast<char>(pixels[i + 1]),
+                static_cast<char>(pixels[i + (is_bgra ? 0 : 2)]),
+            };
+            out.write(rgb, 3);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <Benchmark/BenchmarkOptions.hpp>
+#include <Benchmark/CameraPath.hpp>
+#include <Nebula/GpuTimer.hpp>
+#include <Vulkan/Context.hpp>
+
+namespace sdvk
+{
+    class OffscreenTarget;
+}
+
+namespace sd
+{
+    class Camera;
+
+    struct FrameTimeStatistics
+    {
+        double mean {0.0};
+        double min {0.0};
+        double max {0.0};
+        double p50 {0.0};
+        double p95 {0.0};
+        double p99 {0.0};
+
+        // Nearest-rank percentiles.
+        static FrameTimeStatistics from_samples(std::vector<double> samples);
+    };
+
+    // Identifies the measured graph and scene in the report.
+    struct BenchmarkConfiguration
+    {
+        std::string graph;
+        std::string scene;
+        uint32_t    object_count {0};
+        uint32_t    mesh_count {0};
+        uint32_t    dynamic_object_count {0};
+        double      compile_ms {0.0};
+    };
+
+    /**
+     * Drives a fixed number of warm-up and measured frames through the headless render loop.
+     * CPU time covers command recording of a frame, GPU time is measured with timestamps around the command buffer.
+     */
+    class Benchmark
+    {
+    public:
+        Benchmark(const BenchmarkOptions& options, uint32_t frame_slots, const sdvk::Context& context);
+
+        uint32_t total_frames() const { return m_options.warmup_frames + m_options.measured_frames; }
+
+        // Call after the fence of the slot was waited on, collects the results of the frame previously recorded in it.
+        void collect(uint32_t frame_slot, const sdvk::OffscreenTarget& target);
+
+        void begin_frame(uint32_t frame, uint32_t frame_slot, Camera& camera, const vk::CommandBuffer& command_buffer);
+
+        void end_frame(uint32_t frame_slot, const vk::CommandBuffer& command_buffer);
+
+        // GPU allocations are reported in total and for the frame loop alone, which should not allocate once warmed up.
+        void write_report(const BenchmarkConfiguration& configuration) const;
+
+    private:
+        void _capture(uint32_t measured_frame, uint32_t frame_slot, const sdvk::OffscreenTarget& target) const;
+
+        using clock = std::chrono::steady_clock;
+
+        struct InFlightFrame
+        {
+            std::optional<uint32_t> frame;
+            clock::time_point       cpu_begin;
+            double                  cpu_ms {0.0};
+        };
+
+        BenchmarkOptions          m_options;
+        std::optional<CameraPath> m_camera_path;
+        Nebula::GpuTimer          m_gpu_timer;
+
+        std::vector<InFlightFrame> m_in_flight;
+        std::vector<double>        m_cpu_samples;
+        std::vector<double>        m_gpu_samples;
+        sdvk::MemoryStatistics     m_memory_before_frames;
+
+        const sdvk::Context& m_context;
+    };
+}
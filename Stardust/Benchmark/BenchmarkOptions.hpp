@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sd
+{
+    struct BenchmarkOptions
+    {
+        bool enabled { false };
+
+        // Seed of the procedural scene layout.
+        uint32_t seed { 1 };
+
+        // Keyframed camera path, the camera stays at its default pose if empty. See CameraPath.
+        std::string camera_path;
+
+        uint32_t warmup_frames { 60 };
+        uint32_t measured_frames { 600 };
+
+        // Frame time percentiles are written here as JSON.
+        std::string report_path { "benchmark.json" };
+
+        // Indices of measured frames (0 = first frame after warm-up) that are written as PPM images.
+        std::vector<uint32_t> capture_frames;
+        std::string capture_directory { "." };
+    };
+}
@@ -0,0 +1,80 @@
+#include "CameraPath.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <Scene/Camera.hpp>
+
+namespace sd
+{
+    CameraPath::CameraPath(std::vector<Keyframe> keyframes)
+    : m_keyframes(std::move(keyframes))
+    {
+        if (m_keyframes.empty())
+        {
+            throw std::runtime_error("[Error] Camera path requires at least one keyframe");
+        }
+
+        if (!std::ranges::is_sorted(m_keyframes, {}, &Keyframe::frame))
+        {
+            throw std::runtime_error("[Error] Camera path keyframes must be sorted by frame");
+        }
+    }
+
+    CameraPath CameraPath::load(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error(std::format("[Error] Failed to open camera path \"{}\"", path));
+        }
+
+        std::vector<Keyframe> keyframes;
+        std::string line;
+        uint32_t line_number = 0;
+        while (std::getline(file, line))
+        {
+            line_number++;
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            Keyframe keyframe;
+            std::istringstream stream(line);
+            if (!(stream >> keyframe.frame
+                         >> keyframe.eye.x >> keyframe.eye.y >> keyframe.eye.z
+                         >> keyframe.target.x >> keyframe.target.y >> keyframe.target.z))
+            {
+                throw std::runtime_error(std::format("[Error] Malformed keyframe in \"{}\" on line {}", path, line_number));
+            }
+            keyframes.push_back(keyframe);
+        }
+
+        return CameraPath(std::move(keyframes));
+    }
+
+    void CameraPath::apply(Camera& camera, const uint32_t frame) const
+    {
+        const auto current = static_cast<float>(frame);
+        const auto next = std::ranges::upper_bound(m_keyframes, current, {}, &Keyframe::frame);
+
+        if (next == m_keyframes.begin())
+        {
+            camera.look_at(m_keyframes.front().eye, m_keyframes.front().target);
+            return;
+        }
+        if (next == m_keyframes.end())
+        {
+            camera.look_at(m_keyframes.back().eye, m_keyframes.back().target);
+            return;
+        }
+
+        const Keyframe& a = *(next - 1);
+        const Keyframe& b = *next;
+        const float t = (current - a.frame) / (b.frame - a.frame);
+        camera.look_at(glm::mix(a.eye, b.eye, t), glm::mix(a.target, b.target, t));
+    }
+}
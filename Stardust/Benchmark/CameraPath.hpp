@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace sd
+{
+    class Camera;
+
+    /**
+     * Keyframed camera path, loaded from a text file with one keyframe per line:
+     *   <frame> <eye.x> <eye.y> <eye.z> <target.x> <target.y> <target.z>
+     * Empty lines and lines starting with '#' are ignored, keyframes must be sorted by frame.
+     * Poses between keyframes are interpolated linearly, before the first and after the last keyframe they are clamped.
+     */
+    class CameraPath
+    {
+    public:
+        struct Keyframe
+        {
+            float     frame {0.0f};
+            glm::vec3 eye {0.0f};
+            glm::vec3 target {0.0f, 0.0f, -1.0f};
+        };
+
+        explicit CameraPath(std::vector<Keyframe> keyframes);
+
+        static CameraPath load(const std::string& path);
+
+        void apply(Camera& camera, uint32_t frame) const;
+
+        const std::vector<Keyframe>& keyframes() const { return m_keyframes; }
+
+    private:
+        std::vector<Keyframe> m_keyframes;
+    };
+}
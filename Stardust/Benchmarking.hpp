@@ -1,7 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <format>
 #include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
 
 namespace sd::bm
 {
@@ -18,4 +25,110 @@ namespace sd::bm
 
         return duration_cast<unit_t>(end - start);
     }
-}
\ No newline at end of file
+
+    // Keeps the compiler from discarding a value that is computed only to be measured.
+    template <typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    struct Result
+    {
+        std::string name;
+        uint64_t    iterations {0};
+        double      min_ns {0.0};
+        double      median_ns {0.0};
+        double      mean_ns {0.0};
+    };
+
+    /**
+     * Minimal microbenchmark runner.
+     * Each case receives an iteration count and runs its body that many times, the count is calibrated so a sample
+     * takes roughly min_time / sample_count. Reported times are per iteration.
+     */
+    class Suite
+    {
+    public:
+        using case_fn = std::function<void(uint64_t iterations)>;
+
+        void add(const std::string& name, const case_fn& fn)
+        {
+            m_cases.push_back({ name, fn });
+        }
+
+        std::vector<Result> run(const std::string& filter = "", const std::chrono::milliseconds min_time = std::chrono::milliseconds(250)) const
+        {
+            std::vector<Result> results;
+            std::cout << std::format("{:<56} {:>12} {:>14} {:>14} {:>14}\n", "Benchmark", "Iterations", "Min (ns)", "Median (ns)", "Mean (ns)");
+
+            for (const auto& [name, fn] : m_cases)
+            {
+                if (!filter.empty() && name.find(filter) == std::string::npos)
+                {
+                    continue;
+                }
+
+                const auto result = _run_case(name, fn, min_time);
+                std::cout << std::format("{:<56} {:>12} {:>14.1f} {:>14.1f} {:>14.1f}\n",
+                                         result.name, result.iterations, result.min_ns, result.median_ns, result.mean_ns);
+                results.push_back(result);
+            }
+
+            return results;
+        }
+
+    private:
+        static constexpr int32_t s_sample_count = 10;
+
+        static Result _run_case(const std::string& name, const case_fn& fn, const std::chrono::milliseconds min_time)
+        {
+            const auto sample_time = std::chrono::duration<double, std::nano>(min_time) / s_sample_count;
+
+            auto time_batch = [&fn](const uint64_t iterations) {
+                const auto start = clock::now();
+                fn(iterations);
+                return std::chrono::duration<double, std::nano>(clock::now() - start);
+            };
+
+            // Double the batch until a single sample is long enough to time reliably.
+            uint64_t iterations = 1;
+            while (time_batch(iterations) < sample_time && iterations < (1ull << 40))
+            {
+                iterations *= 2;
+            }
+
+            std::vector<double> samples;
+            for (int32_t i = 0; i < s_sample_count; i++)
+            {
+                samples.push_back(time_batch(iterations).count() / static_cast<double>(iterations));
+            }
+            std::ranges::sort(samples);
+
+            Result result;
+            result.name = name;
+            result.iterations = iterations * s_sample_count;
+            result.min_ns = samples.front();
+            result.median_ns = samples[samples.size() / 2];
+            for (const double sample : samples)
+            {
+                result.mean_ns += sample / static_cast<double>(samples.size());
+            }
+            return result;
+        }
+
+        struct Case
+        {
+            std::string name;
+            case_fn     fn;
+        };
+
+        std::vector<Case> m_cases;
+    };
+}
@@ -1,4 +1,5 @@
 #include "Barrier.hpp"
+#include <Nebula/FrameArena.hpp>
 #include <Nebula/Image.hpp>
 
 namespace Nebula::Sync
@@ -68,9 +69,15 @@ namespace Nebula::Sync
         command_buffer.pipelineBarrier2(&m_dependency_info);
     }
 
+    ImageBarrierBatch::ImageBarrierBatch(const std::initializer_list<ImageBarrier>& barriers)
+    : m_barriers(barriers, &FrameArena::current())
+    {
+    }
+
     void ImageBarrierBatch::apply(const vk::CommandBuffer& command_buffer)
     {
-        std::vector<vk::ImageMemoryBarrier2> barriers;
+        std::pmr::vector<vk::ImageMemoryBarrier2> barriers(&FrameArena::current());
+        barriers.reserve(m_barriers.size());
         for (auto& barrier : m_barriers)
         {
             auto image = barrier.m_image.lock();
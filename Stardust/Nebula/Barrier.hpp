@@ -2,6 +2,8 @@
 
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <vector>
 #include <vulkan/vulkan.hpp>
 
 namespace Nebula
@@ -60,12 +62,12 @@ namespace Nebula::Sync
     class ImageBarrierBatch
     {
     public:
-        ImageBarrierBatch(const std::initializer_list<ImageBarrier>& barriers): m_barriers(barriers) {}
+        ImageBarrierBatch(const std::initializer_list<ImageBarrier>& barriers);
 
         void apply(const vk::CommandBuffer& command_buffer);
 
     private:
-        std::vector<ImageBarrier> m_barriers;
+        std::pmr::vector<ImageBarrier> m_barriers;
         vk::DependencyInfo        m_dependency_info {};
     };
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <format>
 #include <stdexcept>
 #include <vector>
+#include <Nebula/FrameArena.hpp>
 
 namespace Nebula
 {
@@ -36,6 +37,7 @@ namespace Nebula
                            const sdvk::Context& context,
                            const std::string& debug_name)
     : m_context(context), m_bindings(bindings), m_name(debug_name), m_set_count(set_count)
+    , m_destruction_queue(context.destruction_queue())
     {
         _create_pool();
         _create_layout();
@@ -47,6 +49,11 @@ namespace Nebula
         }
     }
 
+    Descriptor::~Descriptor()
+    {
+        m_destruction_queue->destroy(m_pool, m_layout);
+    }
+
     void Descriptor::_create_pool()
     {
         std::vector<vk::DescriptorPoolSize> pool_sizes;
@@ -131,8 +138,13 @@ namespace Nebula
     // Writes
 
     Descriptor::Write::Write(const Descriptor& descriptor, uint32_t set_index, const sdvk::Context& context)
-    : _context(context), _descriptor(descriptor), _set_index(set_index)
+    : _writes(&FrameArena::current())
+    , _as_infos(&FrameArena::current())
+    , _buffer_infos(&FrameArena::current())
+    , _image_infos(&FrameArena::current())
+    , _context(context), _descriptor(descriptor), _set_index(set_index)
     {
+        _writes.reserve(s_reserved_writes);
     }
     
     Descriptor::Write& Descriptor::Write::acceleration_structure(uint32_t binding,
@@ -208,7 +220,7 @@ namespace Nebula
                                                          size_t range,
                                                          uint32_t count)
     {
-        auto info = _buffer_infos.emplace_back(buffer, offset, range);
+        const auto& info = _buffer_infos.emplace_back(buffer, offset, range);
 
         vk::WriteDescriptorSet write;
         write.setDstBinding(binding);
@@ -310,7 +322,7 @@ namespace Nebula
     Descriptor::Write::storage_buffer(uint32_t binding, const vk::Buffer& buffer, size_t offset, size_t range,
                                       uint32_t count)
     {
-        auto info = _buffer_infos.emplace_back(buffer, offset, range);
+        const auto& info = _buffer_infos.emplace_back(buffer, offset, range);
 
         vk::WriteDescriptorSet write;
         write.setDstBinding(binding);
@@ -318,7 +330,7 @@ namespace Nebula
         write.setDescriptorCount(count);
         write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
         write.setDstArrayElement(0);
-        write.setPBufferInfo(&_buffer_infos.back());
+        write.setPBufferInfo(&info);
 
         _writes.push_back(write);
 
@@ -381,6 +393,24 @@ namespace Nebula
         return *this;
     }
 
+    Descriptor::Builder&
+    Descriptor::Builder::sampler(uint32_t binding, vk::ShaderStageFlags shader_stage, const vk::Sampler& immutable_sampler)
+    {
+        auto b = make_binding(DescriptorType::eSampler, binding, shader_stage, 1);
+        b.setPImmutableSamplers(&immutable_sampler);
+        _bindings.push_back(b);
+        return *this;
+    }
+
+    Descriptor::Builder&
+    Descriptor::Builder::combined_image_sampler(uint32_t binding, vk::ShaderStageFlags shader_stage, const vk::Sampler& immutable_sampler)
+    {
+        auto b = make_binding(DescriptorType::eCombinedImageSampler, binding, shader_stage, 1);
+        b.setPImmutableSamplers(&immutable_sampler);
+        _bindings.push_back(b);
+        return *this;
+    }
+
     Descriptor::Builder&
     Descriptor::Builder::storage_buffer(uint32_t binding, vk::ShaderStageFlags shader_stage, uint32_t count)
     {
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.hpp>
@@ -37,6 +39,9 @@ namespace Nebula
                    const sdvk::Context& context,
                    const std::string& debug_name);
 
+        // Sets are released with the pool, after the frames using them have finished.
+        ~Descriptor();
+
         Write begin_write(uint32_t set_index);
 
         const vk::DescriptorSet& set(uint32_t index) const;
@@ -64,6 +69,9 @@ namespace Nebula
         const uint32_t m_set_count;
 
         const sdvk::Context& m_context;
+
+        // Descriptors held by statics may outlive the Context.
+        std::shared_ptr<sdvk::DeferredDestructionQueue> m_destruction_queue;
     };
 
     struct Descriptor::Builder
@@ -76,6 +84,11 @@ namespace Nebula
 
         Builder& combined_image_sampler(uint32_t binding, vk::ShaderStageFlags shader_stage, uint32_t count = 1);
 
+        // Immutable sampler variants: the sampler must outlive the layout creation, e.g. one from SamplerCache.
+        Builder& sampler(uint32_t binding, vk::ShaderStageFlags shader_stage, const vk::Sampler& immutable_sampler);
+
+        Builder& combined_image_sampler(uint32_t binding, vk::ShaderStageFlags shader_stage, const vk::Sampler& immutable_sampler);
+
         Builder& storage_buffer(uint32_t binding, vk::ShaderStageFlags shader_stage, uint32_t count = 1);
 
         Builder& storage_image(uint32_t binding, vk::ShaderStageFlags shader_stage, uint32_t count = 1);
@@ -131,10 +144,14 @@ namespace Nebula
         void commit();
 
     private:
-        std::vector<vk::WriteDescriptorSet> _writes;
-        std::vector<vk::WriteDescriptorSetAccelerationStructureKHR> _as_infos;
-        std::vector<vk::DescriptorBufferInfo> _buffer_infos;
-        std::vector<vk::DescriptorImageInfo> _image_infos;
+        // Writes are transient, their storage comes from the current FrameArena.
+        // Writes point into the info containers, deques keep those addresses stable however many writes are added.
+        static constexpr size_t s_reserved_writes = 16;
+
+        std::pmr::vector<vk::WriteDescriptorSet> _writes;
+        std::pmr::deque<vk::WriteDescriptorSetAccelerationStructureKHR> _as_infos;
+        std::pmr::deque<vk::DescriptorBufferInfo> _buffer_infos;
+        std::pmr::deque<vk::DescriptorImageInfo> _image_infos;
 
         const uint32_t _set_index {0};
         const Descriptor& _descriptor;
@@ -0,0 +1,88 @@
+#include "FrameArena.hpp"
+#include <vector>
+
+namespace Nebula
+{
+    static std::vector<std::unique_ptr<FrameArena>> s_frame_arenas;
+    static uint32_t s_current_slot = 0;
+    static thread_local FrameArena* t_thread_arena = nullptr;
+
+    FrameArena::FrameArena(const size_t capacity)
+    : m_memory(std::make_unique<std::byte[]>(capacity))
+    , m_capacity(capacity)
+    {
+    }
+
+    void FrameArena::reset()
+    {
+        m_offset = 0;
+        m_heap_allocations = 0;
+    }
+
+    void FrameArena::begin_frame(const uint32_t frame_slot)
+    {
+        while (s_frame_arenas.size() <= frame_slot)
+        {
+            s_frame_arenas.push_back(std::make_unique<FrameArena>());
+        }
+
+        s_current_slot = frame_slot;
+        s_frame_arenas[frame_slot]->reset();
+    }
+
+    FrameArena& FrameArena::current()
+    {
+        if (t_thread_arena)
+        {
+            return *t_thread_arena;
+        }
+
+        if (s_frame_arenas.empty())
+        {
+            begin_frame(0);
+        }
+
+        return *s_frame_arenas[s_current_slot];
+    }
+
+    void FrameArena::bind_to_thread(FrameArena* arena)
+    {
+        t_thread_arena = arena;
+    }
+
+    void* FrameArena::do_allocate(const size_t bytes, const size_t alignment)
+    {
+        const auto base = reinterpret_cast<uintptr_t>(m_memory.get());
+        const uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        const size_t new_offset = (aligned - base) + bytes;
+
+        if (new_offset > m_capacity)
+        {
+            m_heap_allocations++;
+            return m_upstream->allocate(bytes, alignment);
+        }
+
+        m_offset = new_offset;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void FrameArena::do_deallocate(void* p, const size_t bytes, const size_t alignment)
+    {
+        // Arena memory is released all at once on reset.
+        if (!_owns(p))
+        {
+            m_upstream->deallocate(p, bytes, alignment);
+        }
+    }
+
+    bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    bool FrameArena::_owns(const void* p) const
+    {
+        const auto* ptr = static_cast<const std::byte*>(p);
+        return ptr >= m_memory.get() && ptr < m_memory.get() + m_capacity;
+    }
+}
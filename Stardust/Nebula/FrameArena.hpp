@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace Nebula
+{
+    /**
+     * Linear allocator for data that only lives until the end of a frame.
+     * There is one arena per frame slot, the arena is reset wholesale once the fence of its slot has signaled.
+     * Allocations that do not fit fall back to the heap and are counted, so the block size can be tuned.
+     */
+    class FrameArena final : public std::pmr::memory_resource
+    {
+    public:
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        explicit FrameArena(size_t capacity = s_default_capacity);
+
+        ~FrameArena() override = default;
+
+        void reset();
+
+        size_t bytes_used() const { return m_offset; }
+
+        size_t capacity() const { return m_capacity; }
+
+        // Number of allocations since the last reset that did not fit into the arena.
+        uint32_t heap_allocations() const { return m_heap_allocations; }
+
+        // Must be called after the fence of the frame slot has been waited on.
+        static void begin_frame(uint32_t frame_slot);
+
+        // Arena of the frame slot that is currently being recorded, or the arena bound to the calling thread.
+        static FrameArena& current();
+
+        // Threads working outside the frame loop, like the graph compiler, use their own arena. nullptr unbinds.
+        static void bind_to_thread(FrameArena* arena);
+
+        static constexpr size_t s_default_capacity = 256 * 1024;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        bool _owns(const void* p) const;
+
+        std::unique_ptr<std::byte[]> m_memory;
+        size_t                       m_capacity {0};
+        size_t                       m_offset {0};
+        uint32_t                     m_heap_allocations {0};
+        std::pmr::memory_resource*   m_upstream {std::pmr::new_delete_resource()};
+    };
+}
@@ -55,6 +55,7 @@ namespace Nebula
                              uint32_t count,
                              const sdvk::Context& ctx,
                              const std::string& name)
+    : m_destruction_queue(ctx.destruction_queue())
     {
         vk::FramebufferCreateInfo create_info;
         create_info.setLayers(1);
@@ -90,6 +91,7 @@ namespace Nebula
                              uint32_t count,
                              const sdvk::Context& ctx,
                              const std::string& name)
+    : m_destruction_queue(ctx.destruction_queue())
     {
         vk::FramebufferCreateInfo create_info;
         create_info.setAttachmentCount(1);
@@ -120,6 +122,14 @@ namespace Nebula
         }
     }
 
+    Framebuffer::~Framebuffer()
+    {
+        for (const vk::Framebuffer& framebuffer : m_framebuffers)
+        {
+            m_destruction_queue->destroy(framebuffer);
+        }
+    }
+
     const vk::Framebuffer& Framebuffer::get(uint32_t index)
     {
         if (index > static_cast<uint32_t>(m_framebuffers.size()))
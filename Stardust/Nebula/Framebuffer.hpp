@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include <vulkan/vulkan.hpp>
+#include <Vulkan/DeferredDestructionQueue.hpp>
 
 namespace sdvk
 {
@@ -56,11 +57,15 @@ namespace Nebula
                     const sdvk::Context& ctx,
                     const std::string& name = "Framebuffer");
 
+        ~Framebuffer();
+
         const vk::Framebuffer& get(uint32_t index);
 
         const vk::Framebuffer& operator[](uint32_t index);
 
     private:
         std::vector<vk::Framebuffer> m_framebuffers;
+
+        std::shared_ptr<sdvk::DeferredDestructionQueue> m_destruction_queue;
     };
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "GpuTimer.hpp"
+#include <array>
+#include <stdexcept>
+#include <Vulkan/Context.hpp>
+
+namespace Nebula
+{
+    GpuTimer::GpuTimer(const uint32_t frame_slots, const sdvk::Context& context)
+    : m_frame_slots(frame_slots), m_context(context)
+    {
+        const auto properties = m_context.physical_device().getProperties();
+        if (!properties.limits.timestampComputeAndGraphics)
+        {
+            throw std::runtime_error("[Error] Device does not support timestamp queries on graphics queues");
+        }
+        m_timestamp_period_ns = static_cast<double>(properties.limits.timestampPeriod);
+
+        vk::QueryPoolCreateInfo create_info;
+        create_info.setQueryType(vk::QueryType::eTimestamp);
+        create_info.setQueryCount(2 * m_frame_slots);
+
+        if (const vk::Result result = m_context.device().createQueryPool(&create_info, nullptr, &m_query_pool);
+            result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error("[Error] Failed to create timestamp QueryPool");
+        }
+    }
+
+    GpuTimer::~GpuTimer()
+    {
+        m_context.device().destroyQueryPool(m_query_pool);
+    }
+
+    void GpuTimer::begin(const vk::CommandBuffer& command_buffer, const uint32_t frame_slot) const
+    {
+        command_buffer.resetQueryPool(m_query_pool, 2 * frame_slot, 2);
+        command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, m_query_pool, 2 * frame_slot);
+    }
+
+    void GpuTimer::end(const vk::CommandBuffer& command_buffer, const uint32_t frame_slot) const
+    {
+        command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eBottomOfPipe, m_query_pool, 2 * frame_slot + 1);
+    }
+
+    std::optional<double> GpuTimer::elapsed_ms(const uint32_t frame_slot) const
+    {
+        std::array<uint64_t, 2> timestamps {};
+        const vk::Result result = m_context.device().getQueryPoolResults(m_query_pool, 2 * frame_slot, 2,
+                                                                         sizeof(timestamps), timestamps.data(), sizeof(uint64_t),
+                                                                         vk::QueryResultFlagBits::e64);
+        if (result != vk::Result::eSuccess)
+        {
+            return std::nullopt;
+        }
+
+        return static_cast<double>(timestamps[1] - timestamps[0]) * m_timestamp_period_ns / 1'000'000.0;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vulkan/vulkan.hpp>
+
+namespace sdvk
+{
+    class Context;
+}
+
+namespace Nebula
+{
+    /**
+     * Measures GPU time between two timestamps, one query pair per frame slot.
+     * Results of a slot can be read once the fence of that slot has signaled.
+     */
+    class GpuTimer
+    {
+    public:
+        GpuTimer(const GpuTimer&) = delete;
+        GpuTimer& operator=(const GpuTimer&) = delete;
+
+        GpuTimer(uint32_t frame_slots, const sdvk::Context& context);
+
+        ~GpuTimer();
+
+        void begin(const vk::CommandBuffer& command_buffer, uint32_t frame_slot) const;
+
+        void end(const vk::CommandBuffer& command_buffer, uint32_t frame_slot) const;
+
+        // Elapsed milliseconds of the last begin/end pair recorded for the slot, empty if not available.
+        std::optional<double> elapsed_ms(uint32_t frame_slot) const;
+
+    private:
+        vk::QueryPool m_query_pool;
+        uint32_t      m_frame_slots {0};
+        double        m_timestamp_period_ns {1.0};
+
+        const sdvk::Context& m_context;
+    };
+}
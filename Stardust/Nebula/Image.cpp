@@ -13,7 +13,9 @@ namespace Nebula
                  vk::ImageAspectFlags aspect_flags,
                  vk::ImageTiling tiling,
                  vk::MemoryPropertyFlags memory_property_flags,
-                 const std::string& name) : m_context(context)
+                 const std::string& name)
+    : m_context(context), m_device(context.device()), m_memory_tracker(context.memory_tracker()), m_block_allocator(context.block_allocator())
+    , m_destruction_queue(context.destruction_queue())
     {
         m_properties = ImageProperties {
             .format = format,
@@ -45,8 +47,12 @@ namespace Nebula
         }
 
         auto memory_requirements = context.device().getImageMemoryRequirements(m_image);
-        context.allocate_memory(memory_requirements, memory_property_flags, &m_device_memory);
-        device.bindImageMemory(m_image, m_device_memory, 0);
+        m_memory_allocation = m_block_allocator->allocate(memory_requirements, memory_property_flags, sdvk::MemoryResourceKind::eImage, context);
+        device.bindImageMemory(m_image, m_memory_allocation.memory, m_memory_allocation.offset);
+
+        m_allocation_size = memory_requirements.size;
+        m_allocation = m_memory_tracker->track(name.empty() ? "Unnamed Image" : name, sdvk::MemoryCategory::eImage,
+                                               m_memory_allocation.memory_type, m_allocation_size);
 
         {
             vk::ImageViewCreateInfo create_info;
@@ -85,6 +91,17 @@ namespace Nebula
         }
     }
 
+    Image::~Image()
+    {
+        m_destruction_queue->push([device = m_device, image = m_image, image_view = m_image_view, allocator = m_block_allocator,
+                                   allocation = m_memory_allocation, tracker = m_memory_tracker, tracked = m_allocation]() {
+            device.destroyImageView(image_view);
+            device.destroyImage(image);
+            allocator->free(allocation);
+            tracker->release(tracked);
+        });
+    }
+
     std::shared_ptr<Image> Image::make_depth_image(vk::Extent2D extent,
                                                    const sdvk::Context& context,
                                                    const std::string& name)
@@ -31,6 +31,9 @@ namespace Nebula
             vk::ImageLayout  layout { vk::ImageLayout::eUndefined };
         };
 
+        Image(const Image&) = delete;
+        Image& operator=(const Image&) = delete;
+
         Image(const sdvk::Context& context,
               vk::Format format,
               vk::Extent2D extent,
@@ -41,6 +44,8 @@ namespace Nebula
               vk::MemoryPropertyFlags memory_property_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
               const std::string& name = "");
 
+        ~Image();
+
         const vk::Image& image() const { return m_image; }
 
         const vk::ImageView& image_view() const { return m_image_view; }
@@ -51,6 +56,8 @@ namespace Nebula
 
         void update_state(ImageState state) { m_state = state; }
 
+        vk::DeviceSize allocation_size() const { return m_allocation_size; }
+
         static std::shared_ptr<Image> make_depth_image(vk::Extent2D extent,
                                                        const sdvk::Context& context,
                                                        const std::string& name);
@@ -61,10 +68,20 @@ namespace Nebula
     private:
         vk::Image        m_image;
         vk::ImageView    m_image_view;
-        vk::DeviceMemory m_device_memory;
         ImageProperties  m_properties {};
         ImageState       m_state {};
+        vk::DeviceSize   m_allocation_size {0};
 
         const sdvk::Context& m_context;
+
+        // Used for destruction, images owned by statics may outlive the Context.
+        vk::Device                            m_device;
+        std::shared_ptr<sdvk::MemoryTracker>  m_memory_tracker;
+        sdvk::MemoryTracker::AllocationId     m_allocation {0};
+
+        // Images are packed into blocks but never moved, descriptor sets and framebuffers refer to them.
+        std::shared_ptr<sdvk::MemoryBlockAllocator>     m_block_allocator;
+        std::shared_ptr<sdvk::DeferredDestructionQueue> m_destruction_queue;
+        sdvk::MemoryAllocation                          m_memory_allocation;
     };
 }
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "JobSystem.hpp"
+
+namespace Nebula
+{
+    static thread_local uint32_t t_queue_index = 0;
+
+    JobSystem::JobSystem(const uint32_t worker_count)
+    {
+        m_queues.reserve(worker_count + 1);
+        for (uint32_t i = 0; i <= worker_count; i++)
+        {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+
+        m_threads.reserve(worker_count);
+        for (uint32_t i = 0; i < worker_count; i++)
+        {
+            m_threads.emplace_back(&JobSystem::_run, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard lock(m_sleep_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    JobSystem& JobSystem::instance()
+    {
+        static JobSystem job_system(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return job_system;
+    }
+
+    void JobSystem::submit(Job& job)
+    {
+        if (job.counter)
+        {
+            job.counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        _push(job);
+    }
+
+    void JobSystem::submit_after(JobCounter& dependency, Job& job)
+    {
+        if (job.counter)
+        {
+            job.counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _lock(dependency.m_lock);
+        if (dependency.m_pending.load(std::memory_order_acquire) == 0)
+        {
+            _unlock(dependency.m_lock);
+            _push(job);
+            return;
+        }
+
+        job.next = dependency.m_waiting;
+        dependency.m_waiting = &job;
+        _unlock(dependency.m_lock);
+    }
+
+    void JobSystem::wait(JobCounter& counter)
+    {
+        const uint32_t queue_index = _queue_index();
+        while (!counter.is_done())
+        {
+            if (Job* job = _find_job(queue_index))
+            {
+                _execute(*job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The thread that finished the last job may still be releasing the jobs waiting for the counter.
+        _lock(counter.m_lock);
+        _unlock(counter.m_lock);
+    }
+
+    void JobSystem::_push(Job& job)
+    {
+        Queue& queue = *m_queues[_queue_index()];
+        bool queued = false;
+        {
+            std::lock_guard lock(queue.mutex);
+            if (queue.size < s_queue_capacity)
+            {
+                queue.jobs[(queue.head + queue.size) % s_queue_capacity] = &job;
+                queue.size++;
+                queued = true;
+                m_queued.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        if (!queued)
+        {
+            _execute(job);
+            return;
+        }
+
+        // Taking the mutex orders the wake up after a worker that is about to sleep has checked m_queued.
+        {
+            std::lock_guard lock(m_sleep_mutex);
+        }
+        m_wake.notify_one();
+    }
+
+    Job* JobSystem::_find_job(const uint32_t queue_index)
+    {
+        if (m_queued.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+
+        {
+            Queue& own = *m_queues[queue_index];
+            std::lock_guard lock(own.mutex);
+            if (own.size > 0)
+            {
+                own.size--;
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return own.jobs[(own.head + own.size) % s_queue_capacity];
+            }
+        }
+
+        const auto queue_count = static_cast<uint32_t>(m_queues.size());
+        for (uint32_t i = 1; i < queue_count; i++)
+        {
+            Queue& victim = *m_queues[(queue_index + i) % queue_count];
+            std::lock_guard lock(victim.mutex);
+            if (victim.size > 0)
+            {
+                Job* job = victim.jobs[victim.head];
+                victim.head = (victim.head + 1) % s_queue_capacity;
+                victim.size--;
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void JobSystem::_execute(Job& job)
+    {
+        // The job may be destroyed as soon as its counter reached zero.
+        JobCounter* counter = job.counter;
+        job.function(job.data);
+        if (counter)
+        {
+            _finish(*counter);
+        }
+    }
+
+    void JobSystem::_finish(JobCounter& counter)
+    {
+        Job* released = nullptr;
+        _lock(counter.m_lock);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            released = counter.m_waiting;
+            counter.m_waiting = nullptr;
+        }
+        _unlock(counter.m_lock);
+
+        while (released)
+        {
+            Job* next = released->next;
+            released->next = nullptr;
+            _push(*released);
+            released = next;
+        }
+    }
+
+    void JobSystem::_run(const uint32_t worker)
+    {
+        t_queue_index = worker + 1;
+        while (true)
+        {
+            if (Job* job = _find_job(t_queue_index))
+            {
+                _execute(*job);
+                continue;
+            }
+
+            std::unique_lock lock(m_sleep_mutex);
+            m_wake.wait(lock, [this] { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+            if (m_stop)
+            {
+                return;
+            }
+        }
+    }
+
+    uint32_t JobSystem::_queue_index() const
+    {
+        // Workers of another job system use the shared queue as well.
+        return t_queue_index < m_queues.size() ? t_queue_index : 0;
+    }
+
+    void JobSystem::_lock(std::atomic_flag& lock)
+    {
+        while (lock.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::_unlock(std::atomic_flag& lock)
+    {
+        lock.clear(std::memory_order_release);
+    }
+}
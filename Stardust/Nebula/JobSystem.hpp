@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Nebula
+{
+    class JobCounter;
+
+    /**
+     * Unit of work of the JobSystem. Jobs are owned by the caller, e.g. on the stack of the frame that submits them,
+     * and have to stay alive until their counter reached zero. Submitting a job allocates nothing.
+     */
+    struct Job
+    {
+        using Function = void (*)(void* data);
+
+        Function    function { nullptr };
+        void*       data { nullptr };
+        // Decremented once the job finished, may be null.
+        JobCounter* counter { nullptr };
+        // Next job waiting for the same dependency, used by the job system while the job is pending.
+        Job*        next { nullptr };
+    };
+
+    // Number of unfinished jobs, jobs submitted after it run once it reached zero.
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool is_done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_pending { 0 };
+        // Guards the list of waiting jobs and the transition of m_pending to zero.
+        std::atomic_flag      m_lock;
+        Job*                  m_waiting { nullptr };
+    };
+
+    /**
+     * Work-stealing scheduler, every worker has a deque of its own and takes jobs from the back of it,
+     * idle workers steal from the front of the others. Threads that are not workers share one deque.
+     * Waiting on a counter runs queued jobs on the waiting thread instead of blocking it.
+     */
+    class JobSystem
+    {
+    public:
+        explicit JobSystem(uint32_t worker_count);
+
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // One worker less than there are hardware threads, the thread that waits is the last one.
+        static JobSystem& instance();
+
+        void submit(Job& job);
+
+        // The job is queued once dependency reached zero, right away if it already has.
+        void submit_after(JobCounter& dependency, Job& job);
+
+        // Runs queued jobs on the calling thread until the counter reached zero.
+        void wait(JobCounter& counter);
+
+        /**
+         * Calls function(begin, end) for chunks of at most grain indices covering [0, count) and returns once all of them finished.
+         * The calling thread takes part, ranges with a single chunk run on it directly.
+         */
+        template <typename F>
+        void parallel_for(uint32_t count, uint32_t grain, const F& function);
+
+        // Workers and the calling thread.
+        uint32_t thread_count() const { return static_cast<uint32_t>(m_threads.size()) + 1; }
+
+        // Jobs that do not fit into a full deque run on the submitting thread.
+        static constexpr uint32_t s_queue_capacity = 4096;
+
+        // Upper bound of the jobs a parallel_for splits into.
+        static constexpr uint32_t s_max_parallel_jobs = 64;
+
+    private:
+        struct Queue
+        {
+            std::mutex                             mutex;
+            std::array<Job*, s_queue_capacity>     jobs {};
+            uint32_t                               head { 0 };
+            uint32_t                               size { 0 };
+        };
+
+        void _push(Job& job);
+
+        // Own deque from the back, then the other ones from the front.
+        Job* _find_job(uint32_t queue_index);
+
+        void _execute(Job& job);
+
+        void _finish(JobCounter& counter);
+
+        void _run(uint32_t worker);
+
+        uint32_t _queue_index() const;
+
+        static void _lock(std::atomic_flag& lock);
+
+        static void _unlock(std::atomic_flag& lock);
+
+        // Index 0 is shared by threads that are not workers, worker i uses i + 1.
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread>            m_threads;
+        std::mutex                          m_sleep_mutex;
+        std::condition_variable             m_wake;
+        std::atomic<uint32_t>               m_queued { 0 };
+        std::atomic<bool>                   m_stop { false };
+    };
+
+    template <typename F>
+    void JobSystem::parallel_for(const uint32_t count, const uint32_t grain, const F& function)
+    {
+        const uint32_t chunk_size = std::max(grain, 1u);
+        const uint32_t chunks = (count + chunk_size - 1) / chunk_size;
+        const uint32_t job_count = std::min({ chunks, thread_count(), s_max_parallel_jobs });
+        if (job_count <= 1)
+        {
+            if (count > 0)
+            {
+                function(0u, count);
+            }
+            return;
+        }
+
+        // Jobs take chunks until none are left, so threads that start late or get slow chunks balance out.
+        struct Range
+        {
+            const F*              function;
+            uint32_t              count;
+            uint32_t              grain;
+            std::atomic<uint32_t> next_chunk { 0 };
+
+            void run()
+            {
+                for (uint32_t chunk = next_chunk++; chunk * grain < count; chunk = next_chunk++)
+                {
+                    const uint32_t begin = chunk * grain;
+                    (*function)(begin, std::min(begin + grain, count));
+                }
+            }
+        };
+
+        Range range { &function, count, chunk_size };
+        JobCounter counter;
+        std::array<Job, s_max_parallel_jobs> jobs;
+        for (uint32_t i = 1; i < job_count; i++)
+        {
+            jobs[i] = { [](void* data) { static_cast<Range*>(data)->run(); }, &range, &counter };
+            submit(jobs[i]);
+        }
+
+        range.run();
+        wait(counter);
+    }
+}
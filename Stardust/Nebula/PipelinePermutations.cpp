@@ -0,0 +1,42 @@
+#include "PipelinePermutations.hpp"
+#include <format>
+#include <utility>
+#include <Nebula/Utility.hpp>
+
+namespace Nebula
+{
+    PipelinePermutations::PipelinePermutations(const vk::PipelineLayout& pipeline_layout, Factory factory, std::string name)
+    : m_pipeline_layout(pipeline_layout), m_factory(std::move(factory)), m_name(std::move(name))
+    {
+    }
+
+    const vk::Pipeline& PipelinePermutations::get(const Key key)
+    {
+        if (const auto it = m_pipelines.find(key); it != std::end(m_pipelines))
+        {
+            return it->second;
+        }
+
+        if (!m_factory)
+        {
+            throw Utility::make_exception(std::format("No factory set for pipeline permutations of \"{}\"", m_name));
+        }
+
+        const vk::Pipeline pipeline = m_factory(key, m_pipeline_layout);
+        if (!pipeline)
+        {
+            throw Utility::make_exception(std::format("Failed to create permutation {:#x} of \"{}\"", key, m_name));
+        }
+
+        return m_pipelines.insert({ key, pipeline }).first->second;
+    }
+
+    void PipelinePermutations::release(sdvk::DeferredDestructionQueue& destruction_queue)
+    {
+        for (const auto& [key, pipeline] : m_pipelines)
+        {
+            destruction_queue.destroy(pipeline);
+        }
+        m_pipelines.clear();
+    }
+}
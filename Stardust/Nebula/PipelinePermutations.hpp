@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vulkan/vulkan.hpp>
+#include <Vulkan/DeferredDestructionQueue.hpp>
+
+namespace Nebula
+{
+    /**
+     * Cache of specialized variants of a single pipeline.
+     * Each variant is identified by a key packed from its specialization constant values,
+     * variants are created on first use through the factory and share a common pipeline layout.
+     */
+    class PipelinePermutations
+    {
+    public:
+        using Key = uint32_t;
+        using Factory = std::function<vk::Pipeline(Key key, const vk::PipelineLayout& pipeline_layout)>;
+
+        PipelinePermutations() = default;
+
+        PipelinePermutations(const vk::PipelineLayout& pipeline_layout, Factory factory, std::string name = "Pipeline");
+
+        const vk::Pipeline& get(Key key);
+
+        bool contains(Key key) const { return m_pipelines.contains(key); }
+
+        uint32_t count() const { return static_cast<uint32_t>(m_pipelines.size()); }
+
+        const vk::PipelineLayout& layout() const { return m_pipeline_layout; }
+
+        // Hands every variant to the queue, the layout stays with its owner.
+        void release(sdvk::DeferredDestructionQueue& destruction_queue);
+
+    private:
+        std::map<Key, vk::Pipeline> m_pipelines;
+        vk::PipelineLayout          m_pipeline_layout;
+        Factory                     m_factory;
+        std::string                 m_name;
+    };
+}
@@ -0,0 +1,116 @@
+#include "SamplerCache.hpp"
+#include <format>
+#include <functional>
+#include <map>
+#include <memory>
+#include <Nebula/Utility.hpp>
+#include <Vulkan/Context.hpp>
+#include <Vulkan/DeferredDestructionQueue.hpp>
+#include <Vulkan/Utils.hpp>
+#include <Vulkan/Image/Sampler.hpp>
+
+namespace Nebula
+{
+    namespace
+    {
+        std::map<VkDevice, std::unique_ptr<SamplerCache>> s_caches;
+        std::mutex s_caches_mutex;
+    }
+
+    SamplerCache::SamplerCache(const sdvk::Context& context): m_context(context) {}
+
+    SamplerCache& SamplerCache::instance(const sdvk::Context& context)
+    {
+        std::lock_guard lock(s_caches_mutex);
+
+        const auto device = static_cast<VkDevice>(context.device());
+        if (!s_caches.contains(device))
+        {
+            s_caches.insert({ device, std::make_unique<SamplerCache>(context) });
+        }
+
+        return *s_caches[device];
+    }
+
+    void SamplerCache::release(const sdvk::Context& context)
+    {
+        std::lock_guard lock(s_caches_mutex);
+
+        const auto it = s_caches.find(static_cast<VkDevice>(context.device()));
+        if (it == s_caches.end())
+        {
+            return;
+        }
+
+        const auto cache = std::move(it->second);
+        s_caches.erase(it);
+        for (const auto& [key, entry] : cache->m_samplers)
+        {
+            context.destruction_queue()->destroy(entry.sampler);
+        }
+    }
+
+    const vk::Sampler& SamplerCache::get(const vk::SamplerCreateInfo& create_info)
+    {
+        if (create_info.pNext != nullptr)
+        {
+            throw Utility::make_exception("SamplerCache does not support extended vk::SamplerCreateInfo structures");
+        }
+
+        const size_t key = hash(create_info);
+        std::lock_guard lock(m_mutex);
+        auto [begin, end] = m_samplers.equal_range(key);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->second.create_info == create_info)
+            {
+                return it->second.sampler;
+            }
+        }
+
+        vk::Sampler sampler;
+        if (const vk::Result result = m_context.device().createSampler(&create_info, nullptr, &sampler);
+            result != vk::Result::eSuccess)
+        {
+            throw Utility::make_exception("Failed to create cached Sampler");
+        }
+
+        sdvk::util::name_vk_object(std::format("Cached Sampler #{}", m_samplers.size()),
+                                   (uint64_t) static_cast<VkSampler>(sampler), vk::ObjectType::eSampler,
+                                   m_context.device());
+
+        return m_samplers.insert({ key, Entry { create_info, sampler } })->second.sampler;
+    }
+
+    const vk::Sampler& SamplerCache::get(const sdvk::SamplerBuilder& sampler_builder)
+    {
+        return get(sampler_builder.get_create_info());
+    }
+
+    size_t SamplerCache::hash(const vk::SamplerCreateInfo& create_info)
+    {
+        size_t seed = 0;
+        auto combine = [&seed]<typename T>(const T& value) {
+            seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+
+        combine(static_cast<uint32_t>(create_info.flags));
+        combine(static_cast<uint32_t>(create_info.magFilter));
+        combine(static_cast<uint32_t>(create_info.minFilter));
+        combine(static_cast<uint32_t>(create_info.mipmapMode));
+        combine(static_cast<uint32_t>(create_info.addressModeU));
+        combine(static_cast<uint32_t>(create_info.addressModeV));
+        combine(static_cast<uint32_t>(create_info.addressModeW));
+        combine(create_info.mipLodBias);
+        combine(create_info.anisotropyEnable);
+        combine(create_info.maxAnisotropy);
+        combine(create_info.compareEnable);
+        combine(static_cast<uint32_t>(create_info.compareOp));
+        combine(create_info.minLod);
+        combine(create_info.maxLod);
+        combine(static_cast<uint32_t>(create_info.borderColor));
+        combine(create_info.unnormalizedCoordinates);
+
+        return seed;
+    }
+}
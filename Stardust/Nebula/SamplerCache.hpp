@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vulkan/vulkan.hpp>
+
+namespace sdvk
+{
+    class Context;
+    struct SamplerBuilder;
+}
+
+namespace Nebula
+{
+    /**
+     * Deduplicates samplers by their vk::SamplerCreateInfo.
+     * Returned references stay valid for the lifetime of the cache, which makes them usable as
+     * immutable samplers in descriptor set layouts. Nodes may be initialized on the compile thread, so lookups are locked.
+     */
+    class SamplerCache
+    {
+    public:
+        SamplerCache(const SamplerCache&) = delete;
+        SamplerCache& operator=(const SamplerCache&) = delete;
+
+        explicit SamplerCache(const sdvk::Context& context);
+
+        // Shared cache of the device owned by the given context.
+        static SamplerCache& instance(const sdvk::Context& context);
+
+        // Hands the samplers of the shared cache to the destruction queue and drops the cache, call before the device is destroyed.
+        static void release(const sdvk::Context& context);
+
+        const vk::Sampler& get(const vk::SamplerCreateInfo& create_info);
+
+        const vk::Sampler& get(const sdvk::SamplerBuilder& sampler_builder);
+
+        uint32_t count() const
+        {
+            std::lock_guard lock(m_mutex);
+            return static_cast<uint32_t>(m_samplers.size());
+        }
+
+        static size_t hash(const vk::SamplerCreateInfo& create_info);
+
+    private:
+        struct Entry
+        {
+            vk::SamplerCreateInfo create_info;
+            vk::Sampler           sampler;
+        };
+
+        std::unordered_multimap<size_t, Entry> m_samplers;
+        mutable std::mutex                     m_mutex;
+
+        const sdvk::Context& m_context;
+    };
+}
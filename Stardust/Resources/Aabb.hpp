@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Resources/VertexData.hpp>
+
+namespace sd
+{
+    struct Aabb
+    {
+        glm::vec3 min { std::numeric_limits<float>::max() };
+        glm::vec3 max { std::numeric_limits<float>::lowest() };
+
+        void extend(const glm::vec3& point)
+        {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        void extend(const Aabb& other)
+        {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+
+        bool is_empty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+        glm::vec3 center() const { return (min + max) * 0.5f; }
+
+        // Half the size on each axis.
+        glm::vec3 extent() const { return (max - min) * 0.5f; }
+
+        float surface_area() const
+        {
+            if (is_empty())
+            {
+                return 0.0f;
+            }
+            const glm::vec3 size = max - min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        // Bounds of the box after an affine transformation, the extent is projected onto each axis (Arvo).
+        Aabb transform(const glm::mat4& matrix) const
+        {
+            if (is_empty())
+            {
+                return {};
+            }
+
+            const glm::vec3 c = glm::vec3(matrix * glm::vec4(center(), 1.0f));
+            const glm::vec3 e = extent();
+            const glm::vec3 r = glm::abs(glm::vec3(matrix[0])) * e.x
+                              + glm::abs(glm::vec3(matrix[1])) * e.y
+                              + glm::abs(glm::vec3(matrix[2])) * e.z;
+            return { c - r, c + r };
+        }
+
+        static Aabb from_vertices(const std::vector<VertexData>& vertices)
+        {
+            Aabb result;
+            for (const auto& vertex : vertices)
+            {
+                result.extend(vertex.position);
+            }
+            return result;
+        }
+    };
+}
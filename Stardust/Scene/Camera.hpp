@@ -1,9 +1,10 @@
 #pragma once
 
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <Resources/CameraUniformData.hpp>
 
+struct GLFWwindow;
+
 namespace sd
 {
     class Camera
@@ -19,6 +20,10 @@ namespace sd
 
         CameraUniformData uniform_data() const;
 
+        // Used by scripted camera paths, input handlers keep working from the new pose.
+        void look_at(const glm::vec3& eye, const glm::vec3& target);
+
+        // Defined in SceneInput.cpp, part of the application target.
         void register_keys(GLFWwindow* p_window);
 
         void register_mouse(GLFWwindow* p_window);
@@ -0,0 +1,141 @@
+#include "Frustum.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SD_FRUSTUM_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SD_FRUSTUM_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SD_FRUSTUM_NEON
+#endif
+
+namespace sd
+{
+    Frustum::Frustum(const glm::mat4& view_projection)
+    {
+        const glm::mat4 rows = glm::transpose(view_projection);
+        const std::array<glm::vec4, s_plane_count> planes = {
+            rows[3] + rows[0], rows[3] - rows[0],
+            rows[3] + rows[1], rows[3] - rows[1],
+            rows[2],           rows[3] - rows[2],
+        };
+
+        // The padding repeats the last plane, which does not change the result.
+        for (uint32_t i = 0; i < s_padded_count; i++)
+        {
+            const glm::vec4& plane = planes[std::min(i, s_plane_count - 1)];
+            m_nx[i] = plane.x;
+            m_ny[i] = plane.y;
+            m_nz[i] = plane.z;
+            m_d[i]  = plane.w;
+        }
+    }
+
+    // A box is outside if it is completely behind one plane: n.c + d < -|n|.e, and inside if it is in front of all of them.
+    FrustumTest Frustum::classify(const Aabb& aabb) const
+    {
+        const glm::vec3 c = aabb.center();
+        const glm::vec3 e = aabb.extent();
+
+#if defined(SD_FRUSTUM_AVX2)
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        const __m256 nx = _mm256_load_ps(m_nx), ny = _mm256_load_ps(m_ny), nz = _mm256_load_ps(m_nz);
+
+        __m256 distance = _mm256_load_ps(m_d);
+        distance = _mm256_add_ps(distance, _mm256_mul_ps(nx, _mm256_set1_ps(c.x)));
+        distance = _mm256_add_ps(distance, _mm256_mul_ps(ny, _mm256_set1_ps(c.y)));
+        distance = _mm256_add_ps(distance, _mm256_mul_ps(nz, _mm256_set1_ps(c.z)));
+
+        __m256 radius = _mm256_mul_ps(_mm256_andnot_ps(sign_mask, nx), _mm256_set1_ps(e.x));
+        radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_andnot_ps(sign_mask, ny), _mm256_set1_ps(e.y)));
+        radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_andnot_ps(sign_mask, nz), _mm256_set1_ps(e.z)));
+
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ)) != 0)
+        {
+            return FrustumTest::eOutside;
+        }
+        const bool intersects = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_sub_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ)) != 0;
+#elif defined(SD_FRUSTUM_SSE)
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+        const __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+
+        int32_t outside = 0, intersecting = 0;
+        for (uint32_t i = 0; i < s_padded_count; i += 4)
+        {
+            const __m128 nx = _mm_load_ps(m_nx + i), ny = _mm_load_ps(m_ny + i), nz = _mm_load_ps(m_nz + i);
+
+            __m128 distance = _mm_load_ps(m_d + i);
+            distance = _mm_add_ps(distance, _mm_mul_ps(nx, cx));
+            distance = _mm_add_ps(distance, _mm_mul_ps(ny, cy));
+            distance = _mm_add_ps(distance, _mm_mul_ps(nz, cz));
+
+            __m128 radius = _mm_mul_ps(_mm_andnot_ps(sign_mask, nx), ex);
+            radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, ny), ey));
+            radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, nz), ez));
+
+            outside      |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            intersecting |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), _mm_setzero_ps()));
+        }
+
+        if (outside != 0)
+        {
+            return FrustumTest::eOutside;
+        }
+        const bool intersects = intersecting != 0;
+#elif defined(SD_FRUSTUM_NEON)
+        const float32x4_t cx = vdupq_n_f32(c.x), cy = vdupq_n_f32(c.y), cz = vdupq_n_f32(c.z);
+        const float32x4_t ex = vdupq_n_f32(e.x), ey = vdupq_n_f32(e.y), ez = vdupq_n_f32(e.z);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+
+        uint32x4_t outside = vdupq_n_u32(0), intersecting = vdupq_n_u32(0);
+        for (uint32_t i = 0; i < s_padded_count; i += 4)
+        {
+            const float32x4_t nx = vld1q_f32(m_nx + i), ny = vld1q_f32(m_ny + i), nz = vld1q_f32(m_nz + i);
+
+            float32x4_t distance = vld1q_f32(m_d + i);
+            distance = vmlaq_f32(distance, nx, cx);
+            distance = vmlaq_f32(distance, ny, cy);
+            distance = vmlaq_f32(distance, nz, cz);
+
+            float32x4_t radius = vmulq_f32(vabsq_f32(nx), ex);
+            radius = vmlaq_f32(radius, vabsq_f32(ny), ey);
+            radius = vmlaq_f32(radius, vabsq_f32(nz), ez);
+
+            outside      = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), zero));
+            intersecting = vorrq_u32(intersecting, vcltq_f32(vsubq_f32(distance, radius), zero));
+        }
+
+        auto any_lane = [](const uint32x4_t mask) {
+            const uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+            return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+        };
+
+        if (any_lane(outside))
+        {
+            return FrustumTest::eOutside;
+        }
+        const bool intersects = any_lane(intersecting);
+#else
+        bool intersects = false;
+        for (uint32_t i = 0; i < s_plane_count; i++)
+        {
+            const float distance = m_nx[i] * c.x + m_ny[i] * c.y + m_nz[i] * c.z + m_d[i];
+            const float radius = std::abs(m_nx[i]) * e.x + std::abs(m_ny[i]) * e.y + std::abs(m_nz[i]) * e.z;
+            if (distance + radius < 0.0f)
+            {
+                return FrustumTest::eOutside;
+            }
+            intersects |= distance - radius < 0.0f;
+        }
+#endif
+
+        return intersects ? FrustumTest::eIntersecting : FrustumTest::eInside;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <Resources/Aabb.hpp>
+
+namespace sd
+{
+    enum class FrustumTest
+    {
+        eOutside,
+        eIntersecting,
+        eInside,
+    };
+
+    /**
+     * View frustum planes extracted from a view projection matrix (Gribb-Hartmann).
+     * The planes are kept per component and padded to eight, so a box is tested against all of them at once.
+     */
+    class Frustum
+    {
+    public:
+        explicit Frustum(const glm::mat4& view_projection);
+
+        FrustumTest classify(const Aabb& aabb) const;
+
+        bool is_visible(const Aabb& aabb) const { return classify(aabb) != FrustumTest::eOutside; }
+
+    private:
+        static constexpr uint32_t s_plane_count = 6;
+        static constexpr uint32_t s_padded_count = 8;
+
+        alignas(32) float m_nx[s_padded_count] {};
+        alignas(32) float m_ny[s_padded_count] {};
+        alignas(32) float m_nz[s_padded_count] {};
+        alignas(32) float m_d[s_padded_count] {};
+    };
+}
@@ -0,0 +1,204 @@
+#include "GpuScene.hpp"
+
+#include <algorithm>
+#include <format>
+#include <Application/Application.hpp>
+#include <Scene/MeshDeformer.hpp>
+#include <Vulkan/Buffer.hpp>
+#include <Vulkan/Context.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+
+namespace sd
+{
+    GpuScene::GpuScene(const std::vector<Object>& objects, const SceneStore& store, const MeshDeformer& deformer,
+                       const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context)
+    : m_object_count(static_cast<uint32_t>(objects.size()))
+    , m_context(context)
+    {
+        m_staging.resize(Application::s_max_frames_in_flight);
+
+        // At least one object, so the buffer and its address exist for empty scenes as well.
+        std::vector<GpuObject> data(std::max(m_object_count, 1u));
+        const auto& models = store.models();
+        for (uint32_t i = 0; i < m_object_count; i++)
+        {
+            data[i] = pack_object(objects[i], models[i], store.mesh_index(i), deformer, i);
+        }
+
+        m_buffer = sdvk::Buffer::Builder()
+            .with_size(data.size() * sizeof(GpuObject))
+            .with_usage_flags(vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress
+                              | vk::BufferUsageFlagBits::eTransferDst)
+            .with_memory_property_flags(vk::MemoryPropertyFlagBits::eDeviceLocal)
+            .with_name("Scene: GPU Scene")
+            .create_with_data(data.data(), command_buffers, m_context);
+    }
+
+    GpuScene::~GpuScene() = default;
+
+    void GpuScene::mark_dirty(const uint32_t begin, const uint32_t end)
+    {
+        if (begin < end)
+        {
+            m_dirty.emplace_back(begin, end);
+        }
+    }
+
+    void GpuScene::mark_dirty(const std::vector<uint32_t>& objects)
+    {
+        for (size_t i = 0; i < objects.size();)
+        {
+            size_t j = i + 1;
+            while (j < objects.size() && objects[j] == objects[j - 1] + 1)
+            {
+                j++;
+            }
+            m_dirty.emplace_back(objects[i], objects[j - 1] + 1);
+            i = j;
+        }
+    }
+
+    void GpuScene::upload(const std::vector<Object>& objects, const SceneStore& store, const MeshDeformer& deformer,
+                          const uint32_t current_frame, const vk::CommandBuffer& command_buffer)
+    {
+        m_uploaded_bytes = 0;
+        if (m_dirty.empty())
+        {
+            return;
+        }
+
+        merge_ranges(m_dirty);
+
+        uint32_t dirty_count = 0;
+        for (auto& [begin, end] : m_dirty)
+        {
+            end = std::min(end, m_object_count);
+            begin = std::min(begin, end);
+            dirty_count += end - begin;
+        }
+
+        if (dirty_count == 0)
+        {
+            m_dirty.clear();
+            return;
+        }
+
+        constexpr vk::DeviceSize object_size = sizeof(GpuObject);
+        auto& staging = m_staging[current_frame];
+        if (!staging || staging->size() < dirty_count * object_size)
+        {
+            // Grows to the largest update seen, most frames only touch a few objects.
+            staging = sdvk::Buffer::Builder()
+                .with_size(dirty_count * object_size)
+                .with_name(std::format("Scene: GPU Scene Staging {}", current_frame))
+                .create_staging(m_context);
+        }
+
+        // Dirty objects are packed back to back, each range is copied as one region to its place in the scene buffer.
+        const auto& models = store.models();
+        auto* staged = static_cast<GpuObject*>(staging->mapped());
+        std::vector<vk::BufferCopy> regions;
+        regions.reserve(m_dirty.size());
+        uint32_t cursor = 0;
+        for (const auto& [begin, end] : m_dirty)
+        {
+            if (begin == end)
+            {
+                continue;
+            }
+
+            for (uint32_t i = begin; i < end; i++)
+            {
+                staged[cursor + i - begin] = pack_object(objects[i], models[i], store.mesh_index(i), deformer, i);
+            }
+            regions.emplace_back(cursor * object_size, begin * object_size, (end - begin) * object_size);
+            cursor += end - begin;
+        }
+        m_dirty.clear();
+
+        auto memory_barrier = [&](vk::PipelineStageFlags2 src_stage, vk::AccessFlags2 src_access,
+                                  vk::PipelineStageFlags2 dst_stage, vk::AccessFlags2 dst_access) {
+            vk::MemoryBarrier2 barrier;
+            barrier.setSrcStageMask(src_stage);
+            barrier.setSrcAccessMask(src_access);
+            barrier.setDstStageMask(dst_stage);
+            barrier.setDstAccessMask(dst_access);
+
+            vk::DependencyInfo dependency_info;
+            dependency_info.setMemoryBarrierCount(1);
+            dependency_info.setPMemoryBarriers(&barrier);
+            command_buffer.pipelineBarrier2(&dependency_info);
+        };
+
+        // Raster, mesh shader, compute and ray tracing passes of previous frames may still read the buffer.
+        memory_barrier(vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eShaderStorageRead,
+                       vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite);
+
+        command_buffer.copyBuffer(staging->buffer(), m_buffer->buffer(), regions);
+
+        memory_barrier(vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite,
+                       vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eShaderStorageRead);
+
+        m_uploaded_bytes = dirty_count * object_size;
+    }
+
+    vk::DeviceAddress GpuScene::address() const
+    {
+        return m_buffer->address();
+    }
+
+    GpuObject GpuScene::pack_object(const Object& object, const glm::mat4& model, const uint32_t mesh_index)
+    {
+        GpuObject result;
+        result.model = model;
+        result.color = object.color;
+        result.mesh_index = mesh_index;
+        if (object.mesh)
+        {
+            result.vertex_buffer = object.mesh->vertex_address();
+            result.index_buffer = object.mesh->index_address();
+            result.meshlet_buffer = object.mesh->meshlet_buffer().address();
+            result.meshlet_count = static_cast<uint32_t>(object.mesh->meshlet_data().size());
+            result.previous_vertex_buffer = result.vertex_buffer;
+            result.first_vertex = object.mesh->first_vertex();
+        }
+        return result;
+    }
+
+    GpuObject GpuScene::pack_object(const Object& object, const glm::mat4& model, const uint32_t mesh_index,
+                                    const MeshDeformer& deformer, const uint32_t object_index)
+    {
+        GpuObject result = pack_object(object, model, mesh_index);
+        if (const auto* instance = deformer.find(object_index))
+        {
+            result.vertex_buffer = deformer.vertex_address(*instance);
+            result.previous_vertex_buffer = deformer.previous_vertex_address(*instance);
+            result.deformation = instance->deformation.max_displacement();
+        }
+        return result;
+    }
+
+    void GpuScene::merge_ranges(std::vector<std::pair<uint32_t, uint32_t>>& ranges)
+    {
+        if (ranges.size() < 2)
+        {
+            return;
+        }
+
+        std::sort(ranges.begin(), ranges.end());
+
+        size_t last = 0;
+        for (size_t i = 1; i < ranges.size(); i++)
+        {
+            if (ranges[i].first <= ranges[last].second)
+            {
+                ranges[last].second = std::max(ranges[last].second, ranges[i].second);
+            }
+            else
+            {
+                ranges[++last] = ranges[i];
+            }
+        }
+        ranges.resize(last + 1);
+    }
+}
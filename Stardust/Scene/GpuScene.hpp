@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+#include <Scene/Object.hpp>
+#include <Scene/SceneStore.hpp>
+
+namespace sdvk
+{
+    class Buffer;
+    class CommandBuffers;
+    class Context;
+}
+
+namespace sd
+{
+    class MeshDeformer;
+
+    // Scalar block layout, must match include/gpu_scene.glsl
+    struct GpuObject
+    {
+        glm::mat4 model { 1.0f };
+        glm::vec4 color { 0.5f };
+        uint64_t  vertex_buffer { 0 };
+        uint64_t  index_buffer { 0 };
+        uint64_t  meshlet_buffer { 0 };
+        uint32_t  mesh_index { SceneStore::s_no_mesh };
+        uint32_t  meshlet_count { 0 };
+        // Vertices of the previous frame, differ from vertex_buffer for deformed objects.
+        uint64_t  previous_vertex_buffer { 0 };
+        // Of the mesh in its shared vertex buffer, deformed vertices are indexed with gl_VertexIndex minus this.
+        uint32_t  first_vertex { 0 };
+        // Largest distance a vertex is moved by the deformation, 0 for objects that draw the vertices of their mesh.
+        float     deformation { 0.0f };
+    };
+
+    /**
+     * Per-object data of the scene in one device local buffer, raster, mesh shader and ray tracing passes read it by object index.
+     * Changes are tracked as dirty ranges of objects, upload() packs only those into a staging buffer and copies one region per range,
+     * so the bytes uploaded per frame scale with the number of changed objects instead of the size of the scene.
+     */
+    class GpuScene
+    {
+    public:
+        GpuScene(const std::vector<Object>& objects, const SceneStore& store, const MeshDeformer& deformer,
+                 const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context);
+
+        ~GpuScene();
+
+        GpuScene(const GpuScene&) = delete;
+        GpuScene& operator=(const GpuScene&) = delete;
+
+        // Objects [begin, end).
+        void mark_dirty(uint32_t begin, uint32_t end);
+
+        // Objects in ascending order, e.g. SceneStore::changed().
+        void mark_dirty(const std::vector<uint32_t>& objects);
+
+        // After data of every object changed, e.g. mesh buffers moved.
+        void mark_all_dirty() { mark_dirty(0, m_object_count); }
+
+        // Records the copies of the dirty objects, does nothing if none are dirty.
+        void upload(const std::vector<Object>& objects, const SceneStore& store, const MeshDeformer& deformer,
+                    uint32_t current_frame, const vk::CommandBuffer& command_buffer);
+
+        // Stays the same buffer for the lifetime of the scene, descriptor sets may reference it.
+        const std::shared_ptr<sdvk::Buffer>& buffer() const { return m_buffer; }
+
+        vk::DeviceAddress address() const;
+
+        uint32_t object_count() const { return m_object_count; }
+
+        // Bytes copied by the last upload().
+        vk::DeviceSize uploaded_bytes() const { return m_uploaded_bytes; }
+
+        static GpuObject pack_object(const Object& object, const glm::mat4& model, uint32_t mesh_index);
+
+        // Same as above, deformed objects get the vertices written by the deformer.
+        static GpuObject pack_object(const Object& object, const glm::mat4& model, uint32_t mesh_index,
+                                     const MeshDeformer& deformer, uint32_t object_index);
+
+        // Sorts the ranges and merges the overlapping and adjacent ones.
+        static void merge_ranges(std::vector<std::pair<uint32_t, uint32_t>>& ranges);
+
+    private:
+        std::shared_ptr<sdvk::Buffer>              m_buffer;
+        std::vector<std::unique_ptr<sdvk::Buffer>> m_staging;
+        std::vector<std::pair<uint32_t, uint32_t>> m_dirty;
+        uint32_t                                   m_object_count { 0 };
+        vk::DeviceSize                             m_uploaded_bytes { 0 };
+
+        const sdvk::Context& m_context;
+    };
+}
@@ -0,0 +1,193 @@
+#include "MeshDeformer.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <Vulkan/Buffer.hpp>
+#include <Vulkan/Context.hpp>
+#include <Vulkan/Raytracing/Blas.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+#include <Vulkan/Rendering/PipelineBuilder.hpp>
+
+namespace sd
+{
+    MeshDeformer::MeshDeformer(const std::vector<Object>& objects, const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context)
+    : m_context(context)
+    {
+        // Deformed objects keep their rest pose rather than failing the scene.
+        if (!m_context.memory_manager()->accepts_uploads())
+        {
+            std::cout << "[Warning] Device memory is over budget, mesh deformation is disabled" << std::endl;
+            return;
+        }
+
+        for (uint32_t i = 0; i < objects.size(); i++)
+        {
+            const auto& object = objects[i];
+            if (!object.mesh || !object.deformation.is_enabled())
+            {
+                continue;
+            }
+
+            DeformedInstance instance;
+            instance.object = i;
+            instance.mesh = object.mesh;
+            instance.deformation = object.deformation;
+
+            // Both start in the rest pose, the first update() deforms one of them and builds the BLAS from it.
+            const auto& vertices = object.mesh->geometry().vertices();
+            for (uint32_t j = 0; j < instance.vertices.size(); j++)
+            {
+                instance.vertices[j] = sdvk::Buffer::Builder()
+                    .with_name(std::format("[Deformer] {} - Vertices {}", object.name, j))
+                    .with_size(sizeof(VertexData) * vertices.size())
+                    .as_vertex_buffer()
+                    .create_with_data(vertices.data(), command_buffers, m_context);
+            }
+
+            if (m_context.is_raytracing_capable())
+            {
+                instance.blas = std::make_unique<sdvk::Blas>(object.mesh->geometry(), *instance.vertices[0], object.mesh->index_buffer(),
+                                                             0, object.mesh->first_index(), true,
+                                                             command_buffers, m_context, std::format("[Deformer] {} - BLAS", object.name));
+            }
+
+            m_objects.push_back(i);
+            m_instances.push_back(std::move(instance));
+        }
+
+        if (m_instances.empty())
+        {
+            return;
+        }
+
+        auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
+            .add_push_constant({ vk::ShaderStageFlagBits::eCompute, 0, sizeof(DeformPushConstant) })
+            .create_pipeline_layout()
+            .add_shader("rg_deform.comp.spv", vk::ShaderStageFlagBits::eCompute)
+            .with_name("Mesh Deformation")
+            .create_compute_pipeline();
+
+        m_pipeline = pipeline;
+        m_pipeline_layout = pipeline_layout;
+    }
+
+    MeshDeformer::~MeshDeformer()
+    {
+        m_context.destruction_queue()->destroy(m_pipeline, m_pipeline_layout);
+    }
+
+    void MeshDeformer::update(const float time, const vk::CommandBuffer& command_buffer)
+    {
+        m_statistics = { static_cast<uint32_t>(m_instances.size()), 0, 0 };
+        if (m_instances.empty())
+        {
+            return;
+        }
+
+        const float elapsed = m_has_time ? std::abs(time - m_time) : 0.0f;
+        m_time = time;
+        m_has_time = true;
+        m_current = 1 - m_current;
+
+        auto memory_barrier = [&](vk::PipelineStageFlags2 src_stage, vk::AccessFlags2 src_access,
+                                  vk::PipelineStageFlags2 dst_stage, vk::AccessFlags2 dst_access) {
+            vk::MemoryBarrier2 barrier;
+            barrier.setSrcStageMask(src_stage);
+            barrier.setSrcAccessMask(src_access);
+            barrier.setDstStageMask(dst_stage);
+            barrier.setDstAccessMask(dst_access);
+
+            vk::DependencyInfo dependency_info;
+            dependency_info.setMemoryBarrierCount(1);
+            dependency_info.setPMemoryBarriers(&barrier);
+            command_buffer.pipelineBarrier2(&dependency_info);
+        };
+
+        // The previous frame reads the buffers written now as its previous vertices, and may still trace the BLASes built below.
+        memory_barrier(vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eMemoryWrite,
+                       vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR,
+                       vk::AccessFlagBits2::eShaderStorageWrite | vk::AccessFlagBits2::eAccelerationStructureWriteKHR);
+
+        command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_pipeline);
+        for (const auto& instance : m_instances)
+        {
+            DeformPushConstant pc {};
+            pc.source = instance.mesh->vertex_address();
+            pc.target = instance.vertices[m_current]->address();
+            pc.vertex_count = instance.mesh->geometry().vertex_count();
+            pc.amplitude = instance.deformation.amplitude;
+            pc.frequency = instance.deformation.frequency;
+            pc.offset = instance.deformation.speed * time + instance.deformation.phase;
+
+            command_buffer.pushConstants(m_pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(DeformPushConstant), &pc);
+            command_buffer.dispatch((pc.vertex_count + s_group_size - 1) / s_group_size, 1, 1);
+        }
+
+        // Vertex, mesh and ray tracing shaders read the vertices, BLAS builds take them as input.
+        memory_barrier(vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageWrite,
+                       vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderRead);
+
+        if (!m_context.is_raytracing_capable())
+        {
+            return;
+        }
+
+        for (auto& instance : m_instances)
+        {
+            const Aabb& bounds = instance.mesh->bounds();
+            const glm::vec3 size = bounds.max - bounds.min;
+            const float extent = std::max({ size.x, size.y, size.z });
+
+            // A vertex cannot be further from where it was at the build than twice the amplitude.
+            instance.drift = std::min(instance.drift + instance.deformation.max_distance(elapsed), 2.0f * instance.deformation.max_displacement());
+
+            auto mode = vk::BuildAccelerationStructureModeKHR::eUpdate;
+            if (instance.needs_build || instance.drift > s_rebuild_threshold * extent)
+            {
+                mode = vk::BuildAccelerationStructureModeKHR::eBuild;
+                instance.drift = 0.0f;
+                instance.needs_build = false;
+                m_statistics.rebuilds++;
+            }
+            else
+            {
+                m_statistics.refits++;
+            }
+
+            instance.blas->record_build(instance.vertices[m_current]->address(), instance.mesh->index_address(), mode, command_buffer);
+        }
+
+        // The TLAS is built on top of them later in the frame.
+        memory_barrier(vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, vk::AccessFlagBits2::eAccelerationStructureWriteKHR,
+                       vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits2::eRayTracingShaderKHR
+                       | vk::PipelineStageFlagBits2::eFragmentShader | vk::PipelineStageFlagBits2::eComputeShader,
+                       vk::AccessFlagBits2::eAccelerationStructureReadKHR);
+    }
+
+    const DeformedInstance* MeshDeformer::find(const uint32_t object) const
+    {
+        const auto it = std::ranges::lower_bound(m_objects, object);
+        if (it == m_objects.end() || *it != object)
+        {
+            return nullptr;
+        }
+        return &m_instances[it - m_objects.begin()];
+    }
+
+    vk::DeviceAddress MeshDeformer::vertex_address(const DeformedInstance& instance) const
+    {
+        return instance.vertices[m_current]->address();
+    }
+
+    vk::DeviceAddress MeshDeformer::previous_vertex_address(const DeformedInstance& instance) const
+    {
+        // Before the first update() both hold the rest pose.
+        return instance.vertices[m_has_time ? 1 - m_current : m_current]->address();
+    }
+
+    vk::DeviceAddress MeshDeformer::blas_address(const DeformedInstance& instance) const
+    {
+        return instance.blas ? instance.blas->address() : 0;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <Scene/Object.hpp>
+
+namespace sdvk
+{
+    class Blas;
+    class Buffer;
+    class CommandBuffers;
+    class Context;
+    class Mesh;
+}
+
+namespace sd
+{
+    // Must match rg_deform.comp
+    struct DeformPushConstant
+    {
+        uint64_t source { 0 };
+        uint64_t target { 0 };
+        uint32_t vertex_count { 0 };
+        float    amplitude { 0.0f };
+        float    frequency { 0.0f };
+        float    offset { 0.0f };
+    };
+
+    // Vertices and BLAS of one deformed object.
+    struct DeformedInstance
+    {
+        uint32_t                    object { 0 };
+        std::shared_ptr<sdvk::Mesh> mesh;
+        Deformation                 deformation;
+        // Written in turns, one holds the vertices of the current frame and the other those of the previous one.
+        std::array<std::unique_ptr<sdvk::Buffer>, 2> vertices;
+        std::unique_ptr<sdvk::Blas> blas;
+        // Upper bound of the distance a vertex moved since the BLAS was built.
+        float                       drift { 0.0f };
+        bool                        needs_build { true };
+    };
+
+    struct DeformationStatistics
+    {
+        uint32_t deformed_objects { 0 };
+        uint32_t refits { 0 };
+        uint32_t rebuilds { 0 };
+    };
+
+    /**
+     * Deforms the vertices of objects with a Deformation in a compute pass every frame, each object writes them into buffers
+     * of its own while the mesh keeps the rest pose. The BLAS of a deformed object is refit in place, which keeps its hierarchy,
+     * and rebuilt once the vertices may have moved further than s_rebuild_threshold of the mesh size since the last build.
+     */
+    class MeshDeformer
+    {
+    public:
+        MeshDeformer(const std::vector<Object>& objects, const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context);
+
+        ~MeshDeformer();
+
+        MeshDeformer(const MeshDeformer&) = delete;
+        MeshDeformer& operator=(const MeshDeformer&) = delete;
+
+        // Records the deformation to the given time, then the BLAS refits and rebuilds. The deformed objects have to be uploaded to the GPU scene afterwards.
+        void update(float time, const vk::CommandBuffer& command_buffer);
+
+        bool empty() const { return m_instances.empty(); }
+
+        // Deformed objects in ascending order.
+        const std::vector<uint32_t>& objects() const { return m_objects; }
+
+        // Null for objects without a deformation.
+        const DeformedInstance* find(uint32_t object) const;
+
+        vk::DeviceAddress vertex_address(const DeformedInstance& instance) const;
+
+        vk::DeviceAddress previous_vertex_address(const DeformedInstance& instance) const;
+
+        // 0 without ray tracing.
+        vk::DeviceAddress blas_address(const DeformedInstance& instance) const;
+
+        const std::vector<DeformedInstance>& instances() const { return m_instances; }
+
+        // Of the last update().
+        const DeformationStatistics& statistics() const { return m_statistics; }
+
+        // Fraction of the largest extent of the mesh bounds.
+        static constexpr float s_rebuild_threshold = 0.1f;
+
+    private:
+        std::vector<DeformedInstance> m_instances;
+        std::vector<uint32_t>         m_objects;
+        uint32_t                      m_current { 0 };
+        float                         m_time { 0.0f };
+        bool                          m_has_time { false };
+        DeformationStatistics         m_statistics;
+
+        vk::Pipeline       m_pipeline;
+        vk::PipelineLayout m_pipeline_layout;
+
+        const sdvk::Context& m_context;
+
+        static constexpr uint32_t s_group_size = 64;
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
 #include "Transform.hpp"
@@ -8,8 +10,28 @@
 
 namespace sd
 {
+    // Wave along the object space Y axis, evaluated on the GPU every frame by the MeshDeformer.
+    struct Deformation
+    {
+        // 0 keeps the mesh static.
+        float amplitude { 0.0f };
+        // Radians per object space unit along X and Z.
+        float frequency { 1.0f };
+        // Radians per second.
+        float speed { 1.0f };
+        float phase { 0.0f };
+
+        bool is_enabled() const { return amplitude != 0.0f && frequency != 0.0f; }
+
+        float max_displacement() const { return std::abs(amplitude); }
+
+        // Upper bound of the distance a vertex moves in the given time.
+        float max_distance(const float seconds) const { return std::abs(amplitude * speed) * seconds; }
+    };
+
     struct Object
     {
+        // Relative to the parent, if there is one.
         Transform transform;
         std::shared_ptr<sdvk::Mesh> mesh;
         glm::vec4 color { 0.5f, 0.5f, 0.5f, 1.0f };
@@ -18,6 +40,12 @@ namespace sd
         uint32_t rt_hit_group { 0 };
         uint32_t rt_mask { 0xff };
 
+        // Deformed objects get vertex buffers and a BLAS of their own, the mesh keeps the rest pose.
+        Deformation deformation;
+
+        // Index of the parent object in the scene, parents have to come before their children.
+        uint32_t parent { std::numeric_limits<uint32_t>::max() };
+
         struct PushConstantData
         {
             glm::mat4 model = glm::mat4(1.0f);
@@ -0,0 +1,100 @@
+#include "RenderList.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace sd
+{
+    void RenderList::build(const SceneStore& store, const std::vector<uint32_t>& visible, const glm::vec3& eye)
+    {
+        const auto& models = store.models();
+
+        m_keys.resize(visible.size());
+        m_objects.resize(visible.size());
+        for (size_t i = 0; i < visible.size(); i++)
+        {
+            const uint32_t object = visible[i];
+            const glm::vec3 offset = glm::vec3(models[object][3]) - eye;
+            m_keys[i] = make_key(0, store.mesh_index(object), 0, glm::dot(offset, offset));
+            m_objects[i] = object;
+        }
+
+        radix_sort(m_keys, m_objects, m_key_scratch, m_object_scratch);
+
+        m_batches.clear();
+        for (uint32_t i = 0; i < m_objects.size(); i++)
+        {
+            const uint32_t object = m_objects[i];
+            const uint32_t mesh_index = store.mesh_index(object);
+
+            // Mesh indices wider than s_mesh_bits alias in the key, comparing the full index keeps their draws apart.
+            const uint64_t state = m_keys[i] >> s_depth_bits;
+            if (i == 0 || state != (m_keys[i - 1] >> s_depth_bits) || mesh_index != m_batches.back().mesh_index)
+            {
+                m_batches.push_back({ mesh_index, i, 0 });
+            }
+            m_batches.back().instance_count++;
+        }
+    }
+
+    uint64_t RenderList::make_key(const uint32_t pipeline, const uint32_t mesh, const uint32_t material, const float depth)
+    {
+        constexpr uint64_t depth_mask = (1ull << s_depth_bits) - 1;
+        constexpr uint64_t material_mask = (1ull << s_material_bits) - 1;
+        constexpr uint64_t mesh_mask = (1ull << s_mesh_bits) - 1;
+        constexpr uint64_t pipeline_mask = (1ull << s_pipeline_bits) - 1;
+
+        const uint64_t depth_bits = std::bit_cast<uint32_t>(std::max(depth, 0.0f)) >> (32 - s_depth_bits);
+
+        return ((pipeline & pipeline_mask) << (s_mesh_bits + s_material_bits + s_depth_bits))
+             | ((mesh & mesh_mask) << (s_material_bits + s_depth_bits))
+             | ((material & material_mask) << s_depth_bits)
+             | (depth_bits & depth_mask);
+    }
+
+    void RenderList::radix_sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values,
+                                std::vector<uint64_t>& key_scratch, std::vector<uint32_t>& value_scratch)
+    {
+        const size_t count = keys.size();
+        key_scratch.resize(count);
+        value_scratch.resize(count);
+
+        // Histograms of all eight bytes in one pass.
+        std::array<std::array<uint32_t, 256>, 8> histograms {};
+        for (const uint64_t key : keys)
+        {
+            for (uint32_t byte = 0; byte < 8; byte++)
+            {
+                histograms[byte][(key >> (byte * 8)) & 0xff]++;
+            }
+        }
+
+        for (uint32_t byte = 0; byte < 8; byte++)
+        {
+            auto& histogram = histograms[byte];
+            if (histogram[(keys.empty() ? 0 : keys[0] >> (byte * 8)) & 0xff] == count)
+            {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                const uint32_t bucket_count = bucket;
+                bucket = offset;
+                offset += bucket_count;
+            }
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint32_t destination = histogram[(keys[i] >> (byte * 8)) & 0xff]++;
+                key_scratch[destination] = keys[i];
+                value_scratch[destination] = values[i];
+            }
+
+            keys.swap(key_scratch);
+            values.swap(value_scratch);
+        }
+    }
+}
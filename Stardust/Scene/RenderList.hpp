@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Scene/SceneStore.hpp>
+
+namespace sd
+{
+    // One instanced draw of a mesh, its instances are [first_instance, first_instance + instance_count) of the list.
+    struct DrawBatch
+    {
+        uint32_t mesh_index { 0 };
+        uint32_t first_instance { 0 };
+        uint32_t instance_count { 0 };
+    };
+
+    /**
+     * Visible objects sorted by a 64-bit key of pipeline, mesh, material and view depth, from the most significant bits down.
+     * Runs with the same pipeline, mesh and material collapse into one instanced draw, ordered front to back within.
+     * Meshes whose indices only differ above s_mesh_bits share a sort key and still get separate, if interleaved, draws.
+     */
+    class RenderList
+    {
+    public:
+        void build(const SceneStore& store, const std::vector<uint32_t>& visible, const glm::vec3& eye);
+
+        const std::vector<DrawBatch>& batches() const { return m_batches; }
+
+        // Object index of each instance, the vertex shader looks up the object data in the GPU scene with it.
+        const std::vector<uint32_t>& objects() const { return m_objects; }
+
+        /**
+         * Scenes have a single raster pipeline and no materials yet, both are passed as 0 by build().
+         * The depth is quantized from the bits of a positive float, which sort like unsigned integers.
+         */
+        static uint64_t make_key(uint32_t pipeline, uint32_t mesh, uint32_t material, float depth);
+
+        // LSD radix sort over the key bytes, values are permuted along. Bytes that are equal in all keys are skipped.
+        static void radix_sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values,
+                               std::vector<uint64_t>& key_scratch, std::vector<uint32_t>& value_scratch);
+
+        static constexpr uint32_t s_depth_bits    = 24;
+        static constexpr uint32_t s_material_bits = 16;
+        static constexpr uint32_t s_mesh_bits     = 16;
+        static constexpr uint32_t s_pipeline_bits = 8;
+
+    private:
+        std::vector<uint64_t>  m_keys;
+        std::vector<uint32_t>  m_objects;
+        std::vector<uint64_t>  m_key_scratch;
+        std::vector<uint32_t>  m_object_scratch;
+        std::vector<DrawBatch> m_batches;
+    };
+}
@@ -1,63 +1,262 @@
 #include "Scene.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <format>
+#include <numbers>
+#include <random>
+#include <set>
+#include <stdexcept>
 #include <Application/Application.hpp>
+#include <Nebula/JobSystem.hpp>
 #include <Resources/Primitives/Cube.hpp>
 #include <Resources/Primitives/Sphere.hpp>
 #include <Scene/Transform.hpp>
 #include <Vulkan/Context.hpp>
 #include <Vulkan/Raytracing/Tlas.hpp>
 #include <Vulkan/Rendering/Mesh.hpp>
-#include <Window/Window.hpp>
+#include <Vulkan/Rendering/MeshRegistry.hpp>
 
 namespace sd
 {
+    namespace
+    {
+        // Both ascending, objects stays ascending without duplicates.
+        void merge_objects(std::vector<uint32_t>& objects, const std::vector<uint32_t>& other)
+        {
+            if (other.empty())
+            {
+                return;
+            }
+            const auto middle = static_cast<std::ptrdiff_t>(objects.size());
+            objects.insert(objects.end(), other.begin(), other.end());
+            std::inplace_merge(objects.begin(), objects.begin() + middle, objects.end());
+            objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+        }
+    }
+
     Scene::Scene(const sdvk::CommandBuffers& command_buffers,
-                 const sdvk::Context&        context)
-    : m_command_buffers(command_buffers), m_context(context)
+                 const sdvk::Context&        context,
+                 const uint32_t              seed,
+                 const uint32_t              object_count)
+    : m_mesh_registry(std::make_unique<sdvk::MeshRegistry>(command_buffers, context))
+    , m_seed(seed), m_object_count(object_count), m_command_buffers(command_buffers), m_context(context)
     {
         add_defaults();
         default_init();
-        create_object_description_buffer(command_buffers);
+        create_scene_store();
+        create_deformer();
+        create_gpu_scene();
         create_acceleration_structure();
     }
 
     Scene::Scene(const std::function<void()>& init,
                  const sdvk::CommandBuffers&  command_buffers,
                  const sdvk::Context&         context)
-    : m_command_buffers(command_buffers), m_context(context)
+    : m_mesh_registry(std::make_unique<sdvk::MeshRegistry>(command_buffers, context))
+    , m_command_buffers(command_buffers), m_context(context)
     {
         add_defaults();
         init();
-        create_object_description_buffer(command_buffers);
+        create_scene_store();
+        create_deformer();
+        create_gpu_scene();
         create_acceleration_structure();
     }
 
+    Scene::Scene(const SceneGeneratorOptions& generator_options,
+                 const sdvk::CommandBuffers&  command_buffers,
+                 const sdvk::Context&         context,
+                 const uint32_t               seed,
+                 const uint32_t               object_count)
+    : m_mesh_registry(std::make_unique<sdvk::MeshRegistry>(command_buffers, context))
+    , m_seed(seed), m_object_count(object_count), m_command_buffers(command_buffers), m_context(context)
+    {
+        add_defaults();
+
+        auto generated = SceneGenerator(generator_options, seed, object_count).generate(*m_mesh_registry);
+        m_meshes.merge(generated.meshes);
+        m_objects = std::move(generated.objects);
+        m_motions = std::move(generated.motions);
+
+        create_scene_store();
+        if (!generated.sources.empty())
+        {
+            create_streamer(generator_options.streaming, std::move(generated.sources), std::move(generated.object_sources));
+        }
+        create_deformer();
+        create_gpu_scene();
+        create_acceleration_structure();
+    }
+
+    void Scene::update(const float time, const uint32_t current_frame, const vk::CommandBuffer& command_buffer)
+    {
+        if (m_device_addresses_dirty)
+        {
+            // Every object references mesh buffers and a BLAS that may have moved, all of them are uploaded again.
+            m_store.invalidate();
+            m_device_addresses_dirty = false;
+        }
+
+        for (const auto& motion : m_motions)
+        {
+            glm::vec3 position = motion.origin;
+            position.y += motion.amplitude * std::sin(2.0f * std::numbers::pi_v<float> * motion.frequency * time + motion.phase);
+            m_store.set_position(motion.object, position);
+        }
+        m_store.update_transforms();
+
+        // Objects of cells that became resident get their mesh, those of evicted cells lose it.
+        const bool streamed = m_streamer && m_streamer->update(m_camera->eye());
+        if (streamed)
+        {
+            apply_streamed_meshes();
+        }
+
+        // Objects that moved or changed their mesh get new bounds, GPU scene entries and TLAS instances.
+        // Deformed objects get new vertices and BLASes every frame, they are uploaded and their instances rebuilt as if they moved.
+        m_changed.assign(m_store.changed().begin(), m_store.changed().end());
+        merge_objects(m_changed, m_deformer->objects());
+        if (streamed)
+        {
+            merge_objects(m_changed, m_streamer->changed());
+        }
+
+        // The BVH is refit on the job system while the uploads are recorded here, both only read the store.
+        auto& jobs = Nebula::JobSystem::instance();
+        Nebula::JobCounter bvh_refit;
+        Nebula::Job refit_job { [](void* scene) { static_cast<Scene*>(scene)->refit_bvh(); }, this, &bvh_refit };
+        if (!m_store.changed().empty() || (streamed && !m_streamer->changed().empty()))
+        {
+            jobs.submit(refit_job);
+        }
+
+        m_deformer->update(time, command_buffer);
+
+        m_gpu_scene->mark_dirty(m_changed);
+        m_gpu_scene->upload(m_objects, m_store, *m_deformer, current_frame, command_buffer);
+
+        if (m_acceleration_structure)
+        {
+            // Also after defragmentation moved one of them.
+            for (const auto& instance : m_deformer->instances())
+            {
+                m_acceleration_structure->set_instance_blas(instance.object, m_deformer->blas_address(instance));
+            }
+            m_acceleration_structure->update(m_objects, m_store.models3x4(), m_changed, current_frame, command_buffer);
+        }
+
+        jobs.wait(bvh_refit);
+        cull();
+    }
+
+    void Scene::refit_bvh()
+    {
+        for (const uint32_t object : m_changed)
+        {
+            m_bvh.set_bounds(object, world_bounds(object));
+        }
+        m_bvh.refit();
+    }
+
+    Aabb Scene::world_bounds(const uint32_t object) const
+    {
+        const uint32_t mesh_index = m_store.mesh_index(object);
+        if (mesh_index == SceneStore::s_no_mesh)
+        {
+            return {};
+        }
+        // Deformed vertices stay within this distance of the bounds of the rest pose.
+        Aabb bounds = m_mesh_table[mesh_index]->bounds();
+        const Deformation& deformation = m_objects[object].deformation;
+        if (deformation.is_enabled())
+        {
+            bounds.min -= deformation.max_displacement();
+            bounds.max += deformation.max_displacement();
+        }
+        return bounds.transform(m_store.models()[object]);
+    }
+
+    void Scene::cull()
+    {
+        m_visible_objects.clear();
+        m_cull_statistics = m_bvh.cull(Frustum(m_camera->projection() * m_camera->view()), m_visible_objects);
+        m_render_list.build(m_store, m_visible_objects, m_camera->eye());
+    }
+
+    uint32_t Scene::evict_cold_meshes()
+    {
+        const Frustum frustum(m_camera->projection() * m_camera->view());
+
+        std::set<const sdvk::Mesh*> visible_meshes;
+        for (uint32_t i = 0; i < m_store.size(); i++)
+        {
+            const uint32_t mesh_index = m_store.mesh_index(i);
+            if (mesh_index == SceneStore::s_no_mesh || visible_meshes.contains(m_mesh_table[mesh_index].get()))
+            {
+                continue;
+            }
+
+            if (frustum.is_visible(m_bvh.bounds(i)))
+            {
+                visible_meshes.insert(m_mesh_table[mesh_index].get());
+            }
+        }
+
+        uint32_t evicted = 0;
+        for (const auto& [name, mesh] : m_meshes)
+        {
+            if (!mesh->is_evicted() && !visible_meshes.contains(mesh.get()))
+            {
+                mesh->evict(m_context);
+                evicted++;
+            }
+        }
+
+        if (evicted > 0)
+        {
+            m_gpu_scene->mark_all_dirty();
+        }
+        return evicted;
+    }
+
+    uint32_t Scene::make_meshes_resident()
+    {
+        uint32_t restored = 0;
+        for (const auto& [name, mesh] : m_meshes)
+        {
+            if (mesh->is_evicted())
+            {
+                mesh->make_resident(m_command_buffers, m_context);
+                restored++;
+            }
+        }
+
+        if (restored > 0)
+        {
+            m_gpu_scene->mark_all_dirty();
+        }
+        return restored;
+    }
+
     void Scene::add_defaults()
     {
+        // Checked once up front, the default and generated meshes are all created right after.
+        if (!m_context.memory_manager()->accepts_uploads())
+        {
+            throw std::runtime_error("[Error] Scene meshes cannot be uploaded, device memory is over budget");
+        }
+
         auto res = Application::s_extent;
         m_camera = std::make_shared<Camera>(
             glm::ivec2 { res.width, res.height },
             glm::vec3 { 5.f, 5.f, 5.f }
         );
 
-        m_meshes["cube"] = std::make_shared<sdvk::Mesh>(
-            new primitives::Cube(),
-            m_command_buffers,
-            m_context,
-            "cube",
-            3,
-            3
-        );
+        m_meshes["cube"] = m_mesh_registry->create(new primitives::Cube(), "cube", 3, 3);
 
-        m_meshes["sphere"] = std::make_shared<sdvk::Mesh>(
-            new primitives::Sphere(1.0f, 250),
-            m_command_buffers,
-            m_context,
-            "sphere",
-            64,
-            126
-        );
+        m_meshes["sphere"] = m_mesh_registry->create(new primitives::Sphere(1.0f, 250), "sphere", 64, 126);
     }
 
     void Scene::create_acceleration_structure()
@@ -65,8 +264,49 @@ namespace sd
         if (m_context.is_raytracing_capable())
         {
             m_acceleration_structure = sdvk::Tlas::Builder()
-                .create(m_objects, m_command_buffers, m_context);
+                .with_name("Scene: TLAS")
+                .create(m_objects, m_store.models3x4(), m_command_buffers, m_context);
+        }
+    }
+
+    void Scene::create_scene_store()
+    {
+        std::set<uint32_t> dynamic_objects;
+        for (const auto& motion : m_motions)
+        {
+            dynamic_objects.insert(motion.object);
+        }
+
+        std::map<const sdvk::Mesh*, uint32_t> mesh_indices;
+        m_mesh_table.clear();
+        m_store.clear();
+        m_store.reserve(m_objects.size());
+        for (uint32_t i = 0; i < m_objects.size(); i++)
+        {
+            const auto& object = m_objects[i];
+
+            uint32_t mesh_index = SceneStore::s_no_mesh;
+            if (object.mesh)
+            {
+                auto [it, inserted] = mesh_indices.try_emplace(object.mesh.get(), static_cast<uint32_t>(m_mesh_table.size()));
+                if (inserted)
+                {
+                    m_mesh_table.push_back(object.mesh);
+                }
+                mesh_index = it->second;
+            }
+
+            m_store.add(object.transform, mesh_index, dynamic_objects.contains(i) ? ObjectFlags::eDynamic : ObjectFlags::eNone, object.parent);
+        }
+        m_store.update_transforms();
+
+        std::vector<Aabb> bounds(m_objects.size());
+        for (uint32_t i = 0; i < bounds.size(); i++)
+        {
+            bounds[i] = world_bounds(i);
         }
+        m_bvh.build(bounds);
+        cull();
     }
 
     void Scene::default_init()
@@ -78,7 +318,10 @@ namespace sd
             {{1, 0.1f, 0.1f, 1}, {1, 0.5f, 0, 1}}
         };
 
-        auto randf = [](float lo = 0.0f, float hi = 1.0f){ return lo + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(hi - lo))); };
+        // Raw engine output is specified by the standard, unlike the distributions, so layouts match across platforms.
+        std::mt19937 engine(m_seed);
+        auto randi = [&engine](){ return static_cast<int32_t>(engine() >> 1); };
+        auto randf = [&engine](float lo = 0.0f, float hi = 1.0f){ return lo + static_cast<float>(engine()) / static_cast<float>(std::mt19937::max()) * (hi - lo); };
 
          Object plane = {};
          plane.color = { .5f, .5f, .5f, 1.f };
@@ -106,66 +349,67 @@ namespace sd
 
          m_objects.push_back(bg2);
 
-         ObjDescription plane_desc;
-         plane_desc.vertex_buffer = plane.mesh->vertex_buffer().address();
-         plane_desc.index_buffer  = plane.mesh->index_buffer().address();
-         m_obj_descriptions.push_back(plane_desc);
-
-         ObjDescription bg_dsc1;
-         bg_dsc1.vertex_buffer = bg1.mesh->vertex_buffer().address();
-         bg_dsc1.index_buffer  = bg1.mesh->index_buffer().address();
-         m_obj_descriptions.push_back(bg_dsc1);
-
-         ObjDescription bg_dsc2;
-         bg_dsc2.vertex_buffer = bg2.mesh->vertex_buffer().address();
-         bg_dsc2.index_buffer  = bg2.mesh->index_buffer().address();
-         m_obj_descriptions.push_back(bg_dsc2);
-
-         for (uint32_t i = 0; i < 1024; i++)
+         for (uint32_t i = 0; i < m_object_count; i++)
          {
              Transform transform = {};
              transform.scale = glm::vec3(
-                     static_cast<float>(rand() % 4 + 1),
-                     static_cast<float>(rand() % 16 + 1),
-                     static_cast<float>(rand() % 5 + 1)
+                     static_cast<float>(randi() % 4 + 1),
+                     static_cast<float>(randi() % 16 + 1),
+                     static_cast<float>(randi() % 5 + 1)
                  );
              transform.position = glm::vec3(
-                     static_cast<float>(rand() % 192 - 96) + randf(),
+                     static_cast<float>(randi() % 192 - 96) + randf(),
                      randf(-0.05f, 0.0f),
-                     static_cast<float>(rand() % 192 - 96) + randf()
+                     static_cast<float>(randi() % 192 - 96) + randf()
                  );
 
              Object obj = {};
-             auto idx = std::rand() % color_pool.size();
-             obj.color = (rand() % 2 == 0) ? color_pool[idx].first : color_pool[idx].second;
+             auto idx = randi() % color_pool.size();
+             obj.color = (randi() % 2 == 0) ? color_pool[idx].first : color_pool[idx].second;
              obj.mesh = m_meshes["cube"];
              obj.name = std::format("Object {}", std::to_string(m_objects.size() + 1));
              obj.transform = transform;
              m_objects.push_back(obj);
-
-             ObjDescription obj_desc;
-             obj_desc.vertex_buffer = obj.mesh->vertex_buffer().address();
-             obj_desc.index_buffer  = obj.mesh->index_buffer().address();
-             m_obj_descriptions.push_back(obj_desc);
          }
     }
 
-    void Scene::key_handler(const Window& window)
+    void Scene::create_streamer(const SceneStreamingOptions& options, std::vector<MeshSource>&& sources, std::vector<uint32_t>&& object_sources)
     {
-        m_camera->register_keys(window.handle());
+        // No object references the slot of a source that is not resident, the cube keeps every slot a valid mesh.
+        m_streamed_mesh_base = static_cast<uint32_t>(m_mesh_table.size());
+        m_mesh_table.resize(m_mesh_table.size() + sources.size(), m_meshes["cube"]);
+
+        m_streamer = std::make_unique<SceneStreamer>(options, std::move(sources), std::move(object_sources),
+                                                     m_store, *m_mesh_registry, m_command_buffers, m_context);
+    }
+
+    void Scene::apply_streamed_meshes()
+    {
+        for (const uint32_t source : m_streamer->changed_sources())
+        {
+            const auto& mesh = m_streamer->source_mesh(source);
+            m_mesh_table[m_streamed_mesh_base + source] = mesh ? mesh : m_meshes["cube"];
+        }
+
+        for (const uint32_t object : m_streamer->changed())
+        {
+            m_objects[object].mesh = m_streamer->mesh(object);
+            m_store.set_mesh_index(object, m_objects[object].mesh ? m_streamed_mesh_base + m_streamer->source(object) : SceneStore::s_no_mesh);
+        }
+
+        if (!m_streamer->changed().empty())
+        {
+            m_mesh_assignment++;
+        }
     }
 
-    void Scene::mouse_handler(const Window& window)
+    void Scene::create_deformer()
     {
-        m_camera->register_mouse(window.handle());
+        m_deformer = std::make_unique<MeshDeformer>(m_objects, m_command_buffers, m_context);
     }
 
-    void Scene::create_object_description_buffer(const sdvk::CommandBuffers& command_buffers)
+    void Scene::create_gpu_scene()
     {
-        m_obj_desc_buffer = sdvk::Buffer::Builder()
-            .with_name("Scene: Object Description Buffer")
-            .with_size(sizeof(ObjDescription) * m_obj_descriptions.size())
-            .as_storage_buffer()
-            .create_with_data(m_obj_descriptions.data(), command_buffers, m_context);
+        m_gpu_scene = std::make_unique<GpuScene>(m_objects, m_store, *m_deformer, m_command_buffers, m_context);
     }
 }
\ No newline at end of file
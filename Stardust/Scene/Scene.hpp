@@ -7,8 +7,16 @@
 #include <vector>
 
 #include <Scene/Camera.hpp>
+#include <Scene/GpuScene.hpp>
 #include <Scene/Light.hpp>
+#include <Scene/MeshDeformer.hpp>
 #include <Scene/Object.hpp>
+#include <Scene/RenderList.hpp>
+#include <Scene/SceneBvh.hpp>
+#include <Scene/SceneGenerator.hpp>
+#include <Scene/SceneStore.hpp>
+#include <Scene/SceneStreamer.hpp>
+#include <Vulkan/Rendering/MeshRegistry.hpp>
 
 namespace sdvk
 {
@@ -23,19 +31,35 @@ namespace sd
     class Camera;
     class Window;
 
-    struct ObjDescription
-    {
-        uint64_t  vertex_buffer;
-        uint64_t  index_buffer;
-    };
-
     class Scene
     {
     public:
-        Scene(const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context);
+        Scene(const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context,
+              uint32_t seed = s_default_seed, uint32_t object_count = s_default_object_count);
 
         Scene(const std::function<void()>& init, const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context);
 
+        Scene(const SceneGeneratorOptions& generator_options, const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context,
+              uint32_t seed = s_default_seed, uint32_t object_count = s_default_object_count);
+
+        /**
+         * Moves the animated objects to their position at the given time, streams meshes in and out around the camera and records
+         * the GPU scene and TLAS updates for the objects that moved or changed their mesh. Afterwards the objects are culled against the camera frustum.
+         */
+        void update(float time, uint32_t current_frame, const vk::CommandBuffer& command_buffer);
+
+        /**
+         * Moves the vertex and index buffers of meshes without an object in the camera frustum to host memory.
+         * The device must be idle, returns the number of evicted meshes.
+         */
+        uint32_t evict_cold_meshes();
+
+        // Brings every evicted mesh back to device local memory, the device must be idle.
+        uint32_t make_meshes_resident();
+
+        // Mesh buffers or BLASes were moved by defragmentation, the next update() rewrites the GPU scene and the TLAS.
+        void invalidate_device_addresses() { m_device_addresses_dirty = true; }
+
         virtual void key_handler(const Window& window);
 
         virtual void mouse_handler(const Window& window);
@@ -45,34 +69,110 @@ namespace sd
 
         const std::shared_ptr<Camera>& camera() const { return m_camera; }
 
+        // Objects as they were created, current transforms and matrices are in store(). Streamed objects hold their mesh while it is resident.
         const std::vector<Object>& objects() const { return m_objects; }
 
+        const SceneStore& store() const { return m_store; }
+
+        // Transforms set here are picked up by the next update().
+        SceneStore& store() { return m_store; }
+
+        // Objects with bounds in the camera frustum as of the last update(), these are the ones raster passes draw.
+        const std::vector<uint32_t>& visible_objects() const { return m_visible_objects; }
+
+        const CullStatistics& cull_statistics() const { return m_cull_statistics; }
+
+        // Visible objects sorted and batched into instanced draws.
+        const RenderList& render_list() const { return m_render_list; }
+
+        // Meshes referenced by the mesh indices of the store. Slots of streamed meshes that are not resident hold a placeholder.
+        const std::vector<std::shared_ptr<sdvk::Mesh>>& mesh_table() const { return m_mesh_table; }
+
         const std::shared_ptr<sdvk::Tlas>& acceleration_structure() const { return m_acceleration_structure; }
 
-        const std::shared_ptr<sdvk::Buffer>& object_descriptions() const { return m_obj_desc_buffer; }
+        // Per-object data read by shaders with the object index.
+        const GpuScene& gpu_scene() const { return *m_gpu_scene; }
+
+        // Vertices and BLASes of the deformed objects.
+        const MeshDeformer& deformer() const { return *m_deformer; }
+
+        // Incremented whenever objects change their mesh index, e.g. when streamed meshes become resident.
+        uint64_t mesh_assignment() const { return m_mesh_assignment; }
+
+        // Null unless the scene was generated with streaming.
+        const SceneStreamer* streamer() const { return m_streamer.get(); }
+
+        // Deduplicates meshes by content and packs their geometry into shared buffers.
+        const sdvk::MeshRegistry& mesh_registry() const { return *m_mesh_registry; }
 
         const std::string& name() const { return m_name; }
 
+        uint32_t seed() const { return m_seed; }
+
+        const std::vector<ObjectMotion>& motions() const { return m_motions; }
+
+        static constexpr uint32_t s_default_seed = 1;
+
+        // Number of randomly placed cubes created by the default scene.
+        static constexpr uint32_t s_default_object_count = 1024;
+
     private:
         void add_defaults();
 
         void create_acceleration_structure();
 
-        void create_object_description_buffer(const sdvk::CommandBuffers& command_buffers);
+        // Fills the store from the objects, evaluates their matrices and builds the BVH over their bounds.
+        void create_scene_store();
+
+        Aabb world_bounds(uint32_t object) const;
+
+        // Bounds of the objects changed by the last transform update.
+        void refit_bvh();
+
+        void cull();
+
+        // After the store, streamed meshes get the mesh table slots following those of the objects.
+        void create_streamer(const SceneStreamingOptions& options, std::vector<MeshSource>&& sources, std::vector<uint32_t>&& object_sources);
+
+        // Assigns the meshes changed by the last streamer update to their objects and mesh table slots.
+        void apply_streamed_meshes();
+
+        // Before the GPU scene, which references the deformed vertices.
+        void create_deformer();
+
+        void create_gpu_scene();
 
         void default_init();
 
     private:
+        // Before the meshes, every mesh is created through it.
+        std::unique_ptr<sdvk::MeshRegistry> m_mesh_registry;
+
         std::shared_ptr<Camera>     m_camera;
         std::vector<Object>         m_objects;
         std::vector<Light>          m_lights;
-        std::vector<ObjDescription> m_obj_descriptions;
+        std::vector<ObjectMotion>   m_motions;
 
         std::map<std::string, std::shared_ptr<sdvk::Mesh>> m_meshes;
+        std::vector<std::shared_ptr<sdvk::Mesh>>           m_mesh_table;
+        SceneStore                                         m_store;
+        SceneBvh                                           m_bvh;
+        std::vector<uint32_t>                              m_visible_objects;
+        CullStatistics                                     m_cull_statistics;
+        RenderList                                         m_render_list;
         std::shared_ptr<sdvk::Tlas> m_acceleration_structure;
-        std::shared_ptr<sdvk::Buffer> m_obj_desc_buffer;
+        std::unique_ptr<MeshDeformer> m_deformer;
+        std::unique_ptr<SceneStreamer> m_streamer;
+        uint32_t                    m_streamed_mesh_base { 0 };
+        uint64_t                    m_mesh_assignment { 0 };
+        std::unique_ptr<GpuScene>   m_gpu_scene;
+        // Objects changed by the store, the streamer or deformed in the last update().
+        std::vector<uint32_t>       m_changed;
+        bool m_device_addresses_dirty { false };
 
         const std::string m_name = "Unnamed Scene";
+        const uint32_t m_seed = s_default_seed;
+        const uint32_t m_object_count = s_default_object_count;
         const sdvk::CommandBuffers& m_command_buffers;
         const sdvk::Context& m_context;
     };
@@ -0,0 +1,290 @@
+#include "SceneBvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <Nebula/JobSystem.hpp>
+
+namespace sd
+{
+    SceneBvh::SceneBvh() = default;
+
+    SceneBvh::~SceneBvh() = default;
+
+    void SceneBvh::build(const std::vector<Aabb>& bounds)
+    {
+        m_object_bounds = bounds;
+        _collect_items();
+        _build();
+    }
+
+    void SceneBvh::set_bounds(const uint32_t object, const Aabb& bounds)
+    {
+        m_object_bounds[object] = bounds;
+
+        // Objects outside the tree have no leaf, the rebuild places them.
+        if ((m_object_leaf[object] == s_none) != bounds.is_empty())
+        {
+            m_items_changed = true;
+        }
+
+        for (uint32_t node = m_object_leaf[object]; node != s_none && !m_node_dirty[node]; node = m_nodes[node].parent)
+        {
+            m_node_dirty[node] = 1;
+            m_dirty_nodes.push_back(node);
+        }
+    }
+
+    void SceneBvh::refit()
+    {
+        if (m_items_changed)
+        {
+            _collect_items();
+            _build();
+            return;
+        }
+
+        if (m_dirty_nodes.empty())
+        {
+            return;
+        }
+
+        // Children are stored after their parents, so descending order refits bottom-up.
+        std::ranges::sort(m_dirty_nodes, std::greater());
+        for (const uint32_t node : m_dirty_nodes)
+        {
+            _recompute(node);
+            m_node_dirty[node] = 0;
+        }
+        m_dirty_nodes.clear();
+
+        if (m_area > m_built_area * s_rebuild_ratio)
+        {
+            _build();
+        }
+    }
+
+    CullStatistics SceneBvh::cull(const Frustum& frustum, std::vector<uint32_t>& visible) const
+    {
+        CullStatistics statistics;
+        if (m_nodes.empty())
+        {
+            return statistics;
+        }
+
+        const size_t first_visible = visible.size();
+        if (m_items.size() < s_parallel_threshold)
+        {
+            _cull_subtree(frustum, 0, false, visible, statistics);
+        }
+        else
+        {
+            auto& jobs = Nebula::JobSystem::instance();
+
+            // The top of the tree is split breadth first into a few subtrees per thread.
+            struct Task
+            {
+                uint32_t node;
+                bool     inside;
+            };
+            const size_t target_tasks = 4 * jobs.thread_count();
+
+            std::vector<Task> tasks;
+            std::vector<Task> frontier = {{ 0, false }};
+            while (!frontier.empty() && tasks.size() + frontier.size() < target_tasks)
+            {
+                std::vector<Task> next;
+                for (const auto& task : frontier)
+                {
+                    const Node& node = m_nodes[task.node];
+                    statistics.tested_nodes++;
+                    const FrustumTest test = frustum.classify(node.bounds);
+                    if (test == FrustumTest::eOutside)
+                    {
+                        continue;
+                    }
+
+                    if (test == FrustumTest::eInside || node.left == 0)
+                    {
+                        tasks.push_back({ task.node, test == FrustumTest::eInside });
+                    }
+                    else
+                    {
+                        next.push_back({ node.left, false });
+                        next.push_back({ node.left + 1, false });
+                    }
+                }
+                frontier = std::move(next);
+            }
+            tasks.insert(tasks.end(), frontier.begin(), frontier.end());
+
+            m_task_results.resize(std::max(m_task_results.size(), tasks.size()));
+            std::vector<CullStatistics> task_statistics(tasks.size());
+            jobs.parallel_for(static_cast<uint32_t>(tasks.size()), 1, [&](const uint32_t begin, const uint32_t end) {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    m_task_results[i].clear();
+                    _cull_subtree(frustum, tasks[i].node, tasks[i].inside, m_task_results[i], task_statistics[i]);
+                }
+            });
+
+            for (size_t i = 0; i < tasks.size(); i++)
+            {
+                visible.insert(visible.end(), m_task_results[i].begin(), m_task_results[i].end());
+                statistics.tested_nodes += task_statistics[i].tested_nodes;
+                statistics.tested_objects += task_statistics[i].tested_objects;
+            }
+        }
+
+        statistics.visible = static_cast<uint32_t>(visible.size() - first_visible);
+        statistics.culled = static_cast<uint32_t>(m_items.size()) - statistics.visible;
+        return statistics;
+    }
+
+    void SceneBvh::_collect_items()
+    {
+        m_object_leaf.assign(m_object_bounds.size(), s_none);
+        m_items_changed = false;
+
+        m_items.clear();
+        for (uint32_t i = 0; i < m_object_bounds.size(); i++)
+        {
+            if (!m_object_bounds[i].is_empty())
+            {
+                m_items.push_back(i);
+            }
+        }
+    }
+
+    void SceneBvh::_build()
+    {
+        m_nodes.clear();
+        m_dirty_nodes.clear();
+        m_area = 0.0f;
+
+        if (!m_items.empty())
+        {
+            m_nodes.reserve(2 * (m_items.size() / s_max_leaf_size) + 1);
+            m_nodes.push_back({ {}, 0, static_cast<uint32_t>(m_items.size()), 0, s_none });
+
+            // Median split on the longest axis of the centroids keeps the tree balanced.
+            std::vector<uint32_t> stack = { 0 };
+            while (!stack.empty())
+            {
+                const uint32_t node_index = stack.back();
+                stack.pop_back();
+
+                const uint32_t first = m_nodes[node_index].first;
+                const uint32_t count = m_nodes[node_index].count;
+                const auto begin = m_items.begin() + first;
+                const auto end = begin + count;
+
+                Aabb bounds, centroids;
+                for (auto it = begin; it != end; ++it)
+                {
+                    bounds.extend(m_object_bounds[*it]);
+                    centroids.extend(m_object_bounds[*it].center());
+                }
+                m_nodes[node_index].bounds = bounds;
+                m_area += bounds.surface_area();
+
+                if (count <= s_max_leaf_size)
+                {
+                    for (auto it = begin; it != end; ++it)
+                    {
+                        m_object_leaf[*it] = node_index;
+                    }
+                    continue;
+                }
+
+                const glm::vec3 size = centroids.max - centroids.min;
+                const int32_t axis = (size.x > size.y && size.x > size.z) ? 0 : (size.y > size.z ? 1 : 2);
+                const uint32_t half = count / 2;
+                std::nth_element(begin, begin + half, end, [&](const uint32_t a, const uint32_t b) {
+                    return m_object_bounds[a].center()[axis] < m_object_bounds[b].center()[axis];
+                });
+
+                const auto left = static_cast<uint32_t>(m_nodes.size());
+                m_nodes[node_index].left = left;
+                m_nodes.push_back({ {}, first, half, 0, node_index });
+                m_nodes.push_back({ {}, first + half, count - half, 0, node_index });
+                stack.push_back(left + 1);
+                stack.push_back(left);
+            }
+        }
+
+        m_node_dirty.assign(m_nodes.size(), 0);
+        m_built_area = m_area;
+    }
+
+    void SceneBvh::_recompute(const uint32_t node_index)
+    {
+        Node& node = m_nodes[node_index];
+        m_area -= node.bounds.surface_area();
+
+        Aabb bounds;
+        if (node.left == 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; i++)
+            {
+                bounds.extend(m_object_bounds[m_items[i]]);
+            }
+        }
+        else
+        {
+            bounds.extend(m_nodes[node.left].bounds);
+            bounds.extend(m_nodes[node.left + 1].bounds);
+        }
+
+        node.bounds = bounds;
+        m_area += bounds.surface_area();
+    }
+
+    void SceneBvh::_cull_subtree(const Frustum& frustum, const uint32_t root, const bool inside,
+                                 std::vector<uint32_t>& visible, CullStatistics& statistics) const
+    {
+        // The tree is balanced, its depth stays far below the stack size.
+        std::array<std::pair<uint32_t, bool>, 128> stack;
+        uint32_t stack_size = 0;
+        stack[stack_size++] = { root, inside };
+
+        while (stack_size > 0)
+        {
+            const auto [node_index, is_inside] = stack[--stack_size];
+            const Node& node = m_nodes[node_index];
+
+            FrustumTest test = FrustumTest::eInside;
+            if (!is_inside)
+            {
+                statistics.tested_nodes++;
+                test = frustum.classify(node.bounds);
+                if (test == FrustumTest::eOutside)
+                {
+                    continue;
+                }
+            }
+
+            const auto begin = m_items.begin() + node.first;
+            const auto end = begin + node.count;
+            if (test == FrustumTest::eInside)
+            {
+                visible.insert(visible.end(), begin, end);
+            }
+            else if (node.left == 0)
+            {
+                for (auto it = begin; it != end; ++it)
+                {
+                    statistics.tested_objects++;
+                    if (frustum.is_visible(m_object_bounds[*it]))
+                    {
+                        visible.push_back(*it);
+                    }
+                }
+            }
+            else
+            {
+                stack[stack_size++] = { node.left + 1, false };
+                stack[stack_size++] = { node.left, false };
+            }
+        }
+    }
+}
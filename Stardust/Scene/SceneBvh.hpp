@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <Resources/Aabb.hpp>
+#include <Scene/Frustum.hpp>
+
+namespace sd
+{
+    struct CullStatistics
+    {
+        uint32_t visible { 0 };
+        uint32_t culled { 0 };
+        uint32_t tested_nodes { 0 };
+        uint32_t tested_objects { 0 };
+    };
+
+    /**
+     * Bounding volume hierarchy over the world space bounds of the scene objects.
+     * Moved objects refit the nodes above them, the tree is rebuilt once refitting has degraded it too much.
+     * Children are stored after their parent and each node covers a contiguous range of objects.
+     */
+    class SceneBvh
+    {
+    public:
+        SceneBvh();
+
+        ~SceneBvh();
+
+        // Builds the tree over bounds[i] for every object with non-empty bounds, objects are indexed as in the scene.
+        void build(const std::vector<Aabb>& bounds);
+
+        /**
+         * Takes effect with the next refit(). Objects whose bounds become non-empty, e.g. streamed objects getting their mesh,
+         * or empty, losing it, enter or leave the tree through a rebuild.
+         */
+        void set_bounds(uint32_t object, const Aabb& bounds);
+
+        void refit();
+
+        // Appends the objects whose bounds touch the frustum to visible. Large trees are tested on the job system.
+        CullStatistics cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+        const Aabb& bounds(uint32_t object) const { return m_object_bounds[object]; }
+
+        size_t object_count() const { return m_items.size(); }
+
+        size_t node_count() const { return m_nodes.size(); }
+
+        // Trees with fewer objects are culled on the calling thread.
+        static constexpr uint32_t s_parallel_threshold = 16384;
+
+        static constexpr uint32_t s_max_leaf_size = 4;
+
+        // Rebuild once the summed surface area of the nodes grew by this factor through refits.
+        static constexpr float s_rebuild_ratio = 2.0f;
+
+    private:
+        static constexpr uint32_t s_none = std::numeric_limits<uint32_t>::max();
+
+        struct Node
+        {
+            Aabb     bounds;
+            uint32_t first { 0 };
+            uint32_t count { 0 };
+            uint32_t left { 0 };        // Right child follows the left one, leaves have no children (left = 0)
+            uint32_t parent { s_none };
+        };
+
+        // Objects with non-empty bounds, in index order.
+        void _collect_items();
+
+        void _build();
+
+        void _recompute(uint32_t node_index);
+
+        void _cull_subtree(const Frustum& frustum, uint32_t root, bool inside, std::vector<uint32_t>& visible, CullStatistics& statistics) const;
+
+    private:
+        std::vector<Node>     m_nodes;
+        std::vector<uint32_t> m_items;          // Object indices, ordered so every node covers [first, first + count)
+        std::vector<Aabb>     m_object_bounds;
+        std::vector<uint32_t> m_object_leaf;
+        std::vector<uint32_t> m_dirty_nodes;
+        std::vector<uint8_t>  m_node_dirty;
+        float                 m_area { 0.0f };
+        float                 m_built_area { 0.0f };
+        bool                  m_items_changed { false };
+
+        // Results of the subtrees of a parallel cull, reused across frames.
+        mutable std::vector<std::vector<uint32_t>> m_task_results;
+    };
+}
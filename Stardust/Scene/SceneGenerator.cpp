@@ -0,0 +1,236 @@
+#include "SceneGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <Nebula/JobSystem.hpp>
+#include <Resources/Primitives/Cube.hpp>
+#include <Resources/Primitives/Sphere.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+#include <Vulkan/Rendering/MeshRegistry.hpp>
+
+namespace sd
+{
+    SceneDistribution SceneGeneratorOptions::parse_distribution(const std::string& name)
+    {
+        if (name == "uniform")   return SceneDistribution::eUniform;
+        if (name == "clustered") return SceneDistribution::eClustered;
+        if (name == "city")      return SceneDistribution::eCityGrid;
+
+        throw std::runtime_error(std::format("[Error] Unknown scene distribution \"{}\", expected uniform, clustered or city", name));
+    }
+
+    std::string SceneGeneratorOptions::to_string(const SceneDistribution distribution)
+    {
+        switch (distribution)
+        {
+            case SceneDistribution::eUniform:   return "uniform";
+            case SceneDistribution::eClustered: return "clustered";
+            case SceneDistribution::eCityGrid:  return "city";
+        }
+        return "unknown";
+    }
+
+    SceneGenerator::SceneGenerator(const SceneGeneratorOptions& options, const uint32_t seed, const uint32_t object_count)
+    : m_options(options), m_seed(seed), m_object_count(object_count)
+    {
+        m_options.mesh_variety = std::max(m_options.mesh_variety, 1u);
+        m_options.cluster_count = std::max(m_options.cluster_count, 1u);
+        m_options.max_unique_meshes = std::max(m_options.max_unique_meshes, m_options.mesh_variety);
+        m_options.instancing_ratio = std::clamp(m_options.instancing_ratio, 0.0f, 1.0f);
+        m_options.motion_fraction = std::clamp(m_options.motion_fraction, 0.0f, 1.0f);
+        m_options.deform_fraction = std::clamp(m_options.deform_fraction, 0.0f, 1.0f);
+    }
+
+    uint32_t SceneGenerator::unique_mesh_count() const
+    {
+        const auto unshared = static_cast<uint32_t>(std::round((1.0f - m_options.instancing_ratio) * static_cast<float>(m_object_count)));
+        return std::clamp(unshared, m_options.mesh_variety, m_options.max_unique_meshes);
+    }
+
+    float SceneGenerator::extent() const
+    {
+        if (m_options.extent > 0.0f)
+        {
+            return m_options.extent;
+        }
+
+        // Keeps the density of the default scene (1024 objects on a 192x192 plane).
+        const float density_scale = std::sqrt(static_cast<float>(std::max(m_object_count, 1024u)) / 1024.0f);
+        return s_default_extent * density_scale;
+    }
+
+    std::unique_ptr<Geometry> SceneGenerator::create_geometry(const uint32_t prototype) const
+    {
+        if (prototype % m_options.mesh_variety == 0)
+        {
+            return std::make_unique<primitives::Cube>();
+        }
+
+        // Linearly decreasing tessellation from triangle_density, like a chain of LODs.
+        const uint32_t sphere_count = std::max(m_options.mesh_variety - 1, 1u);
+        const uint32_t lod = prototype % m_options.mesh_variety - 1;
+        const uint32_t tessellation = std::max(m_options.triangle_density * (sphere_count - lod) / sphere_count, 3u);
+        return std::make_unique<primitives::Sphere>(1.0f, static_cast<int32_t>(tessellation));
+    }
+
+    GeneratedScene SceneGenerator::generate(sdvk::MeshRegistry& mesh_registry) const
+    {
+        // Raw engine output is specified by the standard, unlike the distributions, so layouts match across platforms.
+        std::mt19937 engine(m_seed);
+        auto randi = [&engine](){ return static_cast<int32_t>(engine() >> 1); };
+        auto randf = [&engine](float lo = 0.0f, float hi = 1.0f){ return lo + static_cast<float>(engine()) / static_cast<float>(std::mt19937::max()) * (hi - lo); };
+        auto gaussian = [&randf](){
+            const float u1 = std::max(randf(), 1e-7f);
+            const float u2 = randf();
+            return std::sqrt(-2.0f * std::log(u1)) * std::cos(2.0f * std::numbers::pi_v<float> * u2);
+        };
+
+        GeneratedScene result;
+        const float extent = this->extent();
+
+        const uint32_t unique_meshes = unique_mesh_count();
+        const bool streaming = m_options.streaming.enabled;
+        auto prototype_name = [this](const uint32_t prototype) {
+            return std::format("generated {} {}", prototype % m_options.mesh_variety == 0 ? "cube" : "sphere", prototype);
+        };
+
+        // Tessellation and meshlet building run on the job system, only the uploads stay on this thread.
+        // Streamed scenes only create the cube of the plane here, which lets them start rendering right away.
+        const uint32_t created_meshes = streaming ? 1 : unique_meshes;
+        std::vector<std::unique_ptr<Geometry>> geometries(created_meshes);
+        std::vector<std::vector<sdvk::Meshlet>> meshlets(created_meshes);
+        Nebula::JobSystem::instance().parallel_for(created_meshes, 1, [&](const uint32_t begin, const uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                geometries[i] = create_geometry(i);
+                meshlets[i] = sdvk::Mesh::create_meshlets(*geometries[i]);
+            }
+        });
+
+        std::vector<std::shared_ptr<sdvk::Mesh>> meshes(created_meshes);
+        for (uint32_t i = 0; i < created_meshes; i++)
+        {
+            const std::string name = prototype_name(i);
+            meshes[i] = mesh_registry.create(geometries[i].release(), std::move(meshlets[i]), name);
+            result.meshes[name] = meshes[i];
+        }
+
+        if (streaming)
+        {
+            result.sources.reserve(unique_meshes);
+            for (uint32_t i = 0; i < unique_meshes; i++)
+            {
+                result.sources.push_back({ prototype_name(i), [generator = *this, i]() { return generator.create_geometry(i); } });
+            }
+            result.object_sources.reserve(m_object_count + 1);
+            result.object_sources.push_back(SceneStreamer::s_no_source);
+        }
+
+        result.objects.reserve(m_object_count + 1);
+
+        Object plane = {};
+        plane.color = { .5f, .5f, .5f, 1.f };
+        plane.mesh = meshes[0];
+        plane.name = "Object 1";
+        plane.transform.scale = { extent, 0.05f, extent };
+        result.objects.push_back(plane);
+
+        std::vector<glm::vec2> cluster_centers(m_options.cluster_count);
+        for (auto& center : cluster_centers)
+        {
+            center = { randf(-0.8f * extent, 0.8f * extent), randf(-0.8f * extent, 0.8f * extent) };
+        }
+        const float cluster_sigma = extent / (2.0f * std::sqrt(static_cast<float>(m_options.cluster_count)));
+
+        // City blocks are 4x4 lots separated by a street one lot wide.
+        const auto lots_per_side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(std::max(m_object_count, 1u)))));
+        const float lot_size = 2.0f * extent / static_cast<float>(lots_per_side + lots_per_side / 4);
+
+        for (uint32_t i = 0; i < m_object_count; i++)
+        {
+            const uint32_t mesh_index = unique_meshes >= m_object_count ? i : static_cast<uint32_t>(randi()) % unique_meshes;
+            const bool is_cube = mesh_index % m_options.mesh_variety == 0;
+
+            Transform transform = {};
+            if (is_cube)
+            {
+                transform.scale = { randf(0.5f, 2.0f), randf(0.5f, 8.0f), randf(0.5f, 2.5f) };
+            }
+            else
+            {
+                transform.scale = glm::vec3(randf(0.5f, 2.0f));
+            }
+
+            glm::vec2 position;
+            switch (m_options.distribution)
+            {
+                case SceneDistribution::eUniform:
+                {
+                    position = { randf(-extent, extent), randf(-extent, extent) };
+                    break;
+                }
+                case SceneDistribution::eClustered:
+                {
+                    const auto& center = cluster_centers[static_cast<uint32_t>(randi()) % cluster_centers.size()];
+                    position = center + glm::vec2(gaussian(), gaussian()) * cluster_sigma;
+                    position = glm::clamp(position, glm::vec2(-extent), glm::vec2(extent));
+                    break;
+                }
+                case SceneDistribution::eCityGrid:
+                {
+                    const uint32_t column = i % lots_per_side;
+                    const uint32_t row = i / lots_per_side;
+                    position = {
+                        -extent + (static_cast<float>(column + column / 4) + 0.5f) * lot_size,
+                        -extent + (static_cast<float>(row + row / 4) + 0.5f) * lot_size,
+                    };
+
+                    // Mostly low buildings with a few towers.
+                    const float footprint = 0.35f * lot_size;
+                    const float height = lot_size * (0.5f + 6.0f * std::pow(randf(), 3.0f));
+                    transform.scale = is_cube ? glm::vec3(footprint, height, footprint) : glm::vec3(footprint);
+                    break;
+                }
+            }
+            transform.position = { position.x, transform.scale.y, position.y };
+
+            Object obj = {};
+            obj.color = { randf(0.2f, 1.0f), randf(0.2f, 1.0f), randf(0.2f, 1.0f), 1.0f };
+            obj.mesh = streaming ? nullptr : meshes[mesh_index];
+            obj.name = std::format("Object {}", result.objects.size() + 1);
+            obj.transform = transform;
+
+            if (randf() < m_options.motion_fraction)
+            {
+                ObjectMotion motion;
+                motion.object = static_cast<uint32_t>(result.objects.size());
+                motion.origin = transform.position;
+                motion.amplitude = randf(0.5f, 3.0f);
+                motion.frequency = randf(0.25f, 1.0f);
+                motion.phase = randf(0.0f, 2.0f * std::numbers::pi_v<float>);
+                result.motions.push_back(motion);
+            }
+
+            // Draws nothing when disabled, so scenes without deformation stay the same as before.
+            if (m_options.deform_fraction > 0.0f && randf() < m_options.deform_fraction)
+            {
+                obj.deformation.amplitude = randf(0.05f, 0.25f);
+                obj.deformation.frequency = randf(2.0f, 6.0f);
+                obj.deformation.speed = randf(1.0f, 4.0f);
+                obj.deformation.phase = randf(0.0f, 2.0f * std::numbers::pi_v<float>);
+            }
+
+            result.objects.push_back(obj);
+            if (streaming)
+            {
+                result.object_sources.push_back(mesh_index);
+            }
+        }
+
+        return result;
+    }
+}
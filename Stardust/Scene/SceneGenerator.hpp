@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Resources/Geometry.hpp>
+#include <Scene/Object.hpp>
+#include <Scene/SceneStreamer.hpp>
+
+namespace sdvk
+{
+    class Mesh;
+    class MeshRegistry;
+}
+
+namespace sd
+{
+    enum class SceneDistribution
+    {
+        eUniform,
+        eClustered,
+        eCityGrid,
+    };
+
+    struct SceneGeneratorOptions
+    {
+        // Replaces the default scene, the object count and seed are shared with it and passed separately.
+        bool enabled { false };
+
+        // Number of prototype geometries, the first one is a cube and the rest are spheres of decreasing tessellation.
+        uint32_t mesh_variety { 4 };
+
+        // 1: objects only share the prototype meshes, 0: every object gets its own prototype (up to max_unique_meshes).
+        // Prototypes repeat the mesh_variety geometries, the mesh registry returns one mesh and BLAS for equal ones.
+        float instancing_ratio { 1.0f };
+
+        // Sphere tessellation of the densest prototype, a sphere has roughly 2 * density^2 triangles.
+        uint32_t triangle_density { 32 };
+
+        SceneDistribution distribution { SceneDistribution::eUniform };
+        uint32_t cluster_count { 16 };
+
+        // Fraction of objects moved by Scene::update every frame.
+        float motion_fraction { 0.0f };
+
+        // Fraction of objects whose vertices are deformed every frame, each of them gets vertex buffers and a BLAS of its own.
+        float deform_fraction { 0.0f };
+
+        // Half size of the populated square, 0 scales the default scene size with the object count.
+        float extent { 0.0f };
+
+        uint32_t max_unique_meshes { 4096 };
+
+        // Generated objects start without a mesh, their prototypes are streamed in around the camera instead. Streamed objects are not deformed.
+        SceneStreamingOptions streaming;
+
+        static SceneDistribution parse_distribution(const std::string& name);
+
+        static std::string to_string(SceneDistribution distribution);
+    };
+
+    struct ObjectMotion
+    {
+        uint32_t  object { 0 };
+        glm::vec3 origin { 0.0f };
+        float     amplitude { 1.0f };
+        float     frequency { 1.0f };
+        float     phase { 0.0f };
+    };
+
+    struct GeneratedScene
+    {
+        std::map<std::string, std::shared_ptr<sdvk::Mesh>> meshes;
+        std::vector<Object>       objects;
+        std::vector<ObjectMotion> motions;
+
+        // Streaming only: a source per prototype and the source of each object, SceneStreamer::s_no_source for the plane.
+        std::vector<MeshSource>   sources;
+        std::vector<uint32_t>     object_sources;
+    };
+
+    /**
+     * Builds stress test scenes along independent axes (object count, mesh variety, instancing, triangle density,
+     * placement and motion). Everything is derived from the seed with the raw mt19937 output, so a configuration
+     * produces the same scene on every platform.
+     */
+    class SceneGenerator
+    {
+    public:
+        SceneGenerator(const SceneGeneratorOptions& options, uint32_t seed, uint32_t object_count);
+
+        // The first object is a ground plane covering the extent, followed by object_count generated objects.
+        // Prototypes with equal geometry, e.g. the cubes of unshared meshes, come back from the registry as one mesh.
+        // With streaming only the plane gets its mesh, the prototypes are returned as sources and created by the streamer.
+        GeneratedScene generate(sdvk::MeshRegistry& mesh_registry) const;
+
+        // Geometry of a prototype, requires no Vulkan objects.
+        std::unique_ptr<Geometry> create_geometry(uint32_t prototype) const;
+
+        uint32_t unique_mesh_count() const;
+
+        float extent() const;
+
+        static constexpr float s_default_extent = 96.0f;
+
+    private:
+        SceneGeneratorOptions m_options;
+        uint32_t              m_seed;
+        uint32_t              m_object_count;
+    };
+}
\ No newline at end of file
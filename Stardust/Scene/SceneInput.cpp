@@ -0,0 +1,106 @@
+#include "Camera.hpp"
+#include "Scene.hpp"
+
+#include <glm/gtx/rotate_vector.hpp>
+#include <glm/gtx/vector_angle.hpp>
+#include <Window/Window.hpp>
+
+namespace sd
+{
+    void Scene::key_handler(const Window& window)
+    {
+        m_camera->register_keys(window.handle());
+    }
+
+    void Scene::mouse_handler(const Window& window)
+    {
+        m_camera->register_mouse(window.handle());
+    }
+
+    void Camera::register_keys(GLFWwindow* p_window)
+    {
+        // WASD movement
+        if (glfwGetKey(p_window, GLFW_KEY_W) == GLFW_PRESS)
+        {
+            m_eye += m_speed * m_orientation;
+        }
+        if (glfwGetKey(p_window, GLFW_KEY_A) == GLFW_PRESS)
+        {
+            m_eye += m_speed * -glm::normalize(glm::cross(m_orientation, m_up));
+        }
+        if (glfwGetKey(p_window, GLFW_KEY_S) == GLFW_PRESS)
+        {
+            m_eye += m_speed * -m_orientation;
+        }
+        if (glfwGetKey(p_window, GLFW_KEY_D) == GLFW_PRESS)
+        {
+            m_eye += m_speed * glm::normalize(glm::cross(m_orientation, m_up));
+        }
+
+        // Move up & down
+        if (glfwGetKey(p_window, GLFW_KEY_SPACE) == GLFW_PRESS)
+        {
+            m_eye += (m_speed / 2.0f) * m_up;
+        }
+        if (glfwGetKey(p_window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
+        {
+            m_eye -= (m_speed / 2.0f) * m_up;
+        }
+
+        // Exit on ESC
+        if (glfwGetKey(p_window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        {
+            glfwSetWindowShouldClose(p_window, true);
+        }
+    }
+
+    void Camera::register_mouse(GLFWwindow* p_window)
+    {
+        if (glfwGetMouseButton(p_window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+        {
+            glfwSetInputMode(p_window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+
+            if (m_click)
+            {
+                glfwSetCursorPos(p_window, (m_size.x / 2), (m_size.y / 2));
+                m_click = false;
+            }
+
+            double mouseX, mouseY;
+            glfwGetCursorPos(p_window, &mouseX, &mouseY);
+
+            float rotX = m_sensitivity * (float)(mouseY - (m_size.y / 2)) / m_size.y;
+            float rotY = m_sensitivity * (float)(mouseX - (m_size.x / 2)) / m_size.x;
+
+            glm::vec3 newOrientation = glm::rotate(m_orientation, glm::radians(-rotX), glm::normalize(glm::cross(m_orientation, m_up)));
+
+            if (abs(glm::angle(newOrientation, m_up) - glm::radians(90.0f)) <= glm::radians(85.0f))
+            {
+                m_orientation = newOrientation;
+            }
+
+            m_orientation = glm::rotate(m_orientation, glm::radians(-rotY), m_up);
+            glfwSetCursorPos(p_window, (m_size.x / 2), (m_size.y / 2));
+        }
+        else if (glfwGetMouseButton(p_window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_RELEASE)
+        {
+            glfwSetInputMode(p_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+            m_click = true;
+        }
+    }
+
+    CameraUniformData Camera::uniform_data() const
+    {
+        auto v = view();
+        auto p = projection();
+        auto e = eye();
+
+        return {
+            .view = v,
+            .proj = p,
+            .view_inverse = glm::inverse(v),
+            .proj_inverse = glm::inverse(p),
+            .eye = { e.x, e.y, e.z, 1.0f }
+        };
+    }
+}
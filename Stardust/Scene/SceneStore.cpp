@@ -0,0 +1,450 @@
+#include "SceneStore.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <Nebula/JobSystem.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SD_TRANSFORM_KERNEL_AVX2
+#define SD_TRANSFORM_KERNEL_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SD_TRANSFORM_KERNEL_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SD_TRANSFORM_KERNEL_NEON
+#endif
+
+namespace sd
+{
+    namespace
+    {
+        struct TransformStreams
+        {
+            const float* px; const float* py; const float* pz;
+            const float* qx; const float* qy; const float* qz; const float* qw;
+            const float* sx; const float* sy; const float* sz;
+        };
+
+        /**
+         * Lane types of the kernel, width objects are evaluated at once. scatter() transposes the lanes of the
+         * rotation-scale part m[row][column] and translation p[row] into width model and 3x4 matrices.
+         */
+        struct ScalarLanes
+        {
+            using V = float;
+            static constexpr size_t width = 1;
+
+            static V load(const float* p) { return *p; }
+            static V set1(const float v) { return v; }
+            static V add(const V a, const V b) { return a + b; }
+            static V sub(const V a, const V b) { return a - b; }
+            static V mul(const V a, const V b) { return a * b; }
+
+            static void scatter(const V (&m)[3][3], const V (&p)[3], glm::mat4* models, vk::TransformMatrixKHR* models3x4)
+            {
+                auto& model = *models;
+                for (int32_t column = 0; column < 3; column++)
+                {
+                    model[column] = glm::vec4(m[0][column], m[1][column], m[2][column], 0.0f);
+                }
+                model[3] = glm::vec4(p[0], p[1], p[2], 1.0f);
+
+                for (int32_t row = 0; row < 3; row++)
+                {
+                    auto& matrix_row = models3x4->matrix[row];
+                    matrix_row[0] = m[row][0];
+                    matrix_row[1] = m[row][1];
+                    matrix_row[2] = m[row][2];
+                    matrix_row[3] = p[row];
+                }
+            }
+        };
+
+#if defined(SD_TRANSFORM_KERNEL_SSE)
+        struct SseLanes
+        {
+            using V = __m128;
+            static constexpr size_t width = 4;
+
+            static V load(const float* p) { return _mm_loadu_ps(p); }
+            static V set1(const float v) { return _mm_set1_ps(v); }
+            static V add(const V a, const V b) { return _mm_add_ps(a, b); }
+            static V sub(const V a, const V b) { return _mm_sub_ps(a, b); }
+            static V mul(const V a, const V b) { return _mm_mul_ps(a, b); }
+
+            static void scatter(const V (&m)[3][3], const V (&p)[3], glm::mat4* models, vk::TransformMatrixKHR* models3x4)
+            {
+                // Columns of the model matrices: lane k of (m0j, m1j, m2j, w) becomes column j of model k.
+                for (int32_t column = 0; column < 4; column++)
+                {
+                    V c0 = column < 3 ? m[0][column] : p[0];
+                    V c1 = column < 3 ? m[1][column] : p[1];
+                    V c2 = column < 3 ? m[2][column] : p[2];
+                    V c3 = column < 3 ? _mm_setzero_ps() : _mm_set1_ps(1.0f);
+                    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+                    _mm_storeu_ps(&models[0][column][0], c0);
+                    _mm_storeu_ps(&models[1][column][0], c1);
+                    _mm_storeu_ps(&models[2][column][0], c2);
+                    _mm_storeu_ps(&models[3][column][0], c3);
+                }
+
+                // Rows of the 3x4 matrices: lane k of (mi0, mi1, mi2, pi) becomes row i of matrix k.
+                for (int32_t row = 0; row < 3; row++)
+                {
+                    V r0 = m[row][0];
+                    V r1 = m[row][1];
+                    V r2 = m[row][2];
+                    V r3 = p[row];
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    _mm_storeu_ps(models3x4[0].matrix[row].data(), r0);
+                    _mm_storeu_ps(models3x4[1].matrix[row].data(), r1);
+                    _mm_storeu_ps(models3x4[2].matrix[row].data(), r2);
+                    _mm_storeu_ps(models3x4[3].matrix[row].data(), r3);
+                }
+            }
+        };
+#endif
+
+#if defined(SD_TRANSFORM_KERNEL_AVX2)
+        struct Avx2Lanes
+        {
+            using V = __m256;
+            static constexpr size_t width = 8;
+
+            static V load(const float* p) { return _mm256_loadu_ps(p); }
+            static V set1(const float v) { return _mm256_set1_ps(v); }
+            static V add(const V a, const V b) { return _mm256_add_ps(a, b); }
+            static V sub(const V a, const V b) { return _mm256_sub_ps(a, b); }
+            static V mul(const V a, const V b) { return _mm256_mul_ps(a, b); }
+
+            // The transposes are done per 128-bit half, AVX has no cross-lane 4x4 transpose.
+            static void scatter(const V (&m)[3][3], const V (&p)[3], glm::mat4* models, vk::TransformMatrixKHR* models3x4)
+            {
+                __m128 lo_m[3][3], hi_m[3][3], lo_p[3], hi_p[3];
+                for (int32_t row = 0; row < 3; row++)
+                {
+                    for (int32_t column = 0; column < 3; column++)
+                    {
+                        lo_m[row][column] = _mm256_castps256_ps128(m[row][column]);
+                        hi_m[row][column] = _mm256_extractf128_ps(m[row][column], 1);
+                    }
+                    lo_p[row] = _mm256_castps256_ps128(p[row]);
+                    hi_p[row] = _mm256_extractf128_ps(p[row], 1);
+                }
+                SseLanes::scatter(lo_m, lo_p, models, models3x4);
+                SseLanes::scatter(hi_m, hi_p, models + 4, models3x4 + 4);
+            }
+        };
+#endif
+
+#if defined(SD_TRANSFORM_KERNEL_NEON)
+        struct NeonLanes
+        {
+            using V = float32x4_t;
+            static constexpr size_t width = 4;
+
+            static V load(const float* p) { return vld1q_f32(p); }
+            static V set1(const float v) { return vdupq_n_f32(v); }
+            static V add(const V a, const V b) { return vaddq_f32(a, b); }
+            static V sub(const V a, const V b) { return vsubq_f32(a, b); }
+            static V mul(const V a, const V b) { return vmulq_f32(a, b); }
+
+            static void transpose(V& a, V& b, V& c, V& d)
+            {
+                const float32x4x2_t ab = vtrnq_f32(a, b);
+                const float32x4x2_t cd = vtrnq_f32(c, d);
+                a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+                b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+                c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+                d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+            }
+
+            static void scatter(const V (&m)[3][3], const V (&p)[3], glm::mat4* models, vk::TransformMatrixKHR* models3x4)
+            {
+                for (int32_t column = 0; column < 4; column++)
+                {
+                    V c0 = column < 3 ? m[0][column] : p[0];
+                    V c1 = column < 3 ? m[1][column] : p[1];
+                    V c2 = column < 3 ? m[2][column] : p[2];
+                    V c3 = vdupq_n_f32(column < 3 ? 0.0f : 1.0f);
+                    transpose(c0, c1, c2, c3);
+                    vst1q_f32(&models[0][column][0], c0);
+                    vst1q_f32(&models[1][column][0], c1);
+                    vst1q_f32(&models[2][column][0], c2);
+                    vst1q_f32(&models[3][column][0], c3);
+                }
+
+                for (int32_t row = 0; row < 3; row++)
+                {
+                    V r0 = m[row][0];
+                    V r1 = m[row][1];
+                    V r2 = m[row][2];
+                    V r3 = p[row];
+                    transpose(r0, r1, r2, r3);
+                    vst1q_f32(models3x4[0].matrix[row].data(), r0);
+                    vst1q_f32(models3x4[1].matrix[row].data(), r1);
+                    vst1q_f32(models3x4[2].matrix[row].data(), r2);
+                    vst1q_f32(models3x4[3].matrix[row].data(), r3);
+                }
+            }
+        };
+#endif
+
+        // Evaluates whole batches of L::width objects from begin on and returns the index of the first one left over.
+        template <typename L>
+        size_t evaluate(const TransformStreams& s, size_t begin, const size_t end,
+                        glm::mat4* models, vk::TransformMatrixKHR* models3x4)
+        {
+            using V = typename L::V;
+            const V one = L::set1(1.0f);
+
+            for (; begin + L::width <= end; begin += L::width)
+            {
+                const V x = L::load(s.qx + begin), y = L::load(s.qy + begin), z = L::load(s.qz + begin), w = L::load(s.qw + begin);
+                const V x2 = L::add(x, x), y2 = L::add(y, y), z2 = L::add(z, z);
+                const V xx = L::mul(x, x2), yy = L::mul(y, y2), zz = L::mul(z, z2);
+                const V xy = L::mul(x, y2), xz = L::mul(x, z2), yz = L::mul(y, z2);
+                const V wx = L::mul(w, x2), wy = L::mul(w, y2), wz = L::mul(w, z2);
+
+                // Rotation matrix of a unit quaternion, each column scaled by the scale on its axis: R * S.
+                const V sx = L::load(s.sx + begin), sy = L::load(s.sy + begin), sz = L::load(s.sz + begin);
+                const V m[3][3] = {
+                    { L::mul(L::sub(one, L::add(yy, zz)), sx), L::mul(L::sub(xy, wz), sy), L::mul(L::add(xz, wy), sz) },
+                    { L::mul(L::add(xy, wz), sx), L::mul(L::sub(one, L::add(xx, zz)), sy), L::mul(L::sub(yz, wx), sz) },
+                    { L::mul(L::sub(xz, wy), sx), L::mul(L::add(yz, wx), sy), L::mul(L::sub(one, L::add(xx, yy)), sz) },
+                };
+                const V p[3] = { L::load(s.px + begin), L::load(s.py + begin), L::load(s.pz + begin) };
+
+                L::scatter(m, p, models + begin, models3x4 + begin);
+            }
+            return begin;
+        }
+
+        vk::TransformMatrixKHR to_3x4(const glm::mat4& m)
+        {
+            vk::TransformMatrixKHR result;
+            for (int32_t row = 0; row < 3; row++)
+            {
+                for (int32_t column = 0; column < 4; column++)
+                {
+                    result.matrix[row][column] = m[column][row];
+                }
+            }
+            return result;
+        }
+    }
+
+    uint32_t SceneStore::add(const Transform& transform, const uint32_t mesh_index, const uint32_t flags, const uint32_t parent)
+    {
+        const auto index = static_cast<uint32_t>(size());
+        if (parent != s_no_parent && parent >= index)
+        {
+            throw std::runtime_error(std::format("[Error] Object {} was added before its parent {}", index, parent));
+        }
+
+        m_position_x.push_back(transform.position.x);
+        m_position_y.push_back(transform.position.y);
+        m_position_z.push_back(transform.position.z);
+
+        const glm::quat rotation = glm::normalize(transform.rotation);
+        m_rotation_x.push_back(rotation.x);
+        m_rotation_y.push_back(rotation.y);
+        m_rotation_z.push_back(rotation.z);
+        m_rotation_w.push_back(rotation.w);
+
+        m_scale_x.push_back(transform.scale.x);
+        m_scale_y.push_back(transform.scale.y);
+        m_scale_z.push_back(transform.scale.z);
+
+        m_mesh_index.push_back(mesh_index);
+        m_flags.push_back(flags);
+        m_parent.push_back(parent);
+        m_dirty.push_back(1);
+        m_has_dirty = true;
+        m_has_hierarchy |= parent != s_no_parent;
+
+        m_models.emplace_back(1.0f);
+        m_models3x4.emplace_back();
+
+        return index;
+    }
+
+    void SceneStore::reserve(const size_t count)
+    {
+        for (auto* stream : { &m_position_x, &m_position_y, &m_position_z,
+                              &m_rotation_x, &m_rotation_y, &m_rotation_z, &m_rotation_w,
+                              &m_scale_x, &m_scale_y, &m_scale_z })
+        {
+            stream->reserve(count);
+        }
+        m_mesh_index.reserve(count);
+        m_flags.reserve(count);
+        m_parent.reserve(count);
+        m_dirty.reserve(count);
+        m_models.reserve(count);
+        m_models3x4.reserve(count);
+    }
+
+    void SceneStore::clear()
+    {
+        for (auto* stream : { &m_position_x, &m_position_y, &m_position_z,
+                              &m_rotation_x, &m_rotation_y, &m_rotation_z, &m_rotation_w,
+                              &m_scale_x, &m_scale_y, &m_scale_z })
+        {
+            stream->clear();
+        }
+        m_mesh_index.clear();
+        m_flags.clear();
+        m_parent.clear();
+        m_dirty.clear();
+        m_changed.clear();
+        m_models.clear();
+        m_models3x4.clear();
+        m_has_dirty = false;
+        m_has_hierarchy = false;
+    }
+
+    void SceneStore::set_position(const uint32_t index, const glm::vec3& position)
+    {
+        m_position_x[index] = position.x;
+        m_position_y[index] = position.y;
+        m_position_z[index] = position.z;
+        _mark_dirty(index);
+    }
+
+    void SceneStore::set_rotation(const uint32_t index, const glm::quat& rotation)
+    {
+        const glm::quat q = glm::normalize(rotation);
+        m_rotation_x[index] = q.x;
+        m_rotation_y[index] = q.y;
+        m_rotation_z[index] = q.z;
+        m_rotation_w[index] = q.w;
+        _mark_dirty(index);
+    }
+
+    void SceneStore::set_scale(const uint32_t index, const glm::vec3& scale)
+    {
+        m_scale_x[index] = scale.x;
+        m_scale_y[index] = scale.y;
+        m_scale_z[index] = scale.z;
+        _mark_dirty(index);
+    }
+
+    void SceneStore::invalidate()
+    {
+        std::ranges::fill(m_dirty, 1);
+        m_has_dirty = !m_dirty.empty();
+    }
+
+    void SceneStore::update_transforms()
+    {
+        m_changed.clear();
+        if (!m_has_dirty)
+        {
+            return;
+        }
+
+        const size_t count = size();
+
+        // Parents come first, so a single pass carries the flags down whole subtrees.
+        if (m_has_hierarchy)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!m_dirty[i] && m_parent[i] != s_no_parent && m_dirty[m_parent[i]])
+                {
+                    m_dirty[i] = 1;
+                }
+            }
+        }
+
+        // Local matrices do not depend on each other, large stores evaluate them in chunks on the job system.
+        const auto evaluate_dirty = [this](const size_t first, const size_t last) {
+            for (size_t begin = first; begin < last;)
+            {
+                if (!m_dirty[begin])
+                {
+                    begin++;
+                    continue;
+                }
+
+                size_t end = begin + 1;
+                while (end < last && m_dirty[end])
+                {
+                    end++;
+                }
+                _evaluate_local(begin, end);
+                begin = end;
+            }
+        };
+
+        if (count >= s_parallel_threshold)
+        {
+            Nebula::JobSystem::instance().parallel_for(static_cast<uint32_t>(count), s_parallel_grain, evaluate_dirty);
+        }
+        else
+        {
+            evaluate_dirty(0, count);
+        }
+
+        // The world matrix of a parent is final before its children are reached.
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!m_dirty[i])
+            {
+                continue;
+            }
+
+            if (m_parent[i] != s_no_parent)
+            {
+                m_models[i] = m_models[m_parent[i]] * m_models[i];
+                m_models3x4[i] = to_3x4(m_models[i]);
+            }
+            m_dirty[i] = 0;
+            m_changed.push_back(i);
+        }
+        m_has_dirty = false;
+    }
+
+    void SceneStore::_mark_dirty(const uint32_t index)
+    {
+        m_dirty[index] = 1;
+        m_has_dirty = true;
+    }
+
+    void SceneStore::_evaluate_local(const size_t begin, const size_t end)
+    {
+        const TransformStreams streams {
+            m_position_x.data(), m_position_y.data(), m_position_z.data(),
+            m_rotation_x.data(), m_rotation_y.data(), m_rotation_z.data(), m_rotation_w.data(),
+            m_scale_x.data(), m_scale_y.data(), m_scale_z.data(),
+        };
+
+        size_t first = begin;
+#if defined(SD_TRANSFORM_KERNEL_AVX2)
+        first = evaluate<Avx2Lanes>(streams, first, end, m_models.data(), m_models3x4.data());
+#endif
+#if defined(SD_TRANSFORM_KERNEL_SSE)
+        first = evaluate<SseLanes>(streams, first, end, m_models.data(), m_models3x4.data());
+#elif defined(SD_TRANSFORM_KERNEL_NEON)
+        first = evaluate<NeonLanes>(streams, first, end, m_models.data(), m_models3x4.data());
+#endif
+        evaluate<ScalarLanes>(streams, first, end, m_models.data(), m_models3x4.data());
+    }
+
+    const char* SceneStore::kernel_isa()
+    {
+#if defined(SD_TRANSFORM_KERNEL_AVX2)
+        return "AVX2";
+#elif defined(SD_TRANSFORM_KERNEL_SSE)
+        return "SSE2";
+#elif defined(SD_TRANSFORM_KERNEL_NEON)
+        return "NEON";
+#else
+        return "Scalar";
+#endif
+    }
+}
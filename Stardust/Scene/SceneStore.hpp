@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <vulkan/vulkan.hpp>
+#include <Scene/Transform.hpp>
+
+namespace sd
+{
+    struct ObjectFlags
+    {
+        static constexpr uint32_t eNone    = 0;
+        // Moved by a motion each frame.
+        static constexpr uint32_t eDynamic = 1u << 0;
+    };
+
+    /**
+     * Transforms of every object in the scene, one array per component, so evaluating them streams through memory.
+     * Transforms are local to the parent object, parents are stored before their children.
+     * Setting a transform marks the object dirty, update_transforms() re-evaluates the world matrices of dirty subtrees only.
+     */
+    class SceneStore
+    {
+    public:
+        static constexpr uint32_t s_no_mesh = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t s_no_parent = std::numeric_limits<uint32_t>::max();
+
+        // The parent has to be added first.
+        uint32_t add(const Transform& transform, uint32_t mesh_index = s_no_mesh, uint32_t flags = ObjectFlags::eNone,
+                     uint32_t parent = s_no_parent);
+
+        void reserve(size_t count);
+
+        void clear();
+
+        size_t size() const { return m_mesh_index.size(); }
+
+        void set_position(uint32_t index, const glm::vec3& position);
+
+        // Stored normalized, the kernel expects unit quaternions.
+        void set_rotation(uint32_t index, const glm::quat& rotation);
+
+        void set_scale(uint32_t index, const glm::vec3& scale);
+
+        glm::vec3 position(uint32_t index) const { return { m_position_x[index], m_position_y[index], m_position_z[index] }; }
+
+        glm::quat rotation(uint32_t index) const { return { m_rotation_w[index], m_rotation_x[index], m_rotation_y[index], m_rotation_z[index] }; }
+
+        glm::vec3 scale(uint32_t index) const { return { m_scale_x[index], m_scale_y[index], m_scale_z[index] }; }
+
+        uint32_t mesh_index(uint32_t index) const { return m_mesh_index[index]; }
+
+        uint32_t flags(uint32_t index) const { return m_flags[index]; }
+
+        uint32_t parent(uint32_t index) const { return m_parent[index]; }
+
+        const std::vector<uint32_t>& mesh_indices() const { return m_mesh_index; }
+
+        // Leaves the object clean, whoever changes the mesh updates the data derived from it.
+        void set_mesh_index(uint32_t index, uint32_t mesh_index) { m_mesh_index[index] = mesh_index; }
+
+        // Marks every object dirty, e.g. after data derived from all of them was lost.
+        void invalidate();
+
+        // Evaluates the world matrices of dirty objects and their descendants, does nothing if none are dirty.
+        void update_transforms();
+
+        // World matrices.
+        const std::vector<glm::mat4>& models() const { return m_models; }
+
+        const std::vector<vk::TransformMatrixKHR>& models3x4() const { return m_models3x4; }
+
+        // Objects whose world matrix was re-evaluated by the last update_transforms(), in ascending order.
+        const std::vector<uint32_t>& changed() const { return m_changed; }
+
+        // Instruction set the batch kernel was compiled for.
+        static const char* kernel_isa();
+
+        // Stores with fewer objects evaluate their local matrices on the calling thread.
+        static constexpr uint32_t s_parallel_threshold = 16384;
+
+        // Objects evaluated per job, a multiple of every SIMD batch width.
+        static constexpr uint32_t s_parallel_grain = 4096;
+
+    private:
+        void _mark_dirty(uint32_t index);
+
+        // Local matrices of [begin, end) in SIMD batches.
+        void _evaluate_local(size_t begin, size_t end);
+
+    private:
+        std::vector<float> m_position_x, m_position_y, m_position_z;
+        std::vector<float> m_rotation_x, m_rotation_y, m_rotation_z, m_rotation_w;
+        std::vector<float> m_scale_x, m_scale_y, m_scale_z;
+        std::vector<uint32_t> m_mesh_index;
+        std::vector<uint32_t> m_flags;
+        std::vector<uint32_t> m_parent;
+        std::vector<uint8_t>  m_dirty;
+        std::vector<uint32_t> m_changed;
+        bool                  m_has_dirty { false };
+        bool                  m_has_hierarchy { false };
+
+        std::vector<glm::mat4>              m_models;
+        std::vector<vk::TransformMatrixKHR> m_models3x4;
+    };
+}
@@ -0,0 +1,361 @@
+#include "SceneStreamer.hpp"
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <Scene/SceneStore.hpp>
+#include <Vulkan/Context.hpp>
+#include <Vulkan/MemoryManager.hpp>
+#include <Vulkan/Rendering/MeshRegistry.hpp>
+
+namespace sd
+{
+    SceneStreamer::SceneStreamer(const SceneStreamingOptions& options, std::vector<MeshSource>&& sources, std::vector<uint32_t>&& object_sources,
+                                 const SceneStore& store, sdvk::MeshRegistry& mesh_registry,
+                                 const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context)
+    : m_options(options), m_mesh_sources(std::move(sources)), m_object_sources(std::move(object_sources))
+    , m_mesh_registry(mesh_registry), m_command_buffers(command_buffers), m_context(context)
+    {
+        m_options.cell_size = std::max(m_options.cell_size, 1.0f);
+        m_options.load_radius = std::max(m_options.load_radius, 0.0f);
+        m_options.evict_radius = std::max(m_options.evict_radius, m_options.load_radius);
+        m_load_radius = m_options.load_radius;
+
+        m_sources.resize(m_mesh_sources.size());
+        m_object_sources.resize(store.size(), s_no_source);
+
+        // The grid covers the streamed objects.
+        glm::vec2 min(std::numeric_limits<float>::max());
+        glm::vec2 max(std::numeric_limits<float>::lowest());
+        for (uint32_t i = 0; i < m_object_sources.size(); i++)
+        {
+            if (m_object_sources[i] == s_no_source)
+            {
+                continue;
+            }
+            if (m_object_sources[i] >= m_sources.size())
+            {
+                throw std::runtime_error(std::format("[Error] Object {} references mesh source {} of {}", i, m_object_sources[i], m_sources.size()));
+            }
+
+            const glm::vec3 position(store.models()[i][3]);
+            min = glm::min(min, glm::vec2(position.x, position.z));
+            max = glm::max(max, glm::vec2(position.x, position.z));
+        }
+        if (min.x > max.x)
+        {
+            min = max = glm::vec2(0.0f);
+        }
+
+        const glm::uvec2 size = glm::max(glm::uvec2(glm::ceil((max - min) / m_options.cell_size)), glm::uvec2(1));
+        m_cells.resize(size.x * size.y);
+        for (uint32_t y = 0; y < size.y; y++)
+        {
+            for (uint32_t x = 0; x < size.x; x++)
+            {
+                m_cells[y * size.x + x].center = min + (glm::vec2(x, y) + 0.5f) * m_options.cell_size;
+            }
+        }
+
+        m_object_cells.assign(m_object_sources.size(), s_no_source);
+        m_cell_offsets.assign(m_cells.size() + 1, 0);
+        m_source_offsets.assign(m_sources.size() + 1, 0);
+        for (uint32_t i = 0; i < m_object_sources.size(); i++)
+        {
+            if (m_object_sources[i] == s_no_source)
+            {
+                continue;
+            }
+
+            const glm::vec3 position(store.models()[i][3]);
+            const glm::vec2 offset = glm::max((glm::vec2(position.x, position.z) - min) / m_options.cell_size, glm::vec2(0.0f));
+            const glm::uvec2 cell = glm::min(glm::uvec2(offset), size - 1u);
+            m_object_cells[i] = cell.y * size.x + cell.x;
+            m_cell_offsets[m_object_cells[i] + 1]++;
+            m_source_offsets[m_object_sources[i] + 1]++;
+        }
+        std::partial_sum(m_cell_offsets.begin(), m_cell_offsets.end(), m_cell_offsets.begin());
+        std::partial_sum(m_source_offsets.begin(), m_source_offsets.end(), m_source_offsets.begin());
+
+        m_cell_objects.resize(m_cell_offsets.back());
+        m_source_objects.resize(m_source_offsets.back());
+        std::vector<uint32_t> cell_cursor(m_cell_offsets.begin(), m_cell_offsets.end() - 1);
+        std::vector<uint32_t> source_cursor(m_source_offsets.begin(), m_source_offsets.end() - 1);
+        for (uint32_t i = 0; i < m_object_sources.size(); i++)
+        {
+            if (m_object_sources[i] != s_no_source)
+            {
+                m_cell_objects[cell_cursor[m_object_cells[i]]++] = i;
+                m_source_objects[source_cursor[m_object_sources[i]]++] = i;
+            }
+        }
+
+        m_statistics.cells = static_cast<uint32_t>(m_cells.size());
+        m_statistics.load_radius = m_load_radius;
+    }
+
+    SceneStreamer::~SceneStreamer()
+    {
+        for (auto& request : m_loads)
+        {
+            Nebula::JobSystem::instance().wait(request.done);
+        }
+    }
+
+    bool SceneStreamer::update(const glm::vec3& eye)
+    {
+        m_changed.clear();
+        m_changed_sources.clear();
+        m_statistics.uploaded_bytes = 0;
+        m_statistics.blas_builds = 0;
+
+        // Shrinking by a cell per frame evicts the furthest cells first, growing back is slower so the two do not alternate.
+        if (_is_over_budget())
+        {
+            m_load_radius = std::max(m_load_radius - m_options.cell_size, 0.0f);
+        }
+        else if (m_options.memory_budget == 0 || 4 * m_resident_bytes < 3 * m_options.memory_budget)
+        {
+            m_load_radius = std::min(m_load_radius + s_radius_growth * m_options.cell_size, m_options.load_radius);
+        }
+        const float evict_radius = m_load_radius + m_options.evict_radius - m_options.load_radius;
+
+        const glm::vec2 position(eye.x, eye.z);
+        std::vector<std::pair<float, uint32_t>> requested;
+        for (uint32_t i = 0; i < m_cells.size(); i++)
+        {
+            if (m_cell_offsets[i] == m_cell_offsets[i + 1])
+            {
+                continue;
+            }
+
+            const float distance = glm::distance(position, m_cells[i].center);
+            if (m_cells[i].resident && distance > evict_radius)
+            {
+                _evict_cell(i);
+            }
+            else if (!m_cells[i].resident && distance <= m_load_radius)
+            {
+                requested.emplace_back(distance, i);
+            }
+        }
+
+        // Nearest cells are queued first.
+        std::ranges::sort(requested);
+        for (const auto& [distance, cell] : requested)
+        {
+            _load_cell(cell);
+        }
+
+        _upload_loads();
+        _start_loads();
+        _build_blases();
+
+        std::ranges::sort(m_changed);
+        m_changed.erase(std::ranges::unique(m_changed).begin(), m_changed.end());
+        std::ranges::sort(m_changed_sources);
+        m_changed_sources.erase(std::ranges::unique(m_changed_sources).begin(), m_changed_sources.end());
+
+        m_statistics.resident_cells = static_cast<uint32_t>(std::ranges::count_if(m_cells, [](const Cell& cell) { return cell.resident; }));
+        m_statistics.resident_meshes = static_cast<uint32_t>(std::ranges::count_if(m_sources, [](const Source& source) {
+            return source.state == SourceState::eResident;
+        }));
+        m_statistics.pending_loads = static_cast<uint32_t>(std::ranges::count_if(m_sources, [](const Source& source) {
+            return source.state == SourceState::eQueued || source.state == SourceState::eLoading;
+        }));
+        m_statistics.resident_bytes = m_resident_bytes;
+        m_statistics.load_radius = m_load_radius;
+
+        return !m_changed.empty() || !m_changed_sources.empty();
+    }
+
+    std::shared_ptr<sdvk::Mesh> SceneStreamer::mesh(const uint32_t object) const
+    {
+        const uint32_t source = m_object_sources[object];
+        if (source == s_no_source || !m_cells[m_object_cells[object]].resident)
+        {
+            return nullptr;
+        }
+        return m_sources[source].mesh;
+    }
+
+    void SceneStreamer::_load_cell(const uint32_t cell)
+    {
+        m_cells[cell].resident = true;
+        for (uint32_t i = m_cell_offsets[cell]; i < m_cell_offsets[cell + 1]; i++)
+        {
+            const uint32_t object = m_cell_objects[i];
+            const uint32_t index = m_object_sources[object];
+            auto& source = m_sources[index];
+            source.users++;
+
+            if (source.state == SourceState::eUnloaded)
+            {
+                source.state = SourceState::eQueued;
+                m_load_queue.push_back(index);
+            }
+            else if (source.mesh)
+            {
+                m_changed.push_back(object);
+            }
+        }
+    }
+
+    void SceneStreamer::_evict_cell(const uint32_t cell)
+    {
+        m_cells[cell].resident = false;
+        for (uint32_t i = m_cell_offsets[cell]; i < m_cell_offsets[cell + 1]; i++)
+        {
+            const uint32_t object = m_cell_objects[i];
+            const uint32_t index = m_object_sources[object];
+            if (m_sources[index].mesh)
+            {
+                m_changed.push_back(object);
+            }
+            if (--m_sources[index].users == 0)
+            {
+                _release_source(index);
+            }
+        }
+    }
+
+    void SceneStreamer::_release_source(const uint32_t index)
+    {
+        // A running load is dropped once it finished, a queued one is skipped.
+        auto& source = m_sources[index];
+        if (source.state == SourceState::eQueued)
+        {
+            source.state = SourceState::eUnloaded;
+        }
+        else if (source.state == SourceState::eResident)
+        {
+            // Buffers and BLAS are destroyed once the scene dropped the mesh as well and the frames in flight finished.
+            source.mesh.reset();
+            m_resident_bytes -= source.bytes;
+            source.bytes = 0;
+            source.state = SourceState::eUnloaded;
+            m_changed_sources.push_back(index);
+        }
+    }
+
+    void SceneStreamer::_start_loads()
+    {
+        while (m_loads.size() < s_max_loads_in_flight && !m_load_queue.empty())
+        {
+            const uint32_t index = m_load_queue.front();
+            m_load_queue.pop_front();
+            if (m_sources[index].state != SourceState::eQueued)
+            {
+                continue;
+            }
+            m_sources[index].state = SourceState::eLoading;
+
+            auto& request = m_loads.emplace_back();
+            request.source = index;
+            request.mesh_source = &m_mesh_sources[index];
+            request.job = { [](void* data) {
+                auto& load = *static_cast<LoadRequest*>(data);
+                load.geometry = load.mesh_source->load();
+                load.meshlets = sdvk::Mesh::create_meshlets(*load.geometry);
+            }, &request, &request.done };
+            Nebula::JobSystem::instance().submit(request.job);
+        }
+    }
+
+    void SceneStreamer::_upload_loads()
+    {
+        for (auto it = m_loads.begin(); it != m_loads.end();)
+        {
+            if (!it->done.is_done())
+            {
+                ++it;
+                continue;
+            }
+
+            auto& source = m_sources[it->source];
+            if (source.users == 0)
+            {
+                // Every cell using it was evicted while it loaded.
+                source.state = SourceState::eUnloaded;
+                it = m_loads.erase(it);
+                continue;
+            }
+
+            const vk::DeviceSize bytes = sizeof(VertexData) * it->geometry->vertex_count()
+                                       + sizeof(uint32_t) * it->geometry->index_count()
+                                       + sizeof(sdvk::Meshlet) * it->meshlets.size();
+            if ((m_statistics.uploaded_bytes > 0 && m_statistics.uploaded_bytes + bytes > m_options.upload_budget)
+                || !m_context.memory_manager()->accepts_uploads())
+            {
+                break;
+            }
+
+            source.mesh = m_mesh_registry.create(it->geometry.release(), std::move(it->meshlets), it->mesh_source->name, false);
+            source.bytes = bytes;
+            source.state = SourceState::eResident;
+            m_resident_bytes += bytes;
+            m_statistics.uploaded_bytes += bytes;
+
+            m_changed_sources.push_back(it->source);
+            _mark_source_objects(it->source);
+            if (m_context.is_raytracing_capable() && !source.mesh->has_blas())
+            {
+                m_blas_queue.push_back(it->source);
+            }
+            it = m_loads.erase(it);
+        }
+    }
+
+    void SceneStreamer::_build_blases()
+    {
+        uint32_t triangles = 0;
+        while (!m_blas_queue.empty())
+        {
+            const auto& mesh = m_sources[m_blas_queue.front()].mesh;
+            if (!mesh || mesh->has_blas())
+            {
+                m_blas_queue.pop_front();
+                continue;
+            }
+
+            const uint32_t triangle_count = mesh->geometry().index_count() / 3;
+            if (m_statistics.blas_builds > 0 && triangles + triangle_count > m_options.blas_triangle_budget)
+            {
+                break;
+            }
+            m_blas_queue.pop_front();
+
+            mesh->build_blas(m_command_buffers, m_context);
+            triangles += triangle_count;
+            m_statistics.blas_builds++;
+
+            // Sources with equal geometry share the mesh and its BLAS.
+            for (uint32_t i = 0; i < m_sources.size(); i++)
+            {
+                if (m_sources[i].mesh == mesh)
+                {
+                    _mark_source_objects(i);
+                }
+            }
+        }
+    }
+
+    void SceneStreamer::_mark_source_objects(const uint32_t source)
+    {
+        for (uint32_t i = m_source_offsets[source]; i < m_source_offsets[source + 1]; i++)
+        {
+            const uint32_t object = m_source_objects[i];
+            if (m_cells[m_object_cells[object]].resident)
+            {
+                m_changed.push_back(object);
+            }
+        }
+    }
+
+    bool SceneStreamer::_is_over_budget() const
+    {
+        return (m_options.memory_budget > 0 && m_resident_bytes > m_options.memory_budget)
+            || m_context.memory_manager()->level() >= sdvk::MemoryPressureLevel::eEvictColdMeshes;
+    }
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+#include <Nebula/JobSystem.hpp>
+#include <Resources/Geometry.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+
+namespace sdvk
+{
+    class CommandBuffers;
+    class Context;
+    class MeshRegistry;
+}
+
+namespace sd
+{
+    class SceneStore;
+
+    // Geometry of streamed objects, created on demand.
+    struct MeshSource
+    {
+        std::string name;
+        // Runs on a worker thread of the job system, must not touch Vulkan objects.
+        std::function<std::unique_ptr<Geometry>()> load;
+    };
+
+    struct SceneStreamingOptions
+    {
+        // Only generated scenes stream their meshes.
+        bool enabled { false };
+
+        // Edge length of the square cells the XZ plane is divided into.
+        float cell_size { 32.0f };
+
+        // Cells with their center closer to the camera are loaded, cells further than evict_radius are evicted.
+        float load_radius { 96.0f };
+        float evict_radius { 128.0f };
+
+        // Geometry and meshlet bytes uploaded per frame, a frame uploads at least one mesh.
+        vk::DeviceSize upload_budget { 4ull << 20 };
+
+        // Triangles of the BLASes built per frame, a frame builds at least one.
+        uint32_t blas_triangle_budget { 1u << 18 };
+
+        // Device memory of the streamed meshes, the load radius shrinks while it is exceeded. 0: unlimited.
+        vk::DeviceSize memory_budget { 0 };
+    };
+
+    struct StreamingStatistics
+    {
+        uint32_t       cells { 0 };
+        uint32_t       resident_cells { 0 };
+        uint32_t       resident_meshes { 0 };
+        // Queued or running on the job system, or waiting for their upload.
+        uint32_t       pending_loads { 0 };
+        uint32_t       blas_builds { 0 };
+        vk::DeviceSize uploaded_bytes { 0 };
+        // Counted per source, sources with equal geometry share one mesh but count separately.
+        vk::DeviceSize resident_bytes { 0 };
+        float          load_radius { 0.0f };
+    };
+
+    /**
+     * Streams the meshes of a scene in square cells around the camera. Geometry and meshlets of cells entering the load
+     * radius are created on the job system, finished loads are uploaded within a per-frame byte budget and the BLASes of
+     * uploaded meshes are built over the following frames. Objects get their mesh once it is uploaded and become visible
+     * to ray tracing once its BLAS is built. Cells leaving the evict radius release their meshes, the load radius shrinks
+     * while the streamed meshes exceed the memory budget or the memory manager is about to evict meshes.
+     */
+    class SceneStreamer
+    {
+    public:
+        /**
+         * object_sources holds the source of every object of the store, s_no_source for objects that are not streamed.
+         * Cells are assigned by the position of the objects at creation, objects moving across cells keep theirs.
+         */
+        SceneStreamer(const SceneStreamingOptions& options, std::vector<MeshSource>&& sources, std::vector<uint32_t>&& object_sources,
+                      const SceneStore& store, sdvk::MeshRegistry& mesh_registry,
+                      const sdvk::CommandBuffers& command_buffers, const sdvk::Context& context);
+
+        // Waits for the loads still running.
+        ~SceneStreamer();
+
+        SceneStreamer(const SceneStreamer&) = delete;
+        SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+        /**
+         * Loads and evicts cells around the eye, uploads finished loads and builds BLASes within the budgets.
+         * Returns true if objects or sources changed their mesh, see changed() and changed_sources().
+         */
+        bool update(const glm::vec3& eye);
+
+        // Null while the cell of the object or its mesh is not resident.
+        std::shared_ptr<sdvk::Mesh> mesh(uint32_t object) const;
+
+        // Null while the source is not resident.
+        const std::shared_ptr<sdvk::Mesh>& source_mesh(uint32_t source) const { return m_sources[source].mesh; }
+
+        uint32_t source(uint32_t object) const { return m_object_sources[object]; }
+
+        uint32_t source_count() const { return static_cast<uint32_t>(m_sources.size()); }
+
+        // Objects that got or lost their mesh or whose mesh got its BLAS in the last update(), in ascending order.
+        const std::vector<uint32_t>& changed() const { return m_changed; }
+
+        // Sources that became resident or were released in the last update(), in ascending order.
+        const std::vector<uint32_t>& changed_sources() const { return m_changed_sources; }
+
+        // Of the last update().
+        const StreamingStatistics& statistics() const { return m_statistics; }
+
+        static constexpr uint32_t s_no_source = std::numeric_limits<uint32_t>::max();
+
+        // Loads on the job system or waiting for their upload, further ones wait so other jobs are not stuck behind them.
+        static constexpr uint32_t s_max_loads_in_flight = 16;
+
+        // Cells the load radius grows back per frame once the streamed meshes are below 3/4 of the memory budget.
+        static constexpr float s_radius_growth = 0.125f;
+
+    private:
+        enum class SourceState
+        {
+            eUnloaded,
+            eQueued,
+            eLoading,
+            eResident,
+        };
+
+        struct Source
+        {
+            SourceState                 state { SourceState::eUnloaded };
+            // Objects in resident cells using the source.
+            uint32_t                    users { 0 };
+            std::shared_ptr<sdvk::Mesh> mesh;
+            vk::DeviceSize              bytes { 0 };
+        };
+
+        struct Cell
+        {
+            glm::vec2 center { 0.0f };
+            bool      resident { false };
+        };
+
+        // Written by its job, requests stay in place until they are uploaded or dropped.
+        struct LoadRequest
+        {
+            uint32_t                   source { 0 };
+            const MeshSource*          mesh_source { nullptr };
+            std::unique_ptr<Geometry>  geometry;
+            std::vector<sdvk::Meshlet> meshlets;
+            Nebula::Job                job;
+            Nebula::JobCounter         done;
+        };
+
+        void _load_cell(uint32_t cell);
+
+        void _evict_cell(uint32_t cell);
+
+        void _release_source(uint32_t source);
+
+        void _start_loads();
+
+        void _upload_loads();
+
+        void _build_blases();
+
+        // Objects in resident cells using the source.
+        void _mark_source_objects(uint32_t source);
+
+        bool _is_over_budget() const;
+
+        SceneStreamingOptions m_options;
+        float                 m_load_radius { 0.0f };
+
+        std::vector<MeshSource> m_mesh_sources;
+        std::vector<Source>     m_sources;
+        std::vector<uint32_t>   m_object_sources;
+        std::vector<uint32_t>   m_object_cells;
+
+        std::vector<Cell>     m_cells;
+        // Objects of cell i are m_cell_objects[m_cell_offsets[i], m_cell_offsets[i + 1]), the same for sources.
+        std::vector<uint32_t> m_cell_offsets;
+        std::vector<uint32_t> m_cell_objects;
+        std::vector<uint32_t> m_source_offsets;
+        std::vector<uint32_t> m_source_objects;
+
+        std::deque<uint32_t>    m_load_queue;
+        std::list<LoadRequest>  m_loads;
+        std::deque<uint32_t>    m_blas_queue;
+        vk::DeviceSize          m_resident_bytes { 0 };
+
+        std::vector<uint32_t>   m_changed;
+        std::vector<uint32_t>   m_changed_sources;
+        StreamingStatistics     m_statistics;
+
+        sdvk::MeshRegistry&         m_mesh_registry;
+        const sdvk::CommandBuffers& m_command_buffers;
+        const sdvk::Context&        m_context;
+    };
+}
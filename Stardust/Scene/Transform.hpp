@@ -11,13 +11,14 @@ namespace sd
     {
         glm::vec3 position {0, 0, 0};
         glm::vec3 scale    {1, 1, 1};
-        glm::quat rotation = glm::quat();
+        glm::quat rotation = glm::quat(1, 0, 0, 0);
 
+        // Scalar reference, the scene evaluates all objects at once in SceneStore::update_transforms.
         glm::mat4 model() const
         {
             auto T = glm::translate(glm::mat4(1.0f), position);
             auto S = glm::scale(glm::mat4(1.0f), scale);
-            auto R = glm::rotate(glm::mat4(1.0f), glm::radians(0.0f), glm::vec3(0, 1, 0));
+            auto R = glm::mat4_cast(glm::normalize(rotation));
             return T * R * S;
         }
 
@@ -1,11 +1,18 @@
 #include "Builder.h"
 
+#include <format>
+#include <stdexcept>
+
 #include <VirtualGraph/Common/NodeFactory.hpp>
 #include <VirtualGraph/Compile/DefaultCompileStrategy.hpp>
 #include <VirtualGraph/Compile/OptimizedCompileStrategy.hpp>
 
 namespace Nebula::RenderGraph
 {
+    const std::vector<std::string> Builder::s_graph_presets = {
+        "default", "gbuffer", "lighting_ssao", "lighting_rtao", "post_chain",
+    };
+
     Builder::Builder(const std::shared_ptr<RenderGraphContext>& rgctx)
     : m_ctx(rgctx)
     {
@@ -60,7 +67,28 @@ namespace Nebula::RenderGraph
         return compiler->compile(nodes_vector, m_edges, true);
     }
 
+    void Builder::compile_async(Compiler::AsyncGraphCompiler& compiler, const Compiler::CompilerType mode) const
+    {
+        std::vector<node_ptr> nodes_vector;
+        for (const auto& [k, v] : m_nodes)
+        {
+            nodes_vector.push_back(v);
+        }
+
+        compiler.submit(nodes_vector, m_edges, mode);
+    }
+
     Compiler::CompileResult Builder::create_initial_graph(const std::shared_ptr<RenderGraphContext>& rgctx)
+    {
+        return make_initial_graph(rgctx).compile(Compiler::CompilerType::eResourceOptimized);
+    }
+
+    Compiler::CompileResult Builder::create_preset_graph(const std::string& preset, const std::shared_ptr<RenderGraphContext>& rgctx)
+    {
+        return make_preset_graph(preset, rgctx).compile(Compiler::CompilerType::eResourceOptimized);
+    }
+
+    Builder Builder::make_initial_graph(const std::shared_ptr<RenderGraphContext>& rgctx)
     {
         Builder builder(rgctx);
 
@@ -73,7 +101,7 @@ namespace Nebula::RenderGraph
 
         pass_b->as<Editor::LightingPassNode>().params.ambient_occlusion = true;
 
-        auto compile_result = builder
+        builder
             .make_connection(pass_c, pass_a, "Scene Data")
             .make_connection(pass_c, pass_b, "Camera")
             .make_connection(pass_c, pass_b, "TLAS")
@@ -87,9 +115,81 @@ namespace Nebula::RenderGraph
             .make_connection(pass_a, pass_e, "Position Buffer")
             .make_connection(pass_a, pass_e, "Normal Buffer")
             .make_connection(pass_b, pass_f, "Lighting Result", "Anti-Aliasing Input")
-            .make_connection(pass_f, pass_d, "Anti-Aliasing Output", "Final Image")
-            .compile(Compiler::CompilerType::eResourceOptimized);
+            .make_connection(pass_f, pass_d, "Anti-Aliasing Output", "Final Image");
+
+        return builder;
+    }
+
+    Builder Builder::make_preset_graph(const std::string& preset, const std::shared_ptr<RenderGraphContext>& rgctx)
+    {
+        if (preset == "default")
+        {
+            return make_initial_graph(rgctx);
+        }
+
+        Builder builder(rgctx);
+
+        const auto scene_provider = builder.add_pass(NodeType::eSceneProvider);
+        const auto g_buffer       = builder.add_pass(NodeType::eGBufferPass);
+        const auto present        = builder.add_pass(NodeType::ePresent);
+
+        builder.make_connection(scene_provider, g_buffer, "Scene Data");
+
+        if (preset == "gbuffer")
+        {
+            builder.make_connection(g_buffer, present, "Albedo Buffer", "Final Image");
+            return builder;
+        }
+
+        const auto lighting = builder.add_pass(NodeType::eLightingPass);
+        builder
+            .make_connection(scene_provider, lighting, "Camera")
+            .make_connection(scene_provider, lighting, "TLAS")
+            .make_connection(g_buffer, lighting, "Position Buffer")
+            .make_connection(g_buffer, lighting, "Normal Buffer")
+            .make_connection(g_buffer, lighting, "Albedo Buffer")
+            .make_connection(g_buffer, lighting, "Depth Buffer");
+
+        if (preset == "lighting_ssao" || preset == "lighting_rtao")
+        {
+            const auto ambient_occlusion = builder.add_pass(NodeType::eAmbientOcclusion);
+            ambient_occlusion->as<Editor::AmbientOcclusionNode>().params.mode = (preset == "lighting_rtao")
+                ? AmbientOcclusionMode::eRTAO
+                : AmbientOcclusionMode::eSSAO;
+            lighting->as<Editor::LightingPassNode>().params.ambient_occlusion = true;
+
+            builder
+                .make_connection(scene_provider, ambient_occlusion, "Camera")
+                .make_connection(scene_provider, ambient_occlusion, "TLAS")
+                .make_connection(g_buffer, ambient_occlusion, "Position Buffer")
+                .make_connection(g_buffer, ambient_occlusion, "Normal Buffer")
+                .make_connection(ambient_occlusion, lighting, "AO Image")
+                .make_connection(lighting, present, "Lighting Result", "Final Image");
+            return builder;
+        }
+
+        if (preset == "post_chain")
+        {
+            // Lighting -> 4x Blur -> Anti-Aliasing -> Present, exercises image aliasing in the optimized compiler.
+            static constexpr int32_t blur_count = 4;
+
+            auto previous = lighting;
+            std::string previous_output = "Lighting Result";
+            for (int32_t i = 0; i < blur_count; i++)
+            {
+                const auto blur = builder.add_pass(NodeType::eGaussianBlur);
+                builder.make_connection(previous, blur, previous_output, "Blur Input");
+                previous = blur;
+                previous_output = "Blur Output";
+            }
+
+            const auto anti_aliasing = builder.add_pass(NodeType::eAntiAliasing);
+            builder
+                .make_connection(previous, anti_aliasing, previous_output, "Anti-Aliasing Input")
+                .make_connection(anti_aliasing, present, "Anti-Aliasing Output", "Final Image");
+            return builder;
+        }
 
-        return compile_result;
+        throw std::runtime_error(std::format("[Error] Unknown graph preset \"{}\"", preset));
     }
 }
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <VirtualGraph/Common/GraphContext.hpp>
+#include <VirtualGraph/Compile/AsyncGraphCompiler.hpp>
 #include <VirtualGraph/Compile/CompileResult.hpp>
 #include <VirtualGraph/Compile/CompilerType.hpp>
 #include <VirtualGraph/Editor/Edge.hpp>
@@ -32,6 +33,16 @@ namespace Nebula::RenderGraph
 
         static Compiler::CompileResult create_initial_graph(const std::shared_ptr<RenderGraphContext>& rgctx);
 
+        // Named graphs for headless runs and the performance regression tests, see s_graph_presets.
+        static Compiler::CompileResult create_preset_graph(const std::string& preset, const std::shared_ptr<RenderGraphContext>& rgctx);
+
+        // Uncompiled builders of the graphs above, for compile_async().
+        static Builder make_initial_graph(const std::shared_ptr<RenderGraphContext>& rgctx);
+
+        static Builder make_preset_graph(const std::string& preset, const std::shared_ptr<RenderGraphContext>& rgctx);
+
+        static const std::vector<std::string> s_graph_presets;
+
         node_ptr& add_pass(NodeType pass_type);
 
         Builder& make_connection(const node_ptr& start_node, const node_ptr& end_node, const std::string& resource_name);
@@ -41,6 +52,10 @@ namespace Nebula::RenderGraph
 
         Compiler::CompileResult compile(Compiler::CompilerType mode = Compiler::CompilerType::eResourceOptimized);
 
+        // The render path is swapped in by compiler.poll() once it is ready.
+        void compile_async(Compiler::AsyncGraphCompiler& compiler,
+                           Compiler::CompilerType mode = Compiler::CompilerType::eResourceOptimized) const;
+
     private:
         std::shared_ptr<RenderGraphContext> m_ctx;
         std::vector<Editor::Edge>           m_edges;
@@ -9,7 +9,16 @@ namespace Nebula::RenderGraph
     RenderGraphContext::RenderGraphContext(const sdvk::CommandBuffers& command_buffers,
                                            const sdvk::Context& context,
                                            const sdvk::Swapchain& swapchain)
-    : m_command_buffers(command_buffers), m_context(context), m_swapchain(swapchain)
+    : m_command_buffers(command_buffers), m_context(context), m_swapchain(&swapchain)
+    {
+        set_render_resolution(sd::Application::s_extent.vk_ext());
+        set_target_resolution(sd::Application::s_extent.vk_ext());
+    }
+
+    RenderGraphContext::RenderGraphContext(const sdvk::CommandBuffers& command_buffers,
+                                           const sdvk::Context& context,
+                                           const sdvk::OffscreenTarget& offscreen_target)
+    : m_command_buffers(command_buffers), m_context(context), m_offscreen_target(&offscreen_target)
     {
         set_render_resolution(sd::Application::s_extent.vk_ext());
         set_target_resolution(sd::Application::s_extent.vk_ext());
@@ -12,6 +12,7 @@ namespace sdvk
 {
     class CommandBuffers;
     class Context;
+    class OffscreenTarget;
     class Swapchain;
 }
 
@@ -24,6 +25,11 @@ namespace Nebula::RenderGraph
                            const sdvk::Context& context,
                            const sdvk::Swapchain& swapchain);
 
+        // Headless mode, the render path presents into an offscreen target instead of a swapchain.
+        RenderGraphContext(const sdvk::CommandBuffers& command_buffers,
+                           const sdvk::Context& context,
+                           const sdvk::OffscreenTarget& offscreen_target);
+
         const sdvk::CommandBuffers& command_buffers() const
         {
             return m_command_buffers;
@@ -34,11 +40,23 @@ namespace Nebula::RenderGraph
             return m_context;
         }
 
-        const sdvk::Swapchain& swapchain() const
+        // nullptr in headless mode.
+        const sdvk::Swapchain* swapchain() const
         {
             return m_swapchain;
         }
 
+        // nullptr unless in headless mode.
+        const sdvk::OffscreenTarget* offscreen_target() const
+        {
+            return m_offscreen_target;
+        }
+
+        bool is_headless() const
+        {
+            return m_offscreen_target != nullptr;
+        }
+
         const std::shared_ptr<sd::Scene>& scene() const
         {
             return m_selected_scene;
@@ -59,8 +77,10 @@ namespace Nebula::RenderGraph
             m_selected_scene = std::shared_ptr<sd::Scene>(scene);
         }
 
+        // The replaced path is kept alive until the next swap, the frame being recorded may still reference its resources.
         void set_render_path(const std::shared_ptr<RenderPath>& render_path)
         {
+            m_retired_render_path = m_render_path;
             m_render_path = render_path;
         }
 
@@ -74,6 +94,17 @@ namespace Nebula::RenderGraph
             m_target_resolution = target_resolution;
         }
 
+        bool accumulation_enabled() const
+        {
+            return m_accumulation_enabled;
+        }
+
+        // Applied to the nodes of every graph compiled afterwards, see Node::set_accumulation_enabled.
+        void set_accumulation_enabled(const bool enabled)
+        {
+            m_accumulation_enabled = enabled;
+        }
+
         const std::shared_ptr<RenderPath>& get_render_path() const
         {
             return m_render_path;
@@ -82,11 +113,14 @@ namespace Nebula::RenderGraph
     private:
         vk::Extent2D                m_render_resolution;
         vk::Extent2D                m_target_resolution;
+        bool                        m_accumulation_enabled {true};
         std::shared_ptr<sd::Scene>  m_selected_scene;
         std::shared_ptr<RenderPath> m_render_path;
+        std::shared_ptr<RenderPath> m_retired_render_path;
 
         const sdvk::CommandBuffers& m_command_buffers;
         const sdvk::Context&        m_context;
-        const sdvk::Swapchain&      m_swapchain;
+        const sdvk::Swapchain*      m_swapchain {nullptr};
+        const sdvk::OffscreenTarget* m_offscreen_target {nullptr};
     };
 }
\ No newline at end of file
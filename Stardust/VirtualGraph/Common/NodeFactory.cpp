@@ -12,6 +12,7 @@
 #include <VirtualGraph/RenderGraph/Nodes/RayTracingNode.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/PresentNode.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/MeshGBufferPass.hpp>
+#include <Vulkan/Context.hpp>
 
 namespace Nebula::RenderGraph
 {
@@ -24,7 +25,7 @@ namespace Nebula::RenderGraph
         switch (type)
         {
             case NodeType::eAmbientOcclusion:
-                return std::make_shared<AmbientOcclusionNode>(ctx);
+                return std::make_shared<AmbientOcclusionNode>(ctx, dynamic_cast<Editor::AmbientOcclusionNode&>(*en).params);
             case NodeType::eAntiAliasing:
                 return std::make_shared<AntiAliasingNode>(ctx);
             case NodeType::eGaussianBlur:
@@ -34,11 +35,19 @@ namespace Nebula::RenderGraph
             case NodeType::eGBufferPass:
                 return std::make_shared<GBufferPass>(ctx);
             case NodeType::eMeshShaderGBufferPass:
+                if (!ctx.is_extension_enabled(VK_EXT_MESH_SHADER_EXTENSION_NAME))
+                {
+                    throw Utility::make_exception("Mesh shader G-Buffer pass requires a mesh shader capable device");
+                }
                 return std::make_shared<MeshGBufferPass>(ctx, dynamic_cast<Editor::MeshGBufferPassEditorNode&>(*en).m_params);
             case NodeType::eRayTracing:
+                if (!ctx.is_raytracing_capable())
+                {
+                    throw Utility::make_exception("Ray tracing node requires a ray tracing capable device");
+                }
                 return std::make_shared<RayTracingNode>(ctx, dynamic_cast<Editor::RayTracingNode&>(*en).params);
             case NodeType::ePresent:
-                return std::make_shared<PresentNode>(ctx, m_graph_context.swapchain(), dynamic_cast<Editor::PresentNode&>(*en).params);
+                return std::make_shared<PresentNode>(ctx, m_graph_context.swapchain(), m_graph_context.offscreen_target(), dynamic_cast<Editor::PresentNode&>(*en).params);
             case NodeType::eSceneProvider:
                 return std::make_shared<SceneProviderNode>(m_graph_context.scene());
             case NodeType::eUnknown:
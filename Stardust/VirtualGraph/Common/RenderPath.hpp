@@ -1,11 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include <Nebula/Barrier.hpp>
 #include <Nebula/Image.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/Node.hpp>
 #include <VirtualGraph/RenderGraph/Resources/Resource.hpp>
+#include <VirtualGraph/RenderGraph/Resources/ResourceTable.hpp>
 
 namespace vk
 {
@@ -18,28 +20,46 @@ namespace Nebula::RenderGraph
     {
         std::vector<std::shared_ptr<Node>> nodes;
 
-        // Image resources
-        std::map<std::string, std::shared_ptr<Resource>> resources;
+        std::shared_ptr<ResourceTable> resources;
+
+        /**
+         * Creates the pipelines and descriptors of every node, on_node is called before each one.
+         * Records no commands, so the compile thread can do it while the previous path is still rendering.
+         * Otherwise done by the first execute().
+         */
+        void initialize(const std::function<void(const Node& node, size_t index)>& on_node = {})
+        {
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                if (on_node)
+                {
+                    on_node(*nodes[i], i);
+                }
+                nodes[i]->initialize();
+            }
+
+            m_nodes_initialized = true;
+        }
 
         void execute(const vk::CommandBuffer& command_buffer)
         {
-            if (!m_is_initialized)
+            if (!m_nodes_initialized)
+            {
+                initialize();
+            }
+
+            if (!m_layouts_initialized)
             {
-                for (const auto& [id, resource] : resources)
+                for (const auto& resource : *resources)
                 {
                     if (resource->type() == ResourceType::eImage)
                     {
-                        auto image = dynamic_cast<ImageResource&>(*resource).get_image();
+                        auto image = static_cast<ImageResource&>(*resource).get_image();
                         Sync::ImageBarrier(image, image->state().layout, vk::ImageLayout::eGeneral).apply(command_buffer);
                     }
                 }
 
-                for (const auto& node : nodes)
-                {
-                    node->initialize();
-                }
-
-                m_is_initialized = true;
+                m_layouts_initialized = true;
             }
 
             for (const auto& node : nodes)
@@ -49,6 +69,7 @@ namespace Nebula::RenderGraph
         }
 
     private:
-        bool m_is_initialized = false;
+        bool m_nodes_initialized = false;
+        bool m_layouts_initialized = false;
     };
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "AsyncGraphCompiler.hpp"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <Nebula/FrameArena.hpp>
+#include <VirtualGraph/Compile/DefaultCompileStrategy.hpp>
+#include <VirtualGraph/Compile/OptimizedCompileStrategy.hpp>
+
+namespace Nebula::RenderGraph::Compiler
+{
+    AsyncGraphCompiler::AsyncGraphCompiler(RenderGraphContext& context)
+    : m_context(context)
+    , m_thread(&AsyncGraphCompiler::_run, this)
+    {
+    }
+
+    AsyncGraphCompiler::~AsyncGraphCompiler()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_progress)
+            {
+                m_progress->cancel();
+            }
+            m_stop = true;
+        }
+        m_condition.notify_one();
+        m_thread.join();
+    }
+
+    void AsyncGraphCompiler::submit(const std::vector<std::shared_ptr<Editor::Node>>& nodes,
+                                    const std::vector<Editor::Edge>& edges,
+                                    const CompilerType mode,
+                                    const Callback& on_finished)
+    {
+        Job job;
+        job.nodes = Editor::Node::snapshot(nodes);
+        job.edges = edges;
+        job.mode = mode;
+        job.on_finished = on_finished;
+        job.progress = std::make_shared<CompileProgress>();
+
+        std::optional<FinishedJob> replaced;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_progress)
+            {
+                m_progress->cancel();
+            }
+            m_progress = job.progress;
+            m_pending = std::move(job);
+            replaced.swap(m_finished);
+        }
+        m_condition.notify_one();
+    }
+
+    void AsyncGraphCompiler::cancel()
+    {
+        std::optional<FinishedJob> cancelled;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_progress)
+            {
+                m_progress->cancel();
+            }
+            m_progress.reset();
+            m_pending.reset();
+            cancelled.swap(m_finished);
+        }
+    }
+
+    std::optional<CompileResult> AsyncGraphCompiler::poll()
+    {
+        std::optional<FinishedJob> finished;
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_finished || m_finished->job.progress != m_progress)
+            {
+                return std::nullopt;
+            }
+            finished.swap(m_finished);
+            m_progress.reset();
+        }
+
+        const auto& result = finished->result;
+        for (const auto& message : result.logs)
+        {
+            std::cout << message << std::endl;
+        }
+
+        if (result.success)
+        {
+            m_context.set_render_path(result.render_path);
+        }
+
+        if (finished->job.on_finished)
+        {
+            finished->job.on_finished(result);
+        }
+
+        return result;
+    }
+
+    bool AsyncGraphCompiler::is_busy() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_progress != nullptr;
+    }
+
+    std::string AsyncGraphCompiler::stage() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_progress ? m_progress->stage() : std::string();
+    }
+
+    float AsyncGraphCompiler::progress() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_progress ? m_progress->fraction() : 0.0f;
+    }
+
+    void AsyncGraphCompiler::_run()
+    {
+        // Descriptor writes of the nodes allocate from the current arena, the frame slot arenas belong to the render thread.
+        FrameArena arena;
+        FrameArena::bind_to_thread(&arena);
+
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stop || m_pending.has_value(); });
+                if (m_stop)
+                {
+                    break;
+                }
+                job = std::move(*m_pending);
+                m_pending.reset();
+            }
+
+            arena.reset();
+            CompileResult result = _compile(job);
+
+            // A cancelled path is released here, its objects go through the DeferredDestructionQueue like any other.
+            std::optional<FinishedJob> dropped;
+            {
+                std::lock_guard lock(m_mutex);
+                FinishedJob finished { std::move(job), std::move(result) };
+                if (finished.job.progress->is_cancelled())
+                {
+                    dropped = std::move(finished);
+                }
+                else
+                {
+                    m_finished = std::move(finished);
+                }
+            }
+        }
+
+        FrameArena::bind_to_thread(nullptr);
+    }
+
+    CompileResult AsyncGraphCompiler::_compile(const Job& job) const
+    {
+        const auto begin_time = std::chrono::steady_clock::now();
+
+        std::unique_ptr<GraphCompileStrategy> compiler;
+        if (job.mode == CompilerType::eNaive)
+        {
+            compiler = std::make_unique<DefaultCompileStrategy>(m_context);
+        }
+        if (job.mode == CompilerType::eResourceOptimized)
+        {
+            compiler = std::make_unique<OptimizedCompileStrategy>(m_context);
+        }
+        compiler->set_progress(job.progress);
+
+        try
+        {
+            // Compilation is the first half of the progress, node initialization the second.
+            job.progress->set_range(0.0f, 0.5f);
+            CompileResult result = compiler->compile(job.nodes, job.edges, true);
+            if (!result.success)
+            {
+                return result;
+            }
+
+            job.progress->set_range(0.5f, 1.0f);
+            const auto node_count = static_cast<float>(result.render_path->nodes.size());
+            result.render_path->initialize([&job, node_count](const Node& node, const size_t index) {
+                job.progress->report(std::format("Initializing \"{}\"", node.name()), static_cast<float>(index) / node_count);
+            });
+
+            const auto total_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin_time);
+            result.logs.push_back(std::format("[Compiler] Graph ready after {} ms on the compile thread", total_time.count()));
+            return result;
+        }
+        catch (const std::exception& ex)
+        {
+            CompileResult result = {};
+            result.success = false;
+            result.failure_message = ex.what();
+            result.logs.emplace_back(ex.what());
+            return result;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <VirtualGraph/Common/GraphContext.hpp>
+#include <VirtualGraph/Compile/CompileProgress.hpp>
+#include <VirtualGraph/Compile/CompileResult.hpp>
+#include <VirtualGraph/Compile/CompilerType.hpp>
+#include <VirtualGraph/Editor/Edge.hpp>
+#include <VirtualGraph/Editor/Node.hpp>
+
+namespace Nebula::RenderGraph::Compiler
+{
+    /**
+     * Compiles graphs on a thread of its own. Resources, nodes and their pipelines are created there while the current
+     * RenderPath keeps rendering, the finished path is swapped in by poll() at the next frame boundary.
+     * Submitting again cancels the running compilation, only the latest submission is ever swapped in.
+     */
+    class AsyncGraphCompiler
+    {
+    public:
+        using Callback = std::function<void(const CompileResult&)>;
+
+        explicit AsyncGraphCompiler(RenderGraphContext& context);
+
+        // Cancels the running compilation and joins the compile thread.
+        ~AsyncGraphCompiler();
+
+        AsyncGraphCompiler(const AsyncGraphCompiler&) = delete;
+        AsyncGraphCompiler& operator=(const AsyncGraphCompiler&) = delete;
+
+        // Compiles a snapshot of the graph, later edits do not affect it. on_finished is called by poll().
+        void submit(const std::vector<std::shared_ptr<Editor::Node>>& nodes,
+                    const std::vector<Editor::Edge>& edges,
+                    CompilerType mode,
+                    const Callback& on_finished = {});
+
+        void cancel();
+
+        // Render thread, before recording a frame: swaps in the render path of a finished compilation and returns its result.
+        std::optional<CompileResult> poll();
+
+        // From submit() until poll() picked up the result.
+        bool is_busy() const;
+
+        std::string stage() const;
+
+        float progress() const;
+
+    private:
+        struct Job
+        {
+            std::vector<std::shared_ptr<Editor::Node>> nodes;
+            std::vector<Editor::Edge>                  edges;
+            CompilerType                               mode { CompilerType::eResourceOptimized };
+            Callback                                   on_finished;
+            std::shared_ptr<CompileProgress>           progress;
+        };
+
+        struct FinishedJob
+        {
+            Job           job;
+            CompileResult result;
+        };
+
+        void _run();
+
+        CompileResult _compile(const Job& job) const;
+
+        mutable std::mutex               m_mutex;
+        std::condition_variable          m_condition;
+        std::optional<Job>               m_pending;
+        std::optional<FinishedJob>       m_finished;
+        std::shared_ptr<CompileProgress> m_progress;
+        bool                             m_stop { false };
+
+        RenderGraphContext& m_context;
+
+        // Started last, after everything the compile thread uses.
+        std::thread m_thread;
+    };
+}
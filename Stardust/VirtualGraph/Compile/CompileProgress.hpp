@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace Nebula::RenderGraph::Compiler
+{
+    // Thrown from a progress report once the compilation has been cancelled.
+    class CompileCancelled : public std::runtime_error
+    {
+    public:
+        CompileCancelled(): std::runtime_error("[Compiler] Compilation cancelled") {}
+    };
+
+    /**
+     * Shared between a compilation running on the compile thread and the render thread.
+     * Compilers report at every step, which is also where a cancelled compilation stops.
+     */
+    class CompileProgress
+    {
+    public:
+        void report(const std::string& stage, const float fraction)
+        {
+            if (is_cancelled())
+            {
+                throw CompileCancelled();
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_stage = stage;
+            m_fraction = m_range_begin + (m_range_end - m_range_begin) * fraction;
+        }
+
+        // Maps the fractions reported by the following step into [begin, end] of the whole compilation.
+        void set_range(const float begin, const float end)
+        {
+            std::lock_guard lock(m_mutex);
+            m_range_begin = begin;
+            m_range_end = end;
+        }
+
+        void cancel()
+        {
+            m_cancelled = true;
+        }
+
+        bool is_cancelled() const
+        {
+            return m_cancelled;
+        }
+
+        std::string stage() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_stage;
+        }
+
+        float fraction() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_fraction;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        std::string        m_stage;
+        float              m_fraction { 0.0f };
+        float              m_range_begin { 0.0f };
+        float              m_range_end { 1.0f };
+        std::atomic<bool>  m_cancelled { false };
+    };
+}
@@ -47,6 +47,8 @@ namespace Nebula::RenderGraph::Compiler
         // 1. Find unreachable nodes (BFS Traversal)
         #pragma region Filter out unreachable nodes by BFS Traversal of RenderGraph
 
+        report_progress("Filtering unreachable nodes", 0.0f);
+
         std::chrono::milliseconds filter_time;
         std::vector<std::shared_ptr<Editor::Node>> connected_nodes;
 
@@ -87,6 +89,8 @@ namespace Nebula::RenderGraph::Compiler
         // 2. To determine execution order of nodes run Topological Sort based on Logical Nodes and Connections.
         #pragma region Topological Sort on reachable nodes
 
+        report_progress("Sorting nodes", 0.1f);
+
         std::chrono::milliseconds tsort_time;
         auto topological_sort = std::make_unique<Algorithm::TopologicalSort>(connected_nodes);
         std::vector<std::shared_ptr<Editor::Node>> topological_ordering;
@@ -118,6 +122,8 @@ namespace Nebula::RenderGraph::Compiler
         // 3. Evaluate required resources
         #pragma region Evaluate required resources
 
+        report_progress("Evaluating resources", 0.2f);
+
         std::chrono::milliseconds resource_eval_time;
         std::map<int32_t, Editor::ResourceDescription> required_resources;
         resource_eval_time = sd::bm::measure<std::chrono::milliseconds>([&] {
@@ -146,11 +152,16 @@ namespace Nebula::RenderGraph::Compiler
         // 4. Create resources
         #pragma region Create resources
 
+        // Nothing is aliased, clears the savings reported for a graph compiled with the optimizer.
+        m_context.context().memory_tracker()->set_alias_savings({});
+
         std::chrono::milliseconds create_time;
-        std::map<std::string, std::shared_ptr<Resource>> created_resources;
+        auto resource_table = std::make_shared<ResourceTable>();
+        std::map<std::string, uint32_t> created_resources; // resource name -> table id
         std::set gpu_types = { ResourceType::eImage, ResourceType::eDepthImage };
 
         create_time = sd::bm::measure<std::chrono::milliseconds>([&]{
+            size_t resource_index = 0;
             for (const auto& [id, resource] : required_resources)
             {
                 if (resource.role == ResourceRole::eInput)
@@ -158,6 +169,9 @@ namespace Nebula::RenderGraph::Compiler
                     continue;
                 }
 
+                report_progress(std::format("Creating resource \"{}\"", resource.name),
+                                0.3f + 0.5f * static_cast<float>(resource_index++) / static_cast<float>(required_resources.size()));
+
                 const auto resource_name = std::format("({:%Y-%m-%d %H:%M}) {}-{}", begin_time, resource.name, id);
                 const auto& res_spec = resource.spec;
                 std::shared_ptr<Resource> new_res;
@@ -206,7 +220,7 @@ namespace Nebula::RenderGraph::Compiler
                     }
                     else if (resource.type == ResourceType::eBuffer)
                     {
-                        const auto& buffer = m_context.scene()->object_descriptions();
+                        const auto& buffer = m_context.scene()->gpu_scene().buffer();
                         new_res = std::make_shared<BufferResource>(buffer, resource_name);
                     }
                     else if (resource.type == ResourceType::eScene)
@@ -224,7 +238,7 @@ namespace Nebula::RenderGraph::Compiler
                     }
                 }
 
-                created_resources.insert({resource.name, new_res });
+                created_resources.insert({ resource.name, resource_table->add(new_res) });
             }
         });
         m_logs.push_back(std::format("[Info] Created {} resource(s) ({}ms)", std::to_string(created_resources.size()), create_time.count()));
@@ -234,6 +248,8 @@ namespace Nebula::RenderGraph::Compiler
         // 5. Create real nodes
         #pragma region Create real nodes
 
+        report_progress("Creating nodes", 0.8f);
+
         std::vector<std::shared_ptr<Node>> real_nodes;
         std::map<int32_t, int32_t> id_to_node;
         auto node_creation_time = sd::bm::measure<std::chrono::milliseconds>([&](){
@@ -253,13 +269,18 @@ namespace Nebula::RenderGraph::Compiler
         // 6. Connect resources to nodes
         #pragma region Connect resources to nodes
 
+        report_progress("Connecting resources", 0.9f);
+
         auto resource_connection_time = sd::bm::measure<std::chrono::milliseconds>([&]{
             // Set Outputs
             for (const auto& node : real_nodes)
             {
-                for (const auto& [name, res] : created_resources)
+                node->set_resource_table(resource_table);
+                node->set_render_resolution(m_context.render_resolution());
+                node->set_accumulation_enabled(m_context.accumulation_enabled());
+                for (const auto& [name, res_id] : created_resources)
                 {
-                    node->set_resource(name, res);
+                    node->set_resource(name, res_id);
                 }
             }
 
@@ -278,11 +299,15 @@ namespace Nebula::RenderGraph::Compiler
                 }
 
                 // Get resource to be connected
-                auto& resource = created_resources[edge.start.res_name];
+                if (!created_resources.contains(edge.start.res_name))
+                {
+                    continue;
+                }
+                const uint32_t resource_id = created_resources[edge.start.res_name];
 
                 // Set resource
                 const auto& end_node = real_nodes[id_to_node[edge.end.node_id]];
-                end_node->set_resource(edge.end.res_name, resource);
+                end_node->set_resource(edge.end.res_name, resource_id);
             }
         });
 
@@ -295,7 +320,7 @@ namespace Nebula::RenderGraph::Compiler
         m_logs.push_back(std::format("[Info] Graph compiled in {} ms", compile_time.count()));
 
         auto render_path = std::make_shared<RenderPath>();
-        render_path->resources = created_resources;
+        render_path->resources = resource_table;
         render_path->nodes = real_nodes;
 
         result.compile_time = compile_time;
@@ -27,6 +27,14 @@ namespace Nebula::RenderGraph::Compiler
         fs.close();
     }
 
+    void GraphCompileStrategy::report_progress(const std::string& stage, const float fraction) const
+    {
+        if (m_progress)
+        {
+            m_progress->report(stage, fraction);
+        }
+    }
+
     CompileResult GraphCompileStrategy::make_failed_result(const std::string& message) const
     {
         CompileResult result = {};
@@ -42,11 +50,11 @@ namespace Nebula::RenderGraph::Compiler
     {
         std::vector<std::string> dump;
         dump.emplace_back("[=====[ Begin Resources ]=====]");
-        for (const auto& res : render_path.resources)
+        for (const auto& res : *render_path.resources)
         {
-            dump.push_back(std::format("[Resource] {}", res.second->name()));
-            dump.push_back(std::format("\tType: {}", get_resource_type_str(res.second->type())));
-            dump.push_back(std::format("\tValid: {}", res.second->is_valid() ? "true" : "false"));
+            dump.push_back(std::format("[Resource] {}", res->name()));
+            dump.push_back(std::format("\tType: {}", get_resource_type_str(res->type())));
+            dump.push_back(std::format("\tValid: {}", res->is_valid() ? "true" : "false"));
         }
         dump.emplace_back("[=====[ End Resources ]=====]");
 
@@ -59,14 +67,14 @@ namespace Nebula::RenderGraph::Compiler
             dump.push_back(std::format("\tType: {}", get_node_type_str(node->type())));
             dump.emplace_back("\tResources:");
 
-            auto& resources = node->resources();
             for (const ResourceSpecification& rspec : node->get_resource_specs())
             {
-                const bool is_connected = resources.contains(rspec.name);
+                const uint32_t resource_id = node->resource_id(rspec.name);
+                const bool is_connected = resource_id < render_path.resources->size();
                 const std::string in_or_out = (rspec.role == ResourceRole::eInput) ? "Input" : "Output";
                 dump.push_back(
                     is_connected
-                    ? std::format("\t\t{}: Connected to: {} as {}", rspec.name, resources[rspec.name]->name(), in_or_out)
+                    ? std::format("\t\t{}: Connected to: {} as {}", rspec.name, render_path.resources->at(resource_id)->name(), in_or_out)
                     : std::format("\t\t{}: Missing", rspec.name)
                 );
             }
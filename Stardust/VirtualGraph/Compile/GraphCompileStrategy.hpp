@@ -4,6 +4,7 @@
 #include <string>
 #include <VirtualGraph/Common/GraphContext.hpp>
 #include <VirtualGraph/Common/NodeFactory.hpp>
+#include <VirtualGraph/Compile/CompileProgress.hpp>
 #include <VirtualGraph/Compile/CompileResult.hpp>
 
 namespace Nebula::RenderGraph::Editor
@@ -25,7 +26,16 @@ namespace Nebula::RenderGraph::Compiler
 
         virtual ~GraphCompileStrategy() = default;
 
+        // Compilations on the compile thread report their steps here, and stop at the next step once cancelled.
+        void set_progress(const std::shared_ptr<CompileProgress>& progress)
+        {
+            m_progress = progress;
+        }
+
     protected:
+        // Throws CompileCancelled if the compilation was cancelled.
+        void report_progress(const std::string& stage, float fraction) const;
+
         void write_logs_to_file(const std::string& file_name);
 
         CompileResult make_failed_result(const std::string& message) const;
@@ -38,8 +48,9 @@ namespace Nebula::RenderGraph::Compiler
         static std::vector<std::shared_ptr<Editor::Node>>
         get_execution_order(const std::vector<std::shared_ptr<Editor::Node>>& nodes);
 
-        std::vector<std::string>     m_logs;
-        std::unique_ptr<NodeFactory> m_node_factory;
-        const RenderGraphContext&    m_context;
+        std::vector<std::string>         m_logs;
+        std::unique_ptr<NodeFactory>     m_node_factory;
+        std::shared_ptr<CompileProgress> m_progress;
+        const RenderGraphContext&        m_context;
     };
 }
\ No newline at end of file
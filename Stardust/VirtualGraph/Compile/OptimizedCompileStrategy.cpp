@@ -1,4 +1,5 @@
 #include "OptimizedCompileStrategy.hpp"
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <sstream>
@@ -30,6 +31,7 @@ namespace Nebula::RenderGraph::Compiler
         }
 
         // 1. Find unreachable nodes (BFS Traversal)
+        report_progress("Filtering unreachable nodes", 0.0f);
         std::vector<std::shared_ptr<Editor::Node>> connected_nodes;
         try
         {
@@ -46,6 +48,7 @@ namespace Nebula::RenderGraph::Compiler
         }
 
         // 2. To determine execution order of nodes run Topological Sort based on Logical Nodes and Connections.
+        report_progress("Sorting nodes", 0.1f);
         std::vector<std::shared_ptr<Editor::Node>> execution_order;
         try
         {
@@ -69,6 +72,7 @@ namespace Nebula::RenderGraph::Compiler
         }
 
         // 3. Evaluate and optimize resources
+        report_progress("Optimizing resources", 0.2f);
         auto optimizer = std::make_unique<Algorithm::ResourceOptimizer>(execution_order, edges, verbose);
         Algorithm::ResourceOptimizationResult optimization_result;
         try
@@ -87,9 +91,15 @@ namespace Nebula::RenderGraph::Compiler
         m_logs.push_back(std::format("[Compiler] Resource optimization finished in {} microseconds", optimization_result.time.count()));
 
         // 4. Create resources
-        std::map<std::string, std::shared_ptr<Resource>> created_resources; // optimizer_id -> resource
-        for (const auto& opt_resource : optimization_result.resources)
+        auto resource_table = std::make_shared<ResourceTable>();
+        std::map<int32_t, uint32_t> created_resources; // optimizer_id -> table id
+        std::vector<sdvk::MemoryAliasSavings> alias_savings;
+        for (size_t i = 0; i < optimization_result.resources.size(); i++)
         {
+            const auto& opt_resource = optimization_result.resources[i];
+            report_progress(std::format("Creating resource {} of {}", i + 1, optimization_result.resources.size()),
+                            0.3f + 0.5f * static_cast<float>(i) / static_cast<float>(optimization_result.resources.size()));
+
             const auto resource_name = std::format("({:%Y-%m-%d %H:%M}) OptGenResource-{}", start_time, opt_resource.id);
             std::shared_ptr<Resource> new_resource;
 
@@ -110,7 +120,7 @@ namespace Nebula::RenderGraph::Compiler
             }
             else if (opt_resource.type == ResourceType::eBuffer)
             {
-                const auto& buffer = m_context.scene()->object_descriptions();
+                const auto& buffer = m_context.scene()->gpu_scene().buffer();
                 new_resource = std::make_shared<BufferResource>(buffer, resource_name);
             }
             else if (opt_resource.type == ResourceType::eScene)
@@ -119,6 +129,8 @@ namespace Nebula::RenderGraph::Compiler
             }
             else if (opt_resource.type == ResourceType::eImage)
             {
+                // Tagged with the first producer so the memory table shows who owns the image.
+                const auto image_name = std::format("{} [{}: {}]", resource_name, opt_resource.original_desc.origin_node_name, opt_resource.original_desc.origin_res_name);
                 auto image = std::make_shared<Nebula::Image>(m_context.context(),
                                                              opt_resource.format,
                                                              m_context.render_resolution(),
@@ -127,8 +139,17 @@ namespace Nebula::RenderGraph::Compiler
                                                              vk::ImageAspectFlagBits::eColor,
                                                              vk::ImageTiling::eOptimal,
                                                              vk::MemoryPropertyFlagBits::eDeviceLocal,
-                                                             resource_name);
+                                                             image_name);
                 new_resource = std::make_shared<ImageResource>(image, resource_name);
+
+                // Every producer beyond the first would have needed an image of its own without aliasing.
+                const auto producers = static_cast<uint32_t>(std::ranges::count_if(opt_resource.usage_points, [](const auto& point) {
+                    return point.role == ResourceRole::eOutput;
+                }));
+                if (producers > 1)
+                {
+                    alias_savings.push_back({ image_name, producers, image->allocation_size() * (producers - 1) });
+                }
             }
             else if (opt_resource.type == ResourceType::eDepthImage)
             {
@@ -148,10 +169,19 @@ namespace Nebula::RenderGraph::Compiler
                                                resource_name);
             m_logs.push_back(res_created_msg);
 
-            created_resources.insert({ std::to_string(opt_resource.id), new_resource });
+            created_resources.insert({ opt_resource.id, resource_table->add(new_resource) });
         }
 
+        vk::DeviceSize saved_bytes = 0;
+        for (const auto& saving : alias_savings)
+        {
+            saved_bytes += saving.saved_bytes;
+        }
+        m_logs.push_back(std::format("[Compiler] Aliasing saved {:.2f} MB across {} image(s)", static_cast<double>(saved_bytes) / (1024.0 * 1024.0), alias_savings.size()));
+        m_context.context().memory_tracker()->set_alias_savings(alias_savings);
+
         // 5. Create nodes
+        report_progress("Creating nodes", 0.8f);
         std::vector<std::shared_ptr<RenderGraph::Node>> created_nodes;
         std::map<int32_t, int32_t> node_mappings; // graph_id -> real_id
         for (const auto& node : execution_order)
@@ -160,15 +190,23 @@ namespace Nebula::RenderGraph::Compiler
             if (n != nullptr)
             {
                 created_nodes.push_back(n);
+                n->set_resource_table(resource_table);
+                n->set_render_resolution(m_context.render_resolution());
+                n->set_accumulation_enabled(m_context.accumulation_enabled());
                 node_mappings.insert({node->id(), created_nodes.size() - 1 });
             }
         }
 
         // 6. Connect resources to nodes
+        report_progress("Connecting resources", 0.9f);
         for (const auto& opt_resource : optimization_result.resources)
         {
             // 6.0 Get resource
-            auto& resource = created_resources[std::to_string(opt_resource.id)];
+            if (!created_resources.contains(opt_resource.id))
+            {
+                continue;
+            }
+            const uint32_t resource = created_resources[opt_resource.id];
 
             // 6.1 Connect to origin node
             auto& origin = opt_resource.original_desc;
@@ -185,7 +223,7 @@ namespace Nebula::RenderGraph::Compiler
 
         // 7. Create RenderPath
         auto render_path = std::make_shared<RenderPath>();
-        render_path->resources = created_resources;
+        render_path->resources = resource_table;
         render_path->nodes = created_nodes;
 
         // 8. Finish up & Create compile result
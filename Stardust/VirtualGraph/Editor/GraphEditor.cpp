@@ -6,15 +6,14 @@
 #include <imgui.h>
 #include <imnodes.h>
 #include <Application/Application.hpp>
-#include <VirtualGraph/Compile/DefaultCompileStrategy.hpp>
-#include <VirtualGraph/Compile/OptimizedCompileStrategy.hpp>
 
 namespace Nebula::RenderGraph::Editor
 {
     std::shared_ptr<sd::Scene> GraphEditor::s_selected_scene = nullptr;
 
-    GraphEditor::GraphEditor(RenderGraphContext& context)
+    GraphEditor::GraphEditor(RenderGraphContext& context, Compiler::AsyncGraphCompiler& compiler)
     : m_context(context)
+    , m_compiler(compiler)
     {
         _add_default_nodes();
     }
@@ -86,6 +85,16 @@ namespace Nebula::RenderGraph::Editor
                     _handle_reset();
                 }
 
+                if (m_compiler.is_busy())
+                {
+                    const auto stage = m_compiler.stage();
+                    ImGui::ProgressBar(m_compiler.progress(), ImVec2(240.0f, 0.0f), stage.c_str());
+                    if (ImGui::Button("Cancel"))
+                    {
+                        _cancel_compile();
+                    }
+                }
+
                 ImGui::EndMenuBar();
             }
 
@@ -135,29 +144,32 @@ namespace Nebula::RenderGraph::Editor
             nodes_vector.push_back(v);
         }
 
-        std::unique_ptr<Compiler::GraphCompileStrategy> compiler;
-
-        if (mode == Compiler::CompilerType::eNaive)
-        {
-            compiler = std::make_unique<Compiler::DefaultCompileStrategy>(m_context);
-        }
+        // The current graph keeps rendering, the compiler swaps in the new one once its pipelines exist.
+        m_compiler.submit(nodes_vector, m_edges, mode, [this, mode](const Compiler::CompileResult& result) {
+            if (result.success)
+            {
+                m_compiled_mode = mode;
+            }
+        });
+    }
 
-        if (mode == Compiler::CompilerType::eResourceOptimized)
+    void GraphEditor::_cancel_compile()
+    {
+        if (m_compiler.is_busy())
         {
-            compiler = std::make_unique<Compiler::OptimizedCompileStrategy>(m_context);
+            m_compiler.cancel();
         }
+    }
 
-        const auto result = compiler->compile(nodes_vector, m_edges, true);
-
-        for (const auto& msg : result.logs)
+    bool GraphEditor::recompile()
+    {
+        if (!m_compiled_mode.has_value())
         {
-            std::cout << msg << std::endl;
+            return false;
         }
 
-        if (result.success)
-        {
-            m_context.set_render_path(result.render_path);
-        }
+        _handle_compile(m_compiled_mode.value());
+        return true;
     }
 
     bool GraphEditor::_handle_connection()
@@ -209,6 +221,7 @@ namespace Nebula::RenderGraph::Editor
                 return false;
             }
 
+            _cancel_compile();
             Node::make_directed_edge(s_node, e_node);
             m_edges.emplace_back(*s_node, s_attr, *e_node, e_attr, s_attr.type);
             e_attr.input_is_connected = true;
@@ -237,6 +250,7 @@ namespace Nebula::RenderGraph::Editor
             auto& e_attr = e_node->get_resource(edge->end.res_id);
             e_attr.input_is_connected = false;
 
+            _cancel_compile();
             Node::delete_directed_edge(s_node, e_node);
 
             m_edges.erase(edge);
@@ -258,9 +272,11 @@ namespace Nebula::RenderGraph::Editor
 
     void GraphEditor::_handle_reset()
     {
+        _cancel_compile();
         m_messages.clear();
         m_nodes.clear();
         m_edges.clear();
+        m_compiled_mode.reset();
         _add_default_nodes();
         std::cout << "[Info] Reset graph editor." << std::endl;
     }
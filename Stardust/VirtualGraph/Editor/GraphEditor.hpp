@@ -2,8 +2,10 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <Scene/Scene.hpp>
+#include <VirtualGraph/Compile/AsyncGraphCompiler.hpp>
 #include <VirtualGraph/Compile/CompilerType.hpp>
 #include <VirtualGraph/Compile/GraphCompileStrategy.hpp>
 #include <VirtualGraph/Common/GraphContext.hpp>
@@ -17,10 +19,14 @@ namespace Nebula::RenderGraph::Editor
         using Scene_t = sd::Scene;
 
     public:
-        explicit GraphEditor(RenderGraphContext& context);
+        GraphEditor(RenderGraphContext& context, Compiler::AsyncGraphCompiler& compiler);
 
         void render();
 
+        // Compiles the editor graph again in the background with the last successful compiler,
+        // false if no graph was compiled from the editor yet.
+        bool recompile();
+
         static void set_scene(const std::shared_ptr<Scene_t>& scene)
         {
             s_selected_scene = std::shared_ptr(scene);
@@ -29,6 +35,9 @@ namespace Nebula::RenderGraph::Editor
     private:
         void _handle_compile(Compiler::CompilerType mode);
 
+        // A running compilation would swap in a graph that no longer matches the editor.
+        void _cancel_compile();
+
         bool _handle_connection();
 
         void _erase_edge(int32_t edge_id);
@@ -50,6 +59,9 @@ namespace Nebula::RenderGraph::Editor
         bool m_has_scene_provider { false };
         bool m_has_presenter { false };
 
-        RenderGraphContext& m_context;
+        std::optional<Compiler::CompilerType> m_compiled_mode;
+
+        RenderGraphContext&           m_context;
+        Compiler::AsyncGraphCompiler& m_compiler;
     };
 }
\ No newline at end of file
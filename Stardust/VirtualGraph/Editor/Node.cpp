@@ -1,6 +1,7 @@
 #include "Node.hpp"
 
 #include <format>
+#include <map>
 #include <stdexcept>
 #include <imgui.h>
 #include <imnodes.h>
@@ -70,6 +71,34 @@ namespace Nebula::RenderGraph::Editor
         ImNodes::PopColorStyle();
     }
 
+    std::vector<std::shared_ptr<Node>> Node::snapshot(const std::vector<std::shared_ptr<Node>>& nodes)
+    {
+        std::vector<std::shared_ptr<Node>> copies;
+        std::map<int32_t, std::shared_ptr<Node>> copies_by_id;
+        for (const auto& node : nodes)
+        {
+            const auto copy = node->clone();
+            copies.push_back(copy);
+            copies_by_id.insert({ copy->id(), copy });
+        }
+
+        const auto relink = [&copies_by_id](std::vector<std::shared_ptr<Graph::Vertex>>& edges) {
+            std::erase_if(edges, [&copies_by_id](const auto& vertex) { return !copies_by_id.contains(vertex->id()); });
+            for (auto& vertex : edges)
+            {
+                vertex = copies_by_id.at(vertex->id());
+            }
+        };
+
+        for (const auto& copy : copies)
+        {
+            relink(copy->get_incoming_edges());
+            relink(copy->get_outgoing_edges());
+        }
+
+        return copies;
+    }
+
     NodeType Node::type() const
     {
         return m_type;
@@ -159,6 +188,15 @@ namespace Nebula::RenderGraph::Editor
         }
     }
 
+    void AmbientOcclusionNode::render_options()
+    {
+        bool rtao = params.mode == AmbientOcclusionMode::eRTAO;
+        if (ImGui::Checkbox("Ray Traced", &rtao))
+        {
+            params.mode = rtao ? AmbientOcclusionMode::eRTAO : AmbientOcclusionMode::eSSAO;
+        }
+    }
+
     AntiAliasingNode::AntiAliasingNode()
     : Node("Anti-Aliasing", aa_color, aa_hover, NodeType::eAntiAliasing)
     {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <glm/vec4.hpp>
@@ -8,6 +9,7 @@
 #include <VirtualGraph/Editor/ResourceDescription.hpp>
 #include <VirtualGraph/Common/NodeType.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/LightingPass.hpp>
+#include <VirtualGraph/RenderGraph/Nodes/AmbientOcclusion/AmbientOcclusionOptions.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/PresentNode.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/RayTracingNode.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/SceneProviderNode.hpp>
@@ -17,6 +19,7 @@ namespace Editor {                 \
     class CN final : public Node { \
     public:                        \
         CN();                      \
+        std::shared_ptr<Node> clone() const override { return std::make_shared<CN>(*this); } \
     };                             \
 }
 
@@ -24,6 +27,7 @@ namespace Editor {                 \
 class CN final : public Node {          \
 public:                                 \
     CN();                               \
+    std::shared_ptr<Node> clone() const override { return std::make_shared<CN>(*this); } \
 };
 
 namespace Nebula::RenderGraph::Editor
@@ -70,6 +74,15 @@ namespace Nebula::RenderGraph::Editor
 
         virtual void render();
 
+        // Copy with the same id, its edges still refer to the original nodes until relinked by snapshot().
+        virtual std::shared_ptr<Node> clone() const
+        {
+            return std::make_shared<Node>(*this);
+        }
+
+        // Deep copy of an editor graph, compilations on the compile thread must not see later edits.
+        static std::vector<std::shared_ptr<Node>> snapshot(const std::vector<std::shared_ptr<Node>>& nodes);
+
         template <typename T>
         T& as()
         {
@@ -96,16 +109,30 @@ namespace Nebula::RenderGraph::Editor
         NodeType   m_type = NodeType::eUnknown;
     };
 
-    INT_DEF_BASIC_EDITOR_NODE(AmbientOcclusionNode);
     INT_DEF_BASIC_EDITOR_NODE(AntiAliasingNode);
     INT_DEF_BASIC_EDITOR_NODE(BlurNode);
     INT_DEF_BASIC_EDITOR_NODE(GBufferPass);
     INT_DEF_BASIC_EDITOR_NODE(SceneProviderNode);
 
+    class AmbientOcclusionNode final : public Node
+    {
+    public:
+        AmbientOcclusionNode();
+
+        std::shared_ptr<Node> clone() const override { return std::make_shared<AmbientOcclusionNode>(*this); }
+
+        AmbientOcclusionOptions params;
+
+    protected:
+        void render_options() override;
+    };
+
     class LightingPassNode final : public Node {
     public:
         LightingPassNode();
 
+        std::shared_ptr<Node> clone() const override { return std::make_shared<LightingPassNode>(*this); }
+
         LightingPassOptions params;
 
     protected:
@@ -117,6 +144,8 @@ namespace Nebula::RenderGraph::Editor
     public:
         PresentNode();
 
+        std::shared_ptr<Node> clone() const override { return std::make_shared<PresentNode>(*this); }
+
         PresentNodeOptions params;
 
     protected:
@@ -128,6 +157,8 @@ namespace Nebula::RenderGraph::Editor
     public:
         RayTracingNode();
 
+        std::shared_ptr<Node> clone() const override { return std::make_shared<RayTracingNode>(*this); }
+
         RayTracingNodeOptions params;
 
     protected:
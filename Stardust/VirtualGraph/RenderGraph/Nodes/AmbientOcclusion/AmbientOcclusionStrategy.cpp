@@ -11,9 +11,9 @@ namespace Nebula::RenderGraph
         switch (mode)
         {
             case AmbientOcclusionMode::eSSAO:
-                return new ScreenSpaceAO(m_context, m_resources);
+                return new ScreenSpaceAO(m_context, m_node);
             case AmbientOcclusionMode::eRTAO:
-                return new RayTracedAO(m_context, m_resources);
+                return new RayTracedAO(m_context, m_node);
             case AmbientOcclusionMode::eUnknown:
                 // Falls through
             default:
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <map>
-#include <string>
 #include <vulkan/vulkan.hpp>
 #include <Vulkan/Context.hpp>
+#include <VirtualGraph/RenderGraph/Nodes/Node.hpp>
 #include <VirtualGraph/RenderGraph/Resources/Resource.hpp>
+#include <VirtualGraph/RenderGraph/Resources/ResourceHandle.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/AmbientOcclusion/AmbientOcclusionMode.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/AmbientOcclusion/AmbientOcclusionOptions.hpp>
 
@@ -15,10 +15,9 @@ namespace Nebula::RenderGraph
     public:
         struct Factory
         {
-            explicit Factory(const sdvk::Context& context,
-                             std::map<std::string, std::shared_ptr<Resource>>& resources)
+            explicit Factory(const sdvk::Context& context, const Node& node)
             : m_context(context)
-            , m_resources(resources)
+            , m_node(node)
             {
             }
 
@@ -26,25 +25,41 @@ namespace Nebula::RenderGraph
 
         private:
             const sdvk::Context& m_context;
-            std::map<std::string, std::shared_ptr<Resource>>& m_resources;
+            const Node&          m_node;
         };
 
     public:
-        explicit AmbientOcclusionStrategy(const sdvk::Context& context,
-                                          std::map<std::string, std::shared_ptr<Resource>>& resources)
-        : m_context(context)
-        , m_resources(resources)
+        // Resources are resolved from the owning node once, strategies are created in the node's initialize().
+        explicit AmbientOcclusionStrategy(const sdvk::Context& context, const Node& node)
+        : m_node(node)
+        , m_context(context)
         {
+            m_handles.position_buffer = node.get_handle<ImageResource>("Position Buffer");
+            m_handles.normal_buffer   = node.get_handle<ImageResource>("Normal Buffer");
+            m_handles.tlas            = node.get_handle<TlasResource>("TLAS");
+            m_handles.ao_image        = node.get_handle<ImageResource>("AO Image");
         }
 
         virtual void execute(const vk::CommandBuffer& command_buffer) = 0;
 
         virtual void initialize(const AmbientOcclusionOptions& options) = 0;
 
+        virtual uint32_t permutation_count() const { return 0; }
+
+        virtual void set_accumulation_enabled(bool enabled) { /* default: no-op */ }
+
         virtual ~AmbientOcclusionStrategy() = default;
 
     protected:
-        std::map<std::string, std::shared_ptr<Resource>>& m_resources;
+        struct Resources
+        {
+            ImageHandle  position_buffer;
+            ImageHandle  normal_buffer;
+            TlasHandle   tlas;
+            ImageHandle  ao_image;
+        } m_handles;
+
+        const Node&          m_node;
         const sdvk::Context& m_context;
     };
 }
\ No newline at end of file
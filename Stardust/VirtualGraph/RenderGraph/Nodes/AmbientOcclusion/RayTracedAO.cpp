@@ -1,30 +1,35 @@
 #include "RayTracedAO.hpp"
 
+#include <format>
 #include <glm/ext/matrix_relational.hpp>
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
 #include <Vulkan/Context.hpp>
-#include <Vulkan/Image/Sampler.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 
 namespace Nebula::RenderGraph
 {
-    RayTracedAO::RayTracedAO(const sdvk::Context& context, std::map<std::string, std::shared_ptr<Resource>>& resources)
-    : AmbientOcclusionStrategy(context, resources)
+    RayTracedAO::RayTracedAO(const sdvk::Context& context, const Node& node)
+    : AmbientOcclusionStrategy(context, node)
     {
     }
 
+    RayTracedAO::~RayTracedAO()
+    {
+        m_kernel.pipelines.release(*m_context.destruction_queue());
+        m_context.destruction_queue()->destroy(m_kernel.pipeline_layout);
+    }
+
     void RayTracedAO::execute(const vk::CommandBuffer& command_buffer)
     {
         uint32_t current_frame = sd::Application::s_current_frame;
 
-        auto camera = *dynamic_cast<CameraResource&>(*m_resources["Camera"]).get_camera();
-
         // AO accumulation while camera is stationary.
-        auto view_mat = camera.view();
+        const auto& view_mat = ViewConstants::instance(m_context).data().current.view;
         auto eq = glm::equal(glm::mat4(m_ref_mat), view_mat, 0.001f);
-        if (!(eq.x && eq.y && eq.z && eq.w))
+        if (!(eq.x && eq.y && eq.z && eq.w) || !m_accumulation_enabled)
         {
             m_ref_mat = view_mat;
             m_kernel.frame = -1;
@@ -38,9 +43,9 @@ namespace Nebula::RenderGraph
             return;
         }
 
-        auto position = dynamic_cast<ImageResource&>(*m_resources["Position Buffer"]).get_image();
-        auto normal = dynamic_cast<ImageResource&>(*m_resources["Normal Buffer"]).get_image();
-        auto ao = dynamic_cast<ImageResource&>(*m_resources["AO Image"]).get_image();
+        auto position = m_node.get(m_handles.position_buffer).get_image();
+        auto normal = m_node.get(m_handles.normal_buffer).get_image();
+        auto ao = m_node.get(m_handles.ao_image).get_image();
 
         // Calculate grou sizes from AO buffer extent.
         auto size = ao->properties().extent;
@@ -55,7 +60,9 @@ namespace Nebula::RenderGraph
         Nebula::Sync::ImageBarrier(ao, ao->state().layout,vk::ImageLayout::eGeneral).apply(command_buffer);
 
         _update_descriptor(current_frame);
-        command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_kernel.pipeline);
+        // Sample count is baked into the kernel, one permutation per distinct value.
+        const auto& pipeline = m_kernel.pipelines.get(static_cast<PipelinePermutations::Key>(m_options.ao_samples));
+        command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline);
         command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_kernel.pipeline_layout, 0, 1, &m_kernel.descriptor->set(current_frame), 0, nullptr);
         command_buffer.pushConstants(m_kernel.pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(RayTracedAOPushConsant), &pc);
         command_buffer.dispatch(group_x, group_y, 1);
@@ -63,15 +70,9 @@ namespace Nebula::RenderGraph
 
     void RayTracedAO::initialize(const AmbientOcclusionOptions& options)
     {
-        m_kernel.render_resolution = sd::Application::s_extent.vk_ext();
+        m_kernel.render_resolution = m_node.render_resolution();
         m_kernel.frames_in_flight = sd::Application::s_max_frames_in_flight;
 
-        m_kernel.samplers.resize(3);
-        for (vk::Sampler& sampler : m_kernel.samplers)
-        {
-            sampler = sdvk::SamplerBuilder().create(m_context.device());
-        }
-
         m_kernel.descriptor = Descriptor::Builder()
             .storage_image(0, vk::ShaderStageFlagBits::eCompute)
             .storage_image(1, vk::ShaderStageFlagBits::eCompute)
@@ -79,28 +80,43 @@ namespace Nebula::RenderGraph
             .acceleration_structure(3, vk::ShaderStageFlagBits::eCompute)
             .create(m_kernel.frames_in_flight, m_context);
 
-        auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
+        m_kernel.pipeline_layout = sdvk::PipelineBuilder(m_context)
             .add_push_constant({ vk::ShaderStageFlagBits::eCompute, 0, sizeof(RayTracedAOOptions) })
             .add_descriptor_set_layout(m_kernel.descriptor->layout())
             .create_pipeline_layout()
-            .add_shader("rg_rtao.comp.spv", vk::ShaderStageFlagBits::eCompute)
-            .with_name("RayTracing AO")
+            .get_pipeline_layout();
+
+        m_kernel.pipelines = PipelinePermutations(m_kernel.pipeline_layout, [this](auto key, const auto& layout){
+            return _create_permutation(key, layout);
+        }, "RayTracing AO");
+    }
+
+    vk::Pipeline RayTracedAO::_create_permutation(const PipelinePermutations::Key key, const vk::PipelineLayout& pipeline_layout) const
+    {
+        const auto specialization_constants = sdvk::SpecializationConstants()
+            .add(0, static_cast<uint32_t>(Kernel::s_group_size))
+            .add(1, static_cast<uint32_t>(Kernel::s_group_size))
+            .add(2, static_cast<int32_t>(key));
+
+        auto [pipeline, _] = sdvk::PipelineBuilder(m_context)
+            .with_pipeline_layout(pipeline_layout)
+            .add_shader("rg_rtao.comp.spv", vk::ShaderStageFlagBits::eCompute, specialization_constants)
+            .with_name(std::format("RayTracing AO [{} spp]", key))
             .create_compute_pipeline();
 
-        m_kernel.pipeline = pipeline;
-        m_kernel.pipeline_layout = pipeline_layout;
+        return pipeline;
     }
 
     void RayTracedAO::_update_descriptor(uint32_t current_frame)
     {
-        auto position = dynamic_cast<ImageResource&>(*m_resources["Position Buffer"]).get_image();
-        auto normal = dynamic_cast<ImageResource&>(*m_resources["Normal Buffer"]).get_image();
-        auto ao = dynamic_cast<ImageResource&>(*m_resources["AO Image"]).get_image();
-        auto tlas = dynamic_cast<TlasResource&>(*m_resources["TLAS"]).get_tlas();
-
-        vk::DescriptorImageInfo position_info { m_kernel.samplers[0], position->image_view(), position->state().layout };
-        vk::DescriptorImageInfo normal_info { m_kernel.samplers[1], normal->image_view(), normal->state().layout };
-        vk::DescriptorImageInfo ao_info { m_kernel.samplers[2], ao->image_view(), ao->state().layout };
+        auto position = m_node.get(m_handles.position_buffer).get_image();
+        auto normal = m_node.get(m_handles.normal_buffer).get_image();
+        auto ao = m_node.get(m_handles.ao_image).get_image();
+        auto tlas = m_node.get(m_handles.tlas).get_tlas();
+
+        vk::DescriptorImageInfo position_info { nullptr, position->image_view(), position->state().layout };
+        vk::DescriptorImageInfo normal_info { nullptr, normal->image_view(), normal->state().layout };
+        vk::DescriptorImageInfo ao_info { nullptr, ao->image_view(), ao->state().layout };
 
         m_kernel.descriptor->begin_write(current_frame)
             .storage_image(0, position_info)
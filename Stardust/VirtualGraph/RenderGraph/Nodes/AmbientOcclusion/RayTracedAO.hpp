@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 #include <Nebula/Descriptor.hpp>
 #include <Nebula/Framebuffer.hpp>
+#include <Nebula/PipelinePermutations.hpp>
 #include <Vulkan/Buffer.hpp>
 #include "AmbientOcclusionOptions.hpp"
 #include "AmbientOcclusionStrategy.hpp"
@@ -36,25 +37,32 @@ namespace Nebula::RenderGraph
     class RayTracedAO : public AmbientOcclusionStrategy
     {
     public:
-        explicit RayTracedAO(const sdvk::Context& context,
-                             std::map<std::string, std::shared_ptr<Resource>>& resources);
+        explicit RayTracedAO(const sdvk::Context& context, const Node& node);
+
+        ~RayTracedAO() override;
 
         void execute(const vk::CommandBuffer& command_buffer) override;
 
         void initialize(const AmbientOcclusionOptions& options) override;
 
+        uint32_t permutation_count() const override { return m_kernel.pipelines.count(); }
+
+        // Without accumulation every frame overwrites the AO image with a single frame of samples.
+        void set_accumulation_enabled(bool enabled) override { m_accumulation_enabled = enabled; }
+
     private:
         void _update_descriptor(uint32_t current_frame);
 
+        vk::Pipeline _create_permutation(PipelinePermutations::Key key, const vk::PipelineLayout& pipeline_layout) const;
+
         RayTracedAOOptions m_options;
 
         struct Kernel
         {
             static constexpr int32_t    s_group_size {16};
             std::shared_ptr<Descriptor> descriptor;
-            vk::Pipeline                pipeline;
+            PipelinePermutations        pipelines;
             vk::PipelineLayout          pipeline_layout;
-            std::vector<vk::Sampler>    samplers;
             uint32_t                    frames_in_flight;
             vk::Extent2D                render_resolution;
             int32_t                     frame {0};
@@ -62,5 +70,6 @@ namespace Nebula::RenderGraph
 
 
         glm::mat4 m_ref_mat = glm::mat4(1.0f);
+        bool      m_accumulation_enabled { true };
     };
 }
\ No newline at end of file
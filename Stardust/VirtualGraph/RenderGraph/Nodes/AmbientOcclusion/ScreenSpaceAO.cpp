@@ -2,25 +2,31 @@
 
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
+#include <Nebula/SamplerCache.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
 #include <Vulkan/Context.hpp>
 #include <Vulkan/Image/Sampler.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 
 namespace Nebula::RenderGraph
 {
-    ScreenSpaceAO::ScreenSpaceAO(const sdvk::Context& context,
-                                 std::map<std::string, std::shared_ptr<Resource>>& resources)
-    : AmbientOcclusionStrategy(context, resources)
+    ScreenSpaceAO::ScreenSpaceAO(const sdvk::Context& context, const Node& node)
+    : AmbientOcclusionStrategy(context, node)
     {
         m_random_floats = std::uniform_real_distribution<float>(0.0, 1.0);
     }
 
+    ScreenSpaceAO::~ScreenSpaceAO()
+    {
+        m_context.destruction_queue()->destroy(m_kernel.pipeline, m_kernel.pipeline_layout, m_kernel.render_pass);
+    }
+
     void ScreenSpaceAO::execute(const vk::CommandBuffer& command_buffer)
     {
-        auto position = dynamic_cast<ImageResource&>(*m_resources["Position Buffer"]).get_image();
-        auto normal = dynamic_cast<ImageResource&>(*m_resources["Normal Buffer"]).get_image();
-        auto ao_buffer = dynamic_cast<ImageResource&>(*m_resources["AO Image"]).get_image();
+        auto position = m_node.get(m_handles.position_buffer).get_image();
+        auto normal = m_node.get(m_handles.normal_buffer).get_image();
+        auto ao_buffer = m_node.get(m_handles.ao_image).get_image();
 
         Nebula::Sync::ImageBarrier(position, position->state().layout, vk::ImageLayout::eShaderReadOnlyOptimal).apply(command_buffer);
         Nebula::Sync::ImageBarrier(normal, normal->state().layout, vk::ImageLayout::eShaderReadOnlyOptimal).apply(command_buffer);
@@ -37,9 +43,13 @@ namespace Nebula::RenderGraph
             .with_render_pass(m_kernel.render_pass)
             .execute(command_buffer, [&](const vk::CommandBuffer& cmd){
                 cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, m_kernel.pipeline);
+                const std::array descriptor_sets = {
+                    ViewConstants::instance(m_context).set(current_frame),
+                    m_kernel.descriptor->set(current_frame),
+                };
                 cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                       m_kernel.pipeline_layout, 0, 1,
-                                       &m_kernel.descriptor->set(current_frame),
+                                       m_kernel.pipeline_layout, ViewConstants::s_set_index,
+                                       descriptor_sets.size(), descriptor_sets.data(),
                                        0, nullptr);
                 cmd.draw(3, 1, 0, 0);
             });
@@ -79,10 +89,9 @@ namespace Nebula::RenderGraph
             m_kernel.noise.push_back(noise);
         }
 
-        const auto& r_ao_buffer = m_resources["AO Image"];
-        auto ao_buffer = dynamic_cast<ImageResource&>(*r_ao_buffer).get_image();
+        auto ao_buffer = m_node.get(m_handles.ao_image).get_image();
 
-        m_kernel.render_resolution = sd::Application::s_extent.vk_ext();
+        m_kernel.render_resolution = m_node.render_resolution();
         m_kernel.frames_in_flight = sd::Application::s_max_frames_in_flight;
 
         m_kernel.clear_values[0].setColor(std::array<float, 4>{ 0.0f, 0.0f, 0.0f, 1.0f });
@@ -100,14 +109,16 @@ namespace Nebula::RenderGraph
             .set_name("ScreenSpace AO Framebuffer")
             .create(m_context);
 
+        m_kernel.sampler = SamplerCache::instance(m_context).get(sdvk::SamplerBuilder());
+
         m_kernel.descriptor = Descriptor::Builder()
-            .uniform_buffer(0, vk::ShaderStageFlagBits::eFragment)
             .uniform_buffer(1, vk::ShaderStageFlagBits::eFragment)
-            .combined_image_sampler(2, vk::ShaderStageFlagBits::eFragment)
-            .combined_image_sampler(3, vk::ShaderStageFlagBits::eFragment)
+            .combined_image_sampler(2, vk::ShaderStageFlagBits::eFragment, m_kernel.sampler)
+            .combined_image_sampler(3, vk::ShaderStageFlagBits::eFragment, m_kernel.sampler)
             .create(m_kernel.frames_in_flight, m_context);
 
         auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
+            .add_descriptor_set_layout(ViewConstants::instance(m_context).layout())
             .add_descriptor_set_layout(m_kernel.descriptor->layout())
             .create_pipeline_layout()
             .set_sample_count(vk::SampleCountFlagBits::e1)
@@ -121,39 +132,21 @@ namespace Nebula::RenderGraph
         m_kernel.pipeline = pipeline;
         m_kernel.pipeline_layout = pipeline_layout;
 
-        m_kernel.uniform_camera.resize(m_kernel.frames_in_flight);
-        for (auto& ub : m_kernel.uniform_camera)
-        {
-            ub = sdvk::Buffer::Builder()
-                .with_size(sizeof(sd::CameraUniformData))
-                .as_uniform_buffer()
-                .create(m_context);
-        }
-
         m_kernel.uniform_ssao.resize(m_kernel.frames_in_flight);
-        for (auto& ub : m_kernel.uniform_ssao)
+        for (uint32_t i = 0; i < m_kernel.uniform_ssao.size(); i++)
         {
-            ub = sdvk::Buffer::Builder()
+            m_kernel.uniform_ssao[i] = sdvk::Buffer::Builder()
                 .with_size(sizeof(ScreenSpaceAOUniform))
                 .as_uniform_buffer()
+                .with_name(std::format("[SSAO] Uniform Buffer {}", i))
                 .create(m_context);
         }
-
-        m_kernel.samplers.resize(2);
-        for (vk::Sampler& sampler : m_kernel.samplers)
-        {
-            sampler = sdvk::SamplerBuilder().create(m_context.device());
-        }
     }
 
     void ScreenSpaceAO::_update_descriptor(uint32_t current_frame)
     {
-        auto position = dynamic_cast<ImageResource&>(*m_resources["Position Buffer"]).get_image();
-        auto normal = dynamic_cast<ImageResource&>(*m_resources["Normal Buffer"]).get_image();
-
-        auto camera = *(dynamic_cast<CameraResource&>(*m_resources["Camera"]).get_camera());
-        auto camera_data = camera.uniform_data();
-        m_kernel.uniform_camera[current_frame]->set_data(&camera_data, m_context.device());
+        auto position = m_node.get(m_handles.position_buffer).get_image();
+        auto normal = m_node.get(m_handles.normal_buffer).get_image();
 
         ScreenSpaceAOUniform ssao_data(m_options);
         int32_t sample_count = (m_options.sample_count > 64) ? 64 : m_options.sample_count;
@@ -167,13 +160,11 @@ namespace Nebula::RenderGraph
         }
         m_kernel.uniform_ssao[current_frame]->set_data(&ssao_data, m_context.device());
 
-        vk::DescriptorImageInfo position_info { m_kernel.samplers[0],position->image_view(),position->state().layout };
-        vk::DescriptorImageInfo normal_info { m_kernel.samplers[1],normal->image_view(),normal->state().layout };
-        vk::DescriptorBufferInfo camera_info { m_kernel.uniform_camera[current_frame]->buffer(), 0, sizeof(sd::CameraUniformData) };
+        vk::DescriptorImageInfo position_info { m_kernel.sampler,position->image_view(),position->state().layout };
+        vk::DescriptorImageInfo normal_info { m_kernel.sampler,normal->image_view(),normal->state().layout };
         vk::DescriptorBufferInfo ssao_info { m_kernel.uniform_ssao[current_frame]->buffer(), 0, sizeof(ScreenSpaceAOUniform) };
 
         m_kernel.descriptor->begin_write(current_frame)
-            .uniform_buffer(0, camera_info)
             .uniform_buffer(1, ssao_info)
             .combined_image_sampler(2, position_info)
             .combined_image_sampler(3, normal_info)
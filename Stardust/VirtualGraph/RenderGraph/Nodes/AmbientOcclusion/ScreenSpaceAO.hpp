@@ -50,8 +50,9 @@ namespace Nebula::RenderGraph
     class ScreenSpaceAO : public AmbientOcclusionStrategy
     {
     public:
-        explicit ScreenSpaceAO(const sdvk::Context& context,
-                               std::map<std::string, std::shared_ptr<Resource>>& resources);
+        explicit ScreenSpaceAO(const sdvk::Context& context, const Node& node);
+
+        ~ScreenSpaceAO() override;
 
         void execute(const vk::CommandBuffer& command_buffer) override;
 
@@ -72,8 +73,8 @@ namespace Nebula::RenderGraph
             std::array<vk::ClearValue, 1> clear_values;
             uint32_t frames_in_flight;
             vk::Extent2D render_resolution;
-            std::vector<std::unique_ptr<sdvk::Buffer>> uniform_camera, uniform_ssao;
-            std::vector<vk::Sampler> samplers;
+            std::vector<std::unique_ptr<sdvk::Buffer>> uniform_ssao;
+            vk::Sampler sampler;
 
             std::vector<glm::vec4> samples;
             std::vector<glm::vec4> noise;
@@ -1,4 +1,5 @@
 #include "AmbientOcclusionNode.hpp"
+#include <Vulkan/Context.hpp>
 
 namespace Nebula::RenderGraph
 {
@@ -12,9 +13,9 @@ namespace Nebula::RenderGraph
     };
     #pragma endregion
 
-    AmbientOcclusionNode::AmbientOcclusionNode(const sdvk::Context& context)
+    AmbientOcclusionNode::AmbientOcclusionNode(const sdvk::Context& context, const AmbientOcclusionOptions& options)
     : Node("Ambient Occlusion", NodeType::eAmbientOcclusion)
-    , m_context(context)
+    , m_options(options), m_context(context)
     {
     }
 
@@ -25,8 +26,28 @@ namespace Nebula::RenderGraph
 
     void AmbientOcclusionNode::initialize()
     {
-        auto* strategy = AmbientOcclusionStrategy::Factory(m_context, m_resources).create(m_options.mode);
+        if (m_options.mode == AmbientOcclusionMode::eRTAO && !m_context.is_raytracing_capable())
+        {
+            m_options.mode = AmbientOcclusionMode::eSSAO;
+        }
+
+        auto* strategy = AmbientOcclusionStrategy::Factory(m_context, *this).create(m_options.mode);
         m_mode = std::shared_ptr<AmbientOcclusionStrategy>(strategy);
         m_mode->initialize(m_options);
+        m_mode->set_accumulation_enabled(m_accumulation_enabled);
+    }
+
+    uint32_t AmbientOcclusionNode::permutation_count() const
+    {
+        return m_mode ? m_mode->permutation_count() : 0;
+    }
+
+    void AmbientOcclusionNode::set_accumulation_enabled(const bool enabled)
+    {
+        m_accumulation_enabled = enabled;
+        if (m_mode)
+        {
+            m_mode->set_accumulation_enabled(enabled);
+        }
     }
 }
\ No newline at end of file
@@ -12,14 +12,19 @@ namespace Nebula::RenderGraph
     class AmbientOcclusionNode final : public Node
     {
     public:
-        explicit AmbientOcclusionNode(const sdvk::Context& context);
+        AmbientOcclusionNode(const sdvk::Context& context, const AmbientOcclusionOptions& options);
 
         void execute(const vk::CommandBuffer& command_buffer) override;
 
         void initialize() override;
 
+        uint32_t permutation_count() const override;
+
+        void set_accumulation_enabled(bool enabled) override;
+
     private:
         AmbientOcclusionOptions m_options;
+        bool                    m_accumulation_enabled { true };
         std::shared_ptr<AmbientOcclusionStrategy> m_mode;
 
         const sdvk::Context& m_context;
@@ -2,6 +2,7 @@
 #include <Vulkan/Image/Sampler.hpp>
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
+#include <Nebula/SamplerCache.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
 #include <Vulkan/Context.hpp>
@@ -22,12 +23,17 @@ namespace Nebula::RenderGraph
     {
     }
 
+    AntiAliasingNode::~AntiAliasingNode()
+    {
+        m_context.destruction_queue()->destroy(m_renderer.pipeline, m_renderer.pipeline_layout, m_renderer.render_pass);
+    }
+
     void AntiAliasingNode::execute(const vk::CommandBuffer& command_buffer)
     {
         const uint32_t current_frame = sd::Application::s_current_frame;
 
-        const auto aa_in = m_resources["Anti-Aliasing Input"]->as<ImageResource>().get_image();
-        const auto aa_out = m_resources["Anti-Aliasing Output"]->as<ImageResource>().get_image();
+        const auto aa_in = get(m_handles.input).get_image();
+        const auto aa_out = get(m_handles.output).get_image();
 
         Sync::ImageBarrierBatch({
             Sync::ImageBarrier(aa_in, aa_in->state().layout, vk::ImageLayout::eShaderReadOnlyOptimal),
@@ -55,9 +61,12 @@ namespace Nebula::RenderGraph
 
     void AntiAliasingNode::initialize()
     {
-        const auto aa = m_resources["Anti-Aliasing Output"]->as<ImageResource>().get_image();
+        m_handles.input  = get_handle<ImageResource>("Anti-Aliasing Input");
+        m_handles.output = get_handle<ImageResource>("Anti-Aliasing Output");
 
-        const auto extent = sd::Application::s_extent.vk_ext();
+        const auto aa = get(m_handles.output).get_image();
+
+        const auto extent = render_resolution();
 
         m_renderer.frames_in_flight = sd::Application::s_max_frames_in_flight;
         m_renderer.clear_values[0].setColor(std::array{ 0.0f, 0.0f, 0.0f, 1.0f });
@@ -80,8 +89,10 @@ namespace Nebula::RenderGraph
             .set_name("Anti-Aliasing Framebuffer")
             .create(m_context);
 
+        m_renderer.sampler = SamplerCache::instance(m_context).get(sdvk::SamplerBuilder());
+
         m_renderer.descriptor = Descriptor::Builder()
-            .combined_image_sampler(0, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment)
+            .combined_image_sampler(0, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, m_renderer.sampler)
             .create(m_renderer.frames_in_flight, m_context);
 
         auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
@@ -95,15 +106,13 @@ namespace Nebula::RenderGraph
             .with_name("Anti-Aliasing")
             .create_graphics_pipeline(m_renderer.render_pass);
 
-        m_renderer.sampler = sdvk::SamplerBuilder().create(m_context.device());
-
         m_renderer.pipeline = pipeline;
         m_renderer.pipeline_layout = pipeline_layout;
     }
 
     void AntiAliasingNode::_update_descriptor(uint32_t current_frame)
     {
-        const auto aa_in = m_resources["Anti-Aliasing Input"]->as<ImageResource>().get_image();
+        const auto aa_in = get(m_handles.input).get_image();
         const vk::DescriptorImageInfo aa_in_info { m_renderer.sampler, aa_in->image_view(), aa_in->state().layout };
 
         m_renderer.descriptor->begin_write(current_frame)
@@ -33,6 +33,8 @@ namespace Nebula::RenderGraph
     public:
         explicit AntiAliasingNode(const sdvk::Context& context);
 
+        ~AntiAliasingNode() override;
+
         void execute(const vk::CommandBuffer& command_buffer) override;
 
         void initialize() override;
@@ -42,6 +44,12 @@ namespace Nebula::RenderGraph
 
         AntiAliasingNodeOptions m_options {};
 
+        struct Resources
+        {
+            ImageHandle input;
+            ImageHandle output;
+        } m_handles;
+
         struct Renderer
         {
             std::shared_ptr<Descriptor> descriptor;
@@ -1,5 +1,4 @@
 #include "BlurNode.hpp"
-#include <Vulkan/Image/Sampler.hpp>
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
@@ -20,12 +19,17 @@ namespace Nebula::RenderGraph
     {
     }
 
+    BlurNode::~BlurNode()
+    {
+        m_context.destruction_queue()->destroy(m_kernel.pipeline, m_kernel.pipeline_layout);
+    }
+
     void BlurNode::execute(const vk::CommandBuffer& command_buffer)
     {
         const uint32_t current_frame = sd::Application::s_current_frame;
 
-        const auto blur_in = m_resources["Blur Input"]->as<ImageResource>().get_image();
-        const auto blur_out = m_resources["Blur Output"]->as<ImageResource>().get_image();
+        const auto blur_in = get(m_handles.input).get_image();
+        const auto blur_out = get(m_handles.output).get_image();
 
         Sync::ImageBarrierBatch({
             Sync::ImageBarrier(blur_in, blur_in->state().layout, vk::ImageLayout::eGeneral),
@@ -55,22 +59,19 @@ namespace Nebula::RenderGraph
 
     void BlurNode::initialize()
     {
-        const auto input = m_resources["Blur Input"]->as<ImageResource>().get_image();
+        m_handles.input  = get_handle<ImageResource>("Blur Input");
+        m_handles.output = get_handle<ImageResource>("Blur Output");
+
+        const auto input = get(m_handles.input).get_image();
         m_kernel.intermediate_image = std::make_shared<Image>(m_context, input->properties().format, input->properties().extent,
                                                               vk::SampleCountFlagBits::e1, vk::ImageUsageFlagBits::eStorage,
                                                               vk::ImageAspectFlagBits::eColor, vk::ImageTiling::eOptimal,
                                                               vk::MemoryPropertyFlagBits::eDeviceLocal,
-                                                              "GaussianBlurIntermediateImage");
+                                                              std::format("[{}] Intermediate Image", name()));
 
-        m_kernel.resolution = sd::Application::s_extent.vk_ext();
+        m_kernel.resolution = render_resolution();
         m_kernel.frames_in_flight = sd::Application::s_max_frames_in_flight;
 
-        m_kernel.samplers.resize(2);
-        for (vk::Sampler& sampler : m_kernel.samplers)
-        {
-            sampler = sdvk::SamplerBuilder().create(m_context.device());
-        }
-
         m_kernel.descriptor_pass_x = Descriptor::Builder()
             .storage_image(0, vk::ShaderStageFlagBits::eCompute)
             .storage_image(1, vk::ShaderStageFlagBits::eCompute)
@@ -106,7 +107,7 @@ namespace Nebula::RenderGraph
 
         if (pass == 0)
         {
-            input = m_resources["Blur Input"]->as<ImageResource>().get_image();
+            input = get(m_handles.input).get_image();
             output = m_kernel.intermediate_image;
             descriptor = m_kernel.descriptor_pass_x;
         }
@@ -114,12 +115,12 @@ namespace Nebula::RenderGraph
         if (pass == 1)
         {
             input = m_kernel.intermediate_image;
-            output = m_resources["Blur Output"]->as<ImageResource>().get_image();
+            output = get(m_handles.output).get_image();
             descriptor = m_kernel.descriptor_pass_y;
         }
 
-        const vk::DescriptorImageInfo input_info { m_kernel.samplers[0], input->image_view(), input->state().layout };
-        const vk::DescriptorImageInfo output_info { m_kernel.samplers[1], output->image_view(), output->state().layout };
+        const vk::DescriptorImageInfo input_info { nullptr, input->image_view(), input->state().layout };
+        const vk::DescriptorImageInfo output_info { nullptr, output->image_view(), output->state().layout };
 
         descriptor->begin_write(current_frame)
             .storage_image(0, input_info)
@@ -22,6 +22,8 @@ namespace Nebula::RenderGraph
     public:
         explicit BlurNode(const sdvk::Context& context);
 
+        ~BlurNode() override;
+
         void execute(const vk::CommandBuffer& command_buffer) override;
 
         void initialize() override;
@@ -29,6 +31,12 @@ namespace Nebula::RenderGraph
     private:
         void _update_descriptor(uint32_t current_frame, uint32_t pass);
 
+        struct Resources
+        {
+            ImageHandle input;
+            ImageHandle output;
+        } m_handles;
+
         struct ComputeKernel
         {
             std::shared_ptr<Image> intermediate_image;
@@ -36,7 +44,6 @@ namespace Nebula::RenderGraph
             std::shared_ptr<Descriptor> descriptor_pass_y;
             vk::Pipeline pipeline;
             vk::PipelineLayout pipeline_layout;
-            std::vector<vk::Sampler> samplers;
             vk::Extent2D resolution;
             uint32_t frames_in_flight;
         } m_kernel;
@@ -1,7 +1,12 @@
 #include "GBufferPass.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
 #include <Nebula/Image.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
 #include <Vulkan/Context.hpp>
@@ -24,16 +29,29 @@ namespace Nebula::RenderGraph
     {
     }
 
-    void GBufferPass::initialize()
+    GBufferPass::~GBufferPass()
     {
-        const auto position       = m_resources[id_position_buffer]->as<ImageResource>().get_image();
-        const auto normal         = m_resources[id_normal_buffer]->as<ImageResource>().get_image();
-        const auto albedo         = m_resources[id_albedo_buffer]->as<ImageResource>().get_image();
-        const auto depth          = m_resources[id_depth_buffer]->as<DepthImageResource>().get_depth_image();
-        const auto motion_vectors = m_resources[id_motion_vectors]->as<ImageResource>().get_image();
+        m_context.destruction_queue()->destroy(m_renderer.pipeline, m_renderer.pipeline_layout, m_renderer.render_pass);
+    }
 
-        m_renderer.render_resolution = sd::Application::s_extent.vk_ext();
+    void GBufferPass::initialize()
+    {
+        m_handles.scene_data      = get_handle<SceneResource>(id_scene_data);
+        m_handles.position_buffer = get_handle<ImageResource>(id_position_buffer);
+        m_handles.normal_buffer   = get_handle<ImageResource>(id_normal_buffer);
+        m_handles.albedo_buffer   = get_handle<ImageResource>(id_albedo_buffer);
+        m_handles.depth_buffer    = get_handle<DepthImageResource>(id_depth_buffer);
+        m_handles.motion_vectors  = get_handle<ImageResource>(id_motion_vectors);
+
+        const auto position       = get(m_handles.position_buffer).get_image();
+        const auto normal         = get(m_handles.normal_buffer).get_image();
+        const auto albedo         = get(m_handles.albedo_buffer).get_image();
+        const auto depth          = get(m_handles.depth_buffer).get_depth_image();
+        const auto motion_vectors = get(m_handles.motion_vectors).get_image();
+
+        m_renderer.render_resolution = render_resolution();
         m_renderer.frames_in_flight = sd::Application::s_max_frames_in_flight;
+        m_renderer.instance_buffers.resize(m_renderer.frames_in_flight);
 
         for (int32_t i = 0; i < 4; i++)
         {
@@ -46,7 +64,7 @@ namespace Nebula::RenderGraph
             .add_color_attachment(normal->properties().format)
             .add_color_attachment(albedo->properties().format)
             .add_color_attachment(motion_vectors->properties().format)
-            .set_depth_attachment(depth->properties().format)
+            .set_depth_attachment(depth->properties().format, vk::SampleCountFlagBits::e1, vk::AttachmentStoreOp::eStore)
             .make_subpass()
             .create(m_context);
 
@@ -62,13 +80,9 @@ namespace Nebula::RenderGraph
             .set_name("G-Buffer Framebuffer")
             .create(m_context);
 
-        m_renderer.descriptor = Descriptor::Builder()
-            .uniform_buffer(0, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment)
-            .create(m_renderer.frames_in_flight, m_context);
-
         auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
             .add_push_constant({ vk::ShaderStageFlagBits::eVertex, 0, sizeof(PrePassPushConstant) })
-            .add_descriptor_set_layout(m_renderer.descriptor->layout())
+            .add_descriptor_set_layout(ViewConstants::instance(m_context).layout())
             .create_pipeline_layout()
             .set_sample_count(vk::SampleCountFlagBits::e1)
             .set_attachment_count(4)
@@ -82,31 +96,23 @@ namespace Nebula::RenderGraph
         m_renderer.pipeline = pipeline;
         m_renderer.pipeline_layout = pipeline_layout;
 
-        m_renderer.uniform.resize(m_renderer.frames_in_flight);
-        for (auto& ub : m_renderer.uniform)
+        if (m_context.is_indirect_count_capable())
         {
-            ub = sdvk::Buffer::Builder()
-                .with_size(sizeof(PrePassUniform))
-                .as_uniform_buffer()
-                .create(m_context);
+            m_gpu_culling = std::make_unique<GpuCulling>(depth->properties().extent, m_renderer.frames_in_flight, m_context);
         }
-
-        const auto camera = m_resources[id_scene_data]->as<SceneResource>().get_scene()->camera();
-        m_renderer.previous_frame_camera_state = camera->uniform_data();
     }
 
     void GBufferPass::execute(const vk::CommandBuffer& command_buffer)
     {
         const uint32_t current_frame = sd::Application::s_current_frame;
 
-        _update_descriptor(current_frame);
-
-        const auto& objects    = m_resources[id_scene_data]->as<SceneResource>().get_scene()->objects();
-        const auto position       = m_resources[id_position_buffer]->as<ImageResource>().get_image();
-        const auto normal         = m_resources[id_normal_buffer]->as<ImageResource>().get_image();
-        const auto albedo         = m_resources[id_albedo_buffer]->as<ImageResource>().get_image();
-        const auto depth          = m_resources[id_depth_buffer]->as<DepthImageResource>().get_depth_image();
-        const auto motion_vectors = m_resources[id_motion_vectors]->as<ImageResource>().get_image();
+        const auto& scene         = get(m_handles.scene_data).get_scene();
+        const auto& render_list   = scene->render_list();
+        const auto position       = get(m_handles.position_buffer).get_image();
+        const auto normal         = get(m_handles.normal_buffer).get_image();
+        const auto albedo         = get(m_handles.albedo_buffer).get_image();
+        const auto depth          = get(m_handles.depth_buffer).get_depth_image();
+        const auto motion_vectors = get(m_handles.motion_vectors).get_image();
 
         Sync::ImageBarrier(position, position->state().layout, vk::ImageLayout::eColorAttachmentOptimal).apply(command_buffer);
         Sync::ImageBarrier(normal, normal->state().layout, vk::ImageLayout::eColorAttachmentOptimal).apply(command_buffer);
@@ -114,6 +120,32 @@ namespace Nebula::RenderGraph
         Sync::ImageBarrier(depth, depth->state().layout, vk::ImageLayout::eDepthAttachmentOptimal).apply(command_buffer);
         Sync::ImageBarrier(motion_vectors, motion_vectors->state().layout, vk::ImageLayout::eColorAttachmentOptimal).apply(command_buffer);
 
+        const bool gpu_driven = m_gpu_culling && scene->store().size() >= s_gpu_culling_min_objects;
+        vk::DeviceAddress instance_address = 0;
+        if (gpu_driven)
+        {
+            m_gpu_culling->update_tables(*scene, current_frame, command_buffer);
+            m_gpu_culling->cull(scene->gpu_scene(), current_frame, command_buffer);
+            instance_address = m_gpu_culling->instance_address();
+        }
+        else
+        {
+            const auto& instances = render_list.objects();
+            const vk::DeviceSize instances_size = std::max<size_t>(instances.size(), 1) * sizeof(uint32_t);
+            auto& instance_buffer = m_renderer.instance_buffers[current_frame];
+            if (!instance_buffer || instance_buffer->size() < instances_size)
+            {
+                // Grows with headroom, the previous buffer is released once the frames using it have finished.
+                instance_buffer = sdvk::Buffer::Builder()
+                    .with_size(instances_size + instances_size / 2)
+                    .as_storage_buffer()
+                    .with_name(std::format("G-Buffer Instances {}", current_frame))
+                    .create(m_context);
+            }
+            std::memcpy(instance_buffer->mapped(), instances.data(), instances.size() * sizeof(uint32_t));
+            instance_address = instance_buffer->address();
+        }
+
         sdvk::RenderPass::Execute()
             .with_clear_values<5>(m_renderer.clear_values)
             .with_framebuffer(m_renderer.framebuffers->get(current_frame))
@@ -122,43 +154,43 @@ namespace Nebula::RenderGraph
             .execute(command_buffer, [&](const vk::CommandBuffer& cmd){
                 cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline);
                 cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                       m_renderer.pipeline_layout, 0, 1,
-                                       &m_renderer.descriptor->set(current_frame),
+                                       m_renderer.pipeline_layout, ViewConstants::s_set_index, 1,
+                                       &ViewConstants::instance(m_context).set(current_frame),
                                        0, nullptr);
 
-                for (const auto& object : objects)
-                {
-                    PrePassPushConstant pc {};
-                    pc.model_matrix = object.transform.model();
-                    pc.color = object.color;
+                PrePassPushConstant pc {};
+                pc.objects_address = scene->gpu_scene().address();
+                pc.instances_address = instance_address;
+                cmd.pushConstants(m_renderer.pipeline_layout,
+                                  vk::ShaderStageFlagBits::eVertex,
+                                  0,
+                                  sizeof(PrePassPushConstant),
+                                  &pc);
 
-                    cmd.pushConstants(m_renderer.pipeline_layout,
-                                      vk::ShaderStageFlagBits::eVertex,
-                                      0,
-                                      sizeof(PrePassPushConstant),
-                                      &pc);
+                if (gpu_driven)
+                {
+                    m_gpu_culling->draw(*scene, cmd);
+                    return;
+                }
 
-                    object.mesh->draw(cmd);
+                // Batches are sorted by mesh, consecutive meshes usually share a page of the geometry pool.
+                const auto& meshes = scene->mesh_table();
+                const sdvk::Mesh* bound = nullptr;
+                for (const auto& batch : render_list.batches())
+                {
+                    const auto& mesh = meshes[batch.mesh_index];
+                    if (!bound || !mesh->shares_buffers(*bound))
+                    {
+                        mesh->bind(cmd);
+                        bound = mesh.get();
+                    }
+                    mesh->draw(cmd, batch.instance_count, batch.first_instance);
                 }
             });
-    }
-
-    void GBufferPass::_update_descriptor(const uint32_t current_frame)
-    {
-        const auto camera = m_resources[id_scene_data]->as<SceneResource>().get_scene()->camera();
-        const auto camera_data = camera->uniform_data();
-
-        PrePassUniform uniform {
-            .current = camera_data,
-            .previous = m_renderer.previous_frame_camera_state,
-        };
-
-        m_renderer.uniform[current_frame]->set_data(&uniform, m_context.device());
 
-        m_renderer.descriptor->begin_write(current_frame)
-            .uniform_buffer(0, m_renderer.uniform[current_frame]->buffer(), 0, sizeof(PrePassUniform))
-            .commit();
-
-        m_renderer.previous_frame_camera_state = camera_data;
+        if (gpu_driven)
+        {
+            m_gpu_culling->build_depth_pyramid(depth, current_frame, command_buffer);
+        }
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <Nebula/Descriptor.hpp>
 #include <Nebula/Framebuffer.hpp>
 #include <VirtualGraph/RenderGraph/Resources/ResourceSpecification.hpp>
+#include <VirtualGraph/RenderGraph/Nodes/GpuCulling.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/Node.hpp>
 #include <Vulkan/Buffer.hpp>
 
@@ -16,16 +17,11 @@ namespace sdvk
 
 namespace Nebula::RenderGraph
 {
+    // Object data comes from the GPU scene, the object index of each instance from the render list or from GPU culling.
     struct PrePassPushConstant
     {
-        glm::mat4 model_matrix {1.0f};
-        glm::vec4 color {0.5f};
-    };
-
-    struct PrePassUniform
-    {
-        sd::CameraUniformData current;
-        sd::CameraUniformData previous;
+        uint64_t objects_address { 0 };
+        uint64_t instances_address { 0 };
     };
 
     class GBufferPass final : public Node
@@ -37,26 +33,39 @@ namespace Nebula::RenderGraph
 
         void initialize() override;
 
-        ~GBufferPass() override = default;
+        ~GBufferPass() override;
 
-    private:
-        void _update_descriptor(uint32_t current_frame);
+        // Null if the device cannot draw with a GPU written draw count.
+        const GpuCulling* gpu_culling() const { return m_gpu_culling.get(); }
+
+        // Scenes with at least this many objects are culled and drawn GPU-driven, smaller ones use the CPU render list.
+        static constexpr uint32_t s_gpu_culling_min_objects = 1024;
 
+    private:
         struct Renderer
         {
-            std::shared_ptr<Descriptor>   descriptor;
             std::shared_ptr<Framebuffer>  framebuffers;
+            std::vector<std::unique_ptr<sdvk::Buffer>> instance_buffers;
             vk::Pipeline                  pipeline;
             vk::PipelineLayout            pipeline_layout;
             vk::RenderPass                render_pass;
             std::array<vk::ClearValue, 5> clear_values;
             uint32_t                      frames_in_flight;
             vk::Extent2D                  render_resolution;
-
-            std::vector<std::unique_ptr<sdvk::Buffer>> uniform;
-            sd::CameraUniformData previous_frame_camera_state;
         } m_renderer;
 
+        struct Resources
+        {
+            SceneHandle      scene_data;
+            ImageHandle      position_buffer;
+            ImageHandle      normal_buffer;
+            ImageHandle      albedo_buffer;
+            DepthImageHandle depth_buffer;
+            ImageHandle      motion_vectors;
+        } m_handles;
+
+        std::unique_ptr<GpuCulling> m_gpu_culling;
+
         const sdvk::Context& m_context;
 
         static constexpr std::string id_scene_data      = "Scene Data";
@@ -0,0 +1,370 @@
+#include "GpuCulling.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <map>
+#include <numeric>
+#include <Nebula/Barrier.hpp>
+#include <Nebula/SamplerCache.hpp>
+#include <Scene/GpuScene.hpp>
+#include <Scene/Scene.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
+#include <Vulkan/Context.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+#include <Vulkan/Rendering/PipelineBuilder.hpp>
+
+namespace Nebula::RenderGraph
+{
+    static void memory_barrier(const vk::CommandBuffer& command_buffer,
+                               const vk::PipelineStageFlags2 src_stage, const vk::AccessFlags2 src_access,
+                               const vk::PipelineStageFlags2 dst_stage, const vk::AccessFlags2 dst_access)
+    {
+        vk::MemoryBarrier2 barrier;
+        barrier.setSrcStageMask(src_stage);
+        barrier.setSrcAccessMask(src_access);
+        barrier.setDstStageMask(dst_stage);
+        barrier.setDstAccessMask(dst_access);
+
+        vk::DependencyInfo dependency_info;
+        dependency_info.setMemoryBarrierCount(1);
+        dependency_info.setPMemoryBarriers(&barrier);
+        command_buffer.pipelineBarrier2(&dependency_info);
+    }
+
+    GpuCulling::GpuCulling(const vk::Extent2D depth_extent, const uint32_t frames_in_flight, const sdvk::Context& context)
+    : m_depth_extent(depth_extent)
+    , m_context(context)
+    {
+        m_staging.resize(frames_in_flight);
+        m_readback.resize(frames_in_flight);
+
+        uint32_t pyramid_texels = 0;
+        vk::Extent2D size = depth_extent;
+        do
+        {
+            size = { std::max((size.width + 1) / 2, 1u), std::max((size.height + 1) / 2, 1u) };
+            m_pyramid_sizes.push_back(size);
+            m_pyramid_offsets.push_back(pyramid_texels);
+            pyramid_texels += size.width * size.height;
+        }
+        while (size.width > 1 || size.height > 1);
+
+        m_depth_pyramid = sdvk::Buffer::Builder()
+            .with_size(pyramid_texels * sizeof(float))
+            .with_usage_flags(vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress)
+            .with_memory_property_flags(vk::MemoryPropertyFlagBits::eDeviceLocal)
+            .with_name("GPU Culling - Depth Pyramid")
+            .create(m_context);
+
+        // Depth formats do not have to support linear filtering, the reduction only fetches texels.
+        vk::SamplerCreateInfo sampler_info;
+        sampler_info.setMagFilter(vk::Filter::eNearest);
+        sampler_info.setMinFilter(vk::Filter::eNearest);
+        sampler_info.setMipmapMode(vk::SamplerMipmapMode::eNearest);
+        sampler_info.setAddressModeU(vk::SamplerAddressMode::eClampToEdge);
+        sampler_info.setAddressModeV(vk::SamplerAddressMode::eClampToEdge);
+        sampler_info.setAddressModeW(vk::SamplerAddressMode::eClampToEdge);
+        sampler_info.setMaxLod(0.0f);
+        m_depth_sampler = SamplerCache::instance(m_context).get(sampler_info);
+
+        m_depth_descriptor = Descriptor::Builder()
+            .combined_image_sampler(0, vk::ShaderStageFlagBits::eCompute, m_depth_sampler)
+            .create(frames_in_flight, m_context, "GPU Culling - Depth");
+
+        auto [cull_pipeline, cull_pipeline_layout] = sdvk::PipelineBuilder(m_context)
+            .add_push_constant({ vk::ShaderStageFlagBits::eCompute, 0, sizeof(GpuCullPushConstant) })
+            .add_descriptor_set_layout(ViewConstants::instance(m_context).layout())
+            .create_pipeline_layout()
+            .add_shader("rg_gpu_cull.comp.spv", vk::ShaderStageFlagBits::eCompute)
+            .with_name("GPU Culling")
+            .create_compute_pipeline();
+
+        m_cull_pipeline = cull_pipeline;
+        m_cull_pipeline_layout = cull_pipeline_layout;
+
+        auto [reduce_pipeline, reduce_pipeline_layout] = sdvk::PipelineBuilder(m_context)
+            .add_push_constant({ vk::ShaderStageFlagBits::eCompute, 0, sizeof(HiZReducePushConstant) })
+            .add_descriptor_set_layout(m_depth_descriptor->layout())
+            .create_pipeline_layout()
+            .add_shader("rg_hiz_reduce.comp.spv", vk::ShaderStageFlagBits::eCompute)
+            .with_name("GPU Culling - Depth Pyramid")
+            .create_compute_pipeline();
+
+        m_reduce_pipeline = reduce_pipeline;
+        m_reduce_pipeline_layout = reduce_pipeline_layout;
+    }
+
+    GpuCulling::~GpuCulling()
+    {
+        m_context.destruction_queue()->destroy(m_cull_pipeline, m_cull_pipeline_layout, m_reduce_pipeline, m_reduce_pipeline_layout);
+    }
+
+    void GpuCulling::update_tables(const sd::Scene& scene, const uint32_t current_frame, const vk::CommandBuffer& command_buffer)
+    {
+        const auto& store = scene.store();
+        auto bindings = _mesh_bindings(scene);
+        if (m_meshes && store.size() == m_object_count && bindings == m_bindings && scene.mesh_assignment() == m_mesh_assignment)
+        {
+            return;
+        }
+
+        m_bindings = std::move(bindings);
+        m_mesh_assignment = scene.mesh_assignment();
+        _create_tables(scene);
+        if (m_object_count == 0)
+        {
+            return;
+        }
+
+        const vk::DeviceSize meshes_size = m_mesh_data.size() * sizeof(GpuCullMesh);
+        auto& staging = m_staging[current_frame];
+        if (!staging || staging->size() < meshes_size)
+        {
+            staging = sdvk::Buffer::Builder()
+                .with_size(meshes_size)
+                .with_name(std::format("GPU Culling - Meshes {}", current_frame))
+                .create_staging(m_context);
+        }
+        std::memcpy(staging->mapped(), m_mesh_data.data(), meshes_size);
+
+        // The tables are new, previous frames keep using the ones they were recorded with.
+        command_buffer.copyBuffer(staging->buffer(), m_meshes->buffer(), vk::BufferCopy(0, 0, meshes_size));
+
+        memory_barrier(command_buffer,
+                       vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite,
+                       vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageRead);
+    }
+
+    void GpuCulling::cull(const sd::GpuScene& gpu_scene, const uint32_t current_frame, const vk::CommandBuffer& command_buffer)
+    {
+        _read_statistics(current_frame);
+
+        if (m_object_count == 0)
+        {
+            return;
+        }
+
+        // Counts, commands and instance objects of the previous frame may still be read by its draws and statistics copy.
+        memory_barrier(command_buffer,
+                       vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eVertexShader | vk::PipelineStageFlagBits2::eTransfer, {},
+                       vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite);
+        command_buffer.fillBuffer(m_counts->buffer(), 0, VK_WHOLE_SIZE, 0);
+
+        // Also makes the depth pyramid of the previous frame visible.
+        memory_barrier(command_buffer,
+                       vk::PipelineStageFlagBits2::eTransfer | vk::PipelineStageFlagBits2::eComputeShader,
+                       vk::AccessFlagBits2::eTransferWrite | vk::AccessFlagBits2::eShaderStorageWrite,
+                       vk::PipelineStageFlagBits2::eComputeShader,
+                       vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite);
+
+        GpuCullPushConstant pc {};
+        pc.objects = gpu_scene.address();
+        pc.meshes = m_meshes->address();
+        pc.commands = m_commands->address();
+        pc.instance_objects = m_instance_objects->address();
+        pc.counts = m_counts->address();
+        pc.depth_pyramid = m_depth_pyramid->address();
+        pc.depth_size = { m_depth_extent.width, m_depth_extent.height };
+        pc.pyramid_levels = static_cast<uint32_t>(m_pyramid_sizes.size());
+        pc.object_count = m_object_count;
+        pc.batch_count = static_cast<uint32_t>(m_batches.size());
+        pc.occlusion_enabled = m_has_pyramid ? 1 : 0;
+
+        command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_cull_pipeline);
+        command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_cull_pipeline_layout, ViewConstants::s_set_index, 1,
+                                          &ViewConstants::instance(m_context).set(current_frame), 0, nullptr);
+        command_buffer.pushConstants(m_cull_pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(GpuCullPushConstant), &pc);
+        command_buffer.dispatch((m_object_count + s_cull_group_size - 1) / s_cull_group_size, 1, 1);
+
+        memory_barrier(command_buffer,
+                       vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageWrite,
+                       vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eVertexShader | vk::PipelineStageFlagBits2::eTransfer,
+                       vk::AccessFlagBits2::eIndirectCommandRead | vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eTransferRead);
+
+        auto& readback = m_readback[current_frame];
+        if (!readback.buffer || readback.buffer->size() != m_counts->size())
+        {
+            readback.buffer = sdvk::Buffer::Builder()
+                .with_size(m_counts->size())
+                .as_readback_buffer()
+                .with_name(std::format("GPU Culling - Statistics {}", current_frame))
+                .create(m_context);
+        }
+        command_buffer.copyBuffer(m_counts->buffer(), readback.buffer->buffer(), vk::BufferCopy(0, 0, m_counts->size()));
+        memory_barrier(command_buffer,
+                       vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite,
+                       vk::PipelineStageFlagBits2::eHost, vk::AccessFlagBits2::eHostRead);
+        readback.batch_count = static_cast<uint32_t>(m_batches.size());
+        readback.pending = true;
+    }
+
+    void GpuCulling::draw(const sd::Scene& scene, const vk::CommandBuffer& command_buffer) const
+    {
+        if (m_object_count == 0)
+        {
+            return;
+        }
+
+        const auto& mesh_table = scene.mesh_table();
+        for (uint32_t i = 0; i < m_batches.size(); i++)
+        {
+            const DrawBatch& batch = m_batches[i];
+            if (batch.capacity == 0)
+            {
+                continue;
+            }
+
+            const auto& mesh = mesh_table[batch.mesh];
+            mesh->bind(command_buffer);
+            mesh->draw_indirect_count(command_buffer,
+                                      *m_commands, batch.first_command * sizeof(vk::DrawIndexedIndirectCommand),
+                                      *m_counts, i * sizeof(uint32_t),
+                                      batch.capacity);
+        }
+    }
+
+    void GpuCulling::build_depth_pyramid(const std::shared_ptr<Image>& depth, const uint32_t current_frame, const vk::CommandBuffer& command_buffer)
+    {
+        Sync::ImageBarrier(depth, depth->state().layout, vk::ImageLayout::eShaderReadOnlyOptimal,
+                           vk::AccessFlagBits2::eDepthStencilAttachmentWrite, vk::AccessFlagBits2::eShaderSampledRead,
+                           vk::PipelineStageFlagBits2::eLateFragmentTests, vk::PipelineStageFlagBits2::eComputeShader).apply(command_buffer);
+
+        m_depth_descriptor->begin_write(current_frame)
+            .combined_image_sampler(0, m_depth_sampler, depth->image_view(), vk::ImageLayout::eShaderReadOnlyOptimal)
+            .commit();
+
+        // cull() of this frame has read the previous pyramid.
+        memory_barrier(command_buffer,
+                       vk::PipelineStageFlagBits2::eComputeShader, {},
+                       vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageWrite);
+
+        command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_reduce_pipeline);
+        command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_reduce_pipeline_layout, 0, 1,
+                                          &m_depth_descriptor->set(current_frame), 0, nullptr);
+
+        HiZReducePushConstant pc {};
+        pc.depth_pyramid = m_depth_pyramid->address();
+        for (uint32_t level = 0; level < m_pyramid_sizes.size(); level++)
+        {
+            const vk::Extent2D source = level == 0 ? m_depth_extent : m_pyramid_sizes[level - 1];
+            const vk::Extent2D target = m_pyramid_sizes[level];
+
+            pc.from_depth = level == 0 ? 1 : 0;
+            pc.source_size = { source.width, source.height };
+            pc.source_offset = level == 0 ? 0 : m_pyramid_offsets[level - 1];
+            pc.target_size = { target.width, target.height };
+            pc.target_offset = m_pyramid_offsets[level];
+
+            if (level > 0)
+            {
+                memory_barrier(command_buffer,
+                               vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageWrite,
+                               vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderStorageRead);
+            }
+
+            command_buffer.pushConstants(m_reduce_pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(HiZReducePushConstant), &pc);
+            command_buffer.dispatch((target.width + s_reduce_group_size - 1) / s_reduce_group_size,
+                                    (target.height + s_reduce_group_size - 1) / s_reduce_group_size,
+                                    1);
+        }
+
+        m_has_pyramid = true;
+    }
+
+    void GpuCulling::_create_tables(const sd::Scene& scene)
+    {
+        const auto& store = scene.store();
+        const auto& mesh_table = scene.mesh_table();
+        m_object_count = static_cast<uint32_t>(store.size());
+
+        // Meshes with the same buffers share a batch, pooled geometry puts most meshes into a few of them.
+        std::map<std::pair<const sdvk::Buffer*, const sdvk::Buffer*>, uint32_t> batch_indices;
+        std::vector<uint32_t> mesh_batches(mesh_table.size());
+        m_batches.clear();
+        for (uint32_t i = 0; i < mesh_table.size(); i++)
+        {
+            const auto key = std::make_pair(m_bindings[i].vertex_buffer, m_bindings[i].index_buffer);
+            auto [it, inserted] = batch_indices.try_emplace(key, static_cast<uint32_t>(m_batches.size()));
+            if (inserted)
+            {
+                m_batches.push_back({ i });
+            }
+            mesh_batches[i] = it->second;
+        }
+
+        // Every batch gets a command range large enough for all objects of its meshes.
+        for (const uint32_t mesh_index : store.mesh_indices())
+        {
+            if (mesh_index != sd::SceneStore::s_no_mesh)
+            {
+                m_batches[mesh_batches[mesh_index]].capacity++;
+            }
+        }
+
+        uint32_t command_count = 0;
+        for (auto& batch : m_batches)
+        {
+            batch.first_command = command_count;
+            command_count += batch.capacity;
+        }
+
+        m_mesh_data.resize(mesh_table.size());
+        for (uint32_t i = 0; i < mesh_table.size(); i++)
+        {
+            const auto& bounds = mesh_table[i]->bounds();
+            m_mesh_data[i] = {
+                bounds.min, static_cast<uint32_t>(mesh_table[i]->geometry().indices().size()),
+                bounds.max, m_bindings[i].first_index,
+                static_cast<int32_t>(m_bindings[i].first_vertex), mesh_batches[i], m_batches[mesh_batches[i]].first_command,
+            };
+        }
+
+        constexpr auto table_usage = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress
+                                   | vk::BufferUsageFlagBits::eTransferDst;
+
+        auto create_table = [&](const vk::DeviceSize size, const vk::BufferUsageFlags usage, const std::string& name) {
+            return sdvk::Buffer::Builder()
+                .with_size(std::max<vk::DeviceSize>(size, 4))
+                .with_usage_flags(usage)
+                .with_memory_property_flags(vk::MemoryPropertyFlagBits::eDeviceLocal)
+                .with_name(std::format("GPU Culling - {}", name))
+                .create(m_context);
+        };
+
+        // Replaced tables are released once the frames using them have finished.
+        m_meshes = create_table(mesh_table.size() * sizeof(GpuCullMesh), table_usage, "Meshes");
+        m_commands = create_table(command_count * sizeof(vk::DrawIndexedIndirectCommand),
+                                  table_usage | vk::BufferUsageFlagBits::eIndirectBuffer, "Draw Commands");
+        m_instance_objects = create_table(command_count * sizeof(uint32_t), table_usage, "Instance Objects");
+        m_counts = create_table((m_batches.size() + s_statistics_counters) * sizeof(uint32_t),
+                                table_usage | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferSrc, "Draw Counts");
+    }
+
+    void GpuCulling::_read_statistics(const uint32_t current_frame)
+    {
+        auto& readback = m_readback[current_frame];
+        if (!readback.pending)
+        {
+            return;
+        }
+
+        const auto* counters = static_cast<const uint32_t*>(readback.buffer->mapped());
+        m_statistics.visible = std::accumulate(counters, counters + readback.batch_count, 0u);
+        m_statistics.frustum_culled = counters[readback.batch_count];
+        m_statistics.occlusion_culled = counters[readback.batch_count + 1];
+        m_statistics.tested = m_statistics.visible + m_statistics.frustum_culled + m_statistics.occlusion_culled;
+        readback.pending = false;
+    }
+
+    std::vector<GpuCulling::MeshBinding> GpuCulling::_mesh_bindings(const sd::Scene& scene)
+    {
+        std::vector<MeshBinding> result;
+        result.reserve(scene.mesh_table().size());
+        for (const auto& mesh : scene.mesh_table())
+        {
+            result.push_back({ &mesh->vertex_buffer(), &mesh->index_buffer(), mesh->first_vertex(), mesh->first_index() });
+        }
+        return result;
+    }
+}
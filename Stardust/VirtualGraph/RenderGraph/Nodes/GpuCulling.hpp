@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+#include <Nebula/Descriptor.hpp>
+#include <Nebula/Image.hpp>
+#include <Vulkan/Buffer.hpp>
+
+namespace sd
+{
+    class GpuScene;
+    class Scene;
+}
+
+namespace sdvk
+{
+    class Context;
+}
+
+namespace Nebula::RenderGraph
+{
+    // Must match rg_gpu_cull.comp
+    struct GpuCullPushConstant
+    {
+        uint64_t   objects { 0 };
+        uint64_t   meshes { 0 };
+        uint64_t   commands { 0 };
+        uint64_t   instance_objects { 0 };
+        uint64_t   counts { 0 };
+        uint64_t   depth_pyramid { 0 };
+        glm::uvec2 depth_size { 0 };
+        uint32_t   pyramid_levels { 0 };
+        uint32_t   object_count { 0 };
+        uint32_t   batch_count { 0 };
+        uint32_t   occlusion_enabled { 0 };
+    };
+
+    // Must match rg_hiz_reduce.comp
+    struct HiZReducePushConstant
+    {
+        uint64_t   depth_pyramid { 0 };
+        glm::uvec2 source_size { 0 };
+        glm::uvec2 target_size { 0 };
+        uint32_t   source_offset { 0 };
+        uint32_t   target_offset { 0 };
+        uint32_t   from_depth { 0 };
+    };
+
+    // Scalar block layout, object space bounds, the geometry in the shared buffers and the command range of the batch.
+    struct GpuCullMesh
+    {
+        glm::vec3 bounds_min { 0.0f };
+        uint32_t  index_count { 0 };
+        glm::vec3 bounds_max { 0.0f };
+        uint32_t  first_index { 0 };
+        int32_t   vertex_offset { 0 };
+        uint32_t  batch { 0 };
+        uint32_t  first_command { 0 };
+    };
+
+    struct GpuCullStatistics
+    {
+        uint32_t tested { 0 };
+        uint32_t visible { 0 };
+        uint32_t frustum_culled { 0 };
+        uint32_t occlusion_culled { 0 };
+    };
+
+    /**
+     * GPU-driven culling of the G-Buffer pass. Transforms and meshes of the objects are read from the GPU scene, a compute pass
+     * culls each object against the camera frustum and a depth pyramid of the previous frame. Visible objects append an indexed
+     * indirect draw to the command range of their batch and write their object index to the instance slot of the draw.
+     * Meshes sharing vertex and index buffers form a batch, draw() binds them once and issues one indirect count draw per batch.
+     */
+    class GpuCulling
+    {
+    public:
+        GpuCulling(vk::Extent2D depth_extent, uint32_t frames_in_flight, const sdvk::Context& context);
+
+        ~GpuCulling();
+
+        GpuCulling(const GpuCulling&) = delete;
+        GpuCulling& operator=(const GpuCulling&) = delete;
+
+        // Creates the mesh table and command ranges on the first call, after objects or meshes were added and after mesh geometry moved.
+        void update_tables(const sd::Scene& scene, uint32_t current_frame, const vk::CommandBuffer& command_buffer);
+
+        // Outside of a render pass, before draw().
+        void cull(const sd::GpuScene& gpu_scene, uint32_t current_frame, const vk::CommandBuffer& command_buffer);
+
+        void draw(const sd::Scene& scene, const vk::CommandBuffer& command_buffer) const;
+
+        // After the render pass: reduces the depth buffer into the pyramid the next cull() tests against.
+        void build_depth_pyramid(const std::shared_ptr<Image>& depth, uint32_t current_frame, const vk::CommandBuffer& command_buffer);
+
+        // Object index of every draw command, firstInstance of a command is its own index.
+        vk::DeviceAddress instance_address() const { return m_instance_objects ? m_instance_objects->address() : 0; }
+
+        // Counters read back from the last frame that used the current frame slot.
+        const GpuCullStatistics& statistics() const { return m_statistics; }
+
+    private:
+        void _create_tables(const sd::Scene& scene);
+
+        void _read_statistics(uint32_t current_frame);
+
+        // Where the geometry of a mesh is, draws are recorded against it.
+        struct MeshBinding
+        {
+            const sdvk::Buffer* vertex_buffer { nullptr };
+            const sdvk::Buffer* index_buffer { nullptr };
+            uint32_t            first_vertex { 0 };
+            uint32_t            first_index { 0 };
+
+            bool operator==(const MeshBinding&) const = default;
+        };
+
+        // Meshes sharing buffers, drawn through the first of them.
+        struct DrawBatch
+        {
+            uint32_t mesh { 0 };
+            uint32_t first_command { 0 };
+            uint32_t capacity { 0 };
+        };
+
+        struct Readback
+        {
+            std::unique_ptr<sdvk::Buffer> buffer;
+            uint32_t                      batch_count { 0 };
+            bool                          pending { false };
+        };
+
+        static std::vector<MeshBinding> _mesh_bindings(const sd::Scene& scene);
+
+        std::unique_ptr<sdvk::Buffer>              m_meshes;
+        std::unique_ptr<sdvk::Buffer>              m_commands;
+        std::unique_ptr<sdvk::Buffer>              m_instance_objects;
+        // Draw count per batch, followed by the frustum and occlusion culled counters.
+        std::unique_ptr<sdvk::Buffer>              m_counts;
+        std::vector<std::unique_ptr<sdvk::Buffer>> m_staging;
+        std::vector<Readback>                      m_readback;
+        std::vector<DrawBatch>                     m_batches;
+        std::vector<MeshBinding>                   m_bindings;
+        // Of the mesh indices the batch capacities were counted from.
+        uint64_t                                   m_mesh_assignment { 0 };
+        std::vector<GpuCullMesh>                   m_mesh_data;
+        uint32_t                                   m_object_count { 0 };
+        GpuCullStatistics                          m_statistics;
+
+        // Maximum depth of 2x2 texels per level, level 0 has half the depth resolution and the last one is 1x1.
+        std::unique_ptr<sdvk::Buffer> m_depth_pyramid;
+        std::vector<vk::Extent2D>     m_pyramid_sizes;
+        std::vector<uint32_t>         m_pyramid_offsets;
+        vk::Extent2D                  m_depth_extent;
+        bool                          m_has_pyramid { false };
+
+        std::shared_ptr<Descriptor> m_depth_descriptor;
+        vk::Sampler                 m_depth_sampler;
+        vk::Pipeline                m_cull_pipeline;
+        vk::PipelineLayout          m_cull_pipeline_layout;
+        vk::Pipeline                m_reduce_pipeline;
+        vk::PipelineLayout          m_reduce_pipeline_layout;
+
+        const sdvk::Context& m_context;
+
+        static constexpr uint32_t s_cull_group_size = 64;
+        static constexpr uint32_t s_reduce_group_size = 8;
+        // Counters behind the per batch draw counts.
+        static constexpr uint32_t s_statistics_counters = 2;
+    };
+}
@@ -1,11 +1,13 @@
 #include "LightingPass.hpp"
+#include <format>
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
-#include <Resources/CameraUniformData.hpp>
+#include <Nebula/SamplerCache.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
 #include <Vulkan/Context.hpp>
 #include <Vulkan/Image/Sampler.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 
 namespace Nebula::RenderGraph
 {
@@ -45,19 +47,25 @@ namespace Nebula::RenderGraph
     {
     }
 
+    LightingPass::~LightingPass()
+    {
+        m_renderer.pipelines.release(*m_context.destruction_queue());
+        m_context.destruction_queue()->destroy(m_renderer.pipeline_layout, m_renderer.render_pass);
+    }
+
     void LightingPass::execute(const vk::CommandBuffer& command_buffer)
     {
         const uint32_t current_frame = sd::Application::s_current_frame;
 
-        const auto position = m_resources["Position Buffer"]->as<ImageResource>().get_image();
-        const auto normal = m_resources["Normal Buffer"]->as<ImageResource>().get_image();
-        const auto albedo = m_resources["Albedo Buffer"]->as<ImageResource>().get_image();
-        const auto depth = m_resources["Depth Buffer"]->as<DepthImageResource>().get_depth_image();
-        const auto lr = m_resources["Lighting Result"]->as<ImageResource>().get_image();
+        const auto position = get(m_handles.position_buffer).get_image();
+        const auto normal = get(m_handles.normal_buffer).get_image();
+        const auto albedo = get(m_handles.albedo_buffer).get_image();
+        const auto depth = get(m_handles.depth_buffer).get_depth_image();
+        const auto lr = get(m_handles.lighting_result).get_image();
 
-        if (m_params.ambient_occlusion)
+        if (m_ao_available)
         {
-            const auto ao = dynamic_cast<ImageResource&>(*m_resources["AO Image"]).get_image();
+            const auto ao = get(m_handles.ao_image).get_image();
             Sync::ImageBarrier(ao, ao->state().layout, vk::ImageLayout::eShaderReadOnlyOptimal).apply(command_buffer);
         }
 
@@ -71,19 +79,25 @@ namespace Nebula::RenderGraph
 
         _update_descriptor(current_frame);
 
+        const vk::Pipeline& pipeline = m_renderer.pipelines.get(_permutation_key());
+
         sdvk::RenderPass::Execute()
             .with_clear_value(m_renderer.clear_values)
             .with_framebuffer(m_renderer.framebuffers->get(current_frame))
             .with_render_area({{ 0, 0 }, m_renderer.render_resolution})
             .with_render_pass(m_renderer.render_pass)
             .execute(command_buffer, [&](const vk::CommandBuffer& cmd){
-                LightingPassPushConstant push_constant(m_params);
+                LightingPassPushConstant push_constant;
                 push_constant.light_pos = { -12, 10, 5, 1 };
 
-                cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline);
+                cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
                 cmd.pushConstants(m_renderer.pipeline_layout, vk::ShaderStageFlagBits::eFragment, 0, sizeof(LightingPassPushConstant), &push_constant);
-                cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline_layout, 0, 1,
-                                       &m_renderer.descriptor->set(current_frame), 0, nullptr);
+                const std::array descriptor_sets = {
+                    ViewConstants::instance(m_context).set(current_frame),
+                    m_renderer.descriptor->set(current_frame),
+                };
+                cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline_layout, ViewConstants::s_set_index,
+                                       descriptor_sets.size(), descriptor_sets.data(), 0, nullptr);
 
                 cmd.draw(3, 1, 0, 0);
             });
@@ -91,15 +105,20 @@ namespace Nebula::RenderGraph
 
     void LightingPass::initialize()
     {
-        if (const auto ao_image = std::dynamic_pointer_cast<ImageResource>(m_resources["AO Image"]);
-            ao_image == nullptr)
-        {
-            m_params.ambient_occlusion = false;
-        }
+        m_handles.position_buffer = get_handle<ImageResource>("Position Buffer");
+        m_handles.normal_buffer   = get_handle<ImageResource>("Normal Buffer");
+        m_handles.albedo_buffer   = get_handle<ImageResource>("Albedo Buffer");
+        m_handles.depth_buffer    = get_handle<DepthImageResource>("Depth Buffer");
+        m_handles.ao_image        = get_handle<ImageResource>("AO Image");
+        m_handles.tlas            = get_handle<TlasResource>("TLAS");
+        m_handles.lighting_result = get_handle<ImageResource>("Lighting Result");
+
+        m_ao_available = m_handles.ao_image.is_valid();
+        m_shadows_available = m_context.is_raytracing_capable() && m_handles.tlas.is_valid();
 
-        const auto lighting_result = m_resources["Lighting Result"]->as<ImageResource>().get_image();
+        const auto lighting_result = get(m_handles.lighting_result).get_image();
 
-        m_renderer.render_resolution = sd::Application::s_extent.vk_ext();
+        m_renderer.render_resolution = render_resolution();
         m_renderer.frames_in_flight = sd::Application::s_max_frames_in_flight;
 
         m_renderer.clear_values[0].setColor(std::array{ 0.0f, 0.0f, 0.0f, 1.0f });
@@ -117,112 +136,102 @@ namespace Nebula::RenderGraph
             .set_name("LightingPass Framebuffer")
             .create(m_context);
 
-        const auto tlas_binding = m_params.ambient_occlusion ? 6 : 5;
-        auto builder = Descriptor::Builder()
-            .uniform_buffer(0, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment)
-            .combined_image_sampler(1, vk::ShaderStageFlagBits::eFragment)
-            .combined_image_sampler(2, vk::ShaderStageFlagBits::eFragment)
-            .combined_image_sampler(3, vk::ShaderStageFlagBits::eFragment)
-            .combined_image_sampler(4, vk::ShaderStageFlagBits::eFragment)
-            .acceleration_structure(tlas_binding, vk::ShaderStageFlagBits::eFragment);
-
-        if (m_params.ambient_occlusion)
+        const vk::Sampler& sampler = SamplerCache::instance(m_context).get(sdvk::SamplerBuilder());
+        m_renderer.sampler = sampler;
+
+        // The AO binding is always present so every permutation can share the same layout.
+        auto descriptor_builder = Descriptor::Builder()
+            .combined_image_sampler(1, vk::ShaderStageFlagBits::eFragment, sampler)
+            .combined_image_sampler(2, vk::ShaderStageFlagBits::eFragment, sampler)
+            .combined_image_sampler(3, vk::ShaderStageFlagBits::eFragment, sampler)
+            .combined_image_sampler(4, vk::ShaderStageFlagBits::eFragment, sampler)
+            .combined_image_sampler(6, vk::ShaderStageFlagBits::eFragment, sampler);
+        if (m_shadows_available)
         {
-            builder.combined_image_sampler(5, vk::ShaderStageFlagBits::eFragment);
+            descriptor_builder.acceleration_structure(5, vk::ShaderStageFlagBits::eFragment);
         }
+        m_renderer.descriptor = descriptor_builder.create(m_renderer.frames_in_flight, m_context);
 
-        m_renderer.descriptor = builder.create(m_renderer.frames_in_flight, m_context);
-
-        const auto fragment_shader = _select_fragment_shader();
-        auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
+        // Pipelines are created lazily per permutation on first use, only the shared layout is created here.
+        const auto pipeline_layout = sdvk::PipelineBuilder(m_context)
             .add_push_constant({ vk::ShaderStageFlagBits::eFragment, 0, sizeof(LightingPassPushConstant) })
+            .add_descriptor_set_layout(ViewConstants::instance(m_context).layout())
             .add_descriptor_set_layout(m_renderer.descriptor->layout())
             .create_pipeline_layout()
-            .set_sample_count(vk::SampleCountFlagBits::e1)
-            .set_attachment_count(1)
-            .add_shader("rg_lighting_pass.vert.spv", vk::ShaderStageFlagBits::eVertex)
-            .add_shader(fragment_shader, vk::ShaderStageFlagBits::eFragment)
-            .set_cull_mode(vk::CullModeFlagBits::eNone)
-            .with_name("LightingPass")
-            .create_graphics_pipeline(m_renderer.render_pass);
+            .get_pipeline_layout();
 
-        m_renderer.pipeline = pipeline;
         m_renderer.pipeline_layout = pipeline_layout;
-
-        m_renderer.uniform.resize(m_renderer.frames_in_flight);
-        for (auto& ub : m_renderer.uniform)
-        {
-            ub = sdvk::Buffer::Builder()
-                .with_size(sizeof(LightingPassUniform))
-                .as_uniform_buffer()
-                .create(m_context);
-        }
-
-        m_renderer.samplers.resize(5);
-        for (vk::Sampler& sampler : m_renderer.samplers)
-        {
-            sampler = sdvk::SamplerBuilder().create(m_context.device());
-        }
+        m_renderer.pipelines = PipelinePermutations(pipeline_layout, [this](auto key, const auto& layout){
+            return _create_permutation(key, layout);
+        }, "LightingPass");
     }
 
     void LightingPass::_update_descriptor(uint32_t current_frame)
     {
-        const auto position = m_resources["Position Buffer"]->as<ImageResource>().get_image();
-        const auto normal = m_resources["Normal Buffer"]->as<ImageResource>().get_image();
-        const auto albedo = m_resources["Albedo Buffer"]->as<ImageResource>().get_image();
-        const auto depth = m_resources["Depth Buffer"]->as<DepthImageResource>().get_depth_image();
-
-        auto camera = *m_resources["Camera"]->as<CameraResource>().get_camera();
-        auto camera_data = camera.uniform_data();
-        m_renderer.uniform[current_frame]->set_data(&camera_data, m_context.device());
-
-        auto& tlas = m_resources["TLAS"]->as<TlasResource>().get_tlas();
-
-        LightingPassUniform uniform_data {};
-        uniform_data.view = camera_data.view;
-        uniform_data.proj = camera_data.proj;
-        uniform_data.view_inverse = camera_data.view_inverse;
-        uniform_data.proj_inverse = camera_data.proj_inverse;
-        uniform_data.eye = camera_data.eye;
-
-        vk::DescriptorImageInfo position_info { m_renderer.samplers[0],position->image_view(),position->state().layout };
-        vk::DescriptorImageInfo normal_info { m_renderer.samplers[1],normal->image_view(),normal->state().layout };
-        vk::DescriptorImageInfo albedo_info { m_renderer.samplers[2], albedo->image_view(), albedo->state().layout };
-        vk::DescriptorImageInfo depth_info { m_renderer.samplers[3], depth->image_view(), depth->state().layout };
-
-        if (m_params.ambient_occlusion)
+        const auto position = get(m_handles.position_buffer).get_image();
+        const auto normal = get(m_handles.normal_buffer).get_image();
+        const auto albedo = get(m_handles.albedo_buffer).get_image();
+        const auto depth = get(m_handles.depth_buffer).get_depth_image();
+
+        vk::DescriptorImageInfo position_info { m_renderer.sampler,position->image_view(),position->state().layout };
+        vk::DescriptorImageInfo normal_info { m_renderer.sampler,normal->image_view(),normal->state().layout };
+        vk::DescriptorImageInfo albedo_info { m_renderer.sampler, albedo->image_view(), albedo->state().layout };
+        vk::DescriptorImageInfo depth_info { m_renderer.sampler, depth->image_view(), depth->state().layout };
+
+        // Without an AO input the albedo image is bound as a placeholder, it's never sampled by those permutations.
+        vk::DescriptorImageInfo ao_info = albedo_info;
+        if (m_ao_available)
         {
-            auto ao = m_resources["AO Image"]->as<ImageResource>().get_image();
-            vk::DescriptorImageInfo ao_info { m_renderer.samplers[3], ao->image_view(), ao->state().layout };
-
-            m_renderer.descriptor->begin_write(current_frame)
-                .uniform_buffer(0, m_renderer.uniform[current_frame]->buffer(), 0, sizeof(LightingPassUniform))
-                .combined_image_sampler(1, position_info)
-                .combined_image_sampler(2, normal_info)
-                .combined_image_sampler(3, albedo_info)
-                .combined_image_sampler(4, depth_info)
-                .combined_image_sampler(5, ao_info)
-                .acceleration_structure(6, 1, &tlas->tlas())
-                .commit();
-
-            return;
+            auto ao = get(m_handles.ao_image).get_image();
+            ao_info = vk::DescriptorImageInfo { m_renderer.sampler, ao->image_view(), ao->state().layout };
         }
 
-        m_renderer.descriptor->begin_write(current_frame)
-            .uniform_buffer(0, m_renderer.uniform[current_frame]->buffer(), 0, sizeof(LightingPassUniform))
+        auto write = m_renderer.descriptor->begin_write(current_frame);
+        write
             .combined_image_sampler(1, position_info)
             .combined_image_sampler(2, normal_info)
             .combined_image_sampler(3, albedo_info)
             .combined_image_sampler(4, depth_info)
-            .acceleration_structure(5, 1, &tlas->tlas())
-            .commit();
+            .combined_image_sampler(6, ao_info);
+        if (m_shadows_available)
+        {
+            auto& tlas = get(m_handles.tlas).get_tlas();
+            write.acceleration_structure(5, 1, &tlas->tlas());
+        }
+        write.commit();
+    }
 
+    PipelinePermutations::Key LightingPass::_permutation_key() const
+    {
+        PipelinePermutations::Key key = 0;
+        if (m_ao_available && m_params.ambient_occlusion)
+        {
+            key |= eLightingPassAmbientOcclusion;
+        }
+        if (m_shadows_available && m_params.enable_shadows)
+        {
+            key |= eLightingPassShadows;
+        }
+        return key;
     }
 
-    std::string LightingPass::_select_fragment_shader() const
+    vk::Pipeline LightingPass::_create_permutation(const PipelinePermutations::Key key, const vk::PipelineLayout& pipeline_layout) const
     {
-        return m_params.ambient_occlusion
-            ? "rg_lighting_pass_ao.frag.spv"
-            : "rg_lighting_pass.frag.spv";
+        const auto specialization_constants = sdvk::SpecializationConstants()
+            .add(0, (key & eLightingPassAmbientOcclusion) != 0)
+            .add(1, (key & eLightingPassShadows) != 0);
+
+        auto [pipeline, _] = sdvk::PipelineBuilder(m_context)
+            .with_pipeline_layout(pipeline_layout)
+            .set_sample_count(vk::SampleCountFlagBits::e1)
+            .set_attachment_count(1)
+            .add_shader("rg_lighting_pass.vert.spv", vk::ShaderStageFlagBits::eVertex)
+            .add_shader(m_shadows_available ? "rg_lighting_pass.frag.spv" : "rg_lighting_pass_raster.frag.spv",
+                        vk::ShaderStageFlagBits::eFragment, specialization_constants)
+            .set_cull_mode(vk::CullModeFlagBits::eNone)
+            .with_name(std::format("LightingPass [{:#x}]", key))
+            .create_graphics_pipeline(m_renderer.render_pass);
+
+        return pipeline;
     }
 }
\ No newline at end of file
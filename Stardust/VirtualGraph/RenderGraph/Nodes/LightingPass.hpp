@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 #include <Nebula/Descriptor.hpp>
 #include <Nebula/Framebuffer.hpp>
+#include <Nebula/PipelinePermutations.hpp>
 #include <VirtualGraph/RenderGraph/Nodes/Node.hpp>
 #include <VirtualGraph/RenderGraph/Resources/ResourceSpecification.hpp>
 #include <Vulkan/Buffer.hpp>
@@ -32,27 +33,20 @@ namespace Nebula::RenderGraph
         // bool debug_render_lights {false};
     };
 
-    struct LightingPassUniform
+    struct LightingPassPushConstant
     {
-        glm::mat4 view;
-        glm::mat4 proj;
-        glm::mat4 view_inverse;
-        glm::mat4 proj_inverse;
-        glm::vec4 eye;
+        glm::vec4 light_pos {};
     };
 
-    struct LightingPassPushConstant
+    /*
+     * Specialization constants of rg_lighting_pass.frag
+     * [0]: Enable ambient occlusion
+     * [1]: Enable RayQuery shadows
+     */
+    enum LightingPassPermutationBits : uint32_t
     {
-        explicit LightingPassPushConstant(const LightingPassOptions& options)
-        {
-            flags_a = { options.enable_shadows, 0, 0, 0 };
-        }
-
-        /*
-         * [0]: Enable RayQuery shadows
-         */
-        glm::ivec4 flags_a {};
-        glm::vec4  light_pos {};
+        eLightingPassAmbientOcclusion = 1 << 0,
+        eLightingPassShadows          = 1 << 1,
     };
 
     class LightingPass final : public Node
@@ -64,25 +58,45 @@ namespace Nebula::RenderGraph
 
         void initialize() override;
 
-        ~LightingPass() override = default;
+        uint32_t permutation_count() const override { return m_renderer.pipelines.count(); }
+
+        // Options can be changed between frames, the matching pipeline permutation is selected on execute.
+        LightingPassOptions& options() { return m_params; }
+
+        ~LightingPass() override;
 
     private:
         void _update_descriptor(uint32_t current_frame);
 
-        std::string _select_fragment_shader() const;
+        PipelinePermutations::Key _permutation_key() const;
+
+        vk::Pipeline _create_permutation(PipelinePermutations::Key key, const vk::PipelineLayout& pipeline_layout) const;
 
         LightingPassOptions m_params;
+        bool                m_ao_available {false};
+        // RayQuery shadows need a ray tracing capable device, otherwise the raster-only shader variant is used.
+        bool                m_shadows_available {false};
+
+        struct Resources
+        {
+            ImageHandle      position_buffer;
+            ImageHandle      normal_buffer;
+            ImageHandle      albedo_buffer;
+            DepthImageHandle depth_buffer;
+            ImageHandle      ao_image;
+            TlasHandle       tlas;
+            ImageHandle      lighting_result;
+        } m_handles;
 
         struct Renderer
         {
             std::shared_ptr<Descriptor>                descriptor;
             std::shared_ptr<Framebuffer>               framebuffers;
-            vk::Pipeline                               pipeline;
+            PipelinePermutations                       pipelines;
             vk::PipelineLayout                         pipeline_layout;
             vk::RenderPass                             render_pass;
             std::array<vk::ClearValue, 1>              clear_values;
-            std::vector<vk::Sampler>                   samplers;
-            std::vector<std::unique_ptr<sdvk::Buffer>> uniform;
+            vk::Sampler                                sampler;
             uint32_t                                   frames_in_flight;
             vk::Extent2D                               render_resolution;
         } m_renderer;
@@ -3,6 +3,7 @@
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
 #include <Nebula/Image.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 
@@ -40,21 +41,29 @@ namespace Nebula::RenderGraph
     {
     }
 
-    void MeshGBufferPass::initialize()
+    MeshGBufferPass::~MeshGBufferPass()
     {
-        const auto position       = m_resources[id_position_buffer]->as<ImageResource>().get_image();
-        const auto normal         = m_resources[id_normal_buffer]->as<ImageResource>().get_image();
-        const auto albedo         = m_resources[id_albedo_buffer]->as<ImageResource>().get_image();
-        const auto depth          = m_resources[id_depth_buffer]->as<DepthImageResource>().get_depth_image();
-        const auto motion_vectors = m_resources[id_motion_vectors]->as<ImageResource>().get_image();
+        m_context.destruction_queue()->destroy(m_renderer.pipeline, m_renderer.pipeline_layout, m_renderer.render_pass);
+    }
 
-        m_renderer.render_resolution = sd::Application::s_extent.vk_ext();
+    void MeshGBufferPass::initialize()
+    {
+        m_handles.scene_data      = get_handle<SceneResource>(id_scene_data);
+        m_handles.position_buffer = get_handle<ImageResource>(id_position_buffer);
+        m_handles.normal_buffer   = get_handle<ImageResource>(id_normal_buffer);
+        m_handles.albedo_buffer   = get_handle<ImageResource>(id_albedo_buffer);
+        m_handles.depth_buffer    = get_handle<DepthImageResource>(id_depth_buffer);
+        m_handles.motion_vectors  = get_handle<ImageResource>(id_motion_vectors);
+
+        const auto position       = get(m_handles.position_buffer).get_image();
+        const auto normal         = get(m_handles.normal_buffer).get_image();
+        const auto albedo         = get(m_handles.albedo_buffer).get_image();
+        const auto depth          = get(m_handles.depth_buffer).get_depth_image();
+        const auto motion_vectors = get(m_handles.motion_vectors).get_image();
+
+        m_renderer.render_resolution = render_resolution();
         m_renderer.frames_in_flight = sd::Application::s_max_frames_in_flight;
 
-        m_renderer.descriptor = Descriptor::Builder()
-            .uniform_buffer(0, vk::ShaderStageFlagBits::eMeshEXT | vk::ShaderStageFlagBits::eFragment)
-            .create(m_renderer.frames_in_flight, m_context);
-
         for (int32_t i = 0; i < 4; i++)
         {
             m_renderer.clear_values[i].setColor(std::array{ 0.0f, 0.0f, 0.0f, 1.0f });
@@ -84,7 +93,7 @@ namespace Nebula::RenderGraph
 
         const auto [a, b] = sdvk::PipelineBuilder(m_context)
             .add_push_constant({ vk::ShaderStageFlagBits::eMeshEXT, 0, sizeof(MShGBufferPushConstant) })
-            .add_descriptor_set_layout(m_renderer.descriptor->layout())
+            .add_descriptor_set_layout(ViewConstants::instance(m_context).layout())
             .create_pipeline_layout()
             .add_shader(std::format("{}.mesh.spv", s_shader_name), vk::ShaderStageFlagBits::eMeshEXT)
             .add_shader(std::format("{}.frag.spv", s_shader_name), vk::ShaderStageFlagBits::eFragment)
@@ -94,32 +103,18 @@ namespace Nebula::RenderGraph
 
         m_renderer.pipeline = a;
         m_renderer.pipeline_layout = b;
-
-        m_renderer.camera_uniform.resize(m_renderer.frames_in_flight);
-        for (auto& ub : m_renderer.camera_uniform)
-        {
-            ub = sdvk::Buffer::Builder()
-                .with_size(sizeof(CameraDataUniform))
-                .as_uniform_buffer()
-                .create(m_context);
-        }
-
-        const auto camera = m_resources[id_scene_data]->as<SceneResource>().get_scene()->camera();
-        m_renderer.previous_frame_camera_state = camera->uniform_data();
     }
 
     void MeshGBufferPass::execute(const vk::CommandBuffer& command_buffer)
     {
         const uint32_t current_frame = sd::Application::s_current_frame;
 
-        update_descriptor(current_frame);
-
-        const auto scene          = m_resources[id_scene_data]->as<SceneResource>().get_scene();
-        const auto position       = m_resources[id_position_buffer]->as<ImageResource>().get_image();
-        const auto normal         = m_resources[id_normal_buffer]->as<ImageResource>().get_image();
-        const auto albedo         = m_resources[id_albedo_buffer]->as<ImageResource>().get_image();
-        const auto depth          = m_resources[id_depth_buffer]->as<DepthImageResource>().get_depth_image();
-        const auto motion_vectors = m_resources[id_motion_vectors]->as<ImageResource>().get_image();
+        const auto scene          = get(m_handles.scene_data).get_scene();
+        const auto position       = get(m_handles.position_buffer).get_image();
+        const auto normal         = get(m_handles.normal_buffer).get_image();
+        const auto albedo         = get(m_handles.albedo_buffer).get_image();
+        const auto depth          = get(m_handles.depth_buffer).get_depth_image();
+        const auto motion_vectors = get(m_handles.motion_vectors).get_image();
 
         Sync::ImageBarrierBatch({
             Sync::ImageBarrier(position, position->state().layout, vk::ImageLayout::eColorAttachmentOptimal),
@@ -137,42 +132,21 @@ namespace Nebula::RenderGraph
             .execute(command_buffer, [&](const vk::CommandBuffer& cmd)
             {
                 cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline);
-                cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline_layout, 0, 1, &m_renderer.descriptor->set(current_frame), 0, nullptr);
+                cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_renderer.pipeline_layout, ViewConstants::s_set_index, 1, &ViewConstants::instance(m_context).set(current_frame), 0, nullptr);
 
-                auto& meshes = scene->meshes();
-                for (const auto& object : scene->objects())
+                const auto& objects = scene->objects();
+                const vk::DeviceAddress objects_address = scene->gpu_scene().address();
+                for (const uint32_t i : scene->visible_objects())
                 {
-                    const std::string mesh_name = object.mesh->name();
                     const MShGBufferPushConstant push_constant {
-                        object.transform.model(),
-                        object.color,
-                        meshes.at(mesh_name)->vertex_buffer().address(),
-                        meshes.at(mesh_name)->meshlet_buffer().address(),
-                        glm::ivec4(m_params.use_meshlet_colors ? 1 : 0),
+                        objects_address,
+                        i,
+                        m_params.use_meshlet_colors ? 1 : 0,
                     };
 
                     cmd.pushConstants(m_renderer.pipeline_layout, vk::ShaderStageFlagBits::eMeshEXT, 0, sizeof(MShGBufferPushConstant), &push_constant);
-                    object.mesh->draw_mesh_tasks(cmd);
+                    objects[i].mesh->draw_mesh_tasks(cmd);
                 }
             });
     }
-
-    void MeshGBufferPass::update_descriptor(const uint32_t current_frame)
-    {
-        const auto camera = m_resources[id_scene_data]->as<SceneResource>().get_scene()->camera();
-        const auto camera_data = camera->uniform_data();
-
-        CameraDataUniform uniform {
-            .current = camera_data,
-            .previous = m_renderer.previous_frame_camera_state,
-        };
-
-        m_renderer.camera_uniform[current_frame]->set_data(&uniform, m_context.device());
-
-        m_renderer.descriptor->begin_write(current_frame)
-            .uniform_buffer(0, m_renderer.camera_uniform[current_frame]->buffer(), 0, sizeof(CameraDataUniform))
-            .commit();
-
-        m_renderer.previous_frame_camera_state = camera_data;
-    }
-}
+}
\ No newline at end of file
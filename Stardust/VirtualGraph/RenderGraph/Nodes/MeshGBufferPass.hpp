@@ -18,11 +18,9 @@ namespace Nebula::RenderGraph
 
     struct MShGBufferPushConstant
     {
-        glm::mat4  model;
-        glm::vec4  color;
-        uint64_t   vertex_address;
-        uint64_t   meshlets_address;
-        glm::ivec4 shader_params;       // [0: bool] use meshlet colors
+        uint64_t objects_address;
+        uint32_t object;
+        int32_t  use_meshlet_colors;
     };
 
     struct MShGBufferPassParams
@@ -30,12 +28,6 @@ namespace Nebula::RenderGraph
         bool use_meshlet_colors {false};
     };
 
-    struct CameraDataUniform
-    {
-        sd::CameraUniformData current;
-        sd::CameraUniformData previous;
-    };
-
     namespace Editor
     {
         class MeshGBufferPassEditorNode final : public Node
@@ -43,6 +35,8 @@ namespace Nebula::RenderGraph
         public:
             MeshGBufferPassEditorNode();
 
+            std::shared_ptr<Node> clone() const override { return std::make_shared<MeshGBufferPassEditorNode>(*this); }
+
             MShGBufferPassParams m_params;
 
         protected:
@@ -59,16 +53,11 @@ namespace Nebula::RenderGraph
 
         void initialize() override;
 
-        ~MeshGBufferPass() override = default;
+        ~MeshGBufferPass() override;
 
     private:
-        void update_descriptor(uint32_t current_frame);
-
-        using BufferPtr = std::shared_ptr<sdvk::Buffer>;
-
         struct Renderer
         {
-            std::shared_ptr<Descriptor>   descriptor;
             std::shared_ptr<Framebuffer>  framebuffers;
             vk::Pipeline                  pipeline;
             vk::PipelineLayout            pipeline_layout;
@@ -76,12 +65,20 @@ namespace Nebula::RenderGraph
             std::array<vk::ClearValue, 5> clear_values;
             uint32_t                      frames_in_flight;
             vk::Extent2D                  render_resolution;
-            std::vector<BufferPtr>        camera_uniform;
-            sd::CameraUniformData         previous_frame_camera_state;
         } m_renderer;
 
         MShGBufferPassParams m_params;
 
+        struct Resources
+        {
+            SceneHandle      scene_data;
+            ImageHandle      position_buffer;
+            ImageHandle      normal_buffer;
+            ImageHandle      albedo_buffer;
+            DepthImageHandle depth_buffer;
+            ImageHandle      motion_vectors;
+        } m_handles;
+
         const sdvk::Context& m_context;
 
         static constexpr std::string s_shader_name      = "rg_draw_mesh";
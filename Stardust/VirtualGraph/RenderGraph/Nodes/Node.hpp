@@ -1,9 +1,11 @@
 #pragma once
 
-#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <VirtualGraph/RenderGraph/Resources/Resource.hpp>
+#include <VirtualGraph/RenderGraph/Resources/ResourceHandle.hpp>
+#include <VirtualGraph/RenderGraph/Resources/ResourceTable.hpp>
 #include <VirtualGraph/RenderGraph/Resources/ResourceSpecification.hpp>
 #include <VirtualGraph/Common/NodeType.hpp>
 
@@ -29,29 +31,94 @@ namespace Nebula::RenderGraph
 
         virtual void initialize() { /* default: no-op */ }
 
-        virtual bool set_resource(const std::string& key, const std::shared_ptr<Resource>& resource)
+        void set_resource_table(const std::shared_ptr<ResourceTable>& resource_table)
         {
-            if (!_validate_resource(key, resource))
+            m_resource_table = resource_table;
+        }
+
+        // Set by the compile strategy before initialize(), graph images are created with this extent.
+        void set_render_resolution(const vk::Extent2D& render_resolution)
+        {
+            m_render_resolution = render_resolution;
+        }
+
+        const vk::Extent2D& render_resolution() const
+        {
+            return m_render_resolution;
+        }
+
+        /**
+         * Binds a resource of the table to the slot named by key.
+         * String lookups only happen here during compilation, nodes resolve typed handles once in initialize().
+         */
+        bool set_resource(const std::string& key, const uint32_t resource_id)
+        {
+            const auto& specs = get_resource_specs();
+            for (size_t i = 0; i < specs.size(); i++)
             {
-                return false;
+                if (specs[i].name != key)
+                {
+                    continue;
+                }
+
+                if (m_slots.size() != specs.size())
+                {
+                    m_slots.resize(specs.size(), ResourceHandle<Resource>::s_invalid_id);
+                }
+
+                m_slots[i] = resource_id;
+                return true;
             }
+            return false;
+        }
 
-            if (!m_resources.contains(key))
+        // Id of the resource bound to the slot named by key, or s_invalid_id if the slot is not connected.
+        uint32_t resource_id(const std::string& key) const
+        {
+            const auto& specs = get_resource_specs();
+            for (size_t i = 0; i < m_slots.size(); i++)
             {
-                m_resources.insert({key, resource});
-                return true;
+                if (specs[i].name == key)
+                {
+                    return m_slots[i];
+                }
             }
+            return ResourceHandle<Resource>::s_invalid_id;
+        }
+
+        // Returns an invalid handle if the slot is not connected or holds a resource of a different type.
+        template <typename T>
+        ResourceHandle<T> get_handle(const std::string& key) const
+        {
+            const uint32_t id = resource_id(key);
+            if (id == ResourceHandle<T>::s_invalid_id || m_resource_table == nullptr)
+            {
+                return {};
+            }
+            return m_resource_table->make_handle<T>(id);
+        }
 
-            m_resources[key] = resource;
-            return true;
+        template <typename T>
+        T& get(const ResourceHandle<T>& handle) const
+        {
+            return m_resource_table->get(handle);
         }
 
         virtual ~Node() = default;
 
-        std::map<std::string, std::shared_ptr<Resource>>& resources() { return m_resources; }
-
         virtual const std::vector<ResourceSpecification>& get_resource_specs() const = 0;
 
+        /**
+         * Number of specialized pipeline variants created by this node so far.
+         */
+        virtual uint32_t permutation_count() const { return 0; }
+
+        /**
+         * Nodes that converge over several frames drop their history while disabled, used under memory pressure.
+         * May be called before initialize().
+         */
+        virtual void set_accumulation_enabled(bool enabled) { /* default: no-op */ }
+
         const std::string& name() const
         {
             return m_name;
@@ -62,16 +129,11 @@ namespace Nebula::RenderGraph
             return m_type;
         }
 
-    protected:
-        virtual bool _validate_resource(const std::string& key, const std::shared_ptr<Resource>& resource)
-        {
-            return true;
-        }
-
-    protected:
-        std::map<std::string, std::shared_ptr<Resource>> m_resources;
-
     private:
+        std::vector<uint32_t>          m_slots;
+        std::shared_ptr<ResourceTable> m_resource_table;
+        vk::Extent2D                   m_render_resolution;
+
         const std::string m_name = "Unknown Node";
         const NodeType    m_type = NodeType::eUnknown;
     };
@@ -1,8 +1,10 @@
 #include "PresentNode.hpp"
 #include <Application/Application.hpp>
 #include <Nebula/Barrier.hpp>
+#include <Nebula/SamplerCache.hpp>
 #include <Vulkan/Rendering/RenderPass.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
+#include <Vulkan/Presentation/OffscreenTarget.hpp>
 #include <Vulkan/Presentation/Swapchain.hpp>
 #include <Vulkan/Context.hpp>
 #include <Vulkan/Image/Sampler.hpp>
@@ -15,19 +17,32 @@ namespace Nebula::RenderGraph
     };
     #pragma endregion
 
-    PresentNode::PresentNode(const sdvk::Context& context, const sdvk::Swapchain& swapchain, const PresentNodeOptions& options)
+    PresentNode::PresentNode(const sdvk::Context& context,
+                             const sdvk::Swapchain* swapchain,
+                             const sdvk::OffscreenTarget* offscreen_target,
+                             const PresentNodeOptions& options)
     : Node("Present Node", NodeType::ePresent)
     , m_context(context)
     , m_swapchain(swapchain)
+    , m_offscreen_target(offscreen_target)
     , m_options(options)
     {
+        if (!m_swapchain && !m_offscreen_target)
+        {
+            throw std::runtime_error("[Error] PresentNode requires either a Swapchain or an OffscreenTarget");
+        }
+    }
+
+    PresentNode::~PresentNode()
+    {
+        m_context.destruction_queue()->destroy(m_renderer.pipeline, m_renderer.pipeline_layout, m_renderer.render_pass);
     }
 
     void PresentNode::execute(const vk::CommandBuffer& command_buffer)
     {
         uint32_t current_frame = sd::Application::s_current_frame;
 
-        const auto& input = dynamic_cast<ImageResource&>(*m_resources["Final Image"]).get_image();
+        const auto& input = get(m_handles.final_image).get_image();
         auto input_barrier = Sync::ImageBarrier(input, input->state().layout, vk::ImageLayout::eGeneral);
 
         auto render_commands = [&](const vk::CommandBuffer& cmd){
@@ -45,41 +60,66 @@ namespace Nebula::RenderGraph
         input_barrier.apply(command_buffer);
 
         _update_descriptor(current_frame);
-        auto framebuffer = m_renderer.framebuffers->get(current_frame);
+        auto framebuffer = m_renderer.framebuffers->get(sd::Application::s_current_image);
         sdvk::RenderPass::Execute()
             .with_clear_values<1>(m_renderer.clear_values)
             .with_framebuffer(framebuffer)
             .with_render_area({{ 0, 0 }, m_renderer.render_resolution})
             .with_render_pass(m_renderer.render_pass)
             .execute(command_buffer, render_commands);
+
+        if (m_offscreen_target)
+        {
+            const auto& target = m_offscreen_target->image(current_frame);
+            target->update_state({ vk::AccessFlagBits2::eColorAttachmentWrite, vk::ImageLayout::eTransferSrcOptimal });
+            Sync::ImageBarrier(target, vk::ImageLayout::eTransferSrcOptimal, vk::ImageLayout::eTransferSrcOptimal,
+                               vk::AccessFlagBits2::eColorAttachmentWrite, vk::AccessFlagBits2::eTransferRead,
+                               vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::PipelineStageFlagBits2::eTransfer)
+                .apply(command_buffer);
+
+            m_offscreen_target->record_readback(current_frame, command_buffer);
+        }
     }
 
     void PresentNode::initialize()
     {
+        m_handles.final_image = get_handle<ImageResource>("Final Image");
+
         m_renderer.render_resolution = sd::Application::s_extent.vk_ext();
         m_renderer.frames_in_flight = sd::Application::s_max_frames_in_flight;
 
         m_renderer.clear_values[0].setColor(std::array<float, 4>{ 0.0f, 0.0f, 0.0f, 1.0f });
 
+        const vk::Format target_format = m_swapchain ? m_swapchain->format() : m_offscreen_target->format();
+        const vk::ImageLayout final_layout = m_swapchain ? vk::ImageLayout::ePresentSrcKHR : vk::ImageLayout::eTransferSrcOptimal;
+
         m_renderer.render_pass = sdvk::RenderPass::Builder()
-            .add_color_attachment(m_swapchain.format(), vk::SampleCountFlagBits::e1, vk::ImageLayout::ePresentSrcKHR)
+            .add_color_attachment(target_format, vk::SampleCountFlagBits::e1, final_layout)
             .make_subpass()
             .create(m_context);
 
-        m_renderer.framebuffers = Framebuffer::Builder()
-            .add_attachment_for_index(0, m_swapchain.view(0))
-            .add_attachment_for_index(1, m_swapchain.view(1))
+        // One per target image, the swapchain may have more images than frames in flight.
+        const uint32_t image_count = m_swapchain ? m_swapchain->image_count() : m_offscreen_target->image_count();
+        auto framebuffer_builder = Framebuffer::Builder();
+        for (uint32_t i = 0; i < image_count; i++)
+        {
+            framebuffer_builder.add_attachment_for_index(i, m_swapchain ? m_swapchain->view(i) : m_offscreen_target->view(i));
+        }
+
+        m_renderer.framebuffers = framebuffer_builder
             .set_render_pass(m_renderer.render_pass)
             .set_size(m_renderer.render_resolution)
-            .set_count(m_renderer.frames_in_flight)
+            .set_count(image_count)
             .set_name("Present Framebuffer")
             .create(m_context);
 
+        m_renderer.sampler = SamplerCache::instance(m_context).get(sdvk::SamplerBuilder());
+
         m_renderer.descriptor = Descriptor::Builder()
-            .combined_image_sampler(0, vk::ShaderStageFlagBits::eFragment)
+            .combined_image_sampler(0, vk::ShaderStageFlagBits::eFragment, m_renderer.sampler)
             .create(m_renderer.frames_in_flight, m_context);
 
-        const auto& input = dynamic_cast<ImageResource&>(*m_resources["Final Image"]).get_image();
+        const auto& input = get(m_handles.final_image).get_image();
         auto input_format = input->properties().format;
         std::string fragment_shader =  (input_format == vk::Format::eR32Sfloat) ? "rg_present_r32.frag.spv" : "rg_present.frag.spv";
 
@@ -97,13 +137,11 @@ namespace Nebula::RenderGraph
 
         m_renderer.pipeline = pipeline;
         m_renderer.pipeline_layout = pipeline_layout;
-
-        m_renderer.sampler = sdvk::SamplerBuilder().create(m_context.device());
     }
 
     void PresentNode::_update_descriptor(uint32_t current_frame)
     {
-        const auto& input = dynamic_cast<ImageResource&>(*m_resources["Final Image"]).get_image();
+        const auto& input = get(m_handles.final_image).get_image();
         vk::DescriptorImageInfo input_info { m_renderer.sampler, input->image_view(), input->state().layout };
 
         m_renderer.descriptor->begin_write(current_frame)
@@ -11,6 +11,7 @@
 
 namespace sdvk
 {
+    class OffscreenTarget;
     class Swapchain;
 }
 
@@ -35,7 +36,16 @@ namespace Nebula::RenderGraph
     class PresentNode final : public Node
     {
     public:
-        explicit PresentNode(const sdvk::Context& context, const sdvk::Swapchain& swapchain, const PresentNodeOptions& options);
+        /**
+         * Exactly one of swapchain and offscreen_target is expected to be set.
+         * When presenting offscreen the result is also copied into the readback buffer of the target.
+         */
+        PresentNode(const sdvk::Context& context,
+                    const sdvk::Swapchain* swapchain,
+                    const sdvk::OffscreenTarget* offscreen_target,
+                    const PresentNodeOptions& options);
+
+        ~PresentNode() override;
 
         void execute(const vk::CommandBuffer& command_buffer) override;
 
@@ -46,6 +56,11 @@ namespace Nebula::RenderGraph
 
         PresentNodeOptions m_options;
 
+        struct Resources
+        {
+            ImageHandle final_image;
+        } m_handles;
+
         struct Renderer
         {
             std::shared_ptr<Descriptor> descriptor;
@@ -60,7 +75,8 @@ namespace Nebula::RenderGraph
         } m_renderer;
 
         const sdvk::Context& m_context;
-        const sdvk::Swapchain& m_swapchain;
+        const sdvk::Swapchain* m_swapchain;
+        const sdvk::OffscreenTarget* m_offscreen_target;
 
         DEF_RESOURCE_REQUIREMENTS();
     };
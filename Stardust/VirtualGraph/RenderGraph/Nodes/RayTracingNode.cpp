@@ -4,8 +4,8 @@
 #include <Nebula/Barrier.hpp>
 #include <Nebula/Image.hpp>
 #include <Vulkan/Context.hpp>
-#include <Vulkan/Image/Sampler.hpp>
 #include <Vulkan/Rendering/PipelineBuilder.hpp>
+#include <VirtualGraph/RenderGraph/ViewConstants.hpp>
 
 namespace Nebula::RenderGraph
 {
@@ -25,11 +25,16 @@ namespace Nebula::RenderGraph
     {
     }
 
+    RayTracingNode::~RayTracingNode()
+    {
+        m_context.destruction_queue()->destroy(m_renderer.pipeline, m_renderer.pipeline_layout);
+    }
+
     void RayTracingNode::execute(const vk::CommandBuffer& command_buffer)
     {
         uint32_t current_frame = sd::Application::s_current_frame;
 
-        auto output_image = dynamic_cast<ImageResource&>(*m_resources["Output"]).get_image();
+        auto output_image = get(m_handles.output).get_image();
         Nebula::Sync::ImageBarrier(output_image, output_image->state().layout, vk::ImageLayout::eGeneral).apply(command_buffer);
 
         update_descriptor(current_frame);
@@ -40,7 +45,12 @@ namespace Nebula::RenderGraph
 
         command_buffer.bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, m_renderer.pipeline);
         command_buffer.pushConstants(m_renderer.pipeline_layout, vk::ShaderStageFlagBits::eRaygenKHR, 0, sizeof(RayTracingPushConstant), &push_constant);
-        command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eRayTracingKHR, m_renderer.pipeline_layout, 0, 1, &m_renderer.descriptor->set(current_frame), 0, nullptr);
+        const std::array descriptor_sets = {
+            ViewConstants::instance(m_context).set(current_frame),
+            m_renderer.descriptor->set(current_frame),
+        };
+        command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eRayTracingKHR, m_renderer.pipeline_layout, ViewConstants::s_set_index,
+                                          descriptor_sets.size(), descriptor_sets.data(), 0, nullptr);
         command_buffer.traceRaysKHR(
             sbt.rgen_region(),
             sbt.miss_region(),
@@ -53,18 +63,22 @@ namespace Nebula::RenderGraph
 
     void RayTracingNode::initialize()
     {
+        m_handles.object_descriptions = get_handle<BufferResource>("Object Descriptions");
+        m_handles.tlas                = get_handle<TlasResource>("TLAS");
+        m_handles.output              = get_handle<ImageResource>("Output");
+
         m_renderer.frames_in_flight = sd::Application::s_max_frames_in_flight;
-        m_renderer.render_resolution = sd::Application::s_extent.vk_ext();
+        m_renderer.render_resolution = render_resolution();
 
         m_renderer.descriptor = Descriptor::Builder()
             .acceleration_structure(0, vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR)
             .storage_image(1, vk::ShaderStageFlagBits::eRaygenKHR)
-            .uniform_buffer(2, vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR)
             .storage_buffer(3, vk::ShaderStageFlagBits::eClosestHitKHR)
             .create(m_renderer.frames_in_flight, m_context);
 
         auto [pipeline, pipeline_layout] = sdvk::PipelineBuilder(m_context)
             .add_push_constant({ vk::ShaderStageFlagBits::eRaygenKHR, 0, sizeof(RayTracingPushConstant)})
+            .add_descriptor_set_layout(ViewConstants::instance(m_context).layout())
             .add_descriptor_set_layout(m_renderer.descriptor->layout())
             .create_pipeline_layout()
             .add_shader("rt_test.rgen.spv", vk::ShaderStageFlagBits::eRaygenKHR)
@@ -78,61 +92,40 @@ namespace Nebula::RenderGraph
         m_renderer.pipeline_layout = pipeline_layout;
 
         m_renderer.sbt = std::make_shared<sd::rt::ShaderBindingTable>(2, 1, m_renderer.pipeline, m_context);
-
-        m_renderer.uniform.resize(m_renderer.frames_in_flight);
-        for (auto& ub : m_renderer.uniform)
-        {
-            ub = sdvk::Buffer::Builder()
-                .with_size(sizeof(sd::CameraUniformData))
-                .as_uniform_buffer()
-                .create(m_context);
-        }
-
-        m_renderer.sampler = sdvk::SamplerBuilder().create(m_context.device());
     }
 
     Image& RayTracingNode::get_output()
     {
-        return *(dynamic_cast<ImageResource&>(*m_resources["Output"]).get_image());
+        return *(get(m_handles.output).get_image());
     }
 
     void RayTracingNode::update_descriptor(uint32_t index)
     {
         auto& output_image = get_output();
-        auto& camera = dynamic_cast<CameraResource&>(*m_resources["Camera"]).get_camera();
-        auto& tlas = dynamic_cast<TlasResource&>(*m_resources["TLAS"]).get_tlas();
-        auto& obj_buffer = dynamic_cast<BufferResource&>(*m_resources["Object Descriptions"]).get_buffer();
-
-        auto camera_data = camera->uniform_data();
-        m_renderer.uniform[index]->set_data(&camera_data, m_context.device());
+        auto& tlas = get(m_handles.tlas).get_tlas();
+        auto& obj_buffer = get(m_handles.object_descriptions).get_buffer();
 
         vk::WriteDescriptorSetAccelerationStructureKHR as_info { 1, &tlas->tlas() };
         vk::WriteDescriptorSet as_write {
             m_renderer.descriptor->set(index), 0, 0, 1, vk::DescriptorType::eAccelerationStructureKHR,
             nullptr, nullptr, nullptr, &as_info
         };
-        vk::DescriptorImageInfo image_info { m_renderer.sampler, output_image.image_view(), output_image.state().layout };
+        vk::DescriptorImageInfo image_info { nullptr, output_image.image_view(), output_image.state().layout };
         vk::WriteDescriptorSet image_write {
             m_renderer.descriptor->set(index), 1, 0, 1, vk::DescriptorType::eStorageImage,
             &image_info, nullptr, nullptr, nullptr
         };
-        vk::DescriptorBufferInfo ub_info { m_renderer.uniform[index]->buffer(), 0, sizeof(sd::CameraUniformData) };
-        vk::WriteDescriptorSet ub_write {
-            m_renderer.descriptor->set(index), 2, 0, 1, vk::DescriptorType::eUniformBuffer,
-            nullptr, &ub_info, nullptr, nullptr
-        };
         vk::DescriptorBufferInfo sb_info { obj_buffer->buffer(), 0, obj_buffer->size() };
         vk::WriteDescriptorSet sb_write {
             m_renderer.descriptor->set(index), 3, 0, 1, vk::DescriptorType::eStorageBuffer,
             nullptr, &sb_info, nullptr, nullptr
         };
-        std::vector writes = { as_write, image_write, ub_write, sb_write };
+        std::vector writes = { as_write, image_write, sb_write };
         m_context.device().updateDescriptorSets(writes.size(), writes.data(), 0, nullptr);
 
         // m_renderer.descriptor->begin_write(index)
         //     .acceleration_structure(0, 1, &tlas->tlas())
         //     .storage_image(1, output_image_info)
-        //     .uniform_buffer(2, m_renderer.uniform[index]->buffer(), 0, sizeof(sd::CameraUniformData))
         //     .storage_buffer(3, obj_buffer->buffer(), 0, obj_buffer->size())
         //     .commit();
     }
@@ -40,6 +40,8 @@ namespace Nebula::RenderGraph
     public:
         explicit RayTracingNode(const sdvk::Context& context, const RayTracingNodeOptions& options);
 
+        ~RayTracingNode() override;
+
         void execute(const vk::CommandBuffer& command_buffer) override;
 
         void initialize() override;
@@ -50,17 +52,22 @@ namespace Nebula::RenderGraph
         void update_descriptor(uint32_t index);
 
         RayTracingNodeOptions m_options;
-        
+
+        struct Resources
+        {
+            BufferHandle object_descriptions;
+            TlasHandle   tlas;
+            ImageHandle  output;
+        } m_handles;
+
         struct Renderer {
             uint32_t                    frames_in_flight;
             vk::Extent2D                render_resolution;
             vk::Pipeline                pipeline;
             vk::PipelineLayout          pipeline_layout;
-            vk::Sampler                 sampler;
             std::shared_ptr<Descriptor> descriptor;
 
             std::shared_ptr<sd::rt::ShaderBindingTable> sbt;
-            std::vector<std::unique_ptr<sdvk::Buffer>> uniform;
         } m_renderer;
 
         const sdvk::Context& m_context;
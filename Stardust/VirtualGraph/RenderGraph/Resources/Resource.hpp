@@ -1,6 +1,8 @@
 #pragma once
 
+#include <format>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <Nebula/Image.hpp>
 #include <Scene/Camera.hpp>
@@ -11,6 +13,7 @@
 
 #define PTR_RESOURCE_BODY(T, ResTypeEnum, ResT, GetName)                                                                                                                                                                                           \
 public:                                                                                              \
+    static constexpr ResourceType s_resource_type = ResTypeEnum;                                     \
     explicit T(const std::shared_ptr<ResT>& p_##GetName, const std::string& name = #T)               \
     : Resource(name, ResTypeEnum), m_resource(p_##GetName) {}                                        \
     [[nodiscard]] bool is_valid() override { return m_resource != nullptr; }                         \
@@ -49,7 +52,11 @@ namespace Nebula::RenderGraph
         T& as()
         {
             static_assert(std::is_base_of_v<Resource, T>, "Template parameter T must be a valid Resource type");
-            return dynamic_cast<T&>(*this);
+            if (m_type != T::s_resource_type)
+            {
+                throw std::runtime_error(std::format("[Error] Resource \"{}\" is not of type \"{}\"", m_name, get_resource_type_str(T::s_resource_type)));
+            }
+            return static_cast<T&>(*this);
         }
 
         virtual bool is_valid() = 0;
@@ -98,6 +105,8 @@ namespace Nebula::RenderGraph
     class ObjectsResource final : public Resource
     {
     public:
+        static constexpr ResourceType s_resource_type = ResourceType::eObjects;
+
         explicit ObjectsResource(const ObjectArray_t& objects, const std::string& name = "Objects Resource")
         : Resource(name, ResourceType::eObjects)
         , m_objects(objects)
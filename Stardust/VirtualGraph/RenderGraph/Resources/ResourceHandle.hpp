@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace Nebula::RenderGraph
+{
+    class BufferResource;
+    class CameraResource;
+    class DepthImageResource;
+    class ImageResource;
+    class ObjectsResource;
+    class SceneResource;
+    class TlasResource;
+
+    /**
+     * Typed index into a ResourceTable, ids are assigned densely by the graph compiler.
+     */
+    template <typename T>
+    struct ResourceHandle
+    {
+        static constexpr uint32_t s_invalid_id = std::numeric_limits<uint32_t>::max();
+
+        uint32_t id {s_invalid_id};
+
+        [[nodiscard]] bool is_valid() const noexcept { return id != s_invalid_id; }
+    };
+
+    using BufferHandle     = ResourceHandle<BufferResource>;
+    using CameraHandle     = ResourceHandle<CameraResource>;
+    using DepthImageHandle = ResourceHandle<DepthImageResource>;
+    using ImageHandle      = ResourceHandle<ImageResource>;
+    using ObjectsHandle    = ResourceHandle<ObjectsResource>;
+    using SceneHandle      = ResourceHandle<SceneResource>;
+    using TlasHandle       = ResourceHandle<TlasResource>;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <VirtualGraph/RenderGraph/Resources/Resource.hpp>
+#include <VirtualGraph/RenderGraph/Resources/ResourceHandle.hpp>
+
+namespace Nebula::RenderGraph
+{
+    /**
+     * Flat storage of every resource in a compiled graph.
+     * Types are checked once when a handle is created, lookups through a handle are a plain array index.
+     */
+    class ResourceTable
+    {
+    public:
+        uint32_t add(const std::shared_ptr<Resource>& resource)
+        {
+            m_resources.push_back(resource);
+            return static_cast<uint32_t>(m_resources.size() - 1);
+        }
+
+        template <typename T>
+        [[nodiscard]] ResourceHandle<T> make_handle(const uint32_t id) const
+        {
+            static_assert(std::is_base_of_v<Resource, T>, "Template parameter T must be a valid Resource type");
+            if (id >= m_resources.size() || m_resources[id]->type() != T::s_resource_type)
+            {
+                return {};
+            }
+            return { id };
+        }
+
+        template <typename T>
+        [[nodiscard]] T& get(const ResourceHandle<T>& handle) const
+        {
+            #ifndef NDEBUG
+            if (!handle.is_valid() || handle.id >= m_resources.size())
+            {
+                throw std::out_of_range(std::format("[Error] Invalid resource handle {}", handle.id));
+            }
+            #endif
+            return static_cast<T&>(*m_resources[handle.id]);
+        }
+
+        [[nodiscard]] const std::shared_ptr<Resource>& at(const uint32_t id) const { return m_resources.at(id); }
+
+        [[nodiscard]] uint32_t size() const noexcept { return static_cast<uint32_t>(m_resources.size()); }
+
+        auto begin() const { return m_resources.begin(); }
+
+        auto end() const { return m_resources.end(); }
+
+    private:
+        std::vector<std::shared_ptr<Resource>> m_resources;
+    };
+}
@@ -0,0 +1,63 @@
+#include "ViewConstants.hpp"
+#include <map>
+#include <mutex>
+#include <Application/Application.hpp>
+#include <Scene/Camera.hpp>
+#include <Vulkan/Context.hpp>
+
+namespace Nebula::RenderGraph
+{
+    ViewConstants::ViewConstants(const uint32_t frames_in_flight, const sdvk::Context& context)
+    : m_context(context)
+    {
+        m_uniform.resize(frames_in_flight);
+        for (auto& ub : m_uniform)
+        {
+            ub = sdvk::Buffer::Builder()
+                .with_size(sizeof(ViewConstantsData))
+                .as_uniform_buffer()
+                .with_name("View Constants")
+                .create(m_context);
+        }
+
+        m_descriptor = Descriptor::Builder()
+            .uniform_buffer(0, vk::ShaderStageFlagBits::eAll)
+            .create(frames_in_flight, m_context, "View Constants");
+
+        for (uint32_t i = 0; i < frames_in_flight; i++)
+        {
+            m_descriptor->begin_write(i)
+                .uniform_buffer(0, m_uniform[i]->buffer(), 0, sizeof(ViewConstantsData))
+                .commit();
+        }
+    }
+
+    ViewConstants& ViewConstants::instance(const sdvk::Context& context)
+    {
+        static std::map<VkDevice, std::unique_ptr<ViewConstants>> s_view_constants;
+        static std::mutex s_mutex;
+        std::lock_guard lock(s_mutex);
+
+        const auto device = static_cast<VkDevice>(context.device());
+        if (!s_view_constants.contains(device))
+        {
+            s_view_constants.insert({ device, std::make_unique<ViewConstants>(sd::Application::s_max_frames_in_flight, context) });
+        }
+
+        return *s_view_constants[device];
+    }
+
+    void ViewConstants::update(const sd::Camera& camera, const vk::Extent2D& resolution, const uint32_t current_frame)
+    {
+        const sd::CameraUniformData current = camera.uniform_data();
+
+        m_data.previous = m_has_previous ? m_data.current : current;
+        m_data.current = current;
+        m_data.jitter = m_jitter;
+        m_data.resolution = { static_cast<float>(resolution.width), static_cast<float>(resolution.height) };
+        m_data.frame_index++;
+        m_has_previous = true;
+
+        m_uniform[current_frame]->set_data(&m_data, m_context.device());
+    }
+}
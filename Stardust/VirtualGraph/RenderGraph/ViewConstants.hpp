@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+#include <Nebula/Descriptor.hpp>
+#include <Resources/CameraUniformData.hpp>
+#include <Vulkan/Buffer.hpp>
+
+namespace sd
+{
+    class Camera;
+}
+
+namespace sdvk
+{
+    class Context;
+}
+
+namespace Nebula::RenderGraph
+{
+    // std140 layout, must match include/view_constants.glsl
+    struct ViewConstantsData
+    {
+        sd::CameraUniformData current {};
+        sd::CameraUniformData previous {};
+        glm::vec2             jitter {0.0f};
+        glm::vec2             resolution {0.0f};
+        uint32_t              frame_index {0};
+        uint32_t              _pad[3] {};
+    };
+
+    /**
+     * View dependent constants computed once per frame and uploaded into a single uniform buffer per frame slot.
+     * Every pass that needs the camera binds set(frame) at s_set_index instead of maintaining its own copy.
+     */
+    class ViewConstants
+    {
+    public:
+        ViewConstants(const ViewConstants&) = delete;
+        ViewConstants& operator=(const ViewConstants&) = delete;
+
+        ViewConstants(uint32_t frames_in_flight, const sdvk::Context& context);
+
+        // Shared view constants of the device owned by the given context.
+        static ViewConstants& instance(const sdvk::Context& context);
+
+        void update(const sd::Camera& camera, const vk::Extent2D& resolution, uint32_t current_frame);
+
+        void set_jitter(const glm::vec2& jitter) { m_jitter = jitter; }
+
+        const ViewConstantsData& data() const { return m_data; }
+
+        const vk::DescriptorSetLayout& layout() const { return m_descriptor->layout(); }
+
+        const vk::DescriptorSet& set(uint32_t current_frame) const { return m_descriptor->set(current_frame); }
+
+        static constexpr uint32_t s_set_index = 0;
+
+    private:
+        ViewConstantsData                          m_data {};
+        glm::vec2                                  m_jitter {0.0f};
+        bool                                       m_has_previous {false};
+        std::shared_ptr<Descriptor>                m_descriptor;
+        std::vector<std::unique_ptr<sdvk::Buffer>> m_uniform;
+
+        const sdvk::Context& m_context;
+    };
+}
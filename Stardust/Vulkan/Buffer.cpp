@@ -1,5 +1,7 @@
 #include "Buffer.hpp"
 
+#include <format>
+
 namespace sdvk
 {
 
@@ -29,7 +31,7 @@ namespace sdvk
 
     std::unique_ptr<Buffer> Buffer::Builder::create(const Context& ctx)
     {
-        auto result = std::make_unique<Buffer>(_buffer_size, _usage_flags, _memory_property_flags, ctx);
+        auto result = std::make_unique<Buffer>(_buffer_size, _usage_flags, _memory_property_flags, ctx, _name);
         if (!_name.empty())
         {
             sdvk::util::name_vk_object(_name, (uint64_t) static_cast<VkBuffer>(result->m_buffer), vk::ObjectType::eBuffer, ctx.device());
@@ -42,7 +44,8 @@ namespace sdvk
         return std::make_unique<Buffer>(_buffer_size,
                                         vk::BufferUsageFlagBits::eTransferSrc,
                                         vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                                        ctx);
+                                        ctx,
+                                        _name.empty() ? "[Staging]" : std::format("[Staging] {}", _name));
     }
 
     Buffer::Builder& Buffer::Builder::as_uniform_buffer()
@@ -80,6 +83,13 @@ namespace sdvk
         return *this;
     }
 
+    Buffer::Builder& Buffer::Builder::as_readback_buffer()
+    {
+        _usage_flags = vk::BufferUsageFlagBits::eTransferDst;
+        _memory_property_flags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+        return *this;
+    }
+
     Buffer::Builder& Buffer::Builder::as_acceleration_structure_storage()
     {
         _usage_flags = vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress;
@@ -88,25 +98,92 @@ namespace sdvk
     }
 
     Buffer::Buffer(vk::DeviceSize buffer_size, vk::BufferUsageFlags usage_flags,
-                   vk::MemoryPropertyFlags memory_property_flags, const Context& ctx)
+                   vk::MemoryPropertyFlags memory_property_flags, const Context& ctx, const std::string& name)
     : m_size(buffer_size), m_usage_flags(usage_flags), m_mem_flags(memory_property_flags)
+    , m_device(ctx.device()), m_memory_tracker(ctx.memory_tracker()), m_block_allocator(ctx.block_allocator())
+    , m_destruction_queue(ctx.destruction_queue())
+    {
+        _create_buffer();
+        const auto memory_requirements = m_device.getBufferMemoryRequirements(m_buffer);
+        m_memory_allocation = m_block_allocator->allocate(memory_requirements, memory_property_flags, MemoryResourceKind::eBuffer, ctx);
+
+        const auto category = (usage_flags & vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR)
+                              ? MemoryCategory::eAccelerationStructure
+                              : MemoryCategory::eBuffer;
+        m_allocation = m_memory_tracker->track(name.empty() ? "Unnamed Buffer" : name, category, m_memory_allocation.memory_type, memory_requirements.size);
+
+        _bind_buffer(m_memory_allocation);
+    }
+
+    Buffer::~Buffer()
     {
-        vk::Result result;
+        if (m_owner)
+        {
+            m_block_allocator->set_owner(m_memory_allocation, nullptr);
+        }
 
+        // Memory is accounted until the GPU is done with it.
+        m_destruction_queue->push([device = m_device, buffer = m_buffer, allocator = m_block_allocator, allocation = m_memory_allocation,
+                                   tracker = m_memory_tracker, tracked = m_allocation]() {
+            device.destroyBuffer(buffer);
+            allocator->free(allocation);
+            tracker->release(tracked);
+        });
+    }
+
+    void Buffer::_create_buffer()
+    {
         vk::BufferCreateInfo create_info;
         create_info.setSharingMode(vk::SharingMode::eExclusive);
-        create_info.setSize(buffer_size);
-        create_info.setUsage(usage_flags | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eShaderDeviceAddress);
+        create_info.setSize(m_size);
+        create_info.setUsage(m_usage_flags | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eShaderDeviceAddress);
 
-        result = ctx.device().createBuffer(&create_info, nullptr, &m_buffer);
-        auto memory_requirements = ctx.device().getBufferMemoryRequirements(m_buffer);
-        ctx.allocate_memory(memory_requirements, memory_property_flags, &m_memory);
+        if (const vk::Result result = m_device.createBuffer(&create_info, nullptr, &m_buffer); result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error("[Error] Failed to create Buffer");
+        }
+    }
 
-        ctx.device().bindBufferMemory(m_buffer, m_memory, 0 );
+    void Buffer::_bind_buffer(const MemoryAllocation& allocation)
+    {
+        m_device.bindBufferMemory(m_buffer, allocation.memory, allocation.offset);
 
         vk::BufferDeviceAddressInfo address_info;
         address_info.setBuffer(m_buffer);
-        m_address = ctx.device().getBufferAddress(&address_info);
+        m_address = m_device.getBufferAddress(&address_info);
+    }
+
+    void Buffer::make_relocatable(MemoryRelocatable* owner)
+    {
+        m_owner = owner ? owner : this;
+        m_block_allocator->set_owner(m_memory_allocation, m_owner);
+    }
+
+    void Buffer::relocate(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer)
+    {
+        move_to(target, command_buffer, true);
+    }
+
+    void Buffer::move_to(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer, const bool copy_contents)
+    {
+        const vk::Buffer previous_buffer = m_buffer;
+        const MemoryAllocation previous_allocation = m_memory_allocation;
+
+        _create_buffer();
+        _bind_buffer(target);
+        m_memory_allocation = target;
+        m_block_allocator->set_owner(m_memory_allocation, m_owner);
+
+        if (copy_contents)
+        {
+            const vk::BufferCopy copy_region { 0, 0, m_size };
+            command_buffer.copyBuffer(previous_buffer, m_buffer, 1, &copy_region);
+        }
+
+        m_destruction_queue->push([device = m_device, allocator = m_block_allocator, previous_buffer, previous_allocation]() {
+            device.destroyBuffer(previous_buffer);
+            allocator->free(previous_allocation);
+        });
     }
 
     void Buffer::copy_to_buffer(const Buffer& src, const Buffer& dst, const CommandBuffers& command_buffers)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <format>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.hpp>
@@ -7,11 +9,12 @@
 #include <Resources/VertexData.hpp>
 #include <Vulkan/Context.hpp>
 #include <Vulkan/CommandBuffers.hpp>
+#include <Vulkan/MemoryBlockAllocator.hpp>
 #include <Vulkan/Utils.hpp>
 
 namespace sdvk
 {
-    class Buffer
+    class Buffer : public MemoryRelocatable
     {
     public:
         struct Builder
@@ -35,6 +38,8 @@ namespace sdvk
 
             Builder& as_shader_binding_table();
 
+            Builder& as_readback_buffer();
+
             std::unique_ptr<Buffer> create(Context const& ctx);
 
             std::unique_ptr<Buffer> create_staging(Context const& ctx);
@@ -42,13 +47,18 @@ namespace sdvk
             template <typename T>
             std::unique_ptr<Buffer> create_with_data(T* p_data, CommandBuffers const& command_buffers, Context const& ctx)
             {
-                auto result = std::make_unique<Buffer>(_buffer_size, _usage_flags, _memory_property_flags, ctx);
+                if (!ctx.memory_manager()->accepts_uploads())
+                {
+                    throw std::runtime_error(std::format("[Error] Upload of \"{}\" refused, device memory is over budget", _name));
+                }
+
+                auto result = std::make_unique<Buffer>(_buffer_size, _usage_flags, _memory_property_flags, ctx, _name);
                 if (!_name.empty())
                 {
                     sdvk::util::name_vk_object(_name, (uint64_t) static_cast<VkBuffer>(result->m_buffer), vk::ObjectType::eBuffer, ctx.device());
                 }
 
-                auto staging = Buffer::Builder().with_size(_buffer_size).create_staging(ctx);
+                auto staging = Buffer::Builder().with_size(_buffer_size).with_name(_name).create_staging(ctx);
                 staging->set_data(p_data, ctx.device());
                 Buffer::copy_to_buffer(*staging, *result, command_buffers);
 
@@ -65,22 +75,49 @@ namespace sdvk
         Buffer(Buffer const&) = delete;
         Buffer& operator=(Buffer const&) = delete;
 
-        Buffer(vk::DeviceSize buffer_size, vk::BufferUsageFlags usage_flags, vk::MemoryPropertyFlags memory_property_flags, Context const& ctx);
+        // The name doubles as the owner tag of the allocation in the MemoryTracker.
+        Buffer(vk::DeviceSize buffer_size, vk::BufferUsageFlags usage_flags, vk::MemoryPropertyFlags memory_property_flags, Context const& ctx,
+               std::string const& name = "");
+
+        ~Buffer() override;
 
         template <typename T>
         void set_data(T* p_data, vk::Device const& device)
         {
-            void* mapped_memory = nullptr;
-            auto result = device.mapMemory(m_memory, 0, m_size, {}, &mapped_memory);
-            std::memcpy(mapped_memory, p_data, static_cast<size_t>(m_size));
-            device.unmapMemory(m_memory);
+            std::memcpy(m_memory_allocation.mapped, p_data, static_cast<size_t>(m_size));
+        }
+
+        template <typename T>
+        void get_data(T* p_data, vk::Device const& device) const
+        {
+            if (!m_memory_allocation.mapped)
+            {
+                throw std::runtime_error("[Error] Buffer is not host visible, its data cannot be read");
+            }
+            std::memcpy(p_data, m_memory_allocation.mapped, static_cast<size_t>(m_size));
         }
 
+        /**
+         * Lets the MemoryBlockAllocator move the buffer during defragmentation, owner is notified instead when set.
+         * Only for buffers whose users look up buffer() and address() again after a move.
+         */
+        void make_relocatable(MemoryRelocatable* owner = nullptr);
+
+        void relocate(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer) override;
+
+        // Rebinds the buffer to target, the old buffer and allocation are destroyed deferred. Contents are copied if copy_contents is set.
+        void move_to(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer, bool copy_contents);
+
         const vk::Buffer& buffer() const { return m_buffer; }
 
         const vk::DeviceAddress& address() const { return m_address; }
 
-        const vk::DeviceMemory& memory() const { return m_memory; }
+        const vk::DeviceMemory& memory() const { return m_memory_allocation.memory; }
+
+        vk::DeviceSize offset() const { return m_memory_allocation.offset; }
+
+        // Null unless the buffer is host visible.
+        void* mapped() const { return m_memory_allocation.mapped; }
 
         const vk::DeviceSize& size() const { return m_size; }
 
@@ -93,12 +130,25 @@ namespace sdvk
         void copy_to_image(Nebula::Image const& dst, vk::CommandBuffer const& command_buffer);
 
     protected:
+        void _create_buffer();
+
+        void _bind_buffer(const MemoryAllocation& allocation);
+
         vk::Buffer              m_buffer;
-        vk::DeviceMemory        m_memory;
         vk::DeviceAddress       m_address;
 
         vk::DeviceSize          m_size;
         vk::BufferUsageFlags    m_usage_flags;
         vk::MemoryPropertyFlags m_mem_flags;
+
+        // Device handle instead of the Context, buffers held by statics may be destroyed after it.
+        vk::Device                     m_device;
+        std::shared_ptr<MemoryTracker> m_memory_tracker;
+        MemoryTracker::AllocationId    m_allocation { 0 };
+
+        std::shared_ptr<MemoryBlockAllocator>     m_block_allocator;
+        std::shared_ptr<DeferredDestructionQueue> m_destruction_queue;
+        MemoryAllocation                          m_memory_allocation;
+        MemoryRelocatable*                        m_owner { nullptr };
     };
 }
@@ -1,11 +1,11 @@
 #include "Context.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <ranges>
 #include <utility>
-#include <GLFW/glfw3.h>
 #include <vulkan/vk_enum_string_helper.h>
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE;
@@ -35,6 +35,12 @@ namespace sdvk
 
         create_device(options);
         VULKAN_HPP_DEFAULT_DISPATCHER.init(m_device);
+
+        m_memory_tracker = std::make_shared<MemoryTracker>(m_physical_device.getMemoryProperties());
+        m_memory_manager = std::make_shared<MemoryManager>(m_physical_device, is_extension_enabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME),
+                                                           m_memory_tracker);
+        m_block_allocator = std::make_shared<MemoryBlockAllocator>(*this, m_physical_device.getMemoryProperties());
+        m_destruction_queue = std::make_shared<DeferredDestructionQueue>(m_device);
     }
 
     void Context::create_instance(const ContextOptions& options)
@@ -146,9 +152,8 @@ namespace sdvk
 
     void Context::create_surface(const ContextOptions& options)
     {
-        //auto surface_handle = static_cast<VkSurfaceKHR>(m_surface_khr);
-        VkResult result = glfwCreateWindowSurface(static_cast<VkInstance>(m_instance), options.window, nullptr, reinterpret_cast<VkSurfaceKHR*>(&m_surface));
-        if (result != VK_SUCCESS)
+        m_surface = options.create_surface(m_instance);
+        if (!m_surface)
         {
             throw std::runtime_error("Failed to create window surface.");
         }
@@ -156,12 +161,25 @@ namespace sdvk
 
     void Context::select_device(const ContextOptions& options)
     {
-        std::vector<vk::PhysicalDevice> physical_devices = m_instance.enumeratePhysicalDevices();
-        physical_devices | std::views::filter([](vk::PhysicalDevice const& pd){
-            auto props = pd.getProperties();
-            return props.deviceType == vk::PhysicalDeviceType::eDiscreteGpu
-                || props.deviceType == vk::PhysicalDeviceType::eIntegratedGpu;
+        // Lower is preferred, CPU implementations are only considered as a last resort.
+        auto device_rank = [](vk::PhysicalDevice const& pd) -> uint32_t {
+            switch (pd.getProperties().deviceType)
+            {
+                case vk::PhysicalDeviceType::eDiscreteGpu:   return 0;
+                case vk::PhysicalDeviceType::eIntegratedGpu: return 1;
+                case vk::PhysicalDeviceType::eVirtualGpu:    return 2;
+                case vk::PhysicalDeviceType::eCpu:           return 3;
+                default:                                     return 4;
+            }
+        };
+
+        const uint32_t max_rank = options.allow_cpu_device ? 3 : 1;
+        const std::vector<vk::PhysicalDevice> all_physical_devices = m_instance.enumeratePhysicalDevices();
+        std::vector<vk::PhysicalDevice> physical_devices;
+        std::ranges::copy_if(all_physical_devices, std::back_inserter(physical_devices), [&](vk::PhysicalDevice const& pd){
+            return device_rank(pd) <= max_rank;
         });
+        std::ranges::stable_sort(physical_devices, {}, device_rank);
 
         const auto candidate = std::find_if(
                 std::begin(physical_devices), std::end(physical_devices),
@@ -193,7 +211,7 @@ namespace sdvk
 
                     bool result = has_graphics_queue && !has_missing_extensions;
 
-                    if (options.raytracing)
+                    if (options.raytracing && options.raytracing_required)
                     {
                         // Some Radeon iGPUs are RT capable, pick only discrete for now since we don't score GPUs.
                         return result && has_ray_tracing && is_discrete;
@@ -212,7 +230,7 @@ namespace sdvk
         if (options.debug)
         {
             std::cout << "Detected devices:" << std::endl;
-            for (const auto& pd : physical_devices) {
+            for (const auto& pd : all_physical_devices) {
                 auto props = pd.getProperties();
                 std::cout << "- " << props.deviceName << " [" << to_string(props.deviceType) << "]" << std::endl;
             }
@@ -234,6 +252,39 @@ namespace sdvk
             m_enabled_device_extensions.emplace_back(s);
         }
 
+        const auto supported_extensions = m_physical_device.enumerateDeviceExtensionProperties();
+        auto is_supported = [&supported_extensions](const char* extension) {
+            return std::ranges::any_of(supported_extensions, [extension](vk::ExtensionProperties const& props) {
+                return std::string(props.extensionName.data()) == extension;
+            });
+        };
+
+        auto enable_extension = [&](const char* extension) {
+            if (!is_extension_enabled(extension))
+            {
+                extensions.push_back(extension);
+                m_enabled_device_extensions.emplace_back(extension);
+            }
+        };
+
+        for (const auto& s : options.optional_device_extensions)
+        {
+            if (is_supported(s))
+            {
+                enable_extension(s);
+            }
+        }
+
+        // Ray tracing extensions are only useful together, optional ray tracing is enabled as a whole or not at all.
+        if (options.raytracing && !options.raytracing_required
+            && std::ranges::all_of(options.raytracing_extensions, is_supported))
+        {
+            for (const auto& s : options.raytracing_extensions)
+            {
+                enable_extension(s);
+            }
+        }
+
         const auto queue_families = m_physical_device.getQueueFamilyProperties();
         auto get_queue_index = [queue_families](vk::QueueFlagBits req, vk::QueueFlagBits exc){
             const auto family = std::find_if(
@@ -252,7 +303,12 @@ namespace sdvk
 
             return static_cast<uint32_t>(family - std::begin(queue_families));
         };
-        auto get_present_index = [&, queue_families](){
+        auto get_present_index = [&, queue_families](uint32_t fallback){
+            if (!m_surface)
+            {
+                return fallback;
+            }
+
             uint32_t i = 0, result = 0;
             for (const auto& props : queue_families)
             {
@@ -267,7 +323,7 @@ namespace sdvk
 
         auto graphics = get_queue_index(vk::QueueFlagBits::eGraphics, {});
         auto compute = get_queue_index(vk::QueueFlagBits::eCompute, vk::QueueFlagBits::eGraphics);
-        auto present = get_present_index();
+        auto present = get_present_index(graphics);
 
         float queue_priority = 1.0f;
         std::set<uint32_t> unique_queue_indices = { graphics, compute, present };
@@ -287,14 +343,37 @@ namespace sdvk
         m_device_features.device_features.setSampleRateShading(true);
         m_device_features.device_features.setShaderStorageImageMultisample(true);
 
+        if (is_extension_enabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+        {
+            const auto supported_features = m_physical_device.getFeatures();
+            m_device_features.device_features.setMultiDrawIndirect(supported_features.multiDrawIndirect);
+            m_device_features.device_features.setDrawIndirectFirstInstance(supported_features.drawIndirectFirstInstance);
+        }
+
         m_device_features.timeline_semaphores.setTimelineSemaphore(true);
         m_device_features.timeline_semaphores.setPNext(&m_device_features.maintenance4);
         m_device_features.maintenance4.setMaintenance4(true);
         m_device_features.maintenance4.setPNext(&m_device_features.buffer_device_address);
         m_device_features.buffer_device_address.setBufferDeviceAddress(true);
-        m_device_features.buffer_device_address.setPNext(&m_device_features.mesh_shader);
-        m_device_features.mesh_shader.setMeshShader(true);
-        m_device_features.mesh_shader.setTaskShader(true);
+        m_device_features.buffer_device_address.setPNext(&m_device_features.synchronization2);
+        m_device_features.synchronization2.setSynchronization2(true);
+
+        // Feature structs of optional extensions are only chained if the extension is enabled.
+        void** feature_chain_tail = &m_device_features.synchronization2.pNext;
+
+        if (is_extension_enabled(VK_EXT_MESH_SHADER_EXTENSION_NAME))
+        {
+            m_device_features.mesh_shader.setMeshShader(true);
+            m_device_features.mesh_shader.setTaskShader(true);
+            *feature_chain_tail = &m_device_features.mesh_shader;
+            feature_chain_tail = &m_device_features.mesh_shader.pNext;
+        }
+
+        if (is_raytracing_capable())
+        {
+            m_device_features.with_ray_tracing();
+            *feature_chain_tail = &m_device_features.ray_tracing_pipeline;
+        }
 
         vk::DeviceCreateInfo create_info;
         create_info.setEnabledLayerCount(validation_layers.size());
@@ -306,12 +385,6 @@ namespace sdvk
         create_info.setPQueueCreateInfos(queue_infos.data());
         create_info.setPNext(&m_device_features.timeline_semaphores);
 
-        if (options.raytracing)
-        {
-            m_device_features.with_ray_tracing();
-            m_device_features.mesh_shader.setPNext(&m_device_features.ray_tracing_pipeline);
-        }
-
         vk::Result result = m_physical_device.createDevice(&create_info, nullptr, &m_device);
 
         m_graphics_queue.index = graphics;
@@ -341,9 +414,9 @@ namespace sdvk
         }
     }
 
-    void Context::allocate_memory(vk::MemoryRequirements const& memory_requirements,
-                                  vk::MemoryPropertyFlags memory_property_flags,
-                                  vk::DeviceMemory* memory) const
+    uint32_t Context::allocate_memory(vk::MemoryRequirements const& memory_requirements,
+                                      vk::MemoryPropertyFlags memory_property_flags,
+                                      vk::DeviceMemory* memory) const
     {
         const uint32_t type_index = find_memory_type_index(memory_requirements.memoryTypeBits, memory_property_flags);
         const vk::MemoryAllocateInfo alloc_info { memory_requirements.size, type_index };
@@ -352,6 +425,18 @@ namespace sdvk
         {
             throw std::runtime_error("Failed to allocate memory");
         }
+
+        m_memory_statistics.allocation_count++;
+        m_memory_statistics.allocated_bytes += memory_requirements.size;
+        m_memory_statistics.total_allocation_count++;
+        return type_index;
+    }
+
+    void Context::free_memory(const vk::DeviceMemory memory, const vk::DeviceSize size) const
+    {
+        m_device.freeMemory(memory);
+        m_memory_statistics.allocation_count--;
+        m_memory_statistics.allocated_bytes -= size;
     }
 
     uint32_t Context::find_memory_type_index(uint32_t filter, vk::MemoryPropertyFlags flags) const
@@ -373,257 +458,17 @@ namespace sdvk
         return std::find(std::begin(m_enabled_device_extensions),std::end(m_enabled_device_extensions),VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME)
                != std::end(m_enabled_device_extensions);
     }
-}
 
-namespace Nebula::Vulkan
-{
-    Context::Context(ContextCreateParams create_params): m_create_params(std::move(create_params))
+    bool Context::is_indirect_count_capable() const
     {
-        m_gpu_selector = std::shared_ptr<GpuSelector>(m_create_params.gpu_selector);
-
-        vk::DynamicLoader dl;
-        auto vkGetInstanceProcAddr = dl.getProcAddress<PFN_vkGetInstanceProcAddr>("vkGetInstanceProcAddr");
-        VULKAN_HPP_DEFAULT_DISPATCHER.init(vkGetInstanceProcAddr);
-
-        _create_instance();
-        VULKAN_HPP_DEFAULT_DISPATCHER.init(m_instance);
-
-        _select_gpu();
-
-        _create_device();
-        VULKAN_HPP_DEFAULT_DISPATCHER.init(m_device);
-
-        if (m_create_params.with_debug)
-        {
-            _initialize_debug_features();
-        }
-
-        if (m_create_params.with_surface)
-        {
-            _create_surface();
-        }
+        return is_extension_enabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)
+               && m_device_features.device_features.multiDrawIndirect
+               && m_device_features.device_features.drawIndirectFirstInstance;
     }
 
-    void Context::_create_instance()
+    bool Context::is_extension_enabled(const char* extension) const
     {
-        auto available_layers = vk::enumerateInstanceLayerProperties();
-        auto available_extensions = vk::enumerateInstanceExtensionProperties();
-
-        std::set<std::string> required_layers, required_extensions;
-        for (const auto& e : m_create_params.instance_extensions)
-        {
-            required_extensions.insert(e);
-        }
-
-        if (m_create_params.with_debug)
-        {
-            required_layers.insert("VK_LAYER_KHRONOS_validation");
-            required_extensions.insert(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-            required_extensions.insert("VK_EXT_debug_utils");
-        }
-
-        std::vector<const char*> found_layers;
-        for (const auto& layer : available_layers)
-        {
-            if (required_layers.count(layer.layerName.data()))
-            {
-                found_layers.push_back(layer.layerName);
-            }
-        }
-
-        std::vector<const char*> found_extensions;
-        for (const auto& extension : available_extensions)
-        {
-            if (required_extensions.count(extension.extensionName.data()))
-            {
-                found_extensions.push_back(extension.extensionName);
-            }
-        }
-
-        vk::ApplicationInfo application_info;
-        application_info.setApiVersion(VK_API_VERSION_1_3);
-
-        vk::InstanceCreateInfo create_info;
-        create_info.setPApplicationInfo(&application_info);
-        create_info.setEnabledLayerCount(found_layers.size());
-        create_info.setPpEnabledLayerNames(found_layers.data());
-        create_info.setEnabledExtensionCount(found_extensions.size());
-        create_info.setPpEnabledExtensionNames(found_extensions.data());
-
-        vk::Result result = vk::createInstance(&create_info, nullptr, &m_instance);
-        if (result != vk::Result::eSuccess)
-        {
-            throw std::runtime_error("[Error] Failed to initialize Vulkan Instance");
-        }
-
-        std::copy(std::begin(found_extensions),
-                  std::end(found_extensions),
-                  std::back_inserter(m_enabled_instance_extensions));
-    }
-
-    void Context::_select_gpu()
-    {
-        std::vector<vk::PhysicalDevice> physical_devices = m_instance.enumeratePhysicalDevices();
-
-        if (m_gpu_selector != nullptr)
-        {
-            m_gpu_selector = std::shared_ptr<GpuSelector>(new DefaultGpuSelector(m_create_params.device_extensions));
-            return;
-        }
-
-        m_gpu = m_gpu_selector->select_gpu(physical_devices);
-    }
-
-    void Context::_create_device()
-    {
-        auto& df = m_device_features;
-
-        df.enabled_features.setShaderInt16(true);
-        df.enabled_features.setShaderInt64(true);
-        df.enabled_features.setSamplerAnisotropy(true);
-        df.enabled_features.setFillModeNonSolid(true);
-        df.enabled_features.setShaderStorageImageMultisample(true);
-        df.enabled_features.setSampleRateShading(true);
-
-        df.synchronization_2_features.setSynchronization2(true);
-        df.ray_tracing_pipeline_features.setRayTracingPipeline(true);
-        df.ray_query_features.setRayQuery(true);
-        df.acceleration_structure_features.setAccelerationStructure(true);
-        df.buffer_device_address.setBufferDeviceAddress(true);
-        df.descriptor_indexing.setRuntimeDescriptorArray(true);
-        df.maintenance4_features.setMaintenance4(true);
-        df.timeline_semaphore_features.setTimelineSemaphore(true);
-
-        df.synchronization_2_features.setPNext(&df.ray_tracing_pipeline_features);
-        df.ray_tracing_pipeline_features.setPNext(&df.ray_query_features);
-        df.ray_query_features.setPNext(&df.acceleration_structure_features);
-        df.acceleration_structure_features.setPNext(&df.buffer_device_address);
-        df.descriptor_indexing.setPNext(&df.maintenance4_features);
-        df.maintenance4_features.setPNext(&df.timeline_semaphore_features);
-    }
-
-    void Context::_initialize_debug_features()
-    {
-        auto severities = vk::DebugUtilsMessageSeverityFlagBitsEXT::eVerbose
-                          | vk::DebugUtilsMessageSeverityFlagBitsEXT::eWarning
-                          | vk::DebugUtilsMessageSeverityFlagBitsEXT::eError;
-
-        auto types = vk::DebugUtilsMessageTypeFlagBitsEXT::eGeneral
-                     | vk::DebugUtilsMessageTypeFlagBitsEXT::eValidation
-                     | vk::DebugUtilsMessageTypeFlagBitsEXT::ePerformance;
-
-        vk::DebugUtilsMessengerCreateInfoEXT create_info;
-        create_info.setMessageSeverity(severities);
-        create_info.setMessageType(types);
-        create_info.setPfnUserCallback((PFN_vkDebugUtilsMessengerCallbackEXT)(Context::debug_callback));
-
-        bool error = false;
-        auto fun = (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(static_cast<VkInstance>(m_instance), "vkCreateDebugUtilsMessengerEXT");
-
-        if (fun)
-        {
-            auto result = fun(m_instance, reinterpret_cast<const VkDebugUtilsMessengerCreateInfoEXT*>(&create_info), nullptr, &m_debug_messenger);
-            error = (result != VK_SUCCESS);
-        }
-        else
-        {
-            error = true;
-        }
-
-        if (error)
-        {
-            throw std::runtime_error("[Error] Failed to setup VkDebugUtilsMessengerEXT.");
-        }
-    }
-
-    void Context::_create_surface()
-    {
-        VkResult result = glfwCreateWindowSurface(static_cast<VkInstance>(m_instance), m_create_params.with_window, nullptr, reinterpret_cast<VkSurfaceKHR*>(&m_surface));
-        if (result != VK_SUCCESS)
-        {
-            throw std::runtime_error("[Error] Failed to create window surface.");
-        }
-    }
-
-    VkBool32 Context::debug_callback(VkDebugUtilsMessageSeverityFlagBitsEXT message_severity,
-                                     VkDebugUtilsMessageTypeFlagsEXT message_type,
-                                     const VkDebugUtilsMessengerCallbackDataEXT* p_callback_data,
-                                     void* p_user_data)
-    {
-        if (message_severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
-        {
-            std::cerr << p_callback_data->pMessage << std::endl;
-        }
-
-        return VK_FALSE;
-    }
-
-    vk::PhysicalDevice DefaultGpuSelector::select_gpu(std::vector<vk::PhysicalDevice> physical_devices)
-    {
-        physical_devices | std::views::filter([](vk::PhysicalDevice const& pd){
-            auto props = pd.getProperties();
-            return props.deviceType == vk::PhysicalDeviceType::eDiscreteGpu
-                   || props.deviceType == vk::PhysicalDeviceType::eIntegratedGpu;
-        });
-
-        bool with_raytracing = std::find_if(
-            std::begin(_extensions), std::end(_extensions),
-            [](const auto& extension_name) {
-                return extension_name == VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME;
-            }) != std::end(_extensions);
-
-        const auto candidate = std::find_if(
-            std::begin(physical_devices), std::end(physical_devices),
-            [&](vk::PhysicalDevice const& device) {
-                const auto supported_extensions = device.enumerateDeviceExtensionProperties();
-                const auto queue_families = device.getQueueFamilyProperties();
-                const auto props = device.getProperties();
-
-                bool has_ray_tracing = std::find_if(
-                    std::begin(supported_extensions), std::end(supported_extensions),
-                    [](vk::ExtensionProperties const& extension_properties) {
-                        return std::string(extension_properties.extensionName.data()) == VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME;
-                    }) != std::end(supported_extensions);
-
-                bool has_graphics_queue = std::find_if(
-                    std::begin(queue_families), std::end(queue_families),
-                    [](vk::QueueFamilyProperties const& properties) {
-                        return properties.queueFlags & vk::QueueFlagBits::eGraphics;
-                    }) != std::end(queue_families);
-
-                bool is_discrete = props.deviceType == vk::PhysicalDeviceType::eDiscreteGpu;
-
-                std::set<std::string> required_extensions(std::begin(_extensions), std::end(_extensions));
-                for (const auto& extension : supported_extensions) {
-                    required_extensions.erase(extension.extensionName);
-                }
-
-                bool has_missing_extensions = !required_extensions.empty();
-
-                bool result = has_graphics_queue && !has_missing_extensions;
-
-                if (with_raytracing)
-                {
-                    // Some Radeon iGPUs are RT capable, pick only discrete for now since we don't score GPUs.
-                    return result && has_ray_tracing && is_discrete;
-                }
-
-                return result ;
-            });
-
-        if (candidate == std::end(physical_devices))
-        {
-            throw std::runtime_error("Could not find a suitable GPU.");
-        }
-
-        std::cout << "Detected devices:" << std::endl;
-        for (const auto& pd : physical_devices) {
-            auto props = pd.getProperties();
-            std::cout << "- " << props.deviceName << " [" << to_string(props.deviceType) << "]" << std::endl;
-        }
-        auto props = candidate->getProperties();
-        std::cout << "[Info] Selected device: " << props.deviceName << std::endl;
-
-        return *candidate;
+        return std::find(std::begin(m_enabled_device_extensions), std::end(m_enabled_device_extensions), extension)
+               != std::end(m_enabled_device_extensions);
     }
 }
\ No newline at end of file
@@ -7,12 +7,24 @@
 #include <vector>
 #include <vulkan/vulkan.hpp>
 #include "ContextOptions.hpp"
+#include "DeferredDestructionQueue.hpp"
 #include "DeviceFeatures.hpp"
+#include "MemoryBlockAllocator.hpp"
+#include "MemoryManager.hpp"
+#include "MemoryTracker.hpp"
 #include "Queues.hpp"
 #include "Utils.hpp"
 
 namespace sdvk
 {
+    // Device memory allocated through the Context and not freed yet, total_allocation_count also counts the freed allocations.
+    struct MemoryStatistics
+    {
+        uint64_t       allocation_count {0};
+        vk::DeviceSize allocated_bytes {0};
+        uint64_t       total_allocation_count {0};
+    };
+
     class Context
     {
     public:
@@ -21,9 +33,15 @@ namespace sdvk
 
         explicit Context(ContextOptions const& options);
 
-        void allocate_memory(vk::MemoryRequirements const& memory_requirements,
-                             vk::MemoryPropertyFlags memory_property_flags,
-                             vk::DeviceMemory* memory) const;
+        // Returns the memory type index the allocation was made from.
+        uint32_t allocate_memory(vk::MemoryRequirements const& memory_requirements,
+                                 vk::MemoryPropertyFlags memory_property_flags,
+                                 vk::DeviceMemory* memory) const;
+
+        // Frees memory from allocate_memory(), size is the one it was allocated with.
+        void free_memory(vk::DeviceMemory memory, vk::DeviceSize size) const;
+
+        uint32_t find_memory_type_index(uint32_t filter, vk::MemoryPropertyFlags flags) const;
 
         const vk::Device& device() const { return m_device; }
 
@@ -47,6 +65,23 @@ namespace sdvk
 
         bool is_raytracing_capable() const;
 
+        // Multi draw indirect with a GPU written draw count and first instance, used by GPU-driven culling.
+        bool is_indirect_count_capable() const;
+
+        bool is_extension_enabled(const char* extension) const;
+
+        bool is_headless() const { return !m_surface; }
+
+        const MemoryStatistics& memory_statistics() const { return m_memory_statistics; }
+
+        const std::shared_ptr<MemoryTracker>& memory_tracker() const { return m_memory_tracker; }
+
+        const std::shared_ptr<MemoryManager>& memory_manager() const { return m_memory_manager; }
+
+        const std::shared_ptr<MemoryBlockAllocator>& block_allocator() const { return m_block_allocator; }
+
+        const std::shared_ptr<DeferredDestructionQueue>& destruction_queue() const { return m_destruction_queue; }
+
     private:
         void create_instance(ContextOptions const& options);
 
@@ -63,8 +98,6 @@ namespace sdvk
 
         void create_device(ContextOptions const& options);
 
-        uint32_t find_memory_type_index(uint32_t filter, vk::MemoryPropertyFlags flags) const;
-
     private:
         vk::Instance m_instance { nullptr };
         VkDebugUtilsMessengerEXT m_debug_messenger { nullptr };
@@ -80,141 +113,11 @@ namespace sdvk
         std::vector<std::string>     m_enabled_device_extensions;
         vk::PhysicalDeviceProperties m_physical_device_properties;
         DeviceFeatures               m_device_features;
-    };
-}
-
-namespace Nebula::Vulkan
-{
-    struct QueueInfo
-    {
-        struct Queue
-        {
-            uint32_t  index { 0 };
-            vk::Queue queue { nullptr };
-        } graphics, compute;
-    };
-
-    /**
-     * Allows for a customizable GPU selection process.
-     */
-    struct GpuSelector
-    {
-        virtual ~GpuSelector() = default;
-        virtual vk::PhysicalDevice select_gpu(std::vector<vk::PhysicalDevice> gpus) = 0;
-    };
-
-    struct DefaultGpuSelector : public GpuSelector
-    {
-        explicit DefaultGpuSelector(const std::vector<const char*>& extensions): GpuSelector(), _extensions(extensions) {}
-
-        vk::PhysicalDevice select_gpu(std::vector<vk::PhysicalDevice> gpus) override;
-
-    private:
-        const std::vector<const char*>& _extensions;
-    };
-
-    struct ContextCreateParams
-    {
-        std::vector<const char*> instance_extensions;
-        std::vector<const char*> device_extensions;
-        GpuSelector*             gpu_selector;
-        GLFWwindow*              with_window;
-        bool                     with_surface;
-        bool                     with_debug;
-    };
-
-    class Context
-    {
-    public:
-        struct Builder
-        {
-            Builder& with_gpu_selector(GpuSelector* gpu_selector)
-            {
-                params.gpu_selector = gpu_selector;
-                return *this;
-            }
-
-            Builder& with_instance_extensions(const std::vector<const char*>& extensions)
-            {
-                auto& exts = params.instance_extensions;
-                exts.insert(std::end(exts), std::begin(extensions), std::end(extensions));
-                return *this;
-            }
-
-            Builder& with_device_extensions(const std::vector<const char*>& extensions)
-            {
-                auto& exts = params.device_extensions;
-                exts.insert(std::end(exts), std::begin(extensions), std::end(extensions));
-                return *this;
-            }
-
-            Builder& with_surface(GLFWwindow* window)
-            {
-                params.with_window = window;
-                params.with_surface = true;
-                return *this;
-            }
-
-            std::shared_ptr<Context> create_context()
-            {
-                return std::make_shared<Context>(params);
-            }
-
-        private:
-            ContextCreateParams params;
-        };
-
-        explicit Context(ContextCreateParams  create_params);
-
-        Context(const Context&) = delete;
-        void operator=(const Context&) = delete;
-
-        ~Context() = default;
-
-        vk::Instance get_instance() const { return m_instance; }
-
-        vk::PhysicalDevice get_gpu() const { return m_gpu; }
-
-        vk::Device get_device() const { return m_device; }
-
-        vk::SurfaceKHR get_surface() const { return m_surface; }
-
-    private:
-        void _create_instance();
-
-        void _select_gpu();
-
-        void _create_device();
-
-        void _initialize_debug_features();
-
-        void _create_surface();
-
-        static VKAPI_ATTR VkBool32 VKAPI_CALL debug_callback(VkDebugUtilsMessageSeverityFlagBitsEXT message_severity,
-                                                             VkDebugUtilsMessageTypeFlagsEXT message_type,
-                                                             const VkDebugUtilsMessengerCallbackDataEXT* p_callback_data,
-                                                             void* p_user);
-
-    private:
-        std::shared_ptr<GpuSelector> m_gpu_selector;
-
-        vk::Device         m_device   { nullptr };
-        vk::Instance       m_instance { nullptr };
-        vk::PhysicalDevice m_gpu      { nullptr };
-        vk::SurfaceKHR     m_surface  { nullptr };
-
-        QueueInfo          m_queue_info {};
-        DeviceFeatures     m_device_features {};
-
-        vk::PhysicalDeviceProperties m_gpu_properties {};
-        vk::PhysicalDeviceMemoryProperties m_gpu_memory_properties {};
-
-        vk::PhysicalDeviceFeatures2 m_gpu_features_2 {};
-        std::vector<const char*> m_enabled_device_extensions;
-        std::vector<const char*> m_enabled_instance_extensions;
-
-        VkDebugUtilsMessengerEXT m_debug_messenger;
 
-        ContextCreateParams m_create_params;
+        mutable MemoryStatistics       m_memory_statistics;
+        std::shared_ptr<MemoryTracker> m_memory_tracker;
+        std::shared_ptr<MemoryManager> m_memory_manager;
+        std::shared_ptr<MemoryBlockAllocator> m_block_allocator;
+        std::shared_ptr<DeferredDestructionQueue> m_destruction_queue;
     };
 }
\ No newline at end of file
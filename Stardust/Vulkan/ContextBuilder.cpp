@@ -33,10 +33,10 @@ namespace sdvk
         return *this;
     }
 
-    ContextBuilder& ContextBuilder::with_surface(GLFWwindow* target)
+    ContextBuilder& ContextBuilder::with_surface(const std::function<vk::SurfaceKHR(const vk::Instance&)>& create_surface)
     {
         _options.with_surface = true;
-        _options.window = target;
+        _options.create_surface = create_surface;
         return *this;
     }
 
@@ -49,23 +49,47 @@ namespace sdvk
         return *this;
     }
 
-    ContextBuilder &ContextBuilder::add_raytracing_extensions(bool flag)
+    ContextBuilder& ContextBuilder::add_optional_device_extensions(const std::initializer_list<const char*>& extensions)
+    {
+        for (const auto& e : extensions)
+        {
+            _options.optional_device_extensions.insert(e);
+        }
+        return *this;
+    }
+
+    ContextBuilder &ContextBuilder::add_raytracing_extensions(bool flag, bool required)
     {
         if (flag)
         {
-            add_device_extensions({
+            _options.raytracing_extensions = {
                 VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
                 VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
                 VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
 
                 VK_KHR_RAY_QUERY_EXTENSION_NAME, VK_KHR_SPIRV_1_4_EXTENSION_NAME
-            });
+            };
+
+            if (required)
+            {
+                for (const auto& e : _options.raytracing_extensions)
+                {
+                    _options.device_extensions.insert(e);
+                }
+            }
 
             _options.raytracing = true;
+            _options.raytracing_required = required;
         }
         return *this;
     }
 
+    ContextBuilder& ContextBuilder::set_allow_cpu_device(bool allow)
+    {
+        _options.allow_cpu_device = allow;
+        return *this;
+    }
+
     std::unique_ptr<Context> ContextBuilder::create_context() const
     {
         return std::make_unique<Context>(_options);
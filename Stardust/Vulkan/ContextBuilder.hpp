@@ -1,10 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <set>
 #include <vector>
-#include <GLFW/glfw3.h>
 #include "Context.hpp"
 #include "ContextOptions.hpp"
 
@@ -25,13 +25,20 @@ namespace sdvk
         #pragma endregion
 
         #pragma region Presentation
-        ContextBuilder& with_surface(GLFWwindow* target);
+        ContextBuilder& with_surface(const std::function<vk::SurfaceKHR(const vk::Instance&)>& create_surface);
         #pragma endregion
 
         #pragma region Device
         ContextBuilder& add_device_extensions(std::initializer_list<const char*> const& extensions);
 
-        ContextBuilder& add_raytracing_extensions(bool flag = false);
+        ContextBuilder& add_optional_device_extensions(std::initializer_list<const char*> const& extensions);
+
+        /**
+         * @param required If false, ray tracing is enabled only when the selected device supports every extension of it.
+         */
+        ContextBuilder& add_raytracing_extensions(bool flag = false, bool required = true);
+
+        ContextBuilder& set_allow_cpu_device(bool allow);
         #pragma endregion
 
         std::unique_ptr<Context> create_context() const;
@@ -1,7 +1,8 @@
 #pragma once
 
+#include <functional>
 #include <set>
-#include <GLFW/glfw3.h>
+#include <vulkan/vulkan.hpp>
 
 namespace sdvk
 {
@@ -12,10 +13,19 @@ namespace sdvk
         bool validation { false };
         bool debug { false };
 
+        // Surfaces are created by the windowing layer, which keeps the Context free of it.
         bool with_surface = { false };
-        GLFWwindow* window { nullptr };
+        std::function<vk::SurfaceKHR(const vk::Instance&)> create_surface;
+
+        // Allows selecting virtual and CPU devices (e.g. lavapipe) when no GPU is present.
+        bool allow_cpu_device { false };
 
         std::set<const char*> device_extensions;
+        // Enabled only if the selected device supports them.
+        std::set<const char*> optional_device_extensions;
+
+        std::set<const char*> raytracing_extensions;
         bool raytracing = false;
+        bool raytracing_required = true;
     };
 }
\ No newline at end of file
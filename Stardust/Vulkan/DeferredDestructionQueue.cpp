@@ -0,0 +1,86 @@
+#include "DeferredDestructionQueue.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace sdvk
+{
+    DeferredDestructionQueue::DeferredDestructionQueue(const vk::Device& device, const uint64_t latency)
+    : m_latency(latency), m_device(device)
+    {
+    }
+
+    DeferredDestructionQueue::~DeferredDestructionQueue()
+    {
+        flush();
+    }
+
+    void DeferredDestructionQueue::push(const Destroy& destroy)
+    {
+        std::lock_guard lock(m_mutex);
+        m_entries.push_back({ m_frame, destroy });
+    }
+
+    void DeferredDestructionQueue::begin_frame(const uint64_t frame)
+    {
+        std::vector<Destroy> due;
+        {
+            std::lock_guard lock(m_mutex);
+            m_frame = frame;
+
+            // Entries are pushed in frame order, so the finished ones are at the front.
+            while (!m_entries.empty() && m_entries.front().frame + m_latency <= frame)
+            {
+                due.push_back(std::move(m_entries.front().destroy));
+                m_entries.pop_front();
+            }
+            m_destroyed += due.size();
+        }
+
+        // Not under the lock, an entry may push further entries.
+        for (const auto& destroy : due)
+        {
+            destroy();
+        }
+    }
+
+    void DeferredDestructionQueue::flush()
+    {
+        while (true)
+        {
+            std::deque<Entry> entries;
+            {
+                std::lock_guard lock(m_mutex);
+                if (m_entries.empty())
+                {
+                    return;
+                }
+                entries.swap(m_entries);
+                m_destroyed += entries.size();
+            }
+
+            for (const auto& entry : entries)
+            {
+                entry.destroy();
+            }
+        }
+    }
+
+    void DeferredDestructionQueue::set_latency(const uint64_t latency)
+    {
+        std::lock_guard lock(m_mutex);
+        m_latency = std::max<uint64_t>(latency, 1);
+    }
+
+    size_t DeferredDestructionQueue::pending() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_entries.size();
+    }
+
+    uint64_t DeferredDestructionQueue::destroyed() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_destroyed;
+    }
+}
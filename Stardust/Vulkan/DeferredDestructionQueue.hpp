@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vulkan/vulkan.hpp>
+
+namespace sdvk
+{
+    /**
+     * Destroys Vulkan objects once every frame that could still use them has finished on the GPU.
+     * Entries are keyed on the frame number they were pushed in and released by begin_frame() after latency frames,
+     * which has to be called once the fence of the new frame's slot has been waited on.
+     * Shared by the Context and every resource owner, like the MemoryTracker, so owners held by statics can push after the
+     * Context is gone. Whatever is left is destroyed with the queue.
+     */
+    class DeferredDestructionQueue
+    {
+    public:
+        using Destroy = std::function<void()>;
+
+        explicit DeferredDestructionQueue(const vk::Device& device, uint64_t latency = s_default_latency);
+
+        ~DeferredDestructionQueue();
+
+        DeferredDestructionQueue(const DeferredDestructionQueue&) = delete;
+        DeferredDestructionQueue& operator=(const DeferredDestructionQueue&) = delete;
+
+        void push(const Destroy& destroy);
+
+        // Destroys the handles (pipelines, layouts, render passes, pools, ...) in the given order, null handles are skipped.
+        template <typename... Handles>
+        void destroy(const Handles&... handles)
+        {
+            push([device = m_device, handles...]() {
+                ([&device](const auto& handle) {
+                    if (handle)
+                    {
+                        device.destroy(handle);
+                    }
+                }(handles), ...);
+            });
+        }
+
+        // Runs the entries pushed latency or more frames before frame.
+        void begin_frame(uint64_t frame);
+
+        // Runs every entry, the device must be idle.
+        void flush();
+
+        // Number of frames the GPU may be behind the CPU, frames in flight of the swapchain or offscreen target.
+        void set_latency(uint64_t latency);
+
+        size_t pending() const;
+
+        uint64_t destroyed() const;
+
+        static constexpr uint64_t s_default_latency = 3;
+
+    private:
+        struct Entry
+        {
+            uint64_t frame { 0 };
+            Destroy  destroy;
+        };
+
+        mutable std::mutex m_mutex;
+        std::deque<Entry>  m_entries;
+        uint64_t           m_frame { 0 };
+        uint64_t           m_latency { s_default_latency };
+        uint64_t           m_destroyed { 0 };
+
+        vk::Device m_device;
+    };
+}
@@ -23,10 +23,8 @@ namespace sdvk
         void with_ray_tracing()
         {
             ray_query.setRayQuery(true);
-            synchronization2.setSynchronization2(true);
-            synchronization2.setPNext(&ray_query);
             descriptor_indexing.setRuntimeDescriptorArray(true);
-            descriptor_indexing.setPNext(&synchronization2);
+            descriptor_indexing.setPNext(&ray_query);
             acceleration_structure.setAccelerationStructure(true);
             acceleration_structure.setPNext(&descriptor_indexing);
             ray_tracing_pipeline.setRayTracingPipeline(true);
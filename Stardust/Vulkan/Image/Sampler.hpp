@@ -38,6 +38,11 @@ namespace sdvk
             return *this;
         }
 
+        const vk::SamplerCreateInfo& get_create_info() const
+        {
+            return create_info;
+        }
+
         vk::Sampler create(vk::Device const& device)
         {
             vk::Sampler result;
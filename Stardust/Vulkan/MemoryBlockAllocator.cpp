@@ -0,0 +1,423 @@
+#include "MemoryBlockAllocator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <Vulkan/Context.hpp>
+
+namespace sdvk
+{
+    float MemoryFragmentation::fragmentation() const
+    {
+        const vk::DeviceSize total_free = reserved - used;
+        if (total_free == 0)
+        {
+            return 0.0f;
+        }
+        return 1.0f - static_cast<float>(largest_free_range) / static_cast<float>(total_free);
+    }
+
+    MemoryBlockAllocator::MemoryBlockAllocator(const Context& context, const vk::PhysicalDeviceMemoryProperties& memory_properties)
+    : m_context(context), m_device(context.device()), m_memory_properties(memory_properties)
+    {
+    }
+
+    MemoryBlockAllocator::~MemoryBlockAllocator()
+    {
+        for (const auto& block : m_blocks)
+        {
+            if (!block)
+            {
+                continue;
+            }
+
+            if (block->mapped)
+            {
+                m_device.unmapMemory(block->memory);
+            }
+            m_context.free_memory(block->memory, block->size);
+        }
+    }
+
+    MemoryAllocation MemoryBlockAllocator::allocate(const vk::MemoryRequirements& requirements, const vk::MemoryPropertyFlags memory_property_flags,
+                                                    const MemoryResourceKind kind, const Context& context)
+    {
+        const uint32_t memory_type = context.find_memory_type_index(requirements.memoryTypeBits, memory_property_flags);
+        const vk::DeviceSize alignment = std::max(requirements.alignment, s_min_alignment);
+
+        std::lock_guard lock(m_mutex);
+
+        if (requirements.size > s_block_size / 2)
+        {
+            const uint32_t block = _create_block(memory_type, kind, requirements.size, true, memory_property_flags, context);
+            return _allocate_in(block, requirements.size, alignment);
+        }
+
+        if (auto allocation = _allocate_in_existing(memory_type, kind, requirements.size, alignment, m_evacuated_block);
+            allocation.is_valid())
+        {
+            return allocation;
+        }
+
+        const uint32_t block = _create_block(memory_type, kind, s_block_size, false, memory_property_flags, context);
+        return _allocate_in(block, requirements.size, alignment);
+    }
+
+    void MemoryBlockAllocator::free(const MemoryAllocation& allocation)
+    {
+        if (!allocation.is_valid())
+        {
+            return;
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        auto& block = *m_blocks[allocation.block];
+        const auto used = block.used_ranges.find(allocation.offset);
+        if (used == block.used_ranges.end())
+        {
+            throw std::runtime_error("[Error] Freed memory range is not allocated");
+        }
+        block.used -= used->second.size;
+        block.used_ranges.erase(used);
+
+        auto [range, _] = block.free_ranges.insert({ allocation.offset, allocation.size });
+        if (const auto next = std::next(range); next != block.free_ranges.end() && range->first + range->second == next->first)
+        {
+            range->second += next->second;
+            block.free_ranges.erase(next);
+        }
+        if (range != block.free_ranges.begin())
+        {
+            if (const auto previous = std::prev(range); previous->first + previous->second == range->first)
+            {
+                previous->second += range->second;
+                block.free_ranges.erase(range);
+            }
+        }
+
+        if (!block.used_ranges.empty())
+        {
+            return;
+        }
+
+        // One empty block per memory type is kept, so recompiling a graph does not return and reallocate it.
+        const bool has_other_block = std::ranges::any_of(m_blocks, [&](const std::unique_ptr<Block>& other) {
+            return other && other.get() != &block && !other->dedicated
+                && other->memory_type == block.memory_type && other->kind == block.kind;
+        });
+
+        if (block.dedicated || has_other_block || allocation.block == m_evacuated_block)
+        {
+            _release_block(allocation.block);
+        }
+    }
+
+    void MemoryBlockAllocator::set_owner(const MemoryAllocation& allocation, MemoryRelocatable* owner)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto& block = *m_blocks[allocation.block];
+        if (const auto used = block.used_ranges.find(allocation.offset); used != block.used_ranges.end())
+        {
+            used->second.owner = block.dedicated ? nullptr : owner;
+        }
+    }
+
+    uint32_t MemoryBlockAllocator::defragment(const vk::CommandBuffer& command_buffer, const vk::DeviceSize byte_budget, const Context& context)
+    {
+        std::vector<std::pair<MemoryRelocatable*, MemoryAllocation>> moves;
+        {
+            std::lock_guard lock(m_mutex);
+
+            if (m_evacuated_block != MemoryAllocation::s_invalid_block && !m_blocks[m_evacuated_block])
+            {
+                m_evacuated_block = MemoryAllocation::s_invalid_block;
+            }
+
+            // Least used block whose allocations are all relocatable and fit into the free space of its siblings.
+            if (m_evacuated_block == MemoryAllocation::s_invalid_block)
+            {
+                for (uint32_t i = 0; i < m_blocks.size(); i++)
+                {
+                    const auto& block = m_blocks[i];
+                    if (!block || block->dedicated || block->used_ranges.empty()
+                        || static_cast<float>(block->used) >= s_evacuation_threshold * static_cast<float>(block->size))
+                    {
+                        continue;
+                    }
+
+                    const bool is_relocatable = std::ranges::all_of(block->used_ranges, [](const auto& used) {
+                        return used.second.owner != nullptr;
+                    });
+
+                    vk::DeviceSize sibling_free = 0;
+                    for (const auto& sibling : m_blocks)
+                    {
+                        if (sibling && sibling != block && !sibling->dedicated
+                            && sibling->memory_type == block->memory_type && sibling->kind == block->kind)
+                        {
+                            sibling_free += sibling->size - sibling->used;
+                        }
+                    }
+
+                    const bool is_better = m_evacuated_block == MemoryAllocation::s_invalid_block
+                                        || block->used < m_blocks[m_evacuated_block]->used;
+                    if (is_relocatable && sibling_free >= block->used && is_better)
+                    {
+                        m_evacuated_block = i;
+                    }
+                }
+            }
+
+            if (m_evacuated_block == MemoryAllocation::s_invalid_block)
+            {
+                return 0;
+            }
+
+            auto& source = *m_blocks[m_evacuated_block];
+            vk::DeviceSize planned_bytes = 0;
+            for (auto& [offset, range] : source.used_ranges)
+            {
+                if (range.retiring)
+                {
+                    continue;
+                }
+
+                // An allocation pinned since the block was selected, or no room left elsewhere.
+                if (!range.owner)
+                {
+                    m_evacuated_block = MemoryAllocation::s_invalid_block;
+                    break;
+                }
+
+                // The first move may exceed the budget, otherwise a range larger than it would keep the block evacuated forever.
+                if (planned_bytes > 0 && planned_bytes + range.size > byte_budget)
+                {
+                    break;
+                }
+
+                const auto target = _allocate_in_existing(source.memory_type, source.kind, range.size, range.alignment, m_evacuated_block);
+                if (!target.is_valid())
+                {
+                    m_evacuated_block = MemoryAllocation::s_invalid_block;
+                    break;
+                }
+
+                range.retiring = true;
+                planned_bytes += range.size;
+                moves.emplace_back(range.owner, target);
+            }
+
+            m_defragmentation.moves += moves.size();
+            m_defragmentation.moved_bytes += planned_bytes;
+        }
+
+        if (moves.empty())
+        {
+            return 0;
+        }
+
+        for (const auto& [owner, target] : moves)
+        {
+            owner->relocate(target, command_buffer);
+        }
+
+        vk::PipelineStageFlags2 src_stages = vk::PipelineStageFlagBits2::eTransfer;
+        vk::AccessFlags2 src_access = vk::AccessFlagBits2::eTransferWrite;
+        if (context.is_raytracing_capable())
+        {
+            src_stages |= vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR;
+            src_access |= vk::AccessFlagBits2::eAccelerationStructureWriteKHR;
+        }
+
+        vk::MemoryBarrier2 barrier;
+        barrier.setSrcStageMask(src_stages);
+        barrier.setSrcAccessMask(src_access);
+        barrier.setDstStageMask(vk::PipelineStageFlagBits2::eAllCommands);
+        barrier.setDstAccessMask(vk::AccessFlagBits2::eMemoryRead);
+
+        vk::DependencyInfo dependency_info;
+        dependency_info.setMemoryBarrierCount(1);
+        dependency_info.setPMemoryBarriers(&barrier);
+        command_buffer.pipelineBarrier2(&dependency_info);
+
+        return static_cast<uint32_t>(moves.size());
+    }
+
+    std::vector<MemoryBlockStatistics> MemoryBlockAllocator::block_statistics() const
+    {
+        std::lock_guard lock(m_mutex);
+
+        std::vector<MemoryBlockStatistics> result;
+        for (uint32_t i = 0; i < m_blocks.size(); i++)
+        {
+            const auto& block = m_blocks[i];
+            if (!block)
+            {
+                continue;
+            }
+
+            MemoryBlockStatistics stats;
+            stats.block = i;
+            stats.memory_type = block->memory_type;
+            stats.dedicated = block->dedicated;
+            stats.size = block->size;
+            stats.used = block->used;
+            stats.free_ranges = static_cast<uint32_t>(block->free_ranges.size());
+            stats.allocations = static_cast<uint32_t>(block->used_ranges.size());
+            for (const auto& [offset, size] : block->free_ranges)
+            {
+                stats.largest_free_range = std::max(stats.largest_free_range, size);
+            }
+            for (const auto& [offset, range] : block->used_ranges)
+            {
+                stats.relocatable_allocations += range.owner != nullptr;
+            }
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    std::vector<MemoryFragmentation> MemoryBlockAllocator::fragmentation() const
+    {
+        std::map<uint32_t, MemoryFragmentation> per_type;
+        for (const auto& block : block_statistics())
+        {
+            if (block.dedicated)
+            {
+                continue;
+            }
+
+            auto& type = per_type[block.memory_type];
+            type.memory_type = block.memory_type;
+            type.blocks++;
+            type.reserved += block.size;
+            type.used += block.used;
+            type.free_ranges += block.free_ranges;
+            type.largest_free_range = std::max(type.largest_free_range, block.largest_free_range);
+        }
+
+        std::vector<MemoryFragmentation> result;
+        for (const auto& [memory_type, stats] : per_type)
+        {
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    DefragmentationStatistics MemoryBlockAllocator::defragmentation_statistics() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_defragmentation;
+    }
+
+    MemoryAllocation MemoryBlockAllocator::_allocate_in(const uint32_t block_index, const vk::DeviceSize size, const vk::DeviceSize alignment)
+    {
+        auto& block = *m_blocks[block_index];
+        for (auto it = block.free_ranges.begin(); it != block.free_ranges.end(); ++it)
+        {
+            const auto [offset, range_size] = *it;
+            const vk::DeviceSize aligned = (offset + alignment - 1) / alignment * alignment;
+            const vk::DeviceSize padding = aligned - offset;
+            if (padding + size > range_size)
+            {
+                continue;
+            }
+
+            block.free_ranges.erase(it);
+            if (padding > 0)
+            {
+                block.free_ranges.insert({ offset, padding });
+            }
+            if (padding + size < range_size)
+            {
+                block.free_ranges.insert({ aligned + size, range_size - padding - size });
+            }
+
+            block.used_ranges.insert({ aligned, { size, alignment, nullptr } });
+            block.used += size;
+
+            MemoryAllocation allocation;
+            allocation.block = block_index;
+            allocation.memory_type = block.memory_type;
+            allocation.memory = block.memory;
+            allocation.offset = aligned;
+            allocation.size = size;
+            allocation.mapped = block.mapped ? static_cast<uint8_t*>(block.mapped) + aligned : nullptr;
+            return allocation;
+        }
+
+        return {};
+    }
+
+    MemoryAllocation MemoryBlockAllocator::_allocate_in_existing(const uint32_t memory_type, const MemoryResourceKind kind, const vk::DeviceSize size,
+                                                                 const vk::DeviceSize alignment, const uint32_t excluded_block)
+    {
+        for (uint32_t i = 0; i < m_blocks.size(); i++)
+        {
+            const auto& block = m_blocks[i];
+            if (!block || block->dedicated || i == excluded_block || block->memory_type != memory_type || block->kind != kind
+                || block->size - block->used < size)
+            {
+                continue;
+            }
+
+            if (auto allocation = _allocate_in(i, size, alignment); allocation.is_valid())
+            {
+                return allocation;
+            }
+        }
+
+        return {};
+    }
+
+    uint32_t MemoryBlockAllocator::_create_block(const uint32_t memory_type, const MemoryResourceKind kind, const vk::DeviceSize size,
+                                                 const bool dedicated, const vk::MemoryPropertyFlags memory_property_flags, const Context& context)
+    {
+        auto block = std::make_unique<Block>();
+        block->memory_type = memory_type;
+        block->kind = kind;
+        block->size = size;
+        block->dedicated = dedicated;
+        block->free_ranges.insert({ 0, size });
+
+        const vk::MemoryRequirements requirements { size, s_min_alignment, 1u << memory_type };
+        context.allocate_memory(requirements, memory_property_flags, &block->memory);
+
+        if (m_memory_properties.memoryTypes[memory_type].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible)
+        {
+            if (const vk::Result result = m_device.mapMemory(block->memory, 0, VK_WHOLE_SIZE, {}, &block->mapped);
+                result != vk::Result::eSuccess)
+            {
+                throw std::runtime_error("[Error] Failed to map memory block");
+            }
+        }
+
+        const auto empty_slot = std::ranges::find_if(m_blocks, [](const std::unique_ptr<Block>& slot) { return !slot; });
+        if (empty_slot != m_blocks.end())
+        {
+            *empty_slot = std::move(block);
+            return static_cast<uint32_t>(empty_slot - m_blocks.begin());
+        }
+
+        m_blocks.push_back(std::move(block));
+        return static_cast<uint32_t>(m_blocks.size() - 1);
+    }
+
+    void MemoryBlockAllocator::_release_block(const uint32_t block_index)
+    {
+        auto& block = m_blocks[block_index];
+        if (block->mapped)
+        {
+            m_device.unmapMemory(block->memory);
+        }
+        m_context.free_memory(block->memory, block->size);
+        block.reset();
+
+        if (block_index == m_evacuated_block)
+        {
+            m_defragmentation.released_blocks++;
+            m_evacuated_block = MemoryAllocation::s_invalid_block;
+        }
+    }
+}
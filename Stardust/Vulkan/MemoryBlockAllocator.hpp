@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace sdvk
+{
+    class Context;
+
+    // Buffers and images never share a block, so bufferImageGranularity does not have to be considered.
+    enum class MemoryResourceKind
+    {
+        eBuffer,
+        eImage,
+    };
+
+    struct MemoryAllocation
+    {
+        static constexpr uint32_t s_invalid_block = std::numeric_limits<uint32_t>::max();
+
+        uint32_t         block { s_invalid_block };
+        uint32_t         memory_type { 0 };
+        vk::DeviceMemory memory;
+        vk::DeviceSize   offset { 0 };
+        vk::DeviceSize   size { 0 };
+
+        // Host visible blocks stay mapped for their whole lifetime, points at offset.
+        void*            mapped { nullptr };
+
+        bool is_valid() const { return block != s_invalid_block; }
+    };
+
+    // Owners that can move their resource into another allocation, e.g. by copying it in a command buffer.
+    class MemoryRelocatable
+    {
+    public:
+        // The previous allocation has to be freed through the DeferredDestructionQueue, the GPU may still read it.
+        virtual void relocate(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer) = 0;
+
+        virtual ~MemoryRelocatable() = default;
+    };
+
+    struct MemoryBlockStatistics
+    {
+        uint32_t       block { 0 };
+        uint32_t       memory_type { 0 };
+        bool           dedicated { false };
+        vk::DeviceSize size { 0 };
+        vk::DeviceSize used { 0 };
+        vk::DeviceSize largest_free_range { 0 };
+        uint32_t       free_ranges { 0 };
+        uint32_t       allocations { 0 };
+        uint32_t       relocatable_allocations { 0 };
+    };
+
+    struct MemoryFragmentation
+    {
+        uint32_t       memory_type { 0 };
+        uint32_t       blocks { 0 };
+        vk::DeviceSize reserved { 0 };
+        vk::DeviceSize used { 0 };
+        vk::DeviceSize largest_free_range { 0 };
+        uint32_t       free_ranges { 0 };
+
+        // 0 when the free space of the memory type is one contiguous range, approaches 1 as it splits into small holes.
+        float fragmentation() const;
+    };
+
+    struct DefragmentationStatistics
+    {
+        uint64_t       moves { 0 };
+        vk::DeviceSize moved_bytes { 0 };
+        uint64_t       released_blocks { 0 };
+    };
+
+    /**
+     * Suballocates buffers and images from large blocks per memory type, allocations larger than half a block get a
+     * dedicated one. Relocatable allocations are moved out of sparsely used blocks by defragment(), a little every
+     * frame, so blocks emptied by graph recompiles and scene changes can be returned to the driver.
+     * Shared by the Context and every allocation, like the MemoryTracker.
+     */
+    class MemoryBlockAllocator
+    {
+    public:
+        // Blocks are allocated and freed through the context, which has to outlive the allocator.
+        MemoryBlockAllocator(const Context& context, const vk::PhysicalDeviceMemoryProperties& memory_properties);
+
+        ~MemoryBlockAllocator();
+
+        MemoryAllocation allocate(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags memory_property_flags,
+                                  MemoryResourceKind kind, const Context& context);
+
+        void free(const MemoryAllocation& allocation);
+
+        // Marks an allocation as movable by defragment(), the owner has to outlive the allocation.
+        void set_owner(const MemoryAllocation& allocation, MemoryRelocatable* owner);
+
+        /**
+         * Moves relocatable allocations out of the least used block of a memory type into the other blocks,
+         * until byte_budget is used up, at least one allocation is moved per call. Copies are recorded into command_buffer followed by a barrier for every later stage.
+         * Returns the number of moved allocations, the owners' device addresses changed if non-zero.
+         */
+        uint32_t defragment(const vk::CommandBuffer& command_buffer, vk::DeviceSize byte_budget, const Context& context);
+
+        std::vector<MemoryBlockStatistics> block_statistics() const;
+
+        std::vector<MemoryFragmentation> fragmentation() const;
+
+        DefragmentationStatistics defragmentation_statistics() const;
+
+        static constexpr vk::DeviceSize s_block_size = 64ull * 1024 * 1024;
+
+        // Covers acceleration structure offsets and shader group base alignment.
+        static constexpr vk::DeviceSize s_min_alignment = 256;
+
+        // Blocks used less than this are evacuated.
+        static constexpr float s_evacuation_threshold = 0.5f;
+
+    private:
+        struct Range
+        {
+            vk::DeviceSize     size { 0 };
+            vk::DeviceSize     alignment { 0 };
+            MemoryRelocatable* owner { nullptr };
+
+            // Moved by defragment(), freed once the copy has finished.
+            bool               retiring { false };
+        };
+
+        struct Block
+        {
+            vk::DeviceMemory   memory;
+            uint32_t           memory_type { 0 };
+            MemoryResourceKind kind { MemoryResourceKind::eBuffer };
+            vk::DeviceSize     size { 0 };
+            vk::DeviceSize     used { 0 };
+            void*              mapped { nullptr };
+            bool               dedicated { false };
+
+            // Keyed by offset, free ranges are merged with their neighbours on release.
+            std::map<vk::DeviceSize, vk::DeviceSize> free_ranges;
+            std::map<vk::DeviceSize, Range>          used_ranges;
+        };
+
+        MemoryAllocation _allocate_in(uint32_t block_index, vk::DeviceSize size, vk::DeviceSize alignment);
+
+        MemoryAllocation _allocate_in_existing(uint32_t memory_type, MemoryResourceKind kind, vk::DeviceSize size,
+                                               vk::DeviceSize alignment, uint32_t excluded_block);
+
+        uint32_t _create_block(uint32_t memory_type, MemoryResourceKind kind, vk::DeviceSize size, bool dedicated,
+                               vk::MemoryPropertyFlags memory_property_flags, const Context& context);
+
+        void _release_block(uint32_t block_index);
+
+        mutable std::mutex m_mutex;
+
+        const Context&                     m_context;
+        vk::Device                         m_device;
+        vk::PhysicalDeviceMemoryProperties m_memory_properties;
+
+        // Released blocks leave an empty slot, allocations refer to blocks by index.
+        std::vector<std::unique_ptr<Block>> m_blocks;
+        uint32_t                            m_evacuated_block { MemoryAllocation::s_invalid_block };
+        DefragmentationStatistics           m_defragmentation;
+    };
+}
@@ -0,0 +1,203 @@
+#include "MemoryManager.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace sdvk
+{
+    MemoryManager::MemoryManager(const vk::PhysicalDevice& physical_device, const bool budget_extension,
+                                 const std::shared_ptr<MemoryTracker>& memory_tracker)
+    : m_physical_device(physical_device)
+    , m_budget_extension(budget_extension)
+    , m_memory_tracker(memory_tracker)
+    {
+        _query_heaps();
+    }
+
+    void MemoryManager::set_policy(const MemoryPressureLevel level, const std::string& action, const Policy& apply, const Policy& revert)
+    {
+        m_policies[static_cast<size_t>(level)] = { action, apply, revert };
+    }
+
+    void MemoryManager::update(const uint64_t frame)
+    {
+        if (!m_options.enabled)
+        {
+            return;
+        }
+
+        _query_heaps();
+        m_frames_since_step++;
+
+        // The most oversubscribed device local heap decides.
+        vk::DeviceSize usage = 0, budget = 0;
+        double max_ratio = -1.0;
+        for (const auto& heap : m_heaps)
+        {
+            if (!heap.device_local || heap.budget == 0)
+            {
+                continue;
+            }
+
+            const double ratio = static_cast<double>(heap.usage) / static_cast<double>(heap.budget);
+            if (ratio > max_ratio)
+            {
+                max_ratio = ratio;
+                usage = heap.usage;
+                budget = heap.budget;
+            }
+        }
+
+        const auto headroom = static_cast<double>(std::clamp(m_options.headroom, 0.0f, 0.5f));
+        const auto limit = static_cast<vk::DeviceSize>(static_cast<double>(budget) * (1.0 - headroom));
+        const auto recovery_limit = static_cast<vk::DeviceSize>(static_cast<double>(budget) * (1.0 - 2.0 * headroom));
+        const bool can_step = m_frames_since_step >= m_options.settle_frames;
+
+        if (usage > limit)
+        {
+            m_low_usage_frames = 0;
+            if (can_step && m_level < MemoryPressureLevel::eRefuseUploads)
+            {
+                _step(frame, true, usage, limit);
+            }
+            return;
+        }
+
+        m_low_usage_frames = usage < recovery_limit ? m_low_usage_frames + 1 : 0;
+        if (can_step && m_level > MemoryPressureLevel::eNone && m_low_usage_frames >= m_options.recovery_frames)
+        {
+            _step(frame, false, usage, limit);
+            m_low_usage_frames = 0;
+        }
+    }
+
+    void MemoryManager::_step(const uint64_t frame, const bool escalation, const vk::DeviceSize usage, const vk::DeviceSize limit)
+    {
+        if (escalation)
+        {
+            m_level = static_cast<MemoryPressureLevel>(static_cast<uint32_t>(m_level) + 1);
+        }
+
+        const auto& policy = m_policies[static_cast<size_t>(m_level)];
+        const std::string action = policy.action.empty() ? to_string(m_level) : policy.action;
+
+        MemoryPressureEvent event;
+        event.frame = frame;
+        event.level = m_level;
+        event.escalation = escalation;
+        event.action = action;
+        event.usage = usage;
+        event.limit = limit;
+        m_events.push_back(event);
+
+        static constexpr double megabyte = 1024.0 * 1024.0;
+        std::cout << std::format("[Memory] Frame {}: {} \"{}\" ({:.1f} MB used, {:.1f} MB limit)",
+                                 frame, escalation ? "Applying" : "Reverting", action,
+                                 static_cast<double>(usage) / megabyte, static_cast<double>(limit) / megabyte) << std::endl;
+
+        const Policy& callback = escalation ? policy.apply : policy.revert;
+        if (callback)
+        {
+            callback();
+        }
+
+        if (!escalation)
+        {
+            m_level = static_cast<MemoryPressureLevel>(static_cast<uint32_t>(m_level) - 1);
+        }
+        m_frames_since_step = 0;
+    }
+
+    void MemoryManager::_query_heaps()
+    {
+        vk::PhysicalDeviceMemoryProperties2 properties;
+        vk::PhysicalDeviceMemoryBudgetPropertiesEXT budget;
+        if (m_budget_extension)
+        {
+            properties.pNext = &budget;
+        }
+        m_physical_device.getMemoryProperties2(&properties);
+
+        const auto& memory_properties = properties.memoryProperties;
+        m_heaps.resize(memory_properties.memoryHeapCount);
+
+        // Without the extension usage is estimated from the allocations made through the Context.
+        std::vector<vk::DeviceSize> tracked_usage(memory_properties.memoryHeapCount, 0);
+        if (!m_budget_extension)
+        {
+            for (const auto& type : m_memory_tracker->type_statistics())
+            {
+                if (type.heap < tracked_usage.size())
+                {
+                    tracked_usage[type.heap] += type.live_bytes;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < memory_properties.memoryHeapCount; i++)
+        {
+            auto& heap = m_heaps[i];
+            heap.heap = i;
+            heap.size = memory_properties.memoryHeaps[i].size;
+            heap.device_local = static_cast<bool>(memory_properties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal);
+            heap.budget = m_budget_extension ? budget.heapBudget[i] : heap.size;
+            heap.usage = m_budget_extension ? budget.heapUsage[i] : tracked_usage[i];
+
+            if (heap.device_local && m_options.budget_override > 0)
+            {
+                heap.budget = std::min(heap.budget, m_options.budget_override);
+            }
+        }
+    }
+
+    void MemoryManager::write_json(const std::string& path) const
+    {
+        std::ofstream out(path);
+        if (!out.is_open())
+        {
+            throw std::runtime_error(std::format("[Error] Failed to open memory pressure log \"{}\"", path));
+        }
+
+        out << "{\n";
+        out << std::format("  \"headroom\": {},\n", m_options.headroom);
+        out << std::format("  \"budget_extension\": {},\n", m_budget_extension);
+        out << std::format("  \"final_level\": \"{}\",\n", to_string(m_level));
+
+        out << "  \"heaps\": [\n";
+        for (size_t i = 0; i < m_heaps.size(); i++)
+        {
+            const auto& heap = m_heaps[i];
+            out << std::format("    {{ \"heap\": {}, \"device_local\": {}, \"size\": {}, \"budget\": {}, \"usage\": {} }}{}\n",
+                               heap.heap, heap.device_local, heap.size, heap.budget, heap.usage,
+                               i + 1 < m_heaps.size() ? "," : "");
+        }
+        out << "  ],\n";
+
+        out << "  \"events\": [\n";
+        for (size_t i = 0; i < m_events.size(); i++)
+        {
+            const auto& event = m_events[i];
+            out << std::format("    {{ \"frame\": {}, \"level\": \"{}\", \"escalation\": {}, \"action\": \"{}\", \"usage\": {}, \"limit\": {} }}{}\n",
+                               event.frame, to_string(event.level), event.escalation, event.action, event.usage, event.limit,
+                               i + 1 < m_events.size() ? "," : "");
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+
+    std::string MemoryManager::to_string(const MemoryPressureLevel level)
+    {
+        switch (level)
+        {
+            case MemoryPressureLevel::eNone:                return "none";
+            case MemoryPressureLevel::eReleaseAccumulation: return "release accumulation";
+            case MemoryPressureLevel::eLowerResolution:     return "lower resolution";
+            case MemoryPressureLevel::eEvictColdMeshes:     return "evict cold meshes";
+            case MemoryPressureLevel::eRefuseUploads:       return "refuse uploads";
+        }
+        return "unknown";
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include "MemoryTracker.hpp"
+
+namespace sdvk
+{
+    // Steps taken in order while device local memory stays above the budget minus the headroom.
+    enum class MemoryPressureLevel : uint32_t
+    {
+        eNone,
+        eReleaseAccumulation,
+        eLowerResolution,
+        eEvictColdMeshes,
+        eRefuseUploads,
+    };
+
+    struct MemoryBudgetOptions
+    {
+        bool enabled { true };
+
+        // Fraction of every device local heap budget kept free.
+        float headroom { 0.1f };
+
+        // Frames between two steps, so the previous one shows up in the reported usage.
+        uint32_t settle_frames { 8 };
+
+        // Frames usage has to stay below the budget minus twice the headroom before the last step is undone.
+        uint32_t recovery_frames { 120 };
+
+        // Replaces the budget of device local heaps when non-zero, to exercise the policies on large GPUs.
+        vk::DeviceSize budget_override { 0 };
+    };
+
+    struct HeapBudget
+    {
+        uint32_t       heap { 0 };
+        bool           device_local { false };
+        vk::DeviceSize size { 0 };
+        vk::DeviceSize budget { 0 };
+        vk::DeviceSize usage { 0 };
+    };
+
+    struct MemoryPressureEvent
+    {
+        uint64_t            frame { 0 };
+        MemoryPressureLevel level { MemoryPressureLevel::eNone };
+        bool                escalation { true };
+        std::string         action;
+        vk::DeviceSize      usage { 0 };
+        vk::DeviceSize      limit { 0 };
+    };
+
+    /**
+     * Watches per heap budget and usage (VK_EXT_memory_budget, or the MemoryTracker totals without it) once per frame
+     * and steps through the registered policies while device local memory is oversubscribed.
+     * One step is taken at a time, each is undone in reverse order once usage has stayed low for recovery_frames.
+     */
+    class MemoryManager
+    {
+    public:
+        using Policy = std::function<void()>;
+
+        MemoryManager(const vk::PhysicalDevice& physical_device, bool budget_extension, const std::shared_ptr<MemoryTracker>& memory_tracker);
+
+        void set_options(const MemoryBudgetOptions& options) { m_options = options; }
+
+        // apply runs when pressure reaches the level, revert when it drops below it again.
+        void set_policy(MemoryPressureLevel level, const std::string& action, const Policy& apply, const Policy& revert);
+
+        // Call at the start of a frame with no command buffer recording, policies may wait for the device.
+        void update(uint64_t frame);
+
+        bool accepts_uploads() const { return m_level < MemoryPressureLevel::eRefuseUploads; }
+
+        MemoryPressureLevel level() const { return m_level; }
+
+        const std::vector<HeapBudget>& heaps() const { return m_heaps; }
+
+        const std::vector<MemoryPressureEvent>& events() const { return m_events; }
+
+        void write_json(const std::string& path) const;
+
+        static std::string to_string(MemoryPressureLevel level);
+
+    private:
+        void _query_heaps();
+
+        void _step(uint64_t frame, bool escalation, vk::DeviceSize usage, vk::DeviceSize limit);
+
+        struct PolicyEntry
+        {
+            std::string action;
+            Policy      apply;
+            Policy      revert;
+        };
+
+        static constexpr size_t s_level_count = static_cast<size_t>(MemoryPressureLevel::eRefuseUploads) + 1;
+
+        MemoryBudgetOptions                     m_options;
+        MemoryPressureLevel                     m_level { MemoryPressureLevel::eNone };
+        std::array<PolicyEntry, s_level_count>  m_policies;
+        std::vector<HeapBudget>                 m_heaps;
+        std::vector<MemoryPressureEvent>        m_events;
+        uint32_t                                m_frames_since_step { 0 };
+        uint32_t                                m_low_usage_frames { 0 };
+
+        vk::PhysicalDevice             m_physical_device;
+        bool                           m_budget_extension { false };
+        std::shared_ptr<MemoryTracker> m_memory_tracker;
+    };
+}
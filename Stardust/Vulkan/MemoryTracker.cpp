@@ -0,0 +1,245 @@
+#include "MemoryTracker.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace sdvk
+{
+    MemoryTracker::MemoryTracker(const vk::PhysicalDeviceMemoryProperties& memory_properties)
+    {
+        for (uint32_t i = 0; i < memory_properties.memoryTypeCount; i++)
+        {
+            MemoryTypeStatistics type;
+            type.index = i;
+            type.heap = memory_properties.memoryTypes[i].heapIndex;
+            type.flags = memory_properties.memoryTypes[i].propertyFlags;
+            m_types.push_back(type);
+        }
+
+        m_frames.push_back({});
+    }
+
+    MemoryTracker::AllocationId MemoryTracker::track(const std::string& tag, const MemoryCategory category,
+                                                     const uint32_t memory_type, const vk::DeviceSize size)
+    {
+        std::lock_guard lock(m_mutex);
+
+        const auto key = std::make_pair(tag, memory_type);
+        auto& tag_stats = m_tags[key];
+        tag_stats.tag = tag;
+        tag_stats.category = category;
+        tag_stats.memory_type = memory_type;
+        tag_stats.live_allocations++;
+        tag_stats.live_bytes += size;
+        tag_stats.peak_bytes = std::max(tag_stats.peak_bytes, tag_stats.live_bytes);
+
+        if (memory_type < m_types.size())
+        {
+            m_types[memory_type].live_allocations++;
+            m_types[memory_type].live_bytes += size;
+        }
+
+        m_live_bytes += size;
+        auto& frame = m_frames.back();
+        frame.allocations++;
+        frame.allocated_bytes += size;
+        frame.live_bytes = m_live_bytes;
+
+        const AllocationId allocation = m_next_allocation++;
+        m_allocations.insert({ allocation, { key, size } });
+        return allocation;
+    }
+
+    void MemoryTracker::release(const AllocationId allocation)
+    {
+        std::lock_guard lock(m_mutex);
+
+        const auto it = m_allocations.find(allocation);
+        if (it == m_allocations.end())
+        {
+            return;
+        }
+
+        const auto& [key, size] = it->second;
+        auto& tag_stats = m_tags[key];
+        tag_stats.live_allocations--;
+        tag_stats.live_bytes -= size;
+
+        if (key.second < m_types.size())
+        {
+            m_types[key.second].live_allocations--;
+            m_types[key.second].live_bytes -= size;
+        }
+
+        m_live_bytes -= size;
+        auto& frame = m_frames.back();
+        frame.frees++;
+        frame.freed_bytes += size;
+        frame.live_bytes = m_live_bytes;
+
+        m_allocations.erase(it);
+    }
+
+    void MemoryTracker::begin_frame(const uint64_t frame)
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (m_frames.size() >= s_frame_history_size)
+        {
+            m_frames.pop_front();
+        }
+
+        MemoryFrameStatistics stats;
+        stats.frame = frame;
+        stats.live_bytes = m_live_bytes;
+        m_frames.push_back(stats);
+    }
+
+    void MemoryTracker::set_alias_savings(const std::vector<MemoryAliasSavings>& savings)
+    {
+        std::lock_guard lock(m_mutex);
+        m_alias_savings = savings;
+    }
+
+    void MemoryTracker::set_fragmentation(const std::vector<MemoryFragmentation>& fragmentation, const DefragmentationStatistics& defragmentation)
+    {
+        std::lock_guard lock(m_mutex);
+        m_fragmentation = fragmentation;
+        m_defragmentation = defragmentation;
+    }
+
+    std::vector<MemoryTagStatistics> MemoryTracker::tag_statistics() const
+    {
+        std::lock_guard lock(m_mutex);
+
+        std::vector<MemoryTagStatistics> result;
+        result.reserve(m_tags.size());
+        for (const auto& [key, stats] : m_tags)
+        {
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    std::vector<MemoryTypeStatistics> MemoryTracker::type_statistics() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_types;
+    }
+
+    std::vector<MemoryFrameStatistics> MemoryTracker::frame_history() const
+    {
+        std::lock_guard lock(m_mutex);
+        return { m_frames.begin(), m_frames.end() };
+    }
+
+    std::vector<MemoryAliasSavings> MemoryTracker::alias_savings() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_alias_savings;
+    }
+
+    vk::DeviceSize MemoryTracker::live_bytes() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_live_bytes;
+    }
+
+    void MemoryTracker::write_json(const std::string& path) const
+    {
+        std::ofstream out(path);
+        if (!out.is_open())
+        {
+            throw std::runtime_error(std::format("[Error] Failed to open memory report \"{}\"", path));
+        }
+
+        auto escape = [](std::string value) {
+            std::ranges::replace(value, '"', '\'');
+            std::ranges::replace(value, '\\', '/');
+            return value;
+        };
+
+        const auto tags = tag_statistics();
+        const auto types = type_statistics();
+        const auto frames = frame_history();
+        const auto savings = alias_savings();
+
+        std::vector<MemoryFragmentation> fragmentation;
+        DefragmentationStatistics defragmentation;
+        {
+            std::lock_guard lock(m_mutex);
+            fragmentation = m_fragmentation;
+            defragmentation = m_defragmentation;
+        }
+
+        out << "{\n";
+        out << std::format("  \"live_bytes\": {},\n", live_bytes());
+
+        out << "  \"tags\": [\n";
+        for (size_t i = 0; i < tags.size(); i++)
+        {
+            const auto& tag = tags[i];
+            out << std::format("    {{ \"tag\": \"{}\", \"category\": \"{}\", \"memory_type\": {}, \"live_allocations\": {}, \"live_bytes\": {}, \"peak_bytes\": {} }}{}\n",
+                               escape(tag.tag), to_string(tag.category), tag.memory_type, tag.live_allocations, tag.live_bytes, tag.peak_bytes,
+                               i + 1 < tags.size() ? "," : "");
+        }
+        out << "  ],\n";
+
+        out << "  \"memory_types\": [\n";
+        for (size_t i = 0; i < types.size(); i++)
+        {
+            const auto& type = types[i];
+            out << std::format("    {{ \"index\": {}, \"heap\": {}, \"flags\": \"{}\", \"live_allocations\": {}, \"live_bytes\": {} }}{}\n",
+                               type.index, type.heap, vk::to_string(type.flags), type.live_allocations, type.live_bytes,
+                               i + 1 < types.size() ? "," : "");
+        }
+        out << "  ],\n";
+
+        out << "  \"frames\": [\n";
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            const auto& frame = frames[i];
+            out << std::format("    {{ \"frame\": {}, \"allocations\": {}, \"frees\": {}, \"allocated_bytes\": {}, \"freed_bytes\": {}, \"live_bytes\": {} }}{}\n",
+                               frame.frame, frame.allocations, frame.frees, frame.allocated_bytes, frame.freed_bytes, frame.live_bytes,
+                               i + 1 < frames.size() ? "," : "");
+        }
+        out << "  ],\n";
+
+        out << "  \"alias_savings\": [\n";
+        for (size_t i = 0; i < savings.size(); i++)
+        {
+            const auto& saving = savings[i];
+            out << std::format("    {{ \"tag\": \"{}\", \"aliased_resources\": {}, \"saved_bytes\": {} }}{}\n",
+                               escape(saving.tag), saving.aliased_resources, saving.saved_bytes,
+                               i + 1 < savings.size() ? "," : "");
+        }
+        out << "  ],\n";
+
+        out << "  \"fragmentation\": [\n";
+        for (size_t i = 0; i < fragmentation.size(); i++)
+        {
+            const auto& type = fragmentation[i];
+            out << std::format("    {{ \"memory_type\": {}, \"blocks\": {}, \"reserved\": {}, \"used\": {}, \"free_ranges\": {}, \"largest_free_range\": {}, \"fragmentation\": {:.4f} }}{}\n",
+                               type.memory_type, type.blocks, type.reserved, type.used, type.free_ranges, type.largest_free_range, type.fragmentation(),
+                               i + 1 < fragmentation.size() ? "," : "");
+        }
+        out << "  ],\n";
+
+        out << std::format("  \"defragmentation\": {{ \"moves\": {}, \"moved_bytes\": {}, \"released_blocks\": {} }}\n",
+                           defragmentation.moves, defragmentation.moved_bytes, defragmentation.released_blocks);
+        out << "}\n";
+    }
+
+    std::string MemoryTracker::to_string(const MemoryCategory category)
+    {
+        switch (category)
+        {
+            case MemoryCategory::eBuffer:                return "buffer";
+            case MemoryCategory::eImage:                 return "image";
+            case MemoryCategory::eAccelerationStructure: return "acceleration structure";
+        }
+        return "unknown";
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include "MemoryBlockAllocator.hpp"
+
+namespace sdvk
+{
+    enum class MemoryCategory
+    {
+        eBuffer,
+        eImage,
+        eAccelerationStructure,
+    };
+
+    struct MemoryTagStatistics
+    {
+        std::string    tag;
+        MemoryCategory category { MemoryCategory::eBuffer };
+        uint32_t       memory_type { 0 };
+        uint32_t       live_allocations { 0 };
+        vk::DeviceSize live_bytes { 0 };
+        vk::DeviceSize peak_bytes { 0 };
+    };
+
+    struct MemoryTypeStatistics
+    {
+        uint32_t                index { 0 };
+        uint32_t                heap { 0 };
+        vk::MemoryPropertyFlags flags {};
+        uint32_t                live_allocations { 0 };
+        vk::DeviceSize          live_bytes { 0 };
+    };
+
+    struct MemoryFrameStatistics
+    {
+        uint64_t       frame { 0 };
+        uint32_t       allocations { 0 };
+        uint32_t       frees { 0 };
+        vk::DeviceSize allocated_bytes { 0 };
+        vk::DeviceSize freed_bytes { 0 };
+        vk::DeviceSize live_bytes { 0 };
+    };
+
+    // Memory the ResourceOptimizer avoided by letting several graph resources share one image.
+    struct MemoryAliasSavings
+    {
+        std::string    tag;
+        uint32_t       aliased_resources { 0 };
+        vk::DeviceSize saved_bytes { 0 };
+    };
+
+    /**
+     * Owner based accounting of device memory allocations.
+     * Buffers and images register their allocation with a tag (node, resource or mesh name) and release it when
+     * destroyed, live bytes are kept per tag + memory type, per memory type and per frame.
+     * Shared by the Context and every allocation so it outlives whichever of them is destroyed last.
+     */
+    class MemoryTracker
+    {
+    public:
+        using AllocationId = uint64_t;
+
+        explicit MemoryTracker(const vk::PhysicalDeviceMemoryProperties& memory_properties);
+
+        AllocationId track(const std::string& tag, MemoryCategory category, uint32_t memory_type, vk::DeviceSize size);
+
+        void release(AllocationId allocation);
+
+        // Closes the statistics of the current frame and starts counting for the given one.
+        void begin_frame(uint64_t frame);
+
+        // Replaces the savings of the previously compiled graph.
+        void set_alias_savings(const std::vector<MemoryAliasSavings>& savings);
+
+        // Snapshot of the block allocator, included in the JSON report.
+        void set_fragmentation(const std::vector<MemoryFragmentation>& fragmentation, const DefragmentationStatistics& defragmentation);
+
+        std::vector<MemoryTagStatistics> tag_statistics() const;
+
+        std::vector<MemoryTypeStatistics> type_statistics() const;
+
+        // Oldest first, the last entry is the frame in progress.
+        std::vector<MemoryFrameStatistics> frame_history() const;
+
+        std::vector<MemoryAliasSavings> alias_savings() const;
+
+        vk::DeviceSize live_bytes() const;
+
+        void write_json(const std::string& path) const;
+
+        static std::string to_string(MemoryCategory category);
+
+        static constexpr size_t s_frame_history_size = 240;
+
+    private:
+        struct Allocation
+        {
+            std::pair<std::string, uint32_t> key;
+            vk::DeviceSize                   size { 0 };
+        };
+
+        mutable std::mutex m_mutex;
+
+        AllocationId m_next_allocation { 1 };
+        std::unordered_map<AllocationId, Allocation> m_allocations;
+
+        // Keyed by tag and memory type, entries stay after their last release to keep the peak.
+        std::map<std::pair<std::string, uint32_t>, MemoryTagStatistics> m_tags;
+        std::vector<MemoryTypeStatistics>  m_types;
+        std::deque<MemoryFrameStatistics>  m_frames;
+        std::vector<MemoryAliasSavings>    m_alias_savings;
+        std::vector<MemoryFragmentation>   m_fragmentation;
+        DefragmentationStatistics          m_defragmentation;
+        vk::DeviceSize                     m_live_bytes { 0 };
+    };
+}
@@ -0,0 +1,155 @@
+#include "OffscreenTarget.hpp"
+
+#include <format>
+#include <stdexcept>
+#include <Nebula/Image.hpp>
+
+namespace sdvk
+{
+    static constexpr vk::DeviceSize s_bytes_per_pixel = 4;
+
+    OffscreenTarget::OffscreenTarget(const vk::Extent2D extent, const vk::Format format, const uint32_t image_count, const Context& context)
+    : m_extent(extent), m_format(format), m_ctx(context)
+    {
+        switch (format)
+        {
+            case vk::Format::eB8G8R8A8Unorm:
+            case vk::Format::eB8G8R8A8Srgb:
+            case vk::Format::eR8G8B8A8Unorm:
+            case vk::Format::eR8G8B8A8Srgb:
+                break;
+            default:
+                throw std::runtime_error(std::format("[Error] Unsupported offscreen target format: {}", vk::to_string(format)));
+        }
+
+        const vk::DeviceSize readback_size = s_bytes_per_pixel * extent.width * extent.height;
+
+        for (uint32_t i = 0; i < image_count; i++)
+        {
+            m_images.push_back(std::make_shared<Nebula::Image>(
+                m_ctx, m_format, m_extent, vk::SampleCountFlagBits::e1,
+                vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+                vk::ImageAspectFlagBits::eColor, vk::ImageTiling::eOptimal, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                std::format("[Offscreen] Image {}", i)));
+
+            m_readback_buffers.push_back(Buffer::Builder()
+                .with_size(readback_size)
+                .as_readback_buffer()
+                .with_name(std::format("[Offscreen] Readback {}", i))
+                .create(m_ctx));
+
+            // Signaled so the first wait on each slot returns immediately.
+            const vk::FenceCreateInfo fence_info { vk::FenceCreateFlagBits::eSignaled };
+            vk::Fence fence;
+            if (const vk::Result result = m_ctx.device().createFence(&fence_info, nullptr, &fence);
+                result != vk::Result::eSuccess)
+            {
+                throw std::runtime_error(std::format("[Error] Failed to create offscreen Fence #{}", i));
+            }
+            m_fences.push_back(fence);
+        }
+    }
+
+    OffscreenTarget::~OffscreenTarget()
+    {
+        for (const auto& fence : m_fences)
+        {
+            m_ctx.device().destroyFence(fence);
+        }
+    }
+
+    void OffscreenTarget::wait(const uint32_t current_frame) const
+    {
+        if (const vk::Result result = m_ctx.device().waitForFences(1, &m_fences[current_frame], true, UINT64_MAX);
+            result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error(std::format("[Error] Failed to wait for offscreen frame #{}", current_frame));
+        }
+    }
+
+    void OffscreenTarget::submit(const uint32_t current_frame, const vk::CommandBuffer& command_buffer) const
+    {
+        if (m_ctx.device().resetFences(1, &m_fences[current_frame]) != vk::Result::eSuccess)
+        {
+            throw std::runtime_error(std::format("[Error] Failed to reset the fence of offscreen frame #{}", current_frame));
+        }
+
+        vk::SubmitInfo submit_info;
+        submit_info.setCommandBufferCount(1);
+        submit_info.setCommandBuffers(command_buffer);
+
+        if (m_ctx.q_graphics().queue.submit(1, &submit_info, m_fences[current_frame]) != vk::Result::eSuccess)
+        {
+            throw std::runtime_error(std::format("[Error] Failed to submit offscreen frame #{}", current_frame));
+        }
+    }
+
+    void OffscreenTarget::record_readback(const uint32_t current_frame, const vk::CommandBuffer& command_buffer) const
+    {
+        const auto& image = m_images[current_frame];
+
+        vk::BufferImageCopy copy_region;
+        copy_region.setBufferOffset(0);
+        copy_region.setBufferRowLength(0);
+        copy_region.setBufferImageHeight(0);
+        copy_region.setImageSubresource(image->properties().subresource_layers);
+        copy_region.setImageOffset({ 0, 0, 0 });
+        copy_region.setImageExtent({ m_extent.width, m_extent.height, 1 });
+
+        command_buffer.copyImageToBuffer(image->image(), vk::ImageLayout::eTransferSrcOptimal,
+                                         m_readback_buffers[current_frame]->buffer(), 1, &copy_region);
+
+        // Make the copy visible to the host once the fence of the slot has signaled.
+        vk::MemoryBarrier2 host_barrier;
+        host_barrier.setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer);
+        host_barrier.setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite);
+        host_barrier.setDstStageMask(vk::PipelineStageFlagBits2::eHost);
+        host_barrier.setDstAccessMask(vk::AccessFlagBits2::eHostRead);
+
+        vk::DependencyInfo dependency_info;
+        dependency_info.setMemoryBarrierCount(1);
+        dependency_info.setPMemoryBarriers(&host_barrier);
+        command_buffer.pipelineBarrier2(&dependency_info);
+    }
+
+    std::vector<uint8_t> OffscreenTarget::read_pixels(const uint32_t current_frame) const
+    {
+        const auto& buffer = m_readback_buffers[current_frame];
+        std::vector<uint8_t> pixels(buffer->size());
+        buffer->get_data(pixels.data(), m_ctx.device());
+        return pixels;
+    }
+
+    vk::Rect2D OffscreenTarget::make_scissor() const
+    {
+        return { { 0, 0 }, m_extent };
+    }
+
+    vk::Viewport OffscreenTarget::make_viewport() const
+    {
+        vk::Viewport vp;
+
+        vp.setX(0.0f);
+        vp.setWidth(static_cast<float>(m_extent.width));
+        vp.setY(static_cast<float>(m_extent.height));
+        vp.setHeight(-1.0f * static_cast<float>(m_extent.height));
+        vp.setMaxDepth(1.0f);
+        vp.setMinDepth(0.0f);
+
+        return vp;
+    }
+
+    const std::shared_ptr<Nebula::Image>& OffscreenTarget::image(const uint32_t id) const
+    {
+        if (id >= m_images.size())
+        {
+            throw std::out_of_range(std::format("Offscreen image index {} out of range.", id));
+        }
+        return m_images[id];
+    }
+
+    const vk::ImageView& OffscreenTarget::view(const uint32_t id) const
+    {
+        return image(id)->image_view();
+    }
+}
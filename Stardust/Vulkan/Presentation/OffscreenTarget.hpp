@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <Vulkan/Buffer.hpp>
+#include <Vulkan/Context.hpp>
+
+namespace Nebula
+{
+    class Image;
+}
+
+namespace sdvk
+{
+    /**
+     * Stand-in for the Swapchain in headless mode.
+     * The render path ends in one of the offscreen images, which is then copied into a host visible readback buffer.
+     */
+    class OffscreenTarget
+    {
+    public:
+        OffscreenTarget(OffscreenTarget const&) = delete;
+        OffscreenTarget& operator=(OffscreenTarget const&) = delete;
+
+        OffscreenTarget(vk::Extent2D extent, vk::Format format, uint32_t image_count, Context const& context);
+
+        ~OffscreenTarget();
+
+        // Waits until the previous submission of the frame slot has finished.
+        void wait(uint32_t current_frame) const;
+
+        void submit(uint32_t current_frame, vk::CommandBuffer const& command_buffer) const;
+
+        // Records a copy of the offscreen image into the readback buffer, the image must be in TransferSrcOptimal layout.
+        void record_readback(uint32_t current_frame, vk::CommandBuffer const& command_buffer) const;
+
+        // Tightly packed pixels of the last completed frame in the slot, call after wait().
+        std::vector<uint8_t> read_pixels(uint32_t current_frame) const;
+
+        vk::Rect2D make_scissor() const;
+
+        // Flipped along the Y axis the same way as Swapchain::make_viewport.
+        vk::Viewport make_viewport() const;
+
+        const std::shared_ptr<Nebula::Image>& image(uint32_t id) const;
+
+        const vk::ImageView& view(uint32_t id) const;
+
+        uint32_t image_count() const { return m_images.size(); }
+
+        vk::Extent2D extent() const { return m_extent; }
+
+        vk::Format format() const { return m_format; }
+
+    private:
+        vk::Extent2D m_extent;
+        vk::Format   m_format;
+
+        std::vector<std::shared_ptr<Nebula::Image>> m_images;
+        std::vector<std::unique_ptr<Buffer>>        m_readback_buffers;
+        std::vector<vk::Fence>                      m_fences;
+
+        Context const& m_ctx;
+    };
+}
@@ -1,5 +1,9 @@
 #include "Blas.hpp"
 
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
 namespace sdvk
 {
     Blas::Builder& Blas::Builder::with_geometry(const std::shared_ptr<sd::Geometry>& geometry)
@@ -20,6 +24,19 @@ namespace sdvk
         return *this;
     }
 
+    Blas::Builder& Blas::Builder::with_offsets(const uint32_t first_vertex, const uint32_t first_index)
+    {
+        _first_vertex = first_vertex;
+        _first_index = first_index;
+        return *this;
+    }
+
+    Blas::Builder& Blas::Builder::allow_update()
+    {
+        _allow_update = true;
+        return *this;
+    }
+
     Blas::Builder& Blas::Builder::with_name(const std::string& name)
     {
         _name = name;
@@ -28,7 +45,7 @@ namespace sdvk
 
     std::unique_ptr<Blas> Blas::Builder::create(const CommandBuffers& command_buffers, const Context& context)
     {
-        auto result = std::make_unique<Blas>(*_geometry, *_vertex_buffer, *_index_buffer, command_buffers, context);
+        auto result = std::make_unique<Blas>(*_geometry, *_vertex_buffer, *_index_buffer, _first_vertex, _first_index, _allow_update, command_buffers, context, _name);
 
         if (context.is_debug())
         {
@@ -44,14 +61,24 @@ namespace sdvk
 
 
     Blas::Blas(const sd::Geometry& geometry, const Buffer& vertex_buffer, const Buffer& index_buffer,
-               const CommandBuffers& command_buffers, const Context& context)
+               const uint32_t first_vertex, const uint32_t first_index, const bool allow_update,
+               const CommandBuffers& command_buffers, const Context& context, const std::string& name)
+    : m_vertex_count(geometry.vertex_count())
+    , m_triangle_count(geometry.index_count() / 3)
+    , m_flags(vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace)
+    , m_device(context.device()), m_destruction_queue(context.destruction_queue())
     {
+        if (allow_update)
+        {
+            m_flags |= vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate;
+        }
+
         vk::AccelerationStructureGeometryTrianglesDataKHR geometry_data;
         geometry_data.setVertexFormat(vk::Format::eR32G32B32Sfloat);
-        geometry_data.setVertexData(vertex_buffer.address());
+        geometry_data.setVertexData(vertex_buffer.address() + first_vertex * sizeof(sd::VertexData));
         geometry_data.setVertexStride(sizeof(sd::VertexData));
         geometry_data.setMaxVertex(geometry.vertex_count());
-        geometry_data.setIndexData(index_buffer.address());
+        geometry_data.setIndexData(index_buffer.address() + first_index * sizeof(uint32_t));
         geometry_data.setIndexType(vk::IndexType::eUint32);
 
         vk::AccelerationStructureGeometryKHR as_geo;
@@ -61,7 +88,7 @@ namespace sdvk
         vk::AccelerationStructureBuildSizesInfoKHR as_sizes_info;
         vk::AccelerationStructureBuildGeometryInfoKHR as_geometry_info;
         as_geometry_info.setType(vk::AccelerationStructureTypeKHR::eBottomLevel);
-        as_geometry_info.setFlags(vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace);
+        as_geometry_info.setFlags(m_flags);
         as_geometry_info.setMode(vk::BuildAccelerationStructureModeKHR::eBuild);
         as_geometry_info.setGeometryCount(1);
         as_geometry_info.setPGeometries(&as_geo);
@@ -70,7 +97,12 @@ namespace sdvk
         context.device().getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eDevice,
                                                                &as_geometry_info, &triangle_count, &as_sizes_info);
 
-        m_buffer = Buffer::Builder().with_size(as_sizes_info.accelerationStructureSize).as_acceleration_structure_storage().create(context);
+        m_buffer = Buffer::Builder()
+            .with_size(as_sizes_info.accelerationStructureSize)
+            .as_acceleration_structure_storage()
+            .with_name(name)
+            .create(context);
+        m_size = as_sizes_info.accelerationStructureSize;
 
         vk::AccelerationStructureCreateInfoKHR create_info;
         create_info.setType(vk::AccelerationStructureTypeKHR::eBottomLevel);
@@ -83,7 +115,11 @@ namespace sdvk
         address_info.setAccelerationStructure(m_blas);
         m_address = context.device().getAccelerationStructureAddressKHR(&address_info);
 
-        auto scratch_buf = Buffer::Builder().with_size(as_sizes_info.buildScratchSize).as_storage_buffer().create(context);
+        auto scratch_buf = Buffer::Builder()
+            .with_size(std::max(as_sizes_info.buildScratchSize, allow_update ? as_sizes_info.updateScratchSize : 0))
+            .as_storage_buffer()
+            .with_name(std::format("{} - Scratch", name))
+            .create(context);
         as_geometry_info.setDstAccelerationStructure(m_blas);
         as_geometry_info.setScratchData(scratch_buf->address());
 
@@ -94,5 +130,84 @@ namespace sdvk
         command_buffers.execute_single_time([&](const vk::CommandBuffer& cmd){
             cmd.buildAccelerationStructuresKHR(1, &as_geometry_info, p_build_range_infos);
         });
+
+        m_buffer->make_relocatable(this);
+
+        if (allow_update)
+        {
+            m_scratch = std::move(scratch_buf);
+        }
+    }
+
+    void Blas::record_build(const vk::DeviceAddress vertex_data, const vk::DeviceAddress index_data,
+                            const vk::BuildAccelerationStructureModeKHR mode, const vk::CommandBuffer& command_buffer) const
+    {
+        if (!m_scratch)
+        {
+            throw std::runtime_error("[Error] Blas::record_build requires a BLAS created with allow_update()");
+        }
+
+        vk::AccelerationStructureGeometryTrianglesDataKHR geometry_data;
+        geometry_data.setVertexFormat(vk::Format::eR32G32B32Sfloat);
+        geometry_data.setVertexData(vertex_data);
+        geometry_data.setVertexStride(sizeof(sd::VertexData));
+        geometry_data.setMaxVertex(m_vertex_count);
+        geometry_data.setIndexData(index_data);
+        geometry_data.setIndexType(vk::IndexType::eUint32);
+
+        vk::AccelerationStructureGeometryKHR as_geo;
+        as_geo.setGeometryType(vk::GeometryTypeKHR::eTriangles);
+        as_geo.setGeometry(geometry_data);
+
+        vk::AccelerationStructureBuildGeometryInfoKHR as_geometry_info;
+        as_geometry_info.setType(vk::AccelerationStructureTypeKHR::eBottomLevel);
+        as_geometry_info.setFlags(m_flags);
+        as_geometry_info.setMode(mode);
+        as_geometry_info.setGeometryCount(1);
+        as_geometry_info.setPGeometries(&as_geo);
+        as_geometry_info.setSrcAccelerationStructure(mode == vk::BuildAccelerationStructureModeKHR::eUpdate ? m_blas : nullptr);
+        as_geometry_info.setDstAccelerationStructure(m_blas);
+        as_geometry_info.setScratchData(m_scratch->address());
+
+        vk::AccelerationStructureBuildRangeInfoKHR build_range_info;
+        build_range_info.setPrimitiveCount(m_triangle_count);
+        const vk::AccelerationStructureBuildRangeInfoKHR* p_build_range_infos[1] = { &build_range_info };
+
+        command_buffer.buildAccelerationStructuresKHR(1, &as_geometry_info, p_build_range_infos);
+    }
+
+    Blas::~Blas()
+    {
+        m_destruction_queue->destroy(m_blas);
+    }
+
+    void Blas::relocate(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer)
+    {
+        // Pushed before the buffer, so the old structure is destroyed ahead of the memory it lives in.
+        m_destruction_queue->destroy(m_blas);
+
+        const vk::AccelerationStructureKHR previous = m_blas;
+        m_buffer->move_to(target, command_buffer, false);
+
+        vk::AccelerationStructureCreateInfoKHR create_info;
+        create_info.setType(vk::AccelerationStructureTypeKHR::eBottomLevel);
+        create_info.setBuffer(m_buffer->buffer());
+        create_info.setOffset(0);
+        create_info.setSize(m_size);
+        if (const vk::Result result = m_device.createAccelerationStructureKHR(&create_info, nullptr, &m_blas);
+            result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error("[Error] Failed to create relocated BLAS");
+        }
+
+        vk::CopyAccelerationStructureInfoKHR copy_info;
+        copy_info.setSrc(previous);
+        copy_info.setDst(m_blas);
+        copy_info.setMode(vk::CopyAccelerationStructureModeKHR::eClone);
+        command_buffer.copyAccelerationStructureKHR(&copy_info);
+
+        vk::AccelerationStructureDeviceAddressInfoKHR address_info;
+        address_info.setAccelerationStructure(m_blas);
+        m_address = m_device.getAccelerationStructureAddressKHR(&address_info);
     }
 }
\ No newline at end of file
@@ -7,10 +7,11 @@
 #include <Vulkan/Buffer.hpp>
 #include <Vulkan/CommandBuffers.hpp>
 #include <Vulkan/Context.hpp>
+#include <Vulkan/MemoryBlockAllocator.hpp>
 
 namespace sdvk
 {
-    class Blas
+    class Blas : public MemoryRelocatable
     {
     public:
         struct Builder
@@ -23,6 +24,12 @@ namespace sdvk
 
             Builder& with_index_buffer(std::shared_ptr<Buffer> const& index_buffer);
 
+            // First vertex and index of the geometry in buffers shared with other meshes.
+            Builder& with_offsets(uint32_t first_vertex, uint32_t first_index);
+
+            // Keeps a scratch buffer and allows record_build(), for geometry that is deformed every frame.
+            Builder& allow_update();
+
             Builder& with_name(std::string const& name);
 
             std::unique_ptr<Blas> create(CommandBuffers const& command_buffers, Context const& context);
@@ -31,11 +38,28 @@ namespace sdvk
             std::shared_ptr<sd::Geometry> _geometry;
             std::shared_ptr<Buffer> _vertex_buffer;
             std::shared_ptr<Buffer> _index_buffer;
+            uint32_t _first_vertex { 0 };
+            uint32_t _first_index { 0 };
+            bool _allow_update { false };
             std::string _name;
         };
 
         Blas(sd::Geometry const& geometry, Buffer const& vertex_buffer, Buffer const& index_buffer,
-             CommandBuffers const& command_buffers, Context const& context);
+             uint32_t first_vertex, uint32_t first_index, bool allow_update,
+             CommandBuffers const& command_buffers, Context const& context, std::string const& name = "BLAS");
+
+        ~Blas() override;
+
+        /**
+         * Records a build into the existing structure from vertices that moved, their count and the indices stay the same.
+         * eUpdate refits the boxes of the current hierarchy, which is fast but traces slower the further the vertices moved,
+         * eBuild starts over. Requires allow_update().
+         */
+        void record_build(vk::DeviceAddress vertex_data, vk::DeviceAddress index_data,
+                          vk::BuildAccelerationStructureModeKHR mode, const vk::CommandBuffer& command_buffer) const;
+
+        // Moves the storage buffer and clones the acceleration structure into it, the address changes.
+        void relocate(const MemoryAllocation& target, const vk::CommandBuffer& command_buffer) override;
 
         const vk::AccelerationStructureKHR& blas() const { return m_blas; }
 
@@ -47,5 +71,14 @@ namespace sdvk
         vk::AccelerationStructureKHR m_blas;
         vk::DeviceAddress            m_address;
         std::unique_ptr<Buffer>      m_buffer;
+        vk::DeviceSize               m_size { 0 };
+        uint32_t                     m_vertex_count { 0 };
+        uint32_t                     m_triangle_count { 0 };
+        vk::BuildAccelerationStructureFlagsKHR m_flags;
+        // Large enough for builds and updates, only kept by structures that allow updates.
+        std::unique_ptr<Buffer>      m_scratch;
+
+        vk::Device                                m_device;
+        std::shared_ptr<DeferredDestructionQueue> m_destruction_queue;
     };
 }
@@ -69,11 +69,8 @@ namespace sd::rt
 
             auto get_handle = [&](uint32_t i) { return handles.data() + i * handle_size; };
 
-            // Map buffer memory
-            void* sbt = nullptr;
-            {
-                auto result = context.device().mapMemory(m_buffer->memory(), 0, sbt_size, {}, &sbt);
-            }
+            // Buffer memory is persistently mapped by the block allocator
+            void* sbt = m_buffer->mapped();
 
             #pragma region Copy data
             uint8_t* p_sbt = reinterpret_cast<uint8_t*>(sbt);
@@ -98,9 +95,6 @@ namespace sd::rt
                 p_data += m_hit.stride;
             }
             #pragma endregion
-
-            // Release buffer memory
-            context.device().unmapMemory(m_buffer->memory());
         }
 
         const sdvk::Buffer& sbt() const { return *m_buffer; }
@@ -1,30 +1,60 @@
 #include "Tlas.hpp"
 
+#include <algorithm>
+#include <format>
+#include <Nebula/JobSystem.hpp>
+
 namespace sdvk
 {
 
-    Tlas::Tlas(const std::vector<sd::Object>& objects, CommandBuffers const& command_buffers, Context const& context)
-    : m_command_buffers(command_buffers), m_context(context)
+    Tlas::Tlas(const std::vector<sd::Object>& objects, const std::vector<vk::TransformMatrixKHR>& transforms,
+               CommandBuffers const& command_buffers, Context const& context, const std::string& name)
+    : m_name(name), m_command_buffers(command_buffers), m_context(context)
     {
-        create(objects);
+        create(objects, transforms);
     }
 
-    void Tlas::build_instance_data(const std::vector<sd::Object>& objects)
+    std::vector<vk::AccelerationStructureInstanceKHR> Tlas::pack_instances(const std::vector<sd::Object>& objects, const std::vector<vk::TransformMatrixKHR>& transforms)
     {
-        std::vector<vk::AccelerationStructureInstanceKHR> instances(m_instance_count);
-        for (int32_t i = 0; i < instances.size(); i++)
+        if (transforms.size() != objects.size())
         {
-            instances[i].setTransform(objects[i].transform.model3x4());
-            instances[i].setMask(objects[i].rt_mask);
-            instances[i].setInstanceShaderBindingTableRecordOffset(objects[i].rt_hit_group);
-            instances[i].setFlags(vk::GeometryInstanceFlagBitsKHR::eTriangleFacingCullDisable);
-            instances[i].setAccelerationStructureReference(objects[i].mesh->blas_address());
+            throw std::runtime_error(std::format("[Error] Tlas got {} transforms for {} objects", transforms.size(), objects.size()));
+        }
+
+        std::vector<vk::AccelerationStructureInstanceKHR> instances(objects.size());
+        Nebula::JobSystem::instance().parallel_for(static_cast<uint32_t>(instances.size()), s_pack_grain, [&](const uint32_t begin, const uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                instances[i] = pack_instance(objects[i], transforms[i]);
+            }
+        });
+        return instances;
+    }
+
+    vk::AccelerationStructureInstanceKHR Tlas::pack_instance(const sd::Object& object, const vk::TransformMatrixKHR& transform)
+    {
+        vk::AccelerationStructureInstanceKHR instance;
+        instance.setTransform(transform);
+        instance.setMask(object.rt_mask);
+        instance.setInstanceShaderBindingTableRecordOffset(object.rt_hit_group);
+        instance.setFlags(vk::GeometryInstanceFlagBitsKHR::eTriangleFacingCullDisable);
+        instance.setAccelerationStructureReference(object.mesh ? object.mesh->blas_address() : 0);
+        return instance;
+    }
+
+    void Tlas::build_instance_data(const std::vector<sd::Object>& objects, const std::vector<vk::TransformMatrixKHR>& transforms)
+    {
+        auto instances = pack_instances(objects, transforms);
+        for (const auto& [instance, blas] : m_instance_blas)
+        {
+            instances[instance].setAccelerationStructureReference(blas);
         }
 
         vk::DeviceSize instances_size = instances.size() * sizeof(vk::AccelerationStructureInstanceKHR);
-        auto staging_buf = Buffer::Builder().with_size(instances_size).create_staging(m_context);
+        auto staging_buf = Buffer::Builder().with_size(instances_size).with_name(std::format("{} - Instances", m_name)).create_staging(m_context);
 
         m_instance_data = Buffer::Builder()
+            .with_name(std::format("{} - Instances", m_name))
             .with_size(instances_size)
             .with_usage_flags(vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR)
             .with_memory_property_flags(vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostCoherent)
@@ -38,6 +68,8 @@ namespace sdvk
 
     void Tlas::build_top_level_as()
     {
+        m_update_staging.clear();
+
         vk::AccelerationStructureGeometryInstancesDataKHR geometry_instances_data;
         geometry_instances_data.setArrayOfPointers(false);
         geometry_instances_data.setData(m_instance_data->address());
@@ -56,9 +88,13 @@ namespace sdvk
         vk::AccelerationStructureBuildSizesInfoKHR build_sizes;
         m_context.device().getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eDevice, &build_info, &m_instance_count, &build_sizes);
 
+        // A rebuild replaces the structure, the previous one may still be traced by frames in flight.
+        m_context.destruction_queue()->destroy(m_tlas);
+
         m_buffer = Buffer::Builder()
             .with_size(build_sizes.accelerationStructureSize)
             .as_acceleration_structure_storage()
+            .with_name(m_name)
             .create(m_context);
 
         vk::AccelerationStructureCreateInfoKHR create_info;
@@ -68,29 +104,146 @@ namespace sdvk
         create_info.setType(vk::AccelerationStructureTypeKHR::eTopLevel);
         auto result = m_context.device().createAccelerationStructureKHR(&create_info, nullptr, &m_tlas);
 
-        auto scratch_buf = Buffer::Builder().with_size(build_sizes.buildScratchSize).as_storage_buffer().create(m_context);
+        // Kept alive for update(), which builds into the same acceleration structure.
+        m_scratch_buffer = Buffer::Builder()
+            .with_size(build_sizes.buildScratchSize)
+            .as_storage_buffer()
+            .with_name(std::format("{} - Scratch", m_name))
+            .create(m_context);
 
+        m_command_buffers.execute_single_time([&](const vk::CommandBuffer& cmd){
+            record_build(cmd);
+        });
+    }
+
+    void Tlas::record_build(const vk::CommandBuffer& command_buffer) const
+    {
+        vk::AccelerationStructureGeometryInstancesDataKHR geometry_instances_data;
+        geometry_instances_data.setArrayOfPointers(false);
+        geometry_instances_data.setData(m_instance_data->address());
+
+        vk::AccelerationStructureGeometryKHR geometry;
+        geometry.setGeometryType(vk::GeometryTypeKHR::eInstances);
+        geometry.setGeometry(geometry_instances_data);
+
+        vk::AccelerationStructureBuildGeometryInfoKHR build_info;
+        build_info.setType(vk::AccelerationStructureTypeKHR::eTopLevel);
+        build_info.setFlags(vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace);
+        build_info.setMode(vk::BuildAccelerationStructureModeKHR::eBuild);
+        build_info.setGeometryCount(1);
+        build_info.setPGeometries(&geometry);
         build_info.setDstAccelerationStructure(m_tlas);
-        build_info.setScratchData(scratch_buf->address());
+        build_info.setScratchData(m_scratch_buffer->address());
 
         vk::AccelerationStructureBuildRangeInfoKHR build_range_info;
         build_range_info.setPrimitiveCount(m_instance_count);
         const vk::AccelerationStructureBuildRangeInfoKHR* p_build_range_infos[1] = { &build_range_info };
 
-        m_command_buffers.execute_single_time([&](const vk::CommandBuffer& cmd){
-            cmd.buildAccelerationStructuresKHR(1, &build_info, p_build_range_infos);
+        command_buffer.buildAccelerationStructuresKHR(1, &build_info, p_build_range_infos);
+    }
+
+    void Tlas::update(const std::vector<sd::Object>& objects, const std::vector<vk::TransformMatrixKHR>& transforms,
+                      const std::vector<uint32_t>& changed, const uint32_t current_frame, const vk::CommandBuffer& command_buffer)
+    {
+        if (objects.size() != m_instance_count)
+        {
+            throw std::runtime_error(std::format("[Error] Tlas::update expects {} instances but got {}, use rebuild instead", m_instance_count, objects.size()));
+        }
+
+        if (changed.empty())
+        {
+            return;
+        }
+
+        if (current_frame >= m_update_staging.size())
+        {
+            m_update_staging.resize(current_frame + 1);
+        }
+        auto& staging = m_update_staging[current_frame];
+        if (!staging)
+        {
+            staging = Buffer::Builder()
+                .with_size(m_instance_data->size())
+                .with_name(std::format("{} - Instances {}", m_name, current_frame))
+                .create_staging(m_context);
+        }
+
+        // Changed instances are written to their place in the staging buffer, consecutive ones are copied as one region.
+        constexpr vk::DeviceSize instance_size = sizeof(vk::AccelerationStructureInstanceKHR);
+        auto* staged = static_cast<vk::AccelerationStructureInstanceKHR*>(staging->mapped());
+        Nebula::JobSystem::instance().parallel_for(static_cast<uint32_t>(changed.size()), s_pack_grain, [&](const uint32_t begin, const uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                staged[changed[i]] = pack_instance(objects[changed[i]], transforms[changed[i]]);
+            }
         });
+        for (const auto& [instance, blas] : m_instance_blas)
+        {
+            if (std::ranges::binary_search(changed, instance))
+            {
+                staged[instance].setAccelerationStructureReference(blas);
+            }
+        }
+
+        std::vector<vk::BufferCopy> regions;
+        for (const uint32_t index : changed)
+        {
+            const vk::DeviceSize offset = index * instance_size;
+            if (!regions.empty() && regions.back().srcOffset + regions.back().size == offset)
+            {
+                regions.back().size += instance_size;
+            }
+            else
+            {
+                regions.emplace_back(offset, offset, instance_size);
+            }
+        }
+
+        auto memory_barrier = [&command_buffer](vk::PipelineStageFlags2 src_stage, vk::AccessFlags2 src_access,
+                                                vk::PipelineStageFlags2 dst_stage, vk::AccessFlags2 dst_access) {
+            vk::MemoryBarrier2 barrier;
+            barrier.setSrcStageMask(src_stage);
+            barrier.setSrcAccessMask(src_access);
+            barrier.setDstStageMask(dst_stage);
+            barrier.setDstAccessMask(dst_access);
+
+            vk::DependencyInfo dependency_info;
+            dependency_info.setMemoryBarrierCount(1);
+            dependency_info.setPMemoryBarriers(&barrier);
+            command_buffer.pipelineBarrier2(&dependency_info);
+        };
+
+        // The previous frame may still be tracing against the structure and reading the instances.
+        const auto consumer_stages = vk::PipelineStageFlagBits2::eRayTracingShaderKHR
+                                   | vk::PipelineStageFlagBits2::eFragmentShader
+                                   | vk::PipelineStageFlagBits2::eComputeShader;
+
+        memory_barrier(consumer_stages | vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, {},
+                       vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite);
+        command_buffer.copyBuffer(staging->buffer(), m_instance_data->buffer(), regions);
+
+        memory_barrier(vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite,
+                       vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, vk::AccessFlagBits2::eAccelerationStructureReadKHR | vk::AccessFlagBits2::eAccelerationStructureWriteKHR);
+        record_build(command_buffer);
+
+        memory_barrier(vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, vk::AccessFlagBits2::eAccelerationStructureWriteKHR,
+                       consumer_stages, vk::AccessFlagBits2::eAccelerationStructureReadKHR);
     }
 
-    void Tlas::create(const std::vector<sd::Object>& objects)
+    void Tlas::create(const std::vector<sd::Object>& objects, const std::vector<vk::TransformMatrixKHR>& transforms)
     {
         m_instance_count = objects.size();
-        build_instance_data(objects);
+        build_instance_data(objects, transforms);
         build_top_level_as();
     }
 
-    void Tlas::rebuild(const std::vector<sd::Object>& objects)
+    void Tlas::rebuild(const std::vector<sd::Object>& objects, const std::vector<vk::TransformMatrixKHR>& transforms)
+    {
+        create(objects, transforms);
+    }
+
+    Tlas::~Tlas()
     {
-        create(objects);
+        m_context.destruction_queue()->destroy(m_tlas);
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <vulkan/vulkan.hpp>
 #include <Scene/Object.hpp>
 #include <Vulkan/Buffer.hpp>
@@ -19,9 +20,10 @@ namespace sdvk
                 return *this;
             }
 
-            std::unique_ptr<Tlas> create(std::vector<sd::Object> const& objects, CommandBuffers const& command_buffers, Context const& context)
+            std::unique_ptr<Tlas> create(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms,
+                                         CommandBuffers const& command_buffers, Context const& context)
             {
-                auto result = std::make_unique<Tlas>(objects, command_buffers, context);
+                auto result = std::make_unique<Tlas>(objects, transforms, command_buffers, context, _name);
 
                 if (context.is_debug())
                 {
@@ -36,27 +38,55 @@ namespace sdvk
             }
 
         private:
-            std::string _name;
+            std::string _name { "TLAS" };
         };
 
-        Tlas(std::vector<sd::Object> const& objects, CommandBuffers const& command_buffers, Context const& context);
+        // transforms holds the evaluated 3x4 matrix of each object, see sd::SceneStore.
+        Tlas(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms,
+             CommandBuffers const& command_buffers, Context const& context, std::string const& name = "TLAS");
 
-        void rebuild(std::vector<sd::Object> const& objects);
+        ~Tlas();
+
+        void rebuild(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms);
+
+        // Records a rebuild into the existing acceleration structure, so the handle in descriptor sets stays valid.
+        // Only the changed instances (ascending indices) are uploaded, each frame slot gets its own staging buffer for them.
+        // The instance count must not change.
+        void update(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms,
+                    std::vector<uint32_t> const& changed, uint32_t current_frame, vk::CommandBuffer const& command_buffer);
+
+        // Instance that does not use the BLAS of its mesh, e.g. a deformed object. Written the next time the instance is packed.
+        void set_instance_blas(uint32_t instance, vk::DeviceAddress blas) { m_instance_blas[instance] = blas; }
 
         const vk::AccelerationStructureKHR& tlas() const { return m_tlas; }
 
+        // Objects without a mesh get a null BLAS reference, which makes the instance inactive.
+        static std::vector<vk::AccelerationStructureInstanceKHR> pack_instances(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms);
+
+        static vk::AccelerationStructureInstanceKHR pack_instance(sd::Object const& object, vk::TransformMatrixKHR const& transform);
+
+        // Instances packed per job, fewer are packed on the calling thread.
+        static constexpr uint32_t s_pack_grain = 4096;
+
     private:
-        void create(std::vector<sd::Object> const& objects);
+        void create(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms);
 
-        void build_instance_data(std::vector<sd::Object> const& objects);
+        void build_instance_data(std::vector<sd::Object> const& objects, std::vector<vk::TransformMatrixKHR> const& transforms);
 
         void build_top_level_as();
 
+        void record_build(vk::CommandBuffer const& command_buffer) const;
+
     private:
         vk::AccelerationStructureKHR m_tlas;
         std::unique_ptr<Buffer>      m_buffer;
         std::unique_ptr<Buffer>      m_instance_data;
+        std::unique_ptr<Buffer>      m_scratch_buffer;
         uint32_t                     m_instance_count { 0 };
+        std::string                  m_name;
+
+        std::vector<std::unique_ptr<Buffer>> m_update_staging;
+        std::map<uint32_t, vk::DeviceAddress> m_instance_blas;
 
         const CommandBuffers& m_command_buffers;
         const Context& m_context;
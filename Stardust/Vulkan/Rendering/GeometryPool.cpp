@@ -0,0 +1,223 @@
+#include "GeometryPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <Vulkan/Buffer.hpp>
+#include <Vulkan/CommandBuffers.hpp>
+#include <Vulkan/Context.hpp>
+#include <Vulkan/DeferredDestructionQueue.hpp>
+
+namespace sdvk
+{
+    GeometryPool::GeometryPool(const Context& context)
+    : m_context(context)
+    {
+    }
+
+    GeometryPool::~GeometryPool() = default;
+
+    GeometryRange GeometryPool::allocate(const sd::Geometry& geometry, const CommandBuffers& command_buffers)
+    {
+        if (!m_context.memory_manager()->accepts_uploads())
+        {
+            throw std::runtime_error("[Error] Upload of mesh geometry refused, device memory is over budget");
+        }
+
+        GeometryRange range;
+        range.vertex_count = geometry.vertex_count();
+        range.index_count = geometry.index_count();
+
+        std::shared_ptr<Buffer> vertex_buffer, index_buffer;
+        {
+            std::lock_guard lock(m_mutex);
+
+            bool found = false;
+            for (uint32_t i = 0; i < m_pages.size() && !found; i++)
+            {
+                auto& page = m_pages[i];
+                if (!page || !_take(page->free_vertices, range.vertex_count, range.first_vertex))
+                {
+                    continue;
+                }
+                if (!_take(page->free_indices, range.index_count, range.first_index))
+                {
+                    _give_back(page->free_vertices, range.first_vertex, range.vertex_count);
+                    continue;
+                }
+                range.page = i;
+                found = true;
+            }
+
+            if (!found)
+            {
+                range.page = _create_page(range.vertex_count, range.index_count);
+                auto& page = *m_pages[range.page];
+                _take(page.free_vertices, range.vertex_count, range.first_vertex);
+                _take(page.free_indices, range.index_count, range.first_index);
+            }
+
+            auto& page = *m_pages[range.page];
+            page.range_count++;
+            vertex_buffer = page.vertex_buffer;
+            index_buffer = page.index_buffer;
+        }
+
+        const vk::DeviceSize vertex_bytes = sizeof(sd::VertexData) * range.vertex_count;
+        const vk::DeviceSize index_bytes = sizeof(uint32_t) * range.index_count;
+        if (vertex_bytes + index_bytes == 0)
+        {
+            return range;
+        }
+
+        auto staging = Buffer::Builder()
+            .with_size(vertex_bytes + index_bytes)
+            .with_name("[GeometryPool] Staging")
+            .create_staging(m_context);
+        auto* data = static_cast<uint8_t*>(staging->mapped());
+        std::memcpy(data, geometry.vertices().data(), vertex_bytes);
+        std::memcpy(data + vertex_bytes, geometry.indices().data(), index_bytes);
+
+        command_buffers.execute_single_time([&](const vk::CommandBuffer& cmd) {
+            if (vertex_bytes > 0)
+            {
+                const vk::BufferCopy region(0, range.first_vertex * sizeof(sd::VertexData), vertex_bytes);
+                cmd.copyBuffer(staging->buffer(), vertex_buffer->buffer(), 1, &region);
+            }
+            if (index_bytes > 0)
+            {
+                const vk::BufferCopy region(vertex_bytes, range.first_index * sizeof(uint32_t), index_bytes);
+                cmd.copyBuffer(staging->buffer(), index_buffer->buffer(), 1, &region);
+            }
+        });
+
+        return range;
+    }
+
+    void GeometryPool::release(const GeometryRange& range)
+    {
+        // Frames in flight may still draw the range, a mesh uploaded into it now would overwrite their geometry.
+        m_context.destruction_queue()->push([pool = shared_from_this(), range]() {
+            pool->_free(range);
+        });
+    }
+
+    const std::shared_ptr<Buffer>& GeometryPool::vertex_buffer(const uint32_t page) const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_pages[page]->vertex_buffer;
+    }
+
+    const std::shared_ptr<Buffer>& GeometryPool::index_buffer(const uint32_t page) const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_pages[page]->index_buffer;
+    }
+
+    uint32_t GeometryPool::page_count() const
+    {
+        std::lock_guard lock(m_mutex);
+        return static_cast<uint32_t>(std::ranges::count_if(m_pages, [](const auto& page) { return page != nullptr; }));
+    }
+
+    uint32_t GeometryPool::_create_page(const uint32_t vertex_count, const uint32_t index_count)
+    {
+        const uint32_t page_vertices = std::max(vertex_count, s_page_vertices);
+        const uint32_t page_indices = std::max(index_count, s_page_indices);
+
+        auto it = std::ranges::find(m_pages, nullptr);
+        const auto index = static_cast<uint32_t>(it - m_pages.begin());
+        if (it == m_pages.end())
+        {
+            m_pages.emplace_back();
+        }
+
+        auto page = std::make_unique<Page>();
+        page->vertex_buffer = Buffer::Builder()
+            .with_name(std::format("[GeometryPool] Page {} - Vertex Buffer", index))
+            .with_size(sizeof(sd::VertexData) * page_vertices)
+            .as_vertex_buffer()
+            .create(m_context);
+
+        page->index_buffer = Buffer::Builder()
+            .with_name(std::format("[GeometryPool] Page {} - Index Buffer", index))
+            .with_size(sizeof(uint32_t) * page_indices)
+            .as_index_buffer()
+            .create(m_context);
+
+        page->vertex_buffer->make_relocatable();
+        page->index_buffer->make_relocatable();
+
+        page->free_vertices.insert({ 0, page_vertices });
+        page->free_indices.insert({ 0, page_indices });
+
+        m_pages[index] = std::move(page);
+        return index;
+    }
+
+    void GeometryPool::_free(const GeometryRange& range)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto& page = m_pages[range.page];
+        _give_back(page->free_vertices, range.first_vertex, range.vertex_count);
+        _give_back(page->free_indices, range.first_index, range.index_count);
+
+        // Buffer destruction is deferred as well, nothing draws from an empty page.
+        if (--page->range_count == 0)
+        {
+            page.reset();
+        }
+    }
+
+    bool GeometryPool::_take(std::map<uint32_t, uint32_t>& free_ranges, const uint32_t count, uint32_t& first)
+    {
+        if (count == 0)
+        {
+            first = 0;
+            return true;
+        }
+
+        for (auto it = free_ranges.begin(); it != free_ranges.end(); ++it)
+        {
+            const auto [offset, size] = *it;
+            if (size < count)
+            {
+                continue;
+            }
+
+            free_ranges.erase(it);
+            if (size > count)
+            {
+                free_ranges.insert({ offset + count, size - count });
+            }
+            first = offset;
+            return true;
+        }
+        return false;
+    }
+
+    void GeometryPool::_give_back(std::map<uint32_t, uint32_t>& free_ranges, const uint32_t first, const uint32_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        auto [range, _] = free_ranges.insert({ first, count });
+        if (const auto next = std::next(range); next != free_ranges.end() && range->first + range->second == next->first)
+        {
+            range->second += next->second;
+            free_ranges.erase(next);
+        }
+        if (range != free_ranges.begin())
+        {
+            if (const auto previous = std::prev(range); previous->first + previous->second == range->first)
+            {
+                previous->second += range->second;
+                free_ranges.erase(range);
+            }
+        }
+    }
+}
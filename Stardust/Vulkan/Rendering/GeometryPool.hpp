@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <Resources/Geometry.hpp>
+
+namespace sdvk
+{
+    class Buffer;
+    class CommandBuffers;
+    class Context;
+
+    // Vertices and indices of one mesh inside a page of the pool.
+    struct GeometryRange
+    {
+        uint32_t page { 0 };
+        uint32_t first_vertex { 0 };
+        uint32_t vertex_count { 0 };
+        uint32_t first_index { 0 };
+        uint32_t index_count { 0 };
+    };
+
+    /**
+     * Packs the geometry of many meshes into a few large device local vertex and index buffers, so draws of different
+     * meshes can share one binding and select their geometry with the first index and vertex offset.
+     * Geometry larger than a page gets a page of its own. Ranges are freed once the frames in flight that may read them finished.
+     */
+    class GeometryPool : public std::enable_shared_from_this<GeometryPool>
+    {
+    public:
+        explicit GeometryPool(const Context& context);
+
+        ~GeometryPool();
+
+        GeometryPool(const GeometryPool&) = delete;
+        GeometryPool& operator=(const GeometryPool&) = delete;
+
+        // Uploads the vertices and indices into the first page with room for both, creates a page if none has.
+        GeometryRange allocate(const sd::Geometry& geometry, const CommandBuffers& command_buffers);
+
+        // The range may be reused after the frames that are in flight finished, empty pages are destroyed then.
+        void release(const GeometryRange& range);
+
+        const std::shared_ptr<Buffer>& vertex_buffer(uint32_t page) const;
+
+        const std::shared_ptr<Buffer>& index_buffer(uint32_t page) const;
+
+        // Pages with at least one range.
+        uint32_t page_count() const;
+
+        static constexpr uint32_t s_page_vertices = 1 << 20;
+        static constexpr uint32_t s_page_indices = 1 << 22;
+
+    private:
+        struct Page
+        {
+            std::shared_ptr<Buffer> vertex_buffer;
+            std::shared_ptr<Buffer> index_buffer;
+            // Keyed by first element, free ranges are merged with their neighbours on release.
+            std::map<uint32_t, uint32_t> free_vertices;
+            std::map<uint32_t, uint32_t> free_indices;
+            uint32_t range_count { 0 };
+        };
+
+        uint32_t _create_page(uint32_t vertex_count, uint32_t index_count);
+
+        void _free(const GeometryRange& range);
+
+        // First fit, returns false if no free range is large enough.
+        static bool _take(std::map<uint32_t, uint32_t>& free_ranges, uint32_t count, uint32_t& first);
+
+        static void _give_back(std::map<uint32_t, uint32_t>& free_ranges, uint32_t first, uint32_t count);
+
+        // Released pages stay as empty slots, so the page index of live ranges does not change.
+        std::vector<std::unique_ptr<Page>> m_pages;
+        mutable std::mutex                 m_mutex;
+
+        const Context& m_context;
+    };
+}
@@ -5,45 +5,125 @@ namespace sdvk
 {
     Mesh::Mesh(sd::Geometry* p_geometry, const CommandBuffers& command_buffers, const Context& context,
                const std::string& name, uint32_t meshlet_max_vertices, uint32_t meshlet_max_indices)
-    : m_geometry(p_geometry), m_name(name)
+    : Mesh(p_geometry, create_meshlets(*p_geometry, meshlet_max_vertices, meshlet_max_indices), command_buffers, context, name)
     {
-        m_vertex_buffer = Buffer::Builder()
-            .with_name(std::format("[Mesh] {} - Vertex Buffer", name))
-            .with_size(sizeof(sd::VertexData) * m_geometry->vertices().size())
-            .as_vertex_buffer()
-            .create_with_data(m_geometry->vertices().data(), command_buffers, context);
+    }
 
-        m_index_buffer = Buffer::Builder()
-            .with_name(std::format("[Mesh] {} - Index Buffer", name))
-            .with_size(sizeof(uint32_t) * m_geometry->indices().size())
-            .as_index_buffer()
-            .create_with_data(m_geometry->indices().data(), command_buffers, context);
+    Mesh::Mesh(sd::Geometry* p_geometry, std::vector<Meshlet>&& meshlets, const CommandBuffers& command_buffers, const Context& context,
+               const std::string& name)
+    : Mesh(p_geometry, std::move(meshlets), nullptr, command_buffers, context, name)
+    {
+    }
+
+    Mesh::Mesh(sd::Geometry* p_geometry, std::vector<Meshlet>&& meshlets, const std::shared_ptr<GeometryPool>& geometry_pool,
+               const CommandBuffers& command_buffers, const Context& context, const std::string& name, const bool with_blas)
+    : m_name(name), m_meshlets(std::move(meshlets)), m_geometry(p_geometry), m_geometry_pool(geometry_pool)
+    {
+        m_bounds = sd::Aabb::from_vertices(m_geometry->vertices());
 
-        if (context.is_raytracing_capable())
+        _create_buffers(command_buffers, context);
+
+        if (with_blas)
         {
-            m_blas = Blas::Builder()
-                .with_geometry(m_geometry)
-                .with_vertex_buffer(m_vertex_buffer)
-                .with_index_buffer(m_index_buffer)
-                .with_name(std::format("[Mesh] {} - BLAS", name))
-                .create(command_buffers, context);
+            build_blas(command_buffers, context);
         }
 
-        create_meshlets(meshlet_max_vertices, meshlet_max_indices);
         m_meshlets_size = m_meshlets.size();
         m_meshlet_buffer = Buffer::Builder()
             .with_size(sizeof(Meshlet) * m_meshlets.size())
             .as_storage_buffer()
             .with_name(std::format("[Mesh] {} - Meshlets", name))
             .create_with_data(m_meshlets.data(), command_buffers, context);
+        m_meshlet_buffer->make_relocatable();
+    }
+
+    Mesh::~Mesh()
+    {
+        _release_range();
+    }
+
+    void Mesh::evict(const Context& context)
+    {
+        if (m_evicted)
+        {
+            return;
+        }
+
+        static constexpr auto host_memory = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+        auto vertex_buffer = Buffer::Builder()
+            .with_name(std::format("[Mesh] {} - Vertex Buffer (Evicted)", m_name))
+            .with_size(sizeof(sd::VertexData) * m_geometry->vertices().size())
+            .as_vertex_buffer()
+            .with_memory_property_flags(host_memory)
+            .create(context);
+        vertex_buffer->set_data(m_geometry->vertices().data(), context.device());
+
+        auto index_buffer = Buffer::Builder()
+            .with_name(std::format("[Mesh] {} - Index Buffer (Evicted)", m_name))
+            .with_size(sizeof(uint32_t) * m_geometry->indices().size())
+            .as_index_buffer()
+            .with_memory_property_flags(host_memory)
+            .create(context);
+        index_buffer->set_data(m_geometry->indices().data(), context.device());
+
+        vertex_buffer->make_relocatable();
+        index_buffer->make_relocatable();
+
+        m_vertex_buffer = std::move(vertex_buffer);
+        m_index_buffer = std::move(index_buffer);
+        _release_range();
+        m_first_vertex = 0;
+        m_first_index = 0;
+        m_evicted = true;
+    }
+
+    void Mesh::make_resident(const CommandBuffers& command_buffers, const Context& context)
+    {
+        if (!m_evicted)
+        {
+            return;
+        }
+
+        _create_buffers(command_buffers, context);
+        m_evicted = false;
     }
 
-    void Mesh::draw(const vk::CommandBuffer& command_buffer) const
+    void Mesh::build_blas(const CommandBuffers& command_buffers, const Context& context)
+    {
+        if (m_blas || !context.is_raytracing_capable())
+        {
+            return;
+        }
+
+        m_blas = Blas::Builder()
+            .with_geometry(m_geometry)
+            .with_vertex_buffer(m_vertex_buffer)
+            .with_index_buffer(m_index_buffer)
+            .with_offsets(m_first_vertex, m_first_index)
+            .with_name(std::format("[Mesh] {} - BLAS", m_name))
+            .create(command_buffers, context);
+    }
+
+    void Mesh::bind(const vk::CommandBuffer& command_buffer) const
     {
         static const std::vector<vk::DeviceSize> offsets = { 0 };
         command_buffer.bindVertexBuffers(0, 1, &m_vertex_buffer->buffer(), offsets.data());
         command_buffer.bindIndexBuffer(m_index_buffer->buffer(), 0, vk::IndexType::eUint32);
-        command_buffer.drawIndexed(m_geometry->indices().size(), 1, 0, 0, 0);
+    }
+
+    void Mesh::draw(const vk::CommandBuffer& command_buffer, const uint32_t instance_count, const uint32_t first_instance) const
+    {
+        command_buffer.drawIndexed(m_geometry->indices().size(), instance_count, m_first_index, static_cast<int32_t>(m_first_vertex), first_instance);
+    }
+
+    void Mesh::draw_indirect_count(const vk::CommandBuffer& command_buffer,
+                                   const Buffer& commands, const vk::DeviceSize offset,
+                                   const Buffer& count_buffer, const vk::DeviceSize count_offset,
+                                   const uint32_t max_draw_count) const
+    {
+        command_buffer.drawIndexedIndirectCountKHR(commands.buffer(), offset, count_buffer.buffer(), count_offset,
+                                                   max_draw_count, sizeof(vk::DrawIndexedIndirectCommand));
     }
 
     void Mesh::draw_mesh_tasks(const vk::CommandBuffer& command_buffer) const
@@ -51,9 +131,45 @@ namespace sdvk
         command_buffer.drawMeshTasksEXT(m_meshlets_size, 1, 1);
     }
 
-    void Mesh::create_meshlets(const uint32_t max_vertices, const uint32_t max_indices)
+    void Mesh::_create_buffers(const CommandBuffers& command_buffers, const Context& context)
+    {
+        if (m_geometry_pool)
+        {
+            m_range = m_geometry_pool->allocate(*m_geometry, command_buffers);
+            m_vertex_buffer = m_geometry_pool->vertex_buffer(m_range->page);
+            m_index_buffer = m_geometry_pool->index_buffer(m_range->page);
+            m_first_vertex = m_range->first_vertex;
+            m_first_index = m_range->first_index;
+            return;
+        }
+
+        m_vertex_buffer = Buffer::Builder()
+            .with_name(std::format("[Mesh] {} - Vertex Buffer", m_name))
+            .with_size(sizeof(sd::VertexData) * m_geometry->vertices().size())
+            .as_vertex_buffer()
+            .create_with_data(m_geometry->vertices().data(), command_buffers, context);
+
+        m_index_buffer = Buffer::Builder()
+            .with_name(std::format("[Mesh] {} - Index Buffer", m_name))
+            .with_size(sizeof(uint32_t) * m_geometry->indices().size())
+            .as_index_buffer()
+            .create_with_data(m_geometry->indices().data(), command_buffers, context);
+
+        m_vertex_buffer->make_relocatable();
+        m_index_buffer->make_relocatable();
+    }
+
+    void Mesh::_release_range()
+    {
+        if (m_range)
+        {
+            m_geometry_pool->release(*m_range);
+            m_range.reset();
+        }
+    }
+
+    std::vector<Meshlet> Mesh::create_meshlets(const sd::Geometry& geom, const uint32_t max_vertices, const uint32_t max_indices)
     {
-        const auto& geom = *m_geometry;
         const auto& indices = geom.indices();
 
         std::vector<Meshlet> meshlets;
@@ -111,6 +227,6 @@ namespace sdvk
             meshlets.push_back(meshlet);
         }
 
-        m_meshlets = meshlets;
+        return meshlets;
     }
 }
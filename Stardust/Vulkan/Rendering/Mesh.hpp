@@ -1,9 +1,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <Resources/Aabb.hpp>
 #include <Resources/Geometry.hpp>
 #include <Vulkan/Buffer.hpp>
 #include <Vulkan/Raytracing/Blas.hpp>
+#include <Vulkan/Rendering/GeometryPool.hpp>
 
 namespace sdvk
 {
@@ -25,14 +28,80 @@ namespace sdvk
              uint32_t meshlet_max_vertices = 64,
              uint32_t meshlet_max_indices = 126);
 
-        void draw(const vk::CommandBuffer& command_buffer) const;
+        // Takes meshlets built beforehand with create_meshlets(), e.g. on the job system.
+        Mesh(sd::Geometry* p_geometry,
+             std::vector<Meshlet>&& meshlets,
+             const CommandBuffers& command_buffers,
+             const Context& context,
+             const std::string& name = "");
+
+        /**
+         * Vertices and indices are uploaded into the pool and share their buffers with the other meshes of the page.
+         * Without with_blas the BLAS is left to a later build_blas(), e.g. to spread the builds of streamed meshes over frames.
+         */
+        Mesh(sd::Geometry* p_geometry,
+             std::vector<Meshlet>&& meshlets,
+             const std::shared_ptr<GeometryPool>& geometry_pool,
+             const CommandBuffers& command_buffers,
+             const Context& context,
+             const std::string& name = "",
+             bool with_blas = true);
+
+        ~Mesh();
+
+        Mesh(const Mesh&) = delete;
+        Mesh& operator=(const Mesh&) = delete;
+
+        void bind(const vk::CommandBuffer& command_buffer) const;
+
+        // Meshes sharing buffers can be drawn one after another with a single bind().
+        bool shares_buffers(const Mesh& other) const
+        {
+            return m_vertex_buffer == other.m_vertex_buffer && m_index_buffer == other.m_index_buffer;
+        }
+
+        // The buffers of this mesh, or of one sharing them, have to be bound.
+        void draw(const vk::CommandBuffer& command_buffer, uint32_t instance_count = 1, uint32_t first_instance = 0) const;
+
+        /**
+         * Up to max_draw_count vk::DrawIndexedIndirectCommands from commands, the draw count is read from count_buffer.
+         * The commands may draw any mesh sharing the bound buffers through their first index and vertex offset.
+         */
+        void draw_indirect_count(const vk::CommandBuffer& command_buffer,
+                                 const Buffer& commands, vk::DeviceSize offset,
+                                 const Buffer& count_buffer, vk::DeviceSize count_offset,
+                                 uint32_t max_draw_count) const;
 
         void draw_mesh_tasks(const vk::CommandBuffer& command_buffer) const;
 
+        /**
+         * Moves the vertex and index buffers to host visible memory, they are re-created from the geometry instead of read back.
+         * Pooled geometry gets buffers of its own and its range is released, make_resident() allocates a new one.
+         * Buffer addresses change, the GPU scene has to be uploaded again. The BLAS keeps working as it only
+         * references the vertex data during its build.
+         */
+        void evict(const Context& context);
+
+        void make_resident(const CommandBuffers& command_buffers, const Context& context);
+
+        bool is_evicted() const { return m_evicted; }
+
+        // Vertex, index and meshlet buffers may be moved by defragmentation, their addresses are not stable across frames.
+
         const Buffer& vertex_buffer() const { return *m_vertex_buffer; }
 
         const Buffer& index_buffer() const { return *m_index_buffer; }
 
+        // Position of the geometry in the vertex and index buffers, 0 unless they are shared.
+        uint32_t first_vertex() const { return m_first_vertex; }
+
+        uint32_t first_index() const { return m_first_index; }
+
+        // Addresses of the first vertex and index of this mesh.
+        vk::DeviceAddress vertex_address() const { return m_vertex_buffer->address() + m_first_vertex * sizeof(sd::VertexData); }
+
+        vk::DeviceAddress index_address() const { return m_index_buffer->address() + m_first_index * sizeof(uint32_t); }
+
         const Buffer& meshlet_buffer() const { return *m_meshlet_buffer; }
 
         const std::vector<Meshlet>& meshlet_data() const { return m_meshlets; }
@@ -41,18 +110,39 @@ namespace sdvk
 
         const std::string& name() const { return m_name; }
 
-        const vk::DeviceAddress& blas_address() const { return m_blas->address(); }
+        // Object space bounds of the vertices.
+        const sd::Aabb& bounds() const { return m_bounds; }
+
+        // Does nothing without ray tracing or if the mesh already has its BLAS.
+        void build_blas(const CommandBuffers& command_buffers, const Context& context);
+
+        bool has_blas() const { return m_blas != nullptr; }
+
+        // 0 until the BLAS is built, TLAS instances referencing it are inactive.
+        vk::DeviceAddress blas_address() const { return m_blas ? m_blas->address() : 0; }
+
+        // Greedily packs consecutive triangles into meshlets, requires no Vulkan objects and may run on any thread.
+        static std::vector<Meshlet> create_meshlets(const sd::Geometry& geometry, uint32_t max_vertices = 64, uint32_t max_indices = 126);
 
     private:
-        void create_meshlets(uint32_t max_vertices = 64, uint32_t max_indices = 126);
+        // Device local vertex and index buffers, from the pool if the mesh has one.
+        void _create_buffers(const CommandBuffers& command_buffers, const Context& context);
+
+        void _release_range();
 
         std::string                   m_name;
         uint32_t                      m_meshlets_size;
         std::vector<Meshlet>          m_meshlets;
         std::shared_ptr<sd::Geometry> m_geometry;
+        sd::Aabb                      m_bounds;
         std::shared_ptr<Buffer>       m_vertex_buffer;
         std::shared_ptr<Buffer>       m_index_buffer;
         std::shared_ptr<Buffer>       m_meshlet_buffer;
+        std::shared_ptr<GeometryPool> m_geometry_pool;
+        std::optional<GeometryRange>  m_range;
+        uint32_t                      m_first_vertex { 0 };
+        uint32_t                      m_first_index { 0 };
         std::unique_ptr<Blas>         m_blas;
+        bool                          m_evicted { false };
     };
 }
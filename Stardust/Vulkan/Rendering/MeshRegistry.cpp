@@ -0,0 +1,105 @@
+#include "MeshRegistry.hpp"
+
+#include <cstring>
+
+namespace sdvk
+{
+    MeshRegistry::MeshRegistry(const CommandBuffers& command_buffers, const Context& context)
+    : m_geometry_pool(std::make_shared<GeometryPool>(context))
+    , m_command_buffers(command_buffers)
+    , m_context(context)
+    {
+    }
+
+    std::shared_ptr<Mesh> MeshRegistry::create(sd::Geometry* p_geometry, const std::string& name,
+                                               const uint32_t meshlet_max_vertices, const uint32_t meshlet_max_indices)
+    {
+        std::unique_ptr<sd::Geometry> geometry(p_geometry);
+        const uint64_t hash = content_hash(*geometry);
+        if (auto mesh = _find(*geometry, hash, meshlet_max_vertices, meshlet_max_indices))
+        {
+            return mesh;
+        }
+
+        auto meshlets = Mesh::create_meshlets(*geometry, meshlet_max_vertices, meshlet_max_indices);
+        auto mesh = std::make_shared<Mesh>(geometry.release(), std::move(meshlets), m_geometry_pool, m_command_buffers, m_context, name);
+        m_meshes.insert({ hash, { mesh, meshlet_max_vertices, meshlet_max_indices } });
+        return mesh;
+    }
+
+    std::shared_ptr<Mesh> MeshRegistry::create(sd::Geometry* p_geometry, std::vector<Meshlet>&& meshlets, const std::string& name,
+                                               const bool with_blas)
+    {
+        static constexpr uint32_t max_vertices = 64;
+        static constexpr uint32_t max_indices = 126;
+
+        std::unique_ptr<sd::Geometry> geometry(p_geometry);
+        const uint64_t hash = content_hash(*geometry);
+        if (auto mesh = _find(*geometry, hash, max_vertices, max_indices))
+        {
+            return mesh;
+        }
+
+        auto mesh = std::make_shared<Mesh>(geometry.release(), std::move(meshlets), m_geometry_pool, m_command_buffers, m_context, name, with_blas);
+        m_meshes.insert({ hash, { mesh, max_vertices, max_indices } });
+        return mesh;
+    }
+
+    uint32_t MeshRegistry::mesh_count() const
+    {
+        uint32_t result = 0;
+        for (const auto& [hash, entry] : m_meshes)
+        {
+            result += !entry.mesh.expired();
+        }
+        return result;
+    }
+
+    uint64_t MeshRegistry::content_hash(const sd::Geometry& geometry)
+    {
+        static constexpr uint64_t offset_basis = 0xcbf29ce484222325ull;
+        static constexpr uint64_t prime = 0x100000001b3ull;
+
+        uint64_t hash = offset_basis;
+        auto append = [&hash](const void* data, const size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                hash = (hash ^ bytes[i]) * prime;
+            }
+        };
+
+        // The counts separate the vertex bytes from the index bytes.
+        const uint32_t counts[2] = { geometry.vertex_count(), geometry.index_count() };
+        append(counts, sizeof(counts));
+        append(geometry.vertices().data(), geometry.vertices().size() * sizeof(sd::VertexData));
+        append(geometry.indices().data(), geometry.indices().size() * sizeof(uint32_t));
+        return hash;
+    }
+
+    std::shared_ptr<Mesh> MeshRegistry::_find(const sd::Geometry& geometry, const uint64_t hash,
+                                              const uint32_t meshlet_max_vertices, const uint32_t meshlet_max_indices)
+    {
+        auto [begin, end] = m_meshes.equal_range(hash);
+        for (auto it = begin; it != end;)
+        {
+            auto mesh = it->second.mesh.lock();
+            if (!mesh)
+            {
+                it = m_meshes.erase(it);
+                continue;
+            }
+
+            const auto& other = mesh->geometry();
+            if (it->second.meshlet_max_vertices == meshlet_max_vertices && it->second.meshlet_max_indices == meshlet_max_indices
+                && other.vertices().size() == geometry.vertices().size() && other.indices() == geometry.indices()
+                && std::memcmp(other.vertices().data(), geometry.vertices().data(), geometry.vertices().size() * sizeof(sd::VertexData)) == 0)
+            {
+                m_duplicate_count++;
+                return mesh;
+            }
+            ++it;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Resources/Geometry.hpp>
+#include <Vulkan/Rendering/GeometryPool.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+
+namespace sdvk
+{
+    class CommandBuffers;
+    class Context;
+
+    /**
+     * Creates meshes with their geometry in a shared GeometryPool and returns the existing mesh for geometry that was
+     * registered before. Vertices and indices are hashed on creation, a matching hash is confirmed by comparing the content.
+     * The registry does not keep meshes alive, a mesh released by all of its users is created again on the next request.
+     */
+    class MeshRegistry
+    {
+    public:
+        MeshRegistry(const CommandBuffers& command_buffers, const Context& context);
+
+        // Takes ownership of the geometry, it is deleted if an equal mesh with the same meshlet limits already exists.
+        std::shared_ptr<Mesh> create(sd::Geometry* p_geometry, const std::string& name = "",
+                                     uint32_t meshlet_max_vertices = 64, uint32_t meshlet_max_indices = 126);
+
+        /**
+         * Takes meshlets built beforehand by Mesh::create_meshlets() with the default limits, e.g. on the job system.
+         * Without with_blas a new mesh is created without its BLAS, an existing one is returned as it is.
+         */
+        std::shared_ptr<Mesh> create(sd::Geometry* p_geometry, std::vector<Meshlet>&& meshlets, const std::string& name = "",
+                                     bool with_blas = true);
+
+        // Registered meshes that are still alive.
+        uint32_t mesh_count() const;
+
+        // Creation requests answered with an existing mesh.
+        uint32_t duplicate_count() const { return m_duplicate_count; }
+
+        const GeometryPool& geometry_pool() const { return *m_geometry_pool; }
+
+        // 64-bit FNV-1a of the vertex and index data.
+        static uint64_t content_hash(const sd::Geometry& geometry);
+
+    private:
+        struct Entry
+        {
+            std::weak_ptr<Mesh> mesh;
+            uint32_t            meshlet_max_vertices { 0 };
+            uint32_t            meshlet_max_indices { 0 };
+        };
+
+        std::shared_ptr<Mesh> _find(const sd::Geometry& geometry, uint64_t hash, uint32_t meshlet_max_vertices, uint32_t meshlet_max_indices);
+
+        std::unordered_multimap<uint64_t, Entry> m_meshes;
+        std::shared_ptr<GeometryPool>            m_geometry_pool;
+        uint32_t                                 m_duplicate_count { 0 };
+
+        const CommandBuffers& m_command_buffers;
+        const Context&        m_context;
+    };
+}
@@ -66,6 +66,13 @@ namespace sdvk
         return *this;
     }
 
+    PipelineBuilder& PipelineBuilder::add_shader(const std::string& shader_src, vk::ShaderStageFlagBits shader_stage,
+                                                 const SpecializationConstants& specialization_constants)
+    {
+        shaders.push_back(std::make_unique<ShaderModule>(shader_src, shader_stage, _context.device(), specialization_constants));
+        return *this;
+    }
+
     std::tuple<vk::Pipeline, vk::PipelineLayout> PipelineBuilder::create_graphics_pipeline(const vk::RenderPass& render_pass)
     {
         if (!pipeline.pipeline_layout)
@@ -4,6 +4,7 @@
 #include <vulkan/vulkan.hpp>
 #include <Vulkan/Context.hpp>
 #include <Vulkan/Rendering/ShaderModule.hpp>
+#include <Vulkan/Rendering/SpecializationConstants.hpp>
 #include <Vulkan/Rendering/Pipeline.hpp>
 #include <Vulkan/Rendering/PipelineState.hpp>
 #include <Vulkan/Presentation/Swapchain.hpp>
@@ -20,6 +21,20 @@ namespace sdvk
 
         PipelineBuilder& create_pipeline_layout();
 
+        /**
+         * Reuse an existing layout instead of creating a new one, e.g. for specialized variants of a pipeline.
+         */
+        PipelineBuilder& with_pipeline_layout(const vk::PipelineLayout& pipeline_layout)
+        {
+            pipeline.pipeline_layout = pipeline_layout;
+            return *this;
+        }
+
+        const vk::PipelineLayout& get_pipeline_layout() const
+        {
+            return pipeline.pipeline_layout;
+        }
+
         PipelineBuilder& enable_wireframe_mode();
 
         PipelineBuilder& add_attribute_descriptions(const std::vector<vk::VertexInputAttributeDescription>& viads);
@@ -55,6 +70,9 @@ namespace sdvk
 
         PipelineBuilder& add_shader(const std::string& shader_src, vk::ShaderStageFlagBits shader_stage);
 
+        PipelineBuilder& add_shader(const std::string& shader_src, vk::ShaderStageFlagBits shader_stage,
+                                    const SpecializationConstants& specialization_constants);
+
         PipelineBuilder& make_rt_shader_groups();
 
         PipelineBuilder& with_name(std::string const& name)
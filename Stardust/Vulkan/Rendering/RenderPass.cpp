@@ -23,13 +23,13 @@ namespace sdvk
         return *this;
     }
 
-    RenderPass::Builder& RenderPass::Builder::set_depth_attachment(vk::Format format, vk::SampleCountFlagBits sample_count)
+    RenderPass::Builder& RenderPass::Builder::set_depth_attachment(vk::Format format, vk::SampleCountFlagBits sample_count, vk::AttachmentStoreOp store_op)
     {
         vk::AttachmentDescription ad;
         ad.setFormat(format);
         ad.setSamples(sample_count);
         ad.setLoadOp(vk::AttachmentLoadOp::eClear);
-        ad.setStoreOp(vk::AttachmentStoreOp::eDontCare);
+        ad.setStoreOp(store_op);
         ad.setStencilLoadOp(vk::AttachmentLoadOp::eDontCare);
         ad.setStencilStoreOp(vk::AttachmentStoreOp::eDontCare);
         ad.setInitialLayout(vk::ImageLayout::eUndefined);
@@ -153,7 +153,20 @@ namespace sdvk
     void
     RenderPass::Execute::execute(const vk::CommandBuffer& cmd, const std::function<void(const vk::CommandBuffer&)>& fn)
     {
+        const vk::Rect2D& area = _begin_info.renderArea;
+
+        // Flipped like the swapchain and offscreen target viewports.
+        vk::Viewport viewport;
+        viewport.setX(static_cast<float>(area.offset.x));
+        viewport.setWidth(static_cast<float>(area.extent.width));
+        viewport.setY(static_cast<float>(area.offset.y) + static_cast<float>(area.extent.height));
+        viewport.setHeight(-1.0f * static_cast<float>(area.extent.height));
+        viewport.setMinDepth(0.0f);
+        viewport.setMaxDepth(1.0f);
+
         cmd.beginRenderPass(&_begin_info, vk::SubpassContents::eInline);
+        cmd.setViewport(0, 1, &viewport);
+        cmd.setScissor(0, 1, &area);
         fn(cmd);
         cmd.endRenderPass();
     }
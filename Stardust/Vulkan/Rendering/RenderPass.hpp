@@ -22,7 +22,8 @@ namespace sdvk
                                           vk::AttachmentLoadOp load_op = vk::AttachmentLoadOp::eClear);
 
             Builder& set_depth_attachment(vk::Format format,
-                                          vk::SampleCountFlagBits sample_count = vk::SampleCountFlagBits::e1);
+                                          vk::SampleCountFlagBits sample_count = vk::SampleCountFlagBits::e1,
+                                          vk::AttachmentStoreOp store_op = vk::AttachmentStoreOp::eDontCare);
 
             Builder& set_resolve_attachment(vk::Format format,
                                             vk::ImageLayout final_layout = vk::ImageLayout::ePresentSrcKHR);
@@ -72,6 +73,7 @@ namespace sdvk
 
             Execute& with_framebuffer(const vk::Framebuffer& framebuffer);
 
+            // Viewport and scissor are set to the render area, so passes below the presentation resolution need no extra state.
             void execute(vk::CommandBuffer const& cmd, const std::function<void(const vk::CommandBuffer&)>& fn);
 
         private:
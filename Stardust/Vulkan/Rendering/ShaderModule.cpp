@@ -5,9 +5,12 @@
 namespace sdvk
 {
 
-    ShaderModule::ShaderModule(const std::string& source, vk::ShaderStageFlagBits shader_stage, const vk::Device& device)
-    : stage(shader_stage)
+    ShaderModule::ShaderModule(const std::string& source, vk::ShaderStageFlagBits shader_stage, const vk::Device& device,
+                               const SpecializationConstants& specialization_constants)
+    : stage(shader_stage), constants(specialization_constants)
     {
+        specialization_info = constants.info();
+
         auto shader_source_code = ShaderModule::read_file(source);
 
         vk::ShaderModuleCreateInfo create_info;
@@ -22,6 +25,10 @@ namespace sdvk
         stage_info.setStage(stage);
         stage_info.setModule(module);
         stage_info.setPName("main");
+        if (!constants.empty())
+        {
+            stage_info.setPSpecializationInfo(&specialization_info);
+        }
         return stage_info;
     }
 
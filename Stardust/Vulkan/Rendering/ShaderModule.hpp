@@ -2,13 +2,15 @@
 
 #include <vector>
 #include <vulkan/vulkan.hpp>
+#include <Vulkan/Rendering/SpecializationConstants.hpp>
 
 namespace sdvk
 {
     struct ShaderModule
     {
     public:
-        ShaderModule(std::string const& source, vk::ShaderStageFlagBits shader_stage, vk::Device const& device);
+        ShaderModule(std::string const& source, vk::ShaderStageFlagBits shader_stage, vk::Device const& device,
+                     SpecializationConstants const& specialization_constants = {});
 
         vk::PipelineShaderStageCreateInfo stage_info() const;
 
@@ -17,5 +19,7 @@ namespace sdvk
 
         vk::ShaderModule module;
         vk::ShaderStageFlagBits stage;
+        SpecializationConstants constants;
+        vk::SpecializationInfo  specialization_info;
     };
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace sdvk
+{
+    /**
+     * Tightly packed specialization constant values for a single shader stage.
+     * Booleans are stored as VkBool32 as required by the SPIR-V spec.
+     */
+    class SpecializationConstants
+    {
+    public:
+        template <typename T>
+        SpecializationConstants& add(uint32_t constant_id, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Specialization constants must be trivially copyable");
+
+            const auto offset = static_cast<uint32_t>(m_data.size());
+            m_data.resize(offset + sizeof(T));
+            std::memcpy(m_data.data() + offset, &value, sizeof(T));
+            m_entries.emplace_back(constant_id, offset, sizeof(T));
+            return *this;
+        }
+
+        SpecializationConstants& add(uint32_t constant_id, bool value)
+        {
+            return add<vk::Bool32>(constant_id, value ? VK_TRUE : VK_FALSE);
+        }
+
+        bool empty() const { return m_entries.empty(); }
+
+        /**
+         * The returned struct points into this object, it must outlive any pipeline creation using it.
+         */
+        vk::SpecializationInfo info() const
+        {
+            vk::SpecializationInfo specialization_info;
+            specialization_info.setMapEntryCount(static_cast<uint32_t>(m_entries.size()));
+            specialization_info.setPMapEntries(m_entries.data());
+            specialization_info.setDataSize(m_data.size());
+            specialization_info.setPData(m_data.data());
+            return specialization_info;
+        }
+
+    private:
+        std::vector<vk::SpecializationMapEntry> m_entries;
+        std::vector<uint8_t>                    m_data;
+    };
+}
@@ -76,6 +76,16 @@ namespace sd
         return std::vector<const char*>(extensions, extensions + extension_count);
     }
 
+    vk::SurfaceKHR Window::create_surface(const vk::Instance& instance) const
+    {
+        VkSurfaceKHR surface;
+        if (glfwCreateWindowSurface(static_cast<VkInstance>(instance), m_window, nullptr, &surface) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create window surface.");
+        }
+        return surface;
+    }
+
     void Window::default_key_handler(GLFWwindow *window, int key, int scancode, int action, int mods)
     {
         if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
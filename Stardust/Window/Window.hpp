@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <vector>
+#include <vulkan/vulkan.hpp>
 #include <GLFW/glfw3.h>
 #include "WindowOptions.hpp"
 
@@ -28,6 +29,8 @@ namespace sd
 
         static std::vector<const char*> get_vk_extensions();
 
+        vk::SurfaceKHR create_surface(const vk::Instance& instance) const;
+
     private:
         static void default_key_handler(GLFWwindow* window, int key, int scancode, int action, int mods);
 
@@ -1,20 +1,166 @@
 #include <memory>
+#include <sstream>
+#include <string>
 #include <Application/Application.hpp>
 
 std::unique_ptr<sd::Application> g_application;
-sd::Extent sd::Application::s_extent = {};
 
-int main()
+int main(int argc, char** argv)
 {
     sd::ApplicationOptions options;
     options.window_options.set_resolution(sd::Resolution::e1600x900);
     //options.window_options.set_resolution(2240, 1260);
     options.window_options.set_title("Nebula");
 
+    // --headless [--frames <count>]
+    // --graph <preset> [--objects <count>]
+    // --scene <uniform|clustered|city> [--clusters <count>] [--mesh-variety <count>] [--instancing <0..1>]
+    //         [--triangle-density <tessellation>] [--motion <0..1>] [--deform <0..1>] [--scene-extent <size>]
+    //         [--stream [--cell-size <size>] [--load-radius <distance>] [--upload-budget <KB>] [--stream-budget <MB>]]
+    // --memory-report <file.json>
+    // --memory-headroom <0..0.5> [--memory-budget <MB>] [--memory-pressure-log <file.json>]
+    // --defrag-budget <KB>
+    // --benchmark [--seed <n>] [--camera-path <file>] [--warmup <count>] [--frames <count>] [--report <file.json>]
+    //             [--capture <frame,frame,...>] [--capture-dir <dir>]
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--headless")
+        {
+            options.headless = true;
+        }
+        else if (arg == "--benchmark")
+        {
+            options.benchmark.enabled = true;
+        }
+        else if (arg == "--frames" && has_value)
+        {
+            options.headless_frame_count = static_cast<uint32_t>(std::stoul(argv[++i]));
+            options.benchmark.measured_frames = options.headless_frame_count;
+        }
+        else if (arg == "--graph" && has_value)
+        {
+            options.graph_preset = argv[++i];
+        }
+        else if (arg == "--objects" && has_value)
+        {
+            options.scene_object_count = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--scene" && has_value)
+        {
+            options.scene_generator.enabled = true;
+            options.scene_generator.distribution = sd::SceneGeneratorOptions::parse_distribution(argv[++i]);
+        }
+        else if (arg == "--clusters" && has_value)
+        {
+            options.scene_generator.cluster_count = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--mesh-variety" && has_value)
+        {
+            options.scene_generator.mesh_variety = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--instancing" && has_value)
+        {
+            options.scene_generator.instancing_ratio = std::stof(argv[++i]);
+        }
+        else if (arg == "--triangle-density" && has_value)
+        {
+            options.scene_generator.triangle_density = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--motion" && has_value)
+        {
+            options.scene_generator.motion_fraction = std::stof(argv[++i]);
+        }
+        else if (arg == "--deform" && has_value)
+        {
+            options.scene_generator.deform_fraction = std::stof(argv[++i]);
+        }
+        else if (arg == "--scene-extent" && has_value)
+        {
+            options.scene_generator.extent = std::stof(argv[++i]);
+        }
+        else if (arg == "--stream")
+        {
+            options.scene_generator.streaming.enabled = true;
+        }
+        else if (arg == "--cell-size" && has_value)
+        {
+            options.scene_generator.streaming.cell_size = std::stof(argv[++i]);
+        }
+        else if (arg == "--load-radius" && has_value)
+        {
+            // Keeps the distance between loading and evicting a cell.
+            auto& streaming = options.scene_generator.streaming;
+            const float hysteresis = streaming.evict_radius - streaming.load_radius;
+            streaming.load_radius = std::stof(argv[++i]);
+            streaming.evict_radius = streaming.load_radius + hysteresis;
+        }
+        else if (arg == "--upload-budget" && has_value)
+        {
+            options.scene_generator.streaming.upload_budget = std::stoull(argv[++i]) * 1024;
+        }
+        else if (arg == "--stream-budget" && has_value)
+        {
+            options.scene_generator.streaming.memory_budget = std::stoull(argv[++i]) * 1024 * 1024;
+        }
+        else if (arg == "--memory-report" && has_value)
+        {
+            options.memory_report_path = argv[++i];
+            options.write_memory_report = true;
+        }
+        else if (arg == "--memory-headroom" && has_value)
+        {
+            options.memory_budget.headroom = std::stof(argv[++i]);
+        }
+        else if (arg == "--memory-budget" && has_value)
+        {
+            options.memory_budget.budget_override = std::stoull(argv[++i]) * 1024 * 1024;
+        }
+        else if (arg == "--memory-pressure-log" && has_value)
+        {
+            options.memory_pressure_log_path = argv[++i];
+            options.write_memory_pressure_log = true;
+        }
+        else if (arg == "--defrag-budget" && has_value)
+        {
+            options.defragmentation_budget = std::stoull(argv[++i]) * 1024;
+        }
+        else if (arg == "--seed" && has_value)
+        {
+            options.benchmark.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--camera-path" && has_value)
+        {
+            options.benchmark.camera_path = argv[++i];
+        }
+        else if (arg == "--warmup" && has_value)
+        {
+            options.benchmark.warmup_frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--report" && has_value)
+        {
+            options.benchmark.report_path = argv[++i];
+        }
+        else if (arg == "--capture" && has_value)
+        {
+            std::stringstream frames(argv[++i]);
+            std::string frame;
+            while (std::getline(frames, frame, ','))
+            {
+                options.benchmark.capture_frames.push_back(static_cast<uint32_t>(std::stoul(frame)));
+            }
+        }
+        else if (arg == "--capture-dir" && has_value)
+        {
+            options.benchmark.capture_directory = argv[++i];
+        }
+    }
+
     sd::Application::s_extent = sd::Extent(options.window_options.width(), options.window_options.height());
 
     g_application = std::make_unique<sd::Application>(options);
     g_application->run();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Benchmarking.hpp>
+
+namespace sd::bench
+{
+    void register_culling_benchmarks(bm::Suite& suite);
+
+    void register_graph_compiler_benchmarks(bm::Suite& suite);
+
+    void register_meshlet_benchmarks(bm::Suite& suite);
+
+    void register_resource_table_benchmarks(bm::Suite& suite);
+
+    void register_transform_benchmarks(bm::Suite& suite);
+}
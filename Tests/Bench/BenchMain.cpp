@@ -0,0 +1,35 @@
+#include <chrono>
+#include <string>
+#include "Bench.hpp"
+
+// stardust_bench [--filter <substring>] [--min-time <ms>]
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::chrono::milliseconds min_time(250);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value)
+        {
+            filter = argv[++i];
+        }
+        else if (arg == "--min-time" && has_value)
+        {
+            min_time = std::chrono::milliseconds(std::stoul(argv[++i]));
+        }
+    }
+
+    sd::bm::Suite suite;
+    sd::bench::register_culling_benchmarks(suite);
+    sd::bench::register_graph_compiler_benchmarks(suite);
+    sd::bench::register_meshlet_benchmarks(suite);
+    sd::bench::register_resource_table_benchmarks(suite);
+    sd::bench::register_transform_benchmarks(suite);
+
+    suite.run(filter, min_time);
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <format>
+#include <memory>
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include <Scene/Frustum.hpp>
+#include <Scene/SceneBvh.hpp>
+#include "Bench.hpp"
+
+namespace sd::bench
+{
+    // Boxes scattered like the default scene, seen by a camera above the ground plane.
+    static std::vector<Aabb> make_bounds(const uint32_t count)
+    {
+        std::mt19937 engine(1);
+        std::uniform_real_distribution<float> position(-96.0f, 96.0f);
+        std::uniform_real_distribution<float> size(0.5f, 8.0f);
+
+        std::vector<Aabb> bounds(count);
+        for (auto& aabb : bounds)
+        {
+            const glm::vec3 center(position(engine), size(engine), position(engine));
+            const glm::vec3 extent(size(engine), size(engine), size(engine));
+            aabb = { center - extent, center + extent };
+        }
+        return bounds;
+    }
+
+    void register_culling_benchmarks(bm::Suite& suite)
+    {
+        const glm::mat4 view = glm::lookAt(glm::vec3(5.0f, 5.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        const auto frustum = std::make_shared<Frustum>(projection * view);
+
+        for (const uint32_t count : { 10000u, 100000u })
+        {
+            const auto bounds = std::make_shared<std::vector<Aabb>>(make_bounds(count));
+            const auto bvh = std::make_shared<SceneBvh>();
+            bvh->build(*bounds);
+
+            suite.add(std::format("Frustum::classify/{}", count), [bounds, frustum](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    uint32_t visible = 0;
+                    for (const auto& aabb : *bounds)
+                    {
+                        visible += frustum->is_visible(aabb) ? 1 : 0;
+                    }
+                    bm::do_not_optimize(visible);
+                }
+            });
+
+            suite.add(std::format("SceneBvh::cull/{}", count), [bvh, frustum](const uint64_t iterations) {
+                std::vector<uint32_t> visible;
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    visible.clear();
+                    bm::do_not_optimize(bvh->cull(*frustum, visible));
+                }
+            });
+
+            // A quarter of the objects move each frame.
+            suite.add(std::format("SceneBvh::refit/{}", count), [bvh, bounds](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    const glm::vec3 offset(0.0f, (i % 2 == 0) ? 0.25f : -0.25f, 0.0f);
+                    for (uint32_t object = 0; object < bounds->size(); object += 4)
+                    {
+                        const Aabb& aabb = (*bounds)[object];
+                        bvh->set_bounds(object, { aabb.min + offset, aabb.max + offset });
+                    }
+                    bvh->refit();
+                }
+            });
+        }
+    }
+}
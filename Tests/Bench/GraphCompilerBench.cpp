@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <random>
+#include <vector>
+#include <VirtualGraph/Compile/Algorithm/ResourceOptimizer.hpp>
+#include <VirtualGraph/Compile/Algorithm/TopologicalSort.hpp>
+#include <VirtualGraph/Editor/Edge.hpp>
+#include <VirtualGraph/Editor/Node.hpp>
+#include "Bench.hpp"
+
+namespace sd::bench
+{
+    using namespace Nebula::RenderGraph;
+
+    struct EditorGraph
+    {
+        std::vector<std::shared_ptr<Editor::Node>> nodes;
+        std::vector<Editor::Edge>                  edges;
+    };
+
+    // Chain of blur passes in shuffled order, consecutive outputs can share an image once optimized.
+    static EditorGraph make_blur_chain(const int32_t length)
+    {
+        EditorGraph graph;
+        for (int32_t i = 0; i < length; i++)
+        {
+            graph.nodes.push_back(std::make_shared<Editor::BlurNode>());
+        }
+
+        for (int32_t i = 1; i < length; i++)
+        {
+            const auto& a = graph.nodes[i - 1];
+            const auto& b = graph.nodes[i];
+            auto& output = a->get_resource("Blur Output");
+            auto& input = b->get_resource("Blur Input");
+
+            Editor::Node::make_directed_edge(a, b);
+            graph.edges.emplace_back(*a, output, *b, input, output.type);
+            input.input_is_connected = true;
+        }
+
+        std::ranges::shuffle(graph.nodes, std::mt19937(1));
+        return graph;
+    }
+
+    void register_graph_compiler_benchmarks(bm::Suite& suite)
+    {
+        for (const int32_t length : { 10, 100, 1000 })
+        {
+            const auto graph = std::make_shared<EditorGraph>(make_blur_chain(length));
+            const auto sorted = std::make_shared<std::vector<std::shared_ptr<Editor::Node>>>(
+                Algorithm::TopologicalSort(graph->nodes).execute());
+
+            suite.add(std::format("TopologicalSort/{}", length), [graph](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    bm::do_not_optimize(Algorithm::TopologicalSort(graph->nodes).execute());
+                }
+            });
+
+            suite.add(std::format("ResourceOptimizer::run/{}", length), [graph, sorted](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    Algorithm::ResourceOptimizer optimizer(*sorted, graph->edges);
+                    bm::do_not_optimize(optimizer.run());
+                }
+            });
+        }
+    }
+}
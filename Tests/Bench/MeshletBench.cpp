@@ -0,0 +1,40 @@
+#include <format>
+#include <Resources/Primitives/Cube.hpp>
+#include <Resources/Primitives/Sphere.hpp>
+#include <Vulkan/Rendering/Mesh.hpp>
+#include <Vulkan/Rendering/MeshRegistry.hpp>
+#include "Bench.hpp"
+
+namespace sd::bench
+{
+    void register_meshlet_benchmarks(bm::Suite& suite)
+    {
+        static const primitives::Cube cube;
+        suite.add("create_meshlets/cube", [](const uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                bm::do_not_optimize(sdvk::Mesh::create_meshlets(cube, 64, 126));
+            }
+        });
+
+        // Same tesselations as the scene sphere (250) and a smaller one
+        for (const int32_t tesselation : { 60, 250 })
+        {
+            const auto sphere = std::make_shared<primitives::Sphere>(1.0f, tesselation);
+            suite.add(std::format("create_meshlets/sphere_{}", tesselation), [sphere](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    bm::do_not_optimize(sdvk::Mesh::create_meshlets(*sphere, 64, 126));
+                }
+            });
+
+            // Paid by every mesh registry request, duplicates included.
+            suite.add(std::format("content_hash/sphere_{}", tesselation), [sphere](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    bm::do_not_optimize(sdvk::MeshRegistry::content_hash(*sphere));
+                }
+            });
+        }
+    }
+}
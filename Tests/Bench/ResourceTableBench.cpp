@@ -0,0 +1,71 @@
+#include <array>
+#include <format>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <VirtualGraph/RenderGraph/Resources/Resource.hpp>
+#include <VirtualGraph/RenderGraph/Resources/ResourceTable.hpp>
+#include "Bench.hpp"
+
+namespace sd::bench
+{
+    using namespace Nebula::RenderGraph;
+
+    static constexpr int32_t s_node_count = 1000;
+    static const std::array<std::string, 4> s_slot_names = { "Position Buffer", "Normal Buffer", "Albedo Buffer", "Lighting Result" };
+
+    // Per-node lookup as done before the flat table: string keyed map plus a checked cast.
+    struct MapNode
+    {
+        std::map<std::string, std::shared_ptr<Resource>> resources;
+    };
+
+    struct HandleNode
+    {
+        std::array<ImageHandle, 4> handles;
+    };
+
+    void register_resource_table_benchmarks(bm::Suite& suite)
+    {
+        auto table = std::make_shared<ResourceTable>();
+        auto map_nodes = std::make_shared<std::vector<MapNode>>(s_node_count);
+        auto handle_nodes = std::make_shared<std::vector<HandleNode>>(s_node_count);
+
+        for (int32_t i = 0; i < s_node_count; i++)
+        {
+            for (size_t slot = 0; slot < s_slot_names.size(); slot++)
+            {
+                const auto resource = std::make_shared<ImageResource>(nullptr, std::format("{} {}", s_slot_names[slot], i));
+                (*map_nodes)[i].resources[s_slot_names[slot]] = resource;
+                (*handle_nodes)[i].handles[slot] = table->make_handle<ImageResource>(table->add(resource));
+            }
+        }
+
+        suite.add(std::format("ResourceLookup/string_map/{}_nodes", s_node_count), [map_nodes](const uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                for (const auto& node : *map_nodes)
+                {
+                    for (const auto& name : s_slot_names)
+                    {
+                        bm::do_not_optimize(std::dynamic_pointer_cast<ImageResource>(node.resources.at(name)).get());
+                    }
+                }
+            }
+        });
+
+        suite.add(std::format("ResourceLookup/handle_table/{}_nodes", s_node_count), [table, handle_nodes](const uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                for (const auto& node : *handle_nodes)
+                {
+                    for (const auto& handle : node.handles)
+                    {
+                        bm::do_not_optimize(&table->get(handle));
+                    }
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,85 @@
+#include <format>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <Scene/Object.hpp>
+#include <Scene/RenderList.hpp>
+#include <Scene/SceneStore.hpp>
+#include <Scene/Transform.hpp>
+#include <Vulkan/Raytracing/Tlas.hpp>
+#include "Bench.hpp"
+
+namespace sd::bench
+{
+    // Placement follows the default scene, objects have no mesh so no Vulkan objects are needed.
+    static std::vector<Object> make_objects(const uint32_t count)
+    {
+        std::mt19937 engine(1);
+        std::uniform_real_distribution<float> position(-96.0f, 96.0f);
+        std::uniform_real_distribution<float> scale(1.0f, 16.0f);
+        std::uniform_real_distribution<float> angle(-1.0f, 1.0f);
+
+        std::vector<Object> objects(count);
+        for (auto& object : objects)
+        {
+            object.transform.position = { position(engine), 0.0f, position(engine) };
+            object.transform.scale = { scale(engine), scale(engine), scale(engine) };
+            object.transform.rotation = glm::normalize(glm::quat(angle(engine), angle(engine), angle(engine), angle(engine)));
+        }
+        return objects;
+    }
+
+    void register_transform_benchmarks(bm::Suite& suite)
+    {
+        for (const uint32_t count : { 1024u, 10000u, 100000u })
+        {
+            const auto objects = std::make_shared<std::vector<Object>>(make_objects(count));
+
+            const auto store = std::make_shared<SceneStore>();
+            store->reserve(count);
+            for (const auto& object : *objects)
+            {
+                store->add(object.transform);
+            }
+            store->update_transforms();
+
+            suite.add(std::format("Transform::model/{}", count), [objects](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    for (const auto& object : *objects)
+                    {
+                        bm::do_not_optimize(object.transform.model());
+                    }
+                }
+            });
+
+            suite.add(std::format("SceneStore::update_transforms ({})/{}", SceneStore::kernel_isa(), count), [store](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    store->invalidate();
+                    store->update_transforms();
+                    bm::do_not_optimize(store->models().data());
+                }
+            });
+
+            suite.add(std::format("RenderList::build/{}", count), [objects, store](const uint64_t iterations) {
+                std::vector<uint32_t> visible(objects->size());
+                std::iota(visible.begin(), visible.end(), 0);
+
+                RenderList render_list;
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    render_list.build(*store, visible, glm::vec3(5.0f));
+                    bm::do_not_optimize(render_list.batches().size());
+                }
+            });
+
+            suite.add(std::format("Tlas::pack_instances/{}", count), [objects, store](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    bm::do_not_optimize(sdvk::Tlas::pack_instances(*objects, store->models3x4()));
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,151 @@
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+# CTest treats this exit code as a skipped test (SKIP_RETURN_CODE).
+skip_return_code = 77
+
+# metric: (relative tolerance, absolute slack), every metric is lower-is-better.
+# Frame times use the --tolerance argument instead of the relative tolerance listed here.
+timing_metrics = {
+    "cpu_ms.p50": (None, 0.05),
+    "cpu_ms.p95": (None, 0.10),
+    "gpu_ms.p50": (None, 0.05),
+    "gpu_ms.p95": (None, 0.10),
+    "compile_ms": (0.25, 2.0),
+}
+
+# Independent of the speed of the machine, compared even if the baseline was recorded on another device.
+resource_metrics = {
+    "gpu_allocations": (0.02, 0),
+    "gpu_allocated_mb": (0.02, 0.5),
+    "frame_gpu_allocations": (0.0, 0),
+}
+
+
+def get_metric(report, name):
+    value = report
+    for key in name.split("."):
+        if not isinstance(value, dict) or key not in value:
+            return None
+        value = value[key]
+    return value
+
+
+def run_case(args, report_path):
+    command = [
+        args.exe,
+        "--benchmark",
+        "--graph", args.graph,
+        "--objects", str(args.objects),
+        "--seed", str(args.seed),
+        "--warmup", str(args.warmup),
+        "--frames", str(args.frames),
+        "--report", report_path,
+    ]
+    if args.camera_path:
+        command += ["--camera-path", args.camera_path]
+    if args.scene:
+        command += [
+            "--scene", args.scene,
+            "--mesh-variety", str(args.mesh_variety),
+            "--instancing", str(args.instancing),
+            "--triangle-density", str(args.triangle_density),
+            "--motion", str(args.motion),
+        ]
+
+    print(" ".join(command))
+    result = subprocess.run(command)
+    if result.returncode != 0:
+        print(f"[Error] {args.name}: exited with code {result.returncode}")
+        sys.exit(1)
+
+    with open(report_path, "r") as f:
+        return json.load(f)
+
+
+def compare(name, report, baseline, tolerance):
+    metrics = dict(resource_metrics)
+    if report.get("device") == baseline.get("device"):
+        metrics.update(timing_metrics)
+    else:
+        print(f"[Warning] {name}: baseline was recorded on \"{baseline.get('device')}\", "
+              f"running on \"{report.get('device')}\", frame and compile times are not compared")
+
+    regressions = []
+    for metric, (relative, absolute) in metrics.items():
+        current = get_metric(report, metric)
+        expected = get_metric(baseline, metric)
+        if current is None or expected is None:
+            continue
+
+        if relative is None:
+            relative = tolerance
+
+        limit = expected * (1.0 + relative) + absolute
+        status = "ok"
+        if current > limit:
+            status = "REGRESSION"
+            regressions.append(metric)
+
+        print(f"  {metric:<24} baseline: {expected:>10.4f}  current: {current:>10.4f}  limit: {limit:>10.4f}  {status}")
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Runs a graph + scene configuration headless and compares it to a baseline.")
+    parser.add_argument("--exe", required=True)
+    parser.add_argument("--name", required=True)
+    parser.add_argument("--graph", default="default")
+    parser.add_argument("--objects", type=int, default=1024)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--warmup", type=int, default=60)
+    parser.add_argument("--frames", type=int, default=300)
+    parser.add_argument("--camera-path", default="")
+    parser.add_argument("--scene", default="", help="Generated scene distribution (uniform, clustered, city), default scene if empty")
+    parser.add_argument("--mesh-variety", type=int, default=4)
+    parser.add_argument("--instancing", type=float, default=1.0)
+    parser.add_argument("--triangle-density", type=int, default=32)
+    parser.add_argument("--motion", type=float, default=0.0)
+    parser.add_argument("--requires-raytracing", action="store_true")
+    parser.add_argument("--baseline-dir", required=True)
+    parser.add_argument("--work-dir", default=".")
+    parser.add_argument("--tolerance", type=float, default=0.10, help="Allowed relative frame time regression")
+    parser.add_argument("--update-baseline", action="store_true")
+    args = parser.parse_args()
+
+    report_path = os.path.join(args.work_dir, f"perf_{args.name}.json")
+    baseline_path = os.path.join(args.baseline_dir, f"{args.name}.json")
+
+    report = run_case(args, report_path)
+
+    if args.requires_raytracing and not report.get("raytracing", False):
+        print(f"{args.name}: device has no ray tracing support, skipped")
+        sys.exit(skip_return_code)
+
+    if args.update_baseline:
+        os.makedirs(args.baseline_dir, exist_ok=True)
+        with open(baseline_path, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+        print(f"{args.name}: baseline updated \"{baseline_path}\"")
+        return
+
+    if not os.path.exists(baseline_path):
+        print(f"[Error] {args.name}: no baseline at \"{baseline_path}\", build the update_performance_baselines target first")
+        sys.exit(1)
+
+    with open(baseline_path, "r") as f:
+        baseline = json.load(f)
+
+    print(f"{args.name}:")
+    regressions = compare(args.name, report, baseline, args.tolerance)
+    if regressions:
+        print(f"[Error] {args.name}: regressed metrics: {', '.join(regressions)}")
+        sys.exit(1)
+
+
+main()
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <vector>
+#include <Scene/Frustum.hpp>
+#include <Scene/SceneBvh.hpp>
+
+// Streamed objects have empty bounds until their cell is resident, they have to enter the tree once it is and leave it on eviction.
+namespace
+{
+    int g_failures = 0;
+
+    void check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cout << std::format("[Error] {}", what) << std::endl;
+            g_failures++;
+        }
+    }
+
+    bool is_visible(const sd::SceneBvh& bvh, const sd::Frustum& frustum, const uint32_t object)
+    {
+        std::vector<uint32_t> visible;
+        bvh.cull(frustum, visible);
+        return std::ranges::find(visible, object) != visible.end();
+    }
+
+    sd::Aabb make_box(const glm::vec3& center, const float extent)
+    {
+        return { center - glm::vec3(extent), center + glm::vec3(extent) };
+    }
+}
+
+int main()
+{
+    // The identity view projection sees -1 <= x, y <= 1 and 0 <= z <= 1.
+    const sd::Frustum frustum(glm::mat4(1.0f));
+
+    // A row of resident objects across and beyond the frustum, so the tree has more than one level.
+    std::vector<sd::Aabb> bounds;
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        bounds.push_back(make_box({ -4.0f + 0.125f * static_cast<float>(i), 0.0f, 0.5f }, 0.05f));
+    }
+
+    const auto streamed = static_cast<uint32_t>(bounds.size());
+    bounds.emplace_back();
+
+    sd::SceneBvh bvh;
+    bvh.build(bounds);
+    check(bvh.object_count() == 64, "Objects without bounds are not part of the built tree");
+    check(!is_visible(bvh, frustum, streamed), "Object of a cell that is not resident is culled");
+
+    // Its cell became resident and the object got its mesh.
+    bvh.set_bounds(streamed, make_box({ 0.0f, 0.5f, 0.5f }, 0.1f));
+    bvh.refit();
+    check(bvh.object_count() == 65, "Streamed object enters the tree once it has bounds");
+    check(is_visible(bvh, frustum, streamed), "Streamed object is visible once its cell is resident");
+
+    // Moving keeps it in the tree through a refit.
+    bvh.set_bounds(streamed, make_box({ 4.0f, 0.5f, 0.5f }, 0.1f));
+    bvh.refit();
+    check(!is_visible(bvh, frustum, streamed), "Streamed object moved out of the frustum is culled");
+    bvh.set_bounds(streamed, make_box({ 0.5f, 0.5f, 0.5f }, 0.1f));
+    bvh.refit();
+    check(is_visible(bvh, frustum, streamed), "Streamed object moved back into the frustum is visible");
+
+    // Its cell was evicted and the object lost its mesh.
+    bvh.set_bounds(streamed, {});
+    bvh.refit();
+    check(bvh.object_count() == 64, "Evicted object leaves the tree");
+    check(!is_visible(bvh, frustum, streamed), "Evicted object is culled");
+
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        check(is_visible(bvh, frustum, i) == frustum.is_visible(bounds[i]), "Resident objects are unaffected by streaming");
+    }
+
+    if (g_failures > 0)
+    {
+        std::cout << std::format("{} checks failed", g_failures) << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}